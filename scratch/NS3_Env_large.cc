@@ -249,6 +249,8 @@ main (int argc, char *argv[])
 
   //opengym environment
   uint32_t openGymPort = 1167;
+  std::string qTablePolicy = "";
+  std::string dqnCoordinator = "";
 
   // change some default attributes so that they are reasonable for
   // this scenario, but do this before processing command line
@@ -263,6 +265,8 @@ main (int argc, char *argv[])
   cmd.AddValue ("speed", "Speed of the UE (default = 20 m/s)", speed);
   cmd.AddValue ("enbTxPowerDbm", "TX power [dBm] used by HeNBs (default = 46.0)", enbTxPowerDbm);
   cmd.AddValue ("RunNum" , "1...10" , RunNum);
+  cmd.AddValue ("qTablePolicy", "Binary Q-table policy file applied in place of the agent (see utils/q-table-import)", qTablePolicy);
+  cmd.AddValue ("dqnCoordinator", "Binary DQN file of the coordinator of the qTablePolicy actions (see export_dqn in the agents)", dqnCoordinator);
 
   cmd.Parse (argc, argv);
 
@@ -884,9 +888,19 @@ m11->SetPosition(Vector(400,400,1.6));
   
 
   Ptr<MyGymEnv> son_server = CreateObject<MyGymEnv> (steptime, numberOfEnbs, numberOfUes, macroEnbBandwidth, openGymPort);
-  Ptr<OpenGymInterface> openGymInterface = CreateObject<OpenGymInterface> (openGymPort);
 
-  son_server->SetOpenGymInterface(openGymInterface);
+  if (qTablePolicy.empty ())
+    {
+      // the interface binds the port of the agent
+      Ptr<OpenGymInterface> openGymInterface = CreateObject<OpenGymInterface> (openGymPort);
+      son_server->SetOpenGymInterface(openGymInterface);
+    }
+  else
+    {
+      // evaluation run, the agent is not notified
+      son_server->SetAttribute ("QTablePolicy", StringValue (qTablePolicy));
+      son_server->SetAttribute ("DqnCoordinator", StringValue (dqnCoordinator));
+    }
 
   // Install LTE Devices in eNB and UEs
   Config::SetDefault ("ns3::LteEnbPhy::TxPower", DoubleValue (enbTxPowerDbm));
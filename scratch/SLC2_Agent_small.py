@@ -63,6 +63,19 @@ def action_func_coordinator(actions):
         actions = int(actions/4)
     
     return env_actions_coordinator
+
+def export_dqn(model, file_path):
+    # flat little endian file of DqnPolicy (src/lte/model/dqn-policy.h):
+    # "SLCD", version, number of layers, then the shape, weights and biases
+    # of each torch.nn.Linear, in single precision
+    layers = [m for m in model.modules() if isinstance(m, nn.Linear)]
+    with open(file_path, 'wb') as f:
+        f.write(b'SLCD')
+        f.write(np.array([1, len(layers)], dtype='<u4').tobytes())
+        for layer in layers:
+            f.write(np.array([layer.in_features, layer.out_features], dtype='<u4').tobytes())
+            f.write(layer.weight.detach().cpu().numpy().astype('<f4').tobytes())
+            f.write(layer.bias.detach().cpu().numpy().astype('<f4').tobytes())
 #################################################################################
 ######################################################################################################################################################
 
@@ -804,3 +817,6 @@ if __name__ == "__main__" :
                 actions_Mro_previous[k] = actions_Mro[k]
                 actions_Mlb_previous[k] = actions_Mlb[k]
 ######################################################################################################################################################
+
+        # coordinator of the evaluation runs (MyGymEnv::DqnCoordinator)
+        export_dqn(Coordinator.model, "coordinator.bin")
@@ -27,6 +27,13 @@
 #include "pointer.h"
 #include "assert.h"
 #include "log.h"
+#ifdef ENABLE_EVENT_PROFILER
+#include "string.h"
+#include "enum.h"
+#include "uinteger.h"
+#include <fstream>
+#include <iostream>
+#endif
 
 #include <cmath>
 
@@ -53,6 +60,25 @@ DefaultSimulatorImpl::GetTypeId (void)
     .SetParent<SimulatorImpl> ()
     .SetGroupName ("Core")
     .AddConstructor<DefaultSimulatorImpl> ()
+#ifdef ENABLE_EVENT_PROFILER
+    .AddAttribute ("EventProfileFile",
+                   "File the event profile is written to at Simulator::Destroy; "
+                   "if empty, the profile is written to std::clog.",
+                   StringValue (""),
+                   MakeStringAccessor (&DefaultSimulatorImpl::m_profileFile),
+                   MakeStringChecker ())
+    .AddAttribute ("EventProfileFormat",
+                   "Format of the event profile.",
+                   EnumValue (EventProfiler::TEXT),
+                   MakeEnumAccessor (&DefaultSimulatorImpl::m_profileFormat),
+                   MakeEnumChecker (EventProfiler::TEXT, "Text",
+                                    EventProfiler::CHROME_TRACE, "ChromeTrace"))
+    .AddAttribute ("EventProfileMaxTraceEvents",
+                   "Maximum number of individual events kept for the ChromeTrace format.",
+                   UintegerValue (1000000),
+                   MakeUintegerAccessor (&DefaultSimulatorImpl::m_profileMaxTraceEvents),
+                   MakeUintegerChecker<uint32_t> ())
+#endif
   ;
   return tid;
 }
@@ -109,8 +135,37 @@ DefaultSimulatorImpl::Destroy ()
           ev->Invoke ();
         }
     }
+#ifdef ENABLE_EVENT_PROFILER
+  WriteEventProfile ();
+#endif
 }
 
+#ifdef ENABLE_EVENT_PROFILER
+void
+DefaultSimulatorImpl::WriteEventProfile (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_eventCount == 0)
+    {
+      return;
+    }
+  if (m_profileFile.empty ())
+    {
+      m_profiler.Write (std::clog, m_profileFormat);
+    }
+  else
+    {
+      std::ofstream os (m_profileFile.c_str ());
+      if (!os.is_open ())
+        {
+          NS_FATAL_ERROR ("Can't open event profile file " << m_profileFile);
+        }
+      m_profiler.Write (os, m_profileFormat);
+    }
+  m_profiler.Clear ();
+}
+#endif
+
 void
 DefaultSimulatorImpl::SetScheduler (ObjectFactory schedulerFactory)
 {
@@ -148,7 +203,13 @@ DefaultSimulatorImpl::ProcessOneEvent (void)
   m_currentTs = next.key.m_ts;
   m_currentContext = next.key.m_context;
   m_currentUid = next.key.m_uid;
+#ifdef ENABLE_EVENT_PROFILER
+  EventProfiler::Clock::time_point start = EventProfiler::Clock::now ();
+  next.impl->Invoke ();
+  m_profiler.Record (next.impl, m_currentContext, start, EventProfiler::Clock::now ());
+#else
   next.impl->Invoke ();
+#endif
   next.impl->Unref ();
 
   ProcessEventsWithContext ();
@@ -198,6 +259,9 @@ DefaultSimulatorImpl::Run (void)
   m_main = SystemThread::Self ();
   ProcessEventsWithContext ();
   m_stop = false;
+#ifdef ENABLE_EVENT_PROFILER
+  m_profiler.SetMaxTraceEvents (m_profileFormat == EventProfiler::CHROME_TRACE ? m_profileMaxTraceEvents : 0);
+#endif
 
   while (!m_events->IsEmpty () && !m_stop)
     {
@@ -26,6 +26,9 @@
 #include "event-impl.h"
 #include "system-thread.h"
 #include "system-mutex.h"
+#ifdef ENABLE_EVENT_PROFILER
+#include "event-profiler.h"
+#endif
 
 #include "ptr.h"
 
@@ -136,6 +139,20 @@ private:
 
   /** Main execution thread. */
   SystemThread::ThreadId m_main;
+
+#ifdef ENABLE_EVENT_PROFILER
+  /** Write the event profile, if any, at Destroy (). */
+  void WriteEventProfile (void);
+
+  /** The per-event-type wall-clock profiler. */
+  EventProfiler m_profiler;
+  /** Output file of the event profile; empty for std::clog. */
+  std::string m_profileFile;
+  /** Output format of the event profile. */
+  EventProfiler::Format m_profileFormat;
+  /** Maximum number of events kept for the Chrome trace output. */
+  uint32_t m_profileMaxTraceEvents;
+#endif
 };
 
 } // namespace ns3
@@ -66,4 +66,11 @@ EventImpl::IsCancelled (void)
   return m_cancel;
 }
 
+const void *
+EventImpl::GetFunction (std::size_t &size) const
+{
+  size = 0;
+  return 0;
+}
+
 } // namespace ns3
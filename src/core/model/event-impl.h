@@ -21,6 +21,7 @@
 #define EVENT_IMPL_H
 
 #include <stdint.h>
+#include <cstddef>
 #include "simple-ref-count.h"
 
 /**
@@ -65,6 +66,16 @@ public:
    * Checked by the simulation engine before calling Invoke().
    */
   bool IsCancelled (void);
+  /**
+   * Get the function invoked by the event, e.g. to tell apart the events
+   * of one MakeEvent() type, which only depends on the signature of the
+   * bound function.
+   *
+   * \param [out] size The size of the object pointed to, 0 if unknown.
+   * \returns A pointer to the function pointer or member function pointer
+   *          called by Notify(), or 0 if unknown.
+   */
+  virtual const void * GetFunction (std::size_t &size) const;
 
 protected:
   /**
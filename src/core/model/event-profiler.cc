@@ -0,0 +1,428 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "event-profiler.h"
+#include "event-impl.h"
+#include "fatal-error.h"
+#include "log.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <typeinfo>
+
+#if (__GNUC__ >= 3)
+#include <cxxabi.h>
+#endif
+#ifdef __GLIBC__
+#include <execinfo.h>
+#endif
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("EventProfiler");
+
+namespace {
+
+/**
+ * \ingroup simulator
+ * Demangle a type or symbol name, if supported by the compiler.
+ * \param [in] name The mangled name.
+ * \return The demangled name.
+ */
+std::string
+Demangle (const std::string &name)
+{
+  std::string ret = name;
+#if (__GNUC__ >= 3)
+  int status;
+  char *demangled = abi::__cxa_demangle (name.c_str (), NULL, NULL, &status);
+  if (status == 0 && demangled)
+    {
+      ret = demangled;
+    }
+  std::free (demangled);
+#endif
+  return ret;
+}
+
+/**
+ * \ingroup simulator
+ * Get the name of the symbol at an address, if supported by the C library.
+ * \param [in] address The address.
+ * \return The demangled name of the symbol starting at \p address, or an
+ *         empty string if unknown.
+ */
+std::string
+SymbolName (uintptr_t address)
+{
+  std::string ret;
+#ifdef __GLIBC__
+  // the symbols are formatted as "file(symbol+offset) [address]", and
+  // the offset is not null if the address is not that of an exported symbol
+  void *buffer = reinterpret_cast<void *> (address);
+  char **symbols = backtrace_symbols (&buffer, 1);
+  if (symbols)
+    {
+      std::string symbol = symbols[0];
+      std::string::size_type begin = symbol.find ('(');
+      std::string::size_type plus = symbol.find ('+', begin);
+      std::string::size_type end = symbol.find (')', plus);
+      if (begin != std::string::npos && plus != std::string::npos && end != std::string::npos
+          && plus > begin + 1
+          && std::strtoul (symbol.substr (plus + 1, end - plus - 1).c_str (), NULL, 16) == 0)
+        {
+          ret = Demangle (symbol.substr (begin + 1, plus - begin - 1));
+        }
+      std::free (symbols);
+    }
+#endif
+  return ret;
+}
+
+/**
+ * \ingroup simulator
+ * Escape a string for use in a JSON string literal.
+ * \param [in] s The string.
+ * \return The escaped string.
+ */
+std::string
+JsonEscape (const std::string &s)
+{
+  std::string ret;
+  ret.reserve (s.size ());
+  for (std::string::const_iterator it = s.begin (); it != s.end (); ++it)
+    {
+      if (*it == '"' || *it == '\\')
+        {
+          ret.push_back ('\\');
+        }
+      ret.push_back (*it);
+    }
+  return ret;
+}
+
+/**
+ * \ingroup simulator
+ * Update a Stats record with one event.
+ * \param [in,out] stats The record.
+ * \param [in] ns The event duration [ns].
+ */
+inline void
+Accumulate (EventProfiler::Stats &stats, uint64_t ns)
+{
+  stats.count++;
+  stats.totalNs += ns;
+  stats.maxNs = std::max (stats.maxNs, ns);
+}
+
+/**
+ * \ingroup simulator
+ * Merge two Stats records.
+ * \param [in,out] stats The record to update.
+ * \param [in] other The record to add to \p stats.
+ */
+void
+Merge (EventProfiler::Stats &stats, const EventProfiler::Stats &other)
+{
+  stats.count += other.count;
+  stats.totalNs += other.totalNs;
+  stats.maxNs = std::max (stats.maxNs, other.maxNs);
+}
+
+/**
+ * \ingroup simulator
+ * Order (name, Stats) pairs by decreasing total time.
+ * \param [in] a The first entry.
+ * \param [in] b The second entry.
+ * \return \c true if \p a took longer than \p b.
+ */
+bool
+ByTotalTime (const std::pair<std::string, EventProfiler::Stats> &a,
+             const std::pair<std::string, EventProfiler::Stats> &b)
+{
+  return a.second.totalNs > b.second.totalNs;
+}
+
+} // unnamed namespace
+
+
+bool
+EventProfiler::EventKey::operator== (const EventKey &other) const
+{
+  return type == other.type && size == other.size
+         && function[0] == other.function[0] && function[1] == other.function[1];
+}
+
+std::size_t
+EventProfiler::EventKeyHash::operator() (const EventKey &key) const
+{
+  std::size_t h = std::hash<std::type_index> () (key.type);
+  h ^= std::hash<uint64_t> () (key.function[0]) + 0x9e3779b9 + (h << 6) + (h >> 2);
+  h ^= std::hash<uint64_t> () (key.function[1]) + 0x9e3779b9 + (h << 6) + (h >> 2);
+  return h;
+}
+
+std::string
+EventProfiler::GetName (const EventKey &key)
+{
+  std::string type = Demangle (key.type.name ());
+  if (key.size == 0)
+    {
+      return type;
+    }
+  uintptr_t address = static_cast<uintptr_t> (key.function[0]);
+  std::ostringstream oss;
+  oss << type << " [";
+  if (key.size == sizeof (void (*)(void)))
+    {
+      // function pointer
+      std::string name = SymbolName (address);
+      if (!name.empty ())
+        {
+          return name;
+        }
+      oss << "0x" << std::hex << address;
+    }
+#if (defined (__x86_64__) || defined (__i386__)) && (__GNUC__ >= 3)
+  else if (key.size == 2 * sizeof (void *) && (address & 1) == 0)
+    {
+      // Itanium C++ ABI member function pointer to a non-virtual function
+      std::string name = SymbolName (address);
+      if (!name.empty ())
+        {
+          return name;
+        }
+      oss << "0x" << std::hex << address;
+    }
+  else if (key.size == 2 * sizeof (void *))
+    {
+      // Itanium C++ ABI member function pointer to a virtual function,
+      // as one plus its offset in the vtable
+      oss << "virtual +" << address - 1;
+    }
+#endif
+  else
+    {
+      const uint8_t *bytes = reinterpret_cast<const uint8_t *> (key.function);
+      oss << std::hex << std::setfill ('0');
+      for (std::size_t i = 0; i < std::min (key.size, sizeof (key.function)); ++i)
+        {
+          oss << std::setw (2) << static_cast<uint32_t> (bytes[i]);
+        }
+    }
+  oss << "]";
+  return oss.str ();
+}
+
+EventProfiler::EventProfiler ()
+  : m_maxTraceEvents (1000000),
+    m_started (false)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+EventProfiler::SetMaxTraceEvents (uint32_t maxTraceEvents)
+{
+  NS_LOG_FUNCTION (this << maxTraceEvents);
+  m_maxTraceEvents = maxTraceEvents;
+}
+
+void
+EventProfiler::Record (const EventImpl *event, uint32_t context,
+                       Clock::time_point start, Clock::time_point end)
+{
+  EventKey key = {std::type_index (typeid (*event)), 0, {0, 0}};
+  const void *function = event->GetFunction (key.size);
+  if (function)
+    {
+      std::memcpy (key.function, function, std::min (key.size, sizeof (key.function)));
+    }
+  DoRecord (key, context, start, end);
+}
+
+void
+EventProfiler::Record (std::type_index type, uint32_t context,
+                       Clock::time_point start, Clock::time_point end)
+{
+  EventKey key = {type, 0, {0, 0}};
+  DoRecord (key, context, start, end);
+}
+
+void
+EventProfiler::DoRecord (const EventKey &key, uint32_t context,
+                         Clock::time_point start, Clock::time_point end)
+{
+  if (!m_started)
+    {
+      m_origin = start;
+      m_started = true;
+    }
+  uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds> (end - start).count ();
+
+  Stats zero = {0, 0, 0};
+  Accumulate (m_types.insert (std::make_pair (key, zero)).first->second, ns);
+  Accumulate (m_contexts.insert (std::make_pair (context, zero)).first->second, ns);
+
+  if (m_trace.size () < m_maxTraceEvents)
+    {
+      uint64_t startNs = std::chrono::duration_cast<std::chrono::nanoseconds> (start - m_origin).count ();
+      TraceEvent ev = {key, context, startNs, ns};
+      m_trace.push_back (ev);
+    }
+}
+
+std::map<std::string, EventProfiler::Stats>
+EventProfiler::GetTypeStats (void) const
+{
+  std::map<std::string, Stats> ret;
+  Stats zero = {0, 0, 0};
+  for (std::unordered_map<EventKey, Stats, EventKeyHash>::const_iterator it = m_types.begin ();
+       it != m_types.end (); ++it)
+    {
+      Merge (ret.insert (std::make_pair (GetName (it->first), zero)).first->second, it->second);
+    }
+  return ret;
+}
+
+std::map<uint32_t, EventProfiler::Stats>
+EventProfiler::GetContextStats (void) const
+{
+  return std::map<uint32_t, Stats> (m_contexts.begin (), m_contexts.end ());
+}
+
+void
+EventProfiler::Write (std::ostream &os, Format format) const
+{
+  NS_LOG_FUNCTION (this << format);
+  switch (format)
+    {
+    case TEXT:
+      WriteText (os);
+      break;
+    case CHROME_TRACE:
+      WriteChromeTrace (os);
+      break;
+    default:
+      NS_FATAL_ERROR ("Unknown profile format " << format);
+    }
+}
+
+void
+EventProfiler::WriteText (std::ostream &os) const
+{
+  std::map<std::string, Stats> types = GetTypeStats ();
+  std::vector<std::pair<std::string, Stats> > sorted (types.begin (), types.end ());
+  std::sort (sorted.begin (), sorted.end (), ByTotalTime);
+
+  uint64_t count = 0;
+  uint64_t totalNs = 0;
+  for (std::vector<std::pair<std::string, Stats> >::const_iterator it = sorted.begin ();
+       it != sorted.end (); ++it)
+    {
+      count += it->second.count;
+      totalNs += it->second.totalNs;
+    }
+
+  os << "Event profile: " << count << " events, "
+     << totalNs / 1e6 << " ms" << std::endl;
+  os << std::setw (7) << "%time" << std::setw (12) << "total[ms]"
+     << std::setw (12) << "count" << std::setw (12) << "mean[us]"
+     << std::setw (12) << "max[us]" << "  event type" << std::endl;
+  for (std::vector<std::pair<std::string, Stats> >::const_iterator it = sorted.begin ();
+       it != sorted.end (); ++it)
+    {
+      const Stats &s = it->second;
+      os << std::fixed << std::setprecision (2)
+         << std::setw (7) << (totalNs ? 100.0 * s.totalNs / totalNs : 0.0)
+         << std::setw (12) << s.totalNs / 1e6
+         << std::setw (12) << s.count
+         << std::setw (12) << s.totalNs / 1e3 / s.count
+         << std::setw (12) << s.maxNs / 1e3
+         << "  " << it->first << std::endl;
+    }
+
+  os << std::endl;
+  os << std::setw (12) << "context" << std::setw (12) << "total[ms]"
+     << std::setw (12) << "count" << std::endl;
+  std::map<uint32_t, Stats> contexts = GetContextStats ();
+  for (std::map<uint32_t, Stats>::const_iterator it = contexts.begin ();
+       it != contexts.end (); ++it)
+    {
+      os << std::setw (12);
+      if (it->first == 0xffffffff)
+        {
+          os << "none";
+        }
+      else
+        {
+          os << it->first;
+        }
+      os << std::setw (12) << it->second.totalNs / 1e6
+         << std::setw (12) << it->second.count << std::endl;
+    }
+  os.unsetf (std::ios_base::floatfield);
+}
+
+void
+EventProfiler::WriteChromeTrace (std::ostream &os) const
+{
+  std::unordered_map<EventKey, std::string, EventKeyHash> names;
+  for (std::unordered_map<EventKey, Stats, EventKeyHash>::const_iterator it = m_types.begin ();
+       it != m_types.end (); ++it)
+    {
+      names.insert (std::make_pair (it->first, JsonEscape (GetName (it->first))));
+    }
+
+  os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  char separator = ' ';
+  for (std::vector<TraceEvent>::const_iterator it = m_trace.begin ();
+       it != m_trace.end (); ++it)
+    {
+      // the trace-event format uses microseconds
+      os << separator << std::endl
+         << "{\"name\":\"" << names.find (it->key)->second << "\""
+         << ",\"cat\":\"event\",\"ph\":\"X\",\"pid\":0"
+         << ",\"tid\":" << (it->context == 0xffffffff ? -1 : static_cast<int64_t> (it->context))
+         << ",\"ts\":" << it->startNs / 1000 << "." << std::setw (3) << std::setfill ('0') << it->startNs % 1000
+         << ",\"dur\":" << it->durationNs / 1000 << "." << std::setw (3) << it->durationNs % 1000
+         << std::setfill (' ') << "}";
+      separator = ',';
+    }
+  os << std::endl << "]}" << std::endl;
+}
+
+void
+EventProfiler::Clear (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_types.clear ();
+  m_contexts.clear ();
+  m_trace.clear ();
+  m_started = false;
+}
+
+} // namespace ns3
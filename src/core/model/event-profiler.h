@@ -0,0 +1,238 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler declaration.
+ */
+
+#include <stdint.h>
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <ostream>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+
+class EventImpl;
+
+/**
+ * \ingroup simulator
+ *
+ * \brief Wall-clock profiler of the events executed by the simulator.
+ *
+ * The profiler attributes the wall-clock time spent in EventImpl::Invoke
+ * to the concrete EventImpl type and the bound function of each event,
+ * and to the context (normally the node id) the event runs in.  The
+ * concrete type of the events created by MakeEvent or
+ * Simulator::Schedule only depends on the signature of the bound
+ * function, e.g. LteEnbPhy::StartFrame and LteEnbPhy::StartSubFrame
+ * share it, so these events are also told apart by the function
+ * returned by EventImpl::GetFunction.
+ *
+ * An entry is named after its function when the symbol can be resolved
+ * (glibc, functions exported by a shared library or an executable
+ * linked with -rdynamic), e.g. \c ns3::LteEnbPhy::StartFrame(); else
+ * after its demangled event type, followed by the address of the
+ * function, or the vtable offset of a virtual member function, in
+ * brackets.  Entries with the same name, e.g. the same function bound to
+ * a raw and to a smart pointer, are merged by GetTypeStats and the text
+ * report.
+ *
+ * Two output formats are supported:
+ * \li a text report of the event types sorted by total time, followed
+ *     by the per-context totals, and
+ * \li a Chrome trace-event JSON file, which can be loaded in
+ *     \c chrome://tracing or https://ui.perfetto.dev, with one complete
+ *     ("X") event per simulator event, using the context as thread id.
+ *
+ * <b> Enabling the event profiler </b>
+ *
+ * The hook in DefaultSimulatorImpl::ProcessOneEvent is compiled in only
+ * when configured with
+ * \verbatim
+   $ waf configure ... --enable-event-profiler \endverbatim
+ * In that case DefaultSimulatorImpl gains the \c EventProfileFile and
+ * \c EventProfileFormat attributes, and writes the profile at
+ * Simulator::Destroy ().
+ */
+class EventProfiler
+{
+public:
+  /** Output format of the profile. */
+  enum Format
+  {
+    TEXT,          //!< Sorted text report.
+    CHROME_TRACE   //!< Chrome trace-event JSON.
+  };
+
+  /** Clock used to time the events. */
+  typedef std::chrono::steady_clock Clock;
+
+  /** Accumulated statistics for one event type or context. */
+  struct Stats
+  {
+    uint64_t count;    //!< Number of events.
+    uint64_t totalNs;  //!< Total wall-clock time [ns].
+    uint64_t maxNs;    //!< Longest event [ns].
+  };
+
+  /** Constructor. */
+  EventProfiler ();
+
+  /**
+   * Set the maximum number of individual events kept for the
+   * Chrome trace output.  Aggregated statistics are not limited.
+   *
+   * \param [in] maxTraceEvents The maximum number of events.
+   */
+  void SetMaxTraceEvents (uint32_t maxTraceEvents);
+
+  /**
+   * Record one executed event.
+   *
+   * \param [in] event The event, before it is unreferenced.
+   * \param [in] context The execution context of the event.
+   * \param [in] start The wall-clock time at which Invoke () was called.
+   * \param [in] end The wall-clock time at which Invoke () returned.
+   */
+  void Record (const EventImpl *event, uint32_t context,
+               Clock::time_point start, Clock::time_point end);
+
+  /**
+   * Record one executed event of a given type, without function.
+   *
+   * \param [in] type The concrete type of the event.
+   * \param [in] context The execution context of the event.
+   * \param [in] start The wall-clock time at which Invoke () was called.
+   * \param [in] end The wall-clock time at which Invoke () returned.
+   */
+  void Record (std::type_index type, uint32_t context,
+               Clock::time_point start, Clock::time_point end);
+
+  /**
+   * Get the statistics of each event type and function, keyed by the
+   * name of the entry.
+   * \return The per-type statistics.
+   */
+  std::map<std::string, Stats> GetTypeStats (void) const;
+
+  /**
+   * Get the statistics of each context.
+   * \return The per-context statistics.
+   */
+  std::map<uint32_t, Stats> GetContextStats (void) const;
+
+  /**
+   * Write the profile.
+   *
+   * \param [in,out] os The output stream.
+   * \param [in] format The output format.
+   */
+  void Write (std::ostream &os, Format format) const;
+
+  /** Discard all recorded data. */
+  void Clear (void);
+
+private:
+  /** Key of the per-type statistics. */
+  struct EventKey
+  {
+    std::type_index type;  //!< Concrete event type.
+    std::size_t size;      //!< Size of the bound function, 0 if unknown.
+    uint64_t function[2];  //!< First bytes of the bound function, zero-padded.
+
+    /**
+     * Compare two keys.
+     * \param [in] other The other key.
+     * \return \c true if the keys are equal.
+     */
+    bool operator== (const EventKey &other) const;
+  };
+
+  /** Hash of an EventKey. */
+  struct EventKeyHash
+  {
+    /**
+     * Hash a key.
+     * \param [in] key The key.
+     * \return The hash of \p key.
+     */
+    std::size_t operator() (const EventKey &key) const;
+  };
+
+  /**
+   * Record one executed event.
+   *
+   * \param [in] key The type and function of the event.
+   * \param [in] context The execution context of the event.
+   * \param [in] start The wall-clock time at which Invoke () was called.
+   * \param [in] end The wall-clock time at which Invoke () returned.
+   */
+  void DoRecord (const EventKey &key, uint32_t context,
+                 Clock::time_point start, Clock::time_point end);
+  /**
+   * Name an entry.
+   * \param [in] key The type and function of the entry.
+   * \return The name of the function, or the demangled type name.
+   */
+  static std::string GetName (const EventKey &key);
+
+  /**
+   * Write the sorted text report.
+   * \param [in,out] os The output stream.
+   */
+  void WriteText (std::ostream &os) const;
+  /**
+   * Write the Chrome trace-event JSON.
+   * \param [in,out] os The output stream.
+   */
+  void WriteChromeTrace (std::ostream &os) const;
+
+  /** One event kept for the Chrome trace output. */
+  struct TraceEvent
+  {
+    EventKey key;          //!< Type and function of the event.
+    uint32_t context;      //!< Execution context.
+    uint64_t startNs;      //!< Start time since the first event [ns].
+    uint64_t durationNs;   //!< Duration [ns].
+  };
+
+  /** Per-type and per-function statistics. */
+  std::unordered_map<EventKey, Stats, EventKeyHash> m_types;
+  /** Per-context statistics. */
+  std::unordered_map<uint32_t, Stats> m_contexts;
+  /** Individual events, for the Chrome trace output. */
+  std::vector<TraceEvent> m_trace;
+  /** Maximum size of m_trace. */
+  uint32_t m_maxTraceEvents;
+  /** Wall-clock time of the first recorded event. */
+  Clock::time_point m_origin;
+  /** Has any event been recorded since construction or Clear (). */
+  bool m_started;
+};
+
+} // namespace ns3
+
+#endif /* EVENT_PROFILER_H */
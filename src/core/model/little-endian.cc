@@ -0,0 +1,65 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "little-endian.h"
+
+/**
+ * \file
+ * \ingroup system
+ * ns3::LittleEndian implementation.
+ */
+
+namespace ns3 {
+
+namespace LittleEndian {
+
+uint32_t
+DecodeU32 (const unsigned char *b)
+{
+  uint32_t v = 0;
+  for (uint32_t i = 0; i < 4; ++i)
+    {
+      v |= static_cast<uint32_t> (b[i]) << (8 * i);
+    }
+  return v;
+}
+
+void
+WriteU32 (std::ostream &os, uint32_t v)
+{
+  unsigned char b[4];
+  for (uint32_t i = 0; i < 4; ++i)
+    {
+      b[i] = (v >> (8 * i)) & 0xff;
+    }
+  os.write (reinterpret_cast<const char *> (b), 4);
+}
+
+bool
+ReadU32 (std::istream &is, uint32_t &v)
+{
+  unsigned char b[4];
+  if (!is.read (reinterpret_cast<char *> (b), 4))
+    {
+      return false;
+    }
+  v = DecodeU32 (b);
+  return true;
+}
+
+} // namespace LittleEndian
+
+} // namespace ns3
@@ -0,0 +1,71 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LITTLE_ENDIAN_H
+#define LITTLE_ENDIAN_H
+
+#include <stdint.h>
+#include <istream>
+#include <ostream>
+
+/**
+ * \file
+ * \ingroup system
+ * ns3::LittleEndian declarations.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup system
+ * \brief Namespace for the little endian integers of the binary files
+ * of the models, independent of the byte order of the host.
+ */
+namespace LittleEndian {
+
+/**
+ * \ingroup system
+ * Decode a 32-bit unsigned integer in little endian order.
+ *
+ * \param [in] b The 4 bytes
+ * \return The value
+ */
+uint32_t DecodeU32 (const unsigned char *b);
+
+/**
+ * \ingroup system
+ * Write a 32-bit unsigned integer in little endian order.
+ *
+ * \param [in] os The output stream
+ * \param [in] v The value
+ */
+void WriteU32 (std::ostream &os, uint32_t v);
+
+/**
+ * \ingroup system
+ * Read a 32-bit unsigned integer in little endian order.
+ *
+ * \param [in] is The input stream
+ * \param [out] v The value
+ * \return false on a read error
+ */
+bool ReadU32 (std::istream &is, uint32_t &v);
+
+} // namespace LittleEndian
+
+} // namespace ns3
+
+#endif /* LITTLE_ENDIAN_H */
@@ -45,6 +45,11 @@ EventImpl * MakeEvent (void (*f)(void))
     {}
     virtual ~EventFunctionImpl0 ()
     {}
+    virtual const void * GetFunction (std::size_t &size) const
+    {
+      size = sizeof (m_function);
+      return &m_function;
+    }
 
   protected:
     virtual void Notify (void)
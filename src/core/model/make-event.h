@@ -368,6 +368,11 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj)
     {}
     virtual ~EventMemberImpl0 ()
     {}
+    virtual const void * GetFunction (std::size_t &size) const
+    {
+      size = sizeof (m_function);
+      return &m_function;
+    }
 
   private:
     virtual void Notify (void)
@@ -398,6 +403,11 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj, T1 a1)
   protected:
     virtual ~EventMemberImpl1 ()
     {}
+    virtual const void * GetFunction (std::size_t &size) const
+    {
+      size = sizeof (m_function);
+      return &m_function;
+    }
 
   private:
     virtual void Notify (void)
@@ -429,6 +439,11 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj, T1 a1, T2 a2)
   protected:
     virtual ~EventMemberImpl2 ()
     {}
+    virtual const void * GetFunction (std::size_t &size) const
+    {
+      size = sizeof (m_function);
+      return &m_function;
+    }
 
   private:
     virtual void Notify (void)
@@ -462,6 +477,11 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj, T1 a1, T2 a2, T3 a3)
   protected:
     virtual ~EventMemberImpl3 ()
     {}
+    virtual const void * GetFunction (std::size_t &size) const
+    {
+      size = sizeof (m_function);
+      return &m_function;
+    }
 
   private:
     virtual void Notify (void)
@@ -497,6 +517,11 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj, T1 a1, T2 a2, T3 a3, T4 a4)
   protected:
     virtual ~EventMemberImpl4 ()
     {}
+    virtual const void * GetFunction (std::size_t &size) const
+    {
+      size = sizeof (m_function);
+      return &m_function;
+    }
 
   private:
     virtual void Notify (void)
@@ -535,6 +560,11 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj,
   protected:
     virtual ~EventMemberImpl5 ()
     {}
+    virtual const void * GetFunction (std::size_t &size) const
+    {
+      size = sizeof (m_function);
+      return &m_function;
+    }
 
   private:
     virtual void Notify (void)
@@ -575,6 +605,11 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj,
   protected:
     virtual ~EventMemberImpl6 ()
     {}
+    virtual const void * GetFunction (std::size_t &size) const
+    {
+      size = sizeof (m_function);
+      return &m_function;
+    }
 
   private:
     virtual void Notify (void)
@@ -610,6 +645,11 @@ EventImpl * MakeEvent (void (*f)(U1), T1 a1)
   protected:
     virtual ~EventFunctionImpl1 ()
     {}
+    virtual const void * GetFunction (std::size_t &size) const
+    {
+      size = sizeof (m_function);
+      return &m_function;
+    }
 
   private:
     virtual void Notify (void)
@@ -640,6 +680,11 @@ EventImpl * MakeEvent (void (*f)(U1,U2), T1 a1, T2 a2)
   protected:
     virtual ~EventFunctionImpl2 ()
     {}
+    virtual const void * GetFunction (std::size_t &size) const
+    {
+      size = sizeof (m_function);
+      return &m_function;
+    }
 
   private:
     virtual void Notify (void)
@@ -673,6 +718,11 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3), T1 a1, T2 a2, T3 a3)
   protected:
     virtual ~EventFunctionImpl3 ()
     {}
+    virtual const void * GetFunction (std::size_t &size) const
+    {
+      size = sizeof (m_function);
+      return &m_function;
+    }
 
   private:
     virtual void Notify (void)
@@ -708,6 +758,11 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3,U4), T1 a1, T2 a2, T3 a3, T4 a4)
   protected:
     virtual ~EventFunctionImpl4 ()
     {}
+    virtual const void * GetFunction (std::size_t &size) const
+    {
+      size = sizeof (m_function);
+      return &m_function;
+    }
 
   private:
     virtual void Notify (void)
@@ -745,6 +800,11 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3,U4,U5), T1 a1, T2 a2, T3 a3, T4 a4, T5
   protected:
     virtual ~EventFunctionImpl5 ()
     {}
+    virtual const void * GetFunction (std::size_t &size) const
+    {
+      size = sizeof (m_function);
+      return &m_function;
+    }
 
   private:
     virtual void Notify (void)
@@ -784,6 +844,11 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3,U4,U5,U6), T1 a1, T2 a2, T3 a3, T4 a4,
   protected:
     virtual ~EventFunctionImpl6 ()
     {}
+    virtual const void * GetFunction (std::size_t &size) const
+    {
+      size = sizeof (m_function);
+      return &m_function;
+    }
 
   private:
     virtual void Notify (void)
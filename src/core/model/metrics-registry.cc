@@ -0,0 +1,367 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "metrics-registry.h"
+#include "log.h"
+#include "assert.h"
+
+#include <sstream>
+
+/**
+ * \file
+ * \ingroup metrics
+ * ns3::MetricsRegistry, ns3::MetricsReader, ns3::MetricCounter and
+ * ns3::MetricHistogram implementations.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MetricsRegistry");
+
+MetricCounter::MetricCounter ()
+  : m_value (0)
+{}
+
+uint64_t
+MetricCounter::GetValue (void) const
+{
+  return m_value.load (std::memory_order_relaxed);
+}
+
+uint64_t
+MetricCounter::Reset (void)
+{
+  return m_value.exchange (0, std::memory_order_relaxed);
+}
+
+
+MetricHistogram::MetricHistogram ()
+  : m_sum (0),
+    m_max (0)
+{
+  for (uint32_t i = 0; i < N_BUCKETS; i++)
+    {
+      m_buckets[i].store (0, std::memory_order_relaxed);
+    }
+}
+
+uint32_t
+MetricHistogram::GetBucket (uint64_t value)
+{
+  const uint64_t subBuckets = 1 << SUB_BUCKET_BITS;
+  if (value < subBuckets)
+    {
+      return value;
+    }
+  uint32_t msb = 63 - __builtin_clzll (value);
+  uint32_t shift = msb - SUB_BUCKET_BITS;
+  return (shift << SUB_BUCKET_BITS) + (value >> shift);
+}
+
+uint64_t
+MetricHistogram::GetBucketLowerBound (uint32_t bucket)
+{
+  const uint32_t subBuckets = 1 << SUB_BUCKET_BITS;
+  if (bucket < subBuckets)
+    {
+      return bucket;
+    }
+  uint32_t shift = (bucket >> SUB_BUCKET_BITS) - 1;
+  uint64_t sub = (bucket & (subBuckets - 1)) + subBuckets;
+  return sub << shift;
+}
+
+void
+MetricHistogram::Record (uint64_t value)
+{
+  m_buckets[GetBucket (value)].fetch_add (1, std::memory_order_relaxed);
+  m_sum.fetch_add (value, std::memory_order_relaxed);
+  uint64_t max = m_max.load (std::memory_order_relaxed);
+  while (value > max
+         && !m_max.compare_exchange_weak (max, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+MetricHistogram::Summary
+MetricHistogram::GetSummary (void) const
+{
+  // Read the buckets once, so the percentiles are consistent with
+  // the count even if samples are recorded concurrently.
+  Counts counts;
+  GetCounts (counts);
+  return Summarize (counts);
+}
+
+void
+MetricHistogram::GetCounts (Counts &counts) const
+{
+  for (uint32_t i = 0; i < N_BUCKETS; i++)
+    {
+      counts.buckets[i] = m_buckets[i].load (std::memory_order_relaxed);
+    }
+  counts.sum = m_sum.load (std::memory_order_relaxed);
+  counts.max = m_max.load (std::memory_order_relaxed);
+}
+
+MetricHistogram::Summary
+MetricHistogram::Summarize (const Counts &counts)
+{
+  Summary s;
+  s.count = 0;
+  s.sum = counts.sum;
+  s.max = counts.max;
+  s.p50 = s.p90 = s.p99 = 0;
+  const uint64_t *buckets = counts.buckets;
+  for (uint32_t i = 0; i < N_BUCKETS; i++)
+    {
+      s.count += buckets[i];
+    }
+
+  uint64_t cumulative = 0;
+  uint64_t p50Rank = (s.count * 50 + 99) / 100;
+  uint64_t p90Rank = (s.count * 90 + 99) / 100;
+  uint64_t p99Rank = (s.count * 99 + 99) / 100;
+  for (uint32_t i = 0; i < N_BUCKETS && cumulative < s.count; i++)
+    {
+      if (buckets[i] == 0)
+        {
+          continue;
+        }
+      uint64_t lower = GetBucketLowerBound (i);
+      if (cumulative < p50Rank && cumulative + buckets[i] >= p50Rank)
+        {
+          s.p50 = lower;
+        }
+      if (cumulative < p90Rank && cumulative + buckets[i] >= p90Rank)
+        {
+          s.p90 = lower;
+        }
+      if (cumulative < p99Rank && cumulative + buckets[i] >= p99Rank)
+        {
+          s.p99 = lower;
+        }
+      cumulative += buckets[i];
+    }
+  return s;
+}
+
+void
+MetricHistogram::Reset (void)
+{
+  for (uint32_t i = 0; i < N_BUCKETS; i++)
+    {
+      m_buckets[i].store (0, std::memory_order_relaxed);
+    }
+  m_sum.store (0, std::memory_order_relaxed);
+  m_max.store (0, std::memory_order_relaxed);
+}
+
+
+MetricsRegistry::MetricsRegistry ()
+  : m_nEnabled (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MetricsRegistry::~MetricsRegistry ()
+{
+  NS_LOG_FUNCTION (this);
+  for (Counters::iterator it = m_counters.begin (); it != m_counters.end (); ++it)
+    {
+      delete it->second;
+    }
+  for (Histograms::iterator it = m_histograms.begin (); it != m_histograms.end (); ++it)
+    {
+      delete it->second;
+    }
+}
+
+MetricCounter *
+MetricsRegistry::GetCounter (const std::string &name)
+{
+  NS_LOG_FUNCTION (this << name);
+  CriticalSection cs (m_mutex);
+  Counters::iterator it = m_counters.find (name);
+  if (it == m_counters.end ())
+    {
+      it = m_counters.insert (std::make_pair (name, new MetricCounter ())).first;
+    }
+  return it->second;
+}
+
+MetricHistogram *
+MetricsRegistry::GetHistogram (const std::string &name)
+{
+  NS_LOG_FUNCTION (this << name);
+  CriticalSection cs (m_mutex);
+  Histograms::iterator it = m_histograms.find (name);
+  if (it == m_histograms.end ())
+    {
+      it = m_histograms.insert (std::make_pair (name, new MetricHistogram ())).first;
+    }
+  return it->second;
+}
+
+void
+MetricsRegistry::Enable (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_nEnabled.fetch_add (1, std::memory_order_relaxed);
+}
+
+void
+MetricsRegistry::Disable (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT_MSG (IsEnabled (), "MetricsRegistry disabled more times than enabled");
+  m_nEnabled.fetch_sub (1, std::memory_order_relaxed);
+}
+
+void
+MetricsRegistry::Read (CounterValues &counters, HistogramCounts &histograms)
+{
+  NS_LOG_FUNCTION (this);
+  CriticalSection cs (m_mutex);
+  counters.clear ();
+  for (Counters::const_iterator it = m_counters.begin (); it != m_counters.end (); ++it)
+    {
+      counters[it->first] = it->second->GetValue ();
+    }
+  histograms.clear ();
+  for (Histograms::const_iterator it = m_histograms.begin (); it != m_histograms.end (); ++it)
+    {
+      it->second->GetCounts (histograms[it->first]);
+    }
+}
+
+std::string
+MetricsRegistry::Snapshot (void)
+{
+  NS_LOG_FUNCTION (this);
+  CounterValues counters;
+  HistogramCounts histograms;
+  Read (counters, histograms);
+  return ToJson (counters, histograms);
+}
+
+std::string
+MetricsRegistry::ToJson (const CounterValues &counters, const HistogramCounts &histograms)
+{
+  std::ostringstream oss;
+  oss << "{\"counters\":{";
+  for (CounterValues::const_iterator it = counters.begin (); it != counters.end (); ++it)
+    {
+      oss << (it == counters.begin () ? "" : ",")
+          << "\"" << it->first << "\":" << it->second;
+    }
+  oss << "},\"histograms\":{";
+  for (HistogramCounts::const_iterator it = histograms.begin (); it != histograms.end (); ++it)
+    {
+      MetricHistogram::Summary s = MetricHistogram::Summarize (it->second);
+      oss << (it == histograms.begin () ? "" : ",")
+          << "\"" << it->first << "\":{"
+          << "\"count\":" << s.count
+          << ",\"sum\":" << s.sum
+          << ",\"max\":" << s.max
+          << ",\"p50\":" << s.p50
+          << ",\"p90\":" << s.p90
+          << ",\"p99\":" << s.p99
+          << "}";
+    }
+  oss << "}}";
+  return oss.str ();
+}
+
+void
+MetricsRegistry::Reset (void)
+{
+  NS_LOG_FUNCTION (this);
+  CriticalSection cs (m_mutex);
+  for (Counters::iterator it = m_counters.begin (); it != m_counters.end (); ++it)
+    {
+      it->second->Reset ();
+    }
+  for (Histograms::iterator it = m_histograms.begin (); it != m_histograms.end (); ++it)
+    {
+      it->second->Reset ();
+    }
+}
+
+
+MetricsReader::MetricsReader ()
+{
+  NS_LOG_FUNCTION (this);
+  MetricsRegistry::Get ()->Enable ();
+  MetricsRegistry::Get ()->Read (m_counters, m_histograms);
+}
+
+MetricsReader::~MetricsReader ()
+{
+  NS_LOG_FUNCTION (this);
+  MetricsRegistry::Get ()->Disable ();
+}
+
+std::string
+MetricsReader::Snapshot (void)
+{
+  NS_LOG_FUNCTION (this);
+  MetricsRegistry::CounterValues counters;
+  MetricsRegistry::HistogramCounts histograms;
+  MetricsRegistry::Get ()->Read (counters, histograms);
+
+  // Metrics created or reset during the interval count from zero.
+  MetricsRegistry::CounterValues counterDeltas;
+  for (MetricsRegistry::CounterValues::const_iterator it = counters.begin (); it != counters.end (); ++it)
+    {
+      MetricsRegistry::CounterValues::const_iterator start = m_counters.find (it->first);
+      bool fromZero = start == m_counters.end () || start->second > it->second;
+      counterDeltas[it->first] = it->second - (fromZero ? 0 : start->second);
+    }
+  MetricsRegistry::HistogramCounts histogramDeltas;
+  for (MetricsRegistry::HistogramCounts::const_iterator it = histograms.begin (); it != histograms.end (); ++it)
+    {
+      const MetricHistogram::Counts &now = it->second;
+      MetricHistogram::Counts &delta = histogramDeltas[it->first];
+      delta = now;
+      MetricsRegistry::HistogramCounts::const_iterator start = m_histograms.find (it->first);
+      if (start == m_histograms.end () || start->second.sum > now.sum)
+        {
+          continue;
+        }
+      const MetricHistogram::Counts &before = start->second;
+      delta.max = 0;
+      for (uint32_t i = 0; i < MetricHistogram::N_BUCKETS; i++)
+        {
+          delta.buckets[i] = now.buckets[i] >= before.buckets[i] ? now.buckets[i] - before.buckets[i] : 0;
+          if (delta.buckets[i] > 0)
+            {
+              // the maximum of the interval is in its highest bucket
+              delta.max = MetricHistogram::GetBucketLowerBound (i);
+            }
+        }
+      delta.sum = now.sum - before.sum;
+      if (now.max > before.max)
+        {
+          delta.max = now.max;
+        }
+    }
+  m_counters.swap (counters);
+  m_histograms.swap (histograms);
+  return MetricsRegistry::ToJson (counterDeltas, histogramDeltas);
+}
+
+} // namespace ns3
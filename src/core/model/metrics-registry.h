@@ -0,0 +1,349 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef METRICS_REGISTRY_H
+#define METRICS_REGISTRY_H
+
+/**
+ * \file
+ * \ingroup metrics
+ * ns3::MetricsRegistry, ns3::MetricsReader, ns3::MetricCounter,
+ * ns3::MetricHistogram and ns3::MetricTimer declarations.
+ */
+
+#include "singleton.h"
+#include "simple-ref-count.h"
+#include "system-mutex.h"
+
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <string>
+
+namespace ns3 {
+
+/**
+ * \ingroup core
+ * \defgroup metrics Simulator-side performance metrics
+ *
+ * Named counters and latency histograms which hot paths of the models
+ * update, and which can be read back as a compact snapshot while the
+ * simulation runs, e.g. once per ns3-gym step.
+ *
+ * Counters and histograms are created on first use by name through the
+ * MetricsRegistry, and live as long as the program, so hot paths can
+ * cache the returned pointer in a function-local static:
+ * \code
+ *   static MetricCounter *decodes = MetricsRegistry::Get ()->GetCounter ("LteSpectrumPhy/TbDecoded");
+ *   decodes->Increment ();
+ * \endcode
+ * Updates are lock-free.  Timing with MetricTimer only reads the
+ * clock when the registry is enabled.
+ *
+ * The metrics are shared by the whole process.  A consumer, such as a
+ * MyGymEnv, reads them through its own MetricsReader, which enables the
+ * timing while it exists and reports the increments since its previous
+ * snapshot, without resetting the metrics seen by the other consumers.
+ */
+
+/**
+ * \ingroup metrics
+ * \brief A lock-free, monotonically increasing counter.
+ */
+class MetricCounter
+{
+public:
+  /** Constructor. */
+  MetricCounter ();
+  /**
+   * Increment the counter.
+   * \param [in] n The increment.
+   */
+  void Increment (uint64_t n = 1)
+  {
+    m_value.fetch_add (n, std::memory_order_relaxed);
+  }
+  /**
+   * Get the counter value.
+   * \return The value.
+   */
+  uint64_t GetValue (void) const;
+  /**
+   * Reset the counter to zero.
+   * \return The value before the reset.
+   */
+  uint64_t Reset (void);
+
+private:
+  std::atomic<uint64_t> m_value;  //!< The counter value.
+};
+
+/**
+ * \ingroup metrics
+ * \brief A lock-free histogram of non-negative integer samples.
+ *
+ * The buckets follow the HDR histogram layout: values below 8 have
+ * their own bucket, and each power of two above is split in 8 linear
+ * sub-buckets, so any recorded value is known to within 12.5% while
+ * the whole uint64_t range fits in a fixed array of buckets.
+ */
+class MetricHistogram
+{
+public:
+  /** Number of sub-buckets per power of two, as a power of two. */
+  static const uint32_t SUB_BUCKET_BITS = 3;
+  /** Number of buckets. */
+  static const uint32_t N_BUCKETS = (64 - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS;
+
+  /** Summary statistics of a histogram. */
+  struct Summary
+  {
+    uint64_t count;  //!< Number of samples.
+    uint64_t sum;    //!< Sum of the samples.
+    uint64_t max;    //!< Largest sample.
+    uint64_t p50;    //!< Median, to the bucket resolution.
+    uint64_t p90;    //!< 90th percentile, to the bucket resolution.
+    uint64_t p99;    //!< 99th percentile, to the bucket resolution.
+  };
+
+  /** Raw content of a histogram, from which its summary is computed. */
+  struct Counts
+  {
+    uint64_t buckets[N_BUCKETS];  //!< Sample count per bucket.
+    uint64_t sum;                 //!< Sum of the samples.
+    uint64_t max;                 //!< Largest sample.
+  };
+
+  /** Constructor. */
+  MetricHistogram ();
+  /**
+   * Record a sample.
+   * \param [in] value The sample.
+   */
+  void Record (uint64_t value);
+  /**
+   * Get the summary statistics of the recorded samples.
+   * \return The summary.
+   */
+  Summary GetSummary (void) const;
+  /**
+   * Get the raw content of the histogram.
+   * \param [out] counts The content.
+   */
+  void GetCounts (Counts &counts) const;
+  /**
+   * Get the summary statistics of the content of a histogram.
+   * \param [in] counts The content.
+   * \return The summary.
+   */
+  static Summary Summarize (const Counts &counts);
+  /** Discard all samples. */
+  void Reset (void);
+
+  /**
+   * Get the bucket a value falls in.
+   * \param [in] value The value.
+   * \return The bucket index.
+   */
+  static uint32_t GetBucket (uint64_t value);
+  /**
+   * Get the smallest value falling in a bucket.
+   * \param [in] bucket The bucket index.
+   * \return The lower bound of the bucket.
+   */
+  static uint64_t GetBucketLowerBound (uint32_t bucket);
+
+private:
+  std::atomic<uint64_t> m_buckets[N_BUCKETS];  //!< Sample count per bucket.
+  std::atomic<uint64_t> m_sum;                 //!< Sum of the samples.
+  std::atomic<uint64_t> m_max;                 //!< Largest sample.
+};
+
+/**
+ * \ingroup metrics
+ * \brief Registry of the named counters and histograms of the process.
+ */
+class MetricsRegistry : public Singleton<MetricsRegistry>
+{
+public:
+  /** Constructor. */
+  MetricsRegistry ();
+  /** Destructor. */
+  ~MetricsRegistry ();
+
+  /**
+   * Get a counter, creating it if needed.
+   * \param [in] name The counter name.
+   * \return The counter, valid for the lifetime of the program.
+   */
+  MetricCounter * GetCounter (const std::string &name);
+  /**
+   * Get a histogram, creating it if needed.
+   * \param [in] name The histogram name.
+   * \return The histogram, valid for the lifetime of the program.
+   */
+  MetricHistogram * GetHistogram (const std::string &name);
+
+  /**
+   * Enable the timing of MetricTimer scopes, for one more consumer.
+   * Each call must be matched by a call to Disable.
+   */
+  void Enable (void);
+  /**
+   * Disable the timing of MetricTimer scopes for one consumer; the
+   * scopes are timed as long as any other consumer enables them.
+   */
+  void Disable (void);
+  /**
+   * Check whether MetricTimer scopes are timed.
+   * \return \c true if enabled.
+   */
+  bool IsEnabled (void) const
+  {
+    return m_nEnabled.load (std::memory_order_relaxed) > 0;
+  }
+
+  /** Values of the counters, by name. */
+  typedef std::map<std::string, uint64_t> CounterValues;
+  /** Contents of the histograms, by name. */
+  typedef std::map<std::string, MetricHistogram::Counts> HistogramCounts;
+
+  /**
+   * Read all counters and histograms.
+   * \param [out] counters The values of the counters.
+   * \param [out] histograms The contents of the histograms.
+   */
+  void Read (CounterValues &counters, HistogramCounts &histograms);
+  /**
+   * Serialize all counters and histograms as a JSON object:
+   * \verbatim
+     {"counters":{"name":value,...},
+      "histograms":{"name":{"count":n,"sum":s,"max":m,"p50":a,"p90":b,"p99":c},...}} \endverbatim
+   *
+   * The metrics are not reset; see MetricsReader for the metrics of
+   * consecutive intervals.
+   *
+   * \return The JSON snapshot.
+   */
+  std::string Snapshot (void);
+  /**
+   * Serialize counters and histograms as Snapshot does.
+   * \param [in] counters The values of the counters.
+   * \param [in] histograms The contents of the histograms.
+   * \return The JSON snapshot.
+   */
+  static std::string ToJson (const CounterValues &counters, const HistogramCounts &histograms);
+  /**
+   * Reset every metric, for all the consumers.  Meant for tests.
+   */
+  void Reset (void);
+
+private:
+  /** Container type of the counters. */
+  typedef std::map<std::string, MetricCounter *> Counters;
+  /** Container type of the histograms. */
+  typedef std::map<std::string, MetricHistogram *> Histograms;
+
+  Counters m_counters;             //!< The counters, by name.
+  Histograms m_histograms;         //!< The histograms, by name.
+  std::atomic<uint32_t> m_nEnabled; //!< Number of consumers timing MetricTimer scopes.
+  SystemMutex m_mutex;             //!< Protects the maps.
+};
+
+/**
+ * \ingroup metrics
+ * \brief A consumer of the MetricsRegistry, reading the metrics of
+ * consecutive intervals.
+ *
+ * The timing of MetricTimer scopes is enabled as long as the reader
+ * exists.  Each snapshot reports the samples recorded since the previous
+ * snapshot of this reader, or since its creation, whatever the other
+ * readers do; the maximum of a histogram is exact when the interval
+ * raised it, and known to the bucket resolution otherwise.
+ */
+class MetricsReader : public SimpleRefCount<MetricsReader>
+{
+public:
+  /** Constructor, starting the first interval. */
+  MetricsReader ();
+  /** Destructor. */
+  ~MetricsReader ();
+
+  /**
+   * Serialize the metrics of the interval since the previous snapshot, in
+   * the format of MetricsRegistry::Snapshot, and start the next interval.
+   * \return The JSON snapshot.
+   */
+  std::string Snapshot (void);
+
+private:
+  /**
+   * Copy constructor, not implemented.
+   * \param [in] o The reader to copy.
+   */
+  MetricsReader (const MetricsReader &o);
+  /**
+   * Assignment, not implemented.
+   * \param [in] o The reader to copy.
+   * \return This reader.
+   */
+  MetricsReader & operator = (const MetricsReader &o);
+
+  MetricsRegistry::CounterValues m_counters;      //!< Counters at the start of the interval.
+  MetricsRegistry::HistogramCounts m_histograms;  //!< Histograms at the start of the interval.
+};
+
+/**
+ * \ingroup metrics
+ * \brief Record the wall-clock duration of a scope, in nanoseconds,
+ * into a MetricHistogram.
+ *
+ * Nothing is measured if the MetricsRegistry is disabled.
+ */
+class MetricTimer
+{
+public:
+  /**
+   * Start timing.
+   * \param [in] histogram The histogram to record into.
+   */
+  explicit MetricTimer (MetricHistogram *histogram)
+    : m_histogram (MetricsRegistry::Get ()->IsEnabled () ? histogram : 0)
+  {
+    if (m_histogram)
+      {
+        m_start = std::chrono::steady_clock::now ();
+      }
+  }
+  /** Stop timing and record the duration. */
+  ~MetricTimer ()
+  {
+    if (m_histogram)
+      {
+        m_histogram->Record (std::chrono::duration_cast<std::chrono::nanoseconds>
+                               (std::chrono::steady_clock::now () - m_start).count ());
+      }
+  }
+
+private:
+  MetricHistogram *m_histogram;                    //!< Histogram, or 0 if disabled.
+  std::chrono::steady_clock::time_point m_start;   //!< Start of the scope.
+};
+
+} // namespace ns3
+
+#endif /* METRICS_REGISTRY_H */
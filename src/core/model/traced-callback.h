@@ -21,7 +21,7 @@
 #ifndef TRACED_CALLBACK_H
 #define TRACED_CALLBACK_H
 
-#include <list>
+#include <vector>
 #include "callback.h"
 
 /**
@@ -89,6 +89,20 @@ public:
    * \param [in] args The arguments to the functor
    */
   void operator() (Ts... args) const;
+  /**
+   * \brief Checks if the chain of Callbacks is empty.
+   *
+   * Trace sources on hot paths can use this to skip building
+   * the trace arguments when nothing is connected.
+   *
+   * \return \c true if no Callback is connected.
+   */
+  bool IsEmpty (void) const;
+  /**
+   * \brief Get the number of Callbacks in the chain.
+   * \return The number of connected Callbacks.
+   */
+  std::size_t GetSize (void) const;
 
   /**
    *  TracedCallback signature for POD.
@@ -103,13 +117,46 @@ public:
 
 private:
   /**
-   * Container type for holding the chain of Callbacks.
+   * Number of Callbacks stored inline, without a heap allocation.
    *
-   * \tparam Ts \deduced Types of the functor arguments.
+   * Most trace sources have no sink or only one or two sinks, so
+   * the chain is kept in a small inline array and only spills
+   * into a contiguous vector when more Callbacks are connected.
+   */
+  static const std::size_t N_INLINE = 2;
+  /**
+   * Get a reference to the Callback at a position in the chain.
+   *
+   * \param [in] i The position in the chain.
+   * \return The Callback at position \p i.
+   */
+  Callback<void,Ts...> & At (std::size_t i);
+  /**
+   * Get a const reference to the Callback at a position in the chain.
+   *
+   * \param [in] i The position in the chain.
+   * \return The Callback at position \p i.
    */
-  typedef std::list<Callback<void,Ts...> > CallbackList;
-  /** The chain of Callbacks. */
-  CallbackList m_callbackList;
+  const Callback<void,Ts...> & At (std::size_t i) const;
+  /**
+   * Append a Callback to the end of the chain.
+   *
+   * \param [in] cb The Callback to append.
+   */
+  void PushBack (const Callback<void,Ts...> & cb);
+  /**
+   * Remove a Callback from the chain, preserving the order of the others.
+   *
+   * \param [in] i The position of the Callback to remove.
+   */
+  void Erase (std::size_t i);
+
+  /** The first Callbacks of the chain. */
+  Callback<void,Ts...> m_inline[N_INLINE];
+  /** The Callbacks of the chain beyond the first N_INLINE. */
+  std::vector<Callback<void,Ts...> > m_overflow;
+  /** The number of Callbacks in the chain. */
+  std::size_t m_size;
 };
 
 } // namespace ns3
@@ -123,9 +170,54 @@ namespace ns3 {
 
 template<typename... Ts>
 TracedCallback<Ts...>::TracedCallback ()
-  : m_callbackList ()
+  : m_overflow (),
+    m_size (0)
 {}
 template<typename... Ts>
+Callback<void,Ts...> &
+TracedCallback<Ts...>::At (std::size_t i)
+{
+  return (i < N_INLINE) ? m_inline[i] : m_overflow[i - N_INLINE];
+}
+template<typename... Ts>
+const Callback<void,Ts...> &
+TracedCallback<Ts...>::At (std::size_t i) const
+{
+  return (i < N_INLINE) ? m_inline[i] : m_overflow[i - N_INLINE];
+}
+template<typename... Ts>
+void
+TracedCallback<Ts...>::PushBack (const Callback<void,Ts...> & cb)
+{
+  if (m_size < N_INLINE)
+    {
+      m_inline[m_size] = cb;
+    }
+  else
+    {
+      m_overflow.push_back (cb);
+    }
+  m_size++;
+}
+template<typename... Ts>
+void
+TracedCallback<Ts...>::Erase (std::size_t i)
+{
+  for (std::size_t j = i; j + 1 < m_size; j++)
+    {
+      At (j) = At (j + 1);
+    }
+  m_size--;
+  if (m_size < N_INLINE)
+    {
+      m_inline[m_size] = Callback<void,Ts...> ();
+    }
+  else
+    {
+      m_overflow.pop_back ();
+    }
+}
+template<typename... Ts>
 void
 TracedCallback<Ts...>::ConnectWithoutContext (const CallbackBase & callback)
 {
@@ -134,7 +226,7 @@ TracedCallback<Ts...>::ConnectWithoutContext (const CallbackBase & callback)
     {
       NS_FATAL_ERROR_NO_MSG ();
     }
-  m_callbackList.push_back (cb);
+  PushBack (cb);
 }
 template<typename... Ts>
 void
@@ -146,18 +238,17 @@ TracedCallback<Ts...>::Connect (const CallbackBase & callback, std::string path)
       NS_FATAL_ERROR ("when connecting to " << path);
     }
   Callback<void,Ts...> realCb = cb.Bind (path);
-  m_callbackList.push_back (realCb);
+  PushBack (realCb);
 }
 template<typename... Ts>
 void
 TracedCallback<Ts...>::DisconnectWithoutContext (const CallbackBase & callback)
 {
-  for (typename CallbackList::iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); /* empty */)
+  for (std::size_t i = 0; i < m_size; /* empty */)
     {
-      if ((*i).IsEqual (callback))
+      if (At (i).IsEqual (callback))
         {
-          i = m_callbackList.erase (i);
+          Erase (i);
         }
       else
         {
@@ -181,12 +272,25 @@ template<typename... Ts>
 void
 TracedCallback<Ts...>::operator() (Ts... args) const
 {
-  for (typename CallbackList::const_iterator i = m_callbackList.begin ();
-       i != m_callbackList.end (); i++)
+  // Index, rather than iterate, so that a sink connecting another
+  // Callback (and growing m_overflow) does not invalidate the walk.
+  for (std::size_t i = 0; i < m_size; i++)
     {
-      (*i)(args...);
+      At (i)(args...);
     }
 }
+template<typename... Ts>
+bool
+TracedCallback<Ts...>::IsEmpty (void) const
+{
+  return m_size == 0;
+}
+template<typename... Ts>
+std::size_t
+TracedCallback<Ts...>::GetSize (void) const
+{
+  return m_size;
+}
 
 } // namespace ns3
 
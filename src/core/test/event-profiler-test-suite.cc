@@ -0,0 +1,323 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/event-profiler.h"
+#include "ns3/event-impl.h"
+#include "ns3/make-event.h"
+#include "ns3/ptr.h"
+#include "ns3/test.h"
+#ifdef ENABLE_EVENT_PROFILER
+#include "ns3/config.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include <fstream>
+#endif
+
+#include <algorithm>
+#include <sstream>
+#include <typeinfo>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup simulator
+ * EventProfiler test suite.
+ */
+
+namespace ns3 {
+
+namespace tests {
+
+
+/**
+ * \ingroup core-tests
+ * Event type used to exercise the profiler.
+ */
+class ProfiledEventA : public EventImpl
+{
+protected:
+  virtual void Notify (void)
+  {}
+};
+
+/**
+ * \ingroup core-tests
+ * Another event type used to exercise the profiler.
+ */
+class ProfiledEventB : public EventImpl
+{
+protected:
+  virtual void Notify (void)
+  {}
+};
+
+/**
+ * \ingroup core-tests
+ * Object whose member functions are bound to the profiled events.
+ */
+class ProfiledObject
+{
+public:
+  /** First member function. */
+  void First (void);
+  /** Second member function, with the signature of First (). */
+  void Second (void);
+  /** Virtual member function, with the signature of First (). */
+  virtual void Third (void);
+  /** Another virtual member function, with the signature of First (). */
+  virtual void Fourth (void);
+  /** Destructor. */
+  virtual ~ProfiledObject ()
+  {}
+};
+
+void
+ProfiledObject::First (void)
+{}
+
+void
+ProfiledObject::Second (void)
+{}
+
+void
+ProfiledObject::Third (void)
+{}
+
+void
+ProfiledObject::Fourth (void)
+{}
+
+/**
+ * \ingroup core-tests
+ * Function bound to the profiled events.
+ */
+void
+ProfiledFunction (void)
+{}
+
+
+/**
+ * \ingroup core-tests
+ * Check the per-type and per-context accounting of EventProfiler.
+ */
+class EventProfilerTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  EventProfilerTestCase ();
+  virtual void DoRun (void);
+};
+
+EventProfilerTestCase::EventProfilerTestCase ()
+  : TestCase ("Check EventProfiler accounting and output")
+{}
+
+void
+EventProfilerTestCase::DoRun (void)
+{
+  typedef EventProfiler::Clock Clock;
+  Ptr<EventImpl> a = Create<ProfiledEventA> ();
+  Ptr<EventImpl> b = Create<ProfiledEventB> ();
+  Clock::time_point t0 = Clock::now ();
+
+  EventProfiler profiler;
+  profiler.SetMaxTraceEvents (2);
+  profiler.Record (PeekPointer (a), 1, t0, t0 + std::chrono::microseconds (10));
+  profiler.Record (PeekPointer (a), 2, t0, t0 + std::chrono::microseconds (30));
+  profiler.Record (PeekPointer (b), 2, t0, t0 + std::chrono::microseconds (100));
+
+  std::map<std::string, EventProfiler::Stats> types = profiler.GetTypeStats ();
+  NS_TEST_ASSERT_MSG_EQ (types.size (), 2, "Wrong number of event types");
+  std::map<std::string, EventProfiler::Stats>::const_iterator it = types.begin ();
+  NS_TEST_ASSERT_MSG_NE (it->first.find ("ProfiledEventA"), std::string::npos, "Wrong type name");
+  NS_TEST_ASSERT_MSG_EQ (it->second.count, 2, "Wrong count");
+  NS_TEST_ASSERT_MSG_EQ (it->second.totalNs, 40000, "Wrong total time");
+  NS_TEST_ASSERT_MSG_EQ (it->second.maxNs, 30000, "Wrong max time");
+  ++it;
+  NS_TEST_ASSERT_MSG_NE (it->first.find ("ProfiledEventB"), std::string::npos, "Wrong type name");
+  NS_TEST_ASSERT_MSG_EQ (it->second.count, 1, "Wrong count");
+
+  std::map<uint32_t, EventProfiler::Stats> contexts = profiler.GetContextStats ();
+  NS_TEST_ASSERT_MSG_EQ (contexts.size (), 2, "Wrong number of contexts");
+  NS_TEST_ASSERT_MSG_EQ (contexts[1].count, 1, "Wrong count for context 1");
+  NS_TEST_ASSERT_MSG_EQ (contexts[2].count, 2, "Wrong count for context 2");
+  NS_TEST_ASSERT_MSG_EQ (contexts[2].totalNs, 130000, "Wrong total time for context 2");
+
+  // The text report is sorted by decreasing total time.
+  std::ostringstream text;
+  profiler.Write (text, EventProfiler::TEXT);
+  NS_TEST_ASSERT_MSG_LT (text.str ().find ("ProfiledEventB"), text.str ().find ("ProfiledEventA"),
+                         "Text report is not sorted by total time");
+
+  // Only two events are kept for the Chrome trace.
+  std::ostringstream json;
+  profiler.Write (json, EventProfiler::CHROME_TRACE);
+  std::string trace = json.str ();
+  uint32_t nEvents = 0;
+  for (std::string::size_type pos = trace.find ("\"ph\":\"X\""); pos != std::string::npos;
+       pos = trace.find ("\"ph\":\"X\"", pos + 1))
+    {
+      nEvents++;
+    }
+  NS_TEST_ASSERT_MSG_EQ (nEvents, 2, "Wrong number of Chrome trace events");
+  NS_TEST_ASSERT_MSG_NE (trace.find ("\"dur\":30.000"), std::string::npos, "Wrong Chrome trace duration");
+
+  profiler.Clear ();
+  NS_TEST_ASSERT_MSG_EQ (profiler.GetTypeStats ().size (), 0, "Profile not cleared");
+}
+
+/**
+ * \ingroup core-tests
+ * Check that the events of one MakeEvent type, bound to different
+ * functions, are separate entries.
+ */
+class EventProfilerFunctionTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  EventProfilerFunctionTestCase ();
+  virtual void DoRun (void);
+};
+
+EventProfilerFunctionTestCase::EventProfilerFunctionTestCase ()
+  : TestCase ("Check EventProfiler entries of the MakeEvent events")
+{}
+
+void
+EventProfilerFunctionTestCase::DoRun (void)
+{
+  typedef EventProfiler::Clock Clock;
+  ProfiledObject object;
+  Ptr<EventImpl> first (MakeEvent (&ProfiledObject::First, &object), false);
+  Ptr<EventImpl> otherFirst (MakeEvent (&ProfiledObject::First, &object), false);
+  Ptr<EventImpl> second (MakeEvent (&ProfiledObject::Second, &object), false);
+  Ptr<EventImpl> third (MakeEvent (&ProfiledObject::Third, &object), false);
+  Ptr<EventImpl> fourth (MakeEvent (&ProfiledObject::Fourth, &object), false);
+  Ptr<EventImpl> function (MakeEvent (&ProfiledFunction), false);
+  NS_TEST_ASSERT_MSG_EQ ((typeid (*first) == typeid (*second)), true,
+                         "The events of First and Second should have the same type");
+  Clock::time_point t0 = Clock::now ();
+
+  EventProfiler profiler;
+  profiler.Record (PeekPointer (first), 1, t0, t0 + std::chrono::microseconds (10));
+  profiler.Record (PeekPointer (otherFirst), 1, t0, t0 + std::chrono::microseconds (20));
+  profiler.Record (PeekPointer (second), 1, t0, t0 + std::chrono::microseconds (40));
+  profiler.Record (PeekPointer (third), 1, t0, t0 + std::chrono::microseconds (80));
+  profiler.Record (PeekPointer (fourth), 1, t0, t0 + std::chrono::microseconds (160));
+  profiler.Record (PeekPointer (function), 1, t0, t0 + std::chrono::microseconds (320));
+
+  std::map<std::string, EventProfiler::Stats> types = profiler.GetTypeStats ();
+  NS_TEST_ASSERT_MSG_EQ (types.size (), 5, "Wrong number of entries");
+  uint64_t totalNs[] = {30000, 40000, 80000, 160000, 320000};
+  std::vector<uint64_t> expected (totalNs, totalNs + 5);
+  std::vector<uint64_t> found;
+  for (std::map<std::string, EventProfiler::Stats>::const_iterator it = types.begin ();
+       it != types.end (); ++it)
+    {
+      found.push_back (it->second.totalNs);
+    }
+  std::sort (found.begin (), found.end ());
+  NS_TEST_ASSERT_MSG_EQ ((found == expected), true, "Wrong total time of the entries");
+
+#ifdef __GLIBC__
+  // the functions of this test library are exported
+  NS_TEST_ASSERT_MSG_EQ (types["ns3::tests::ProfiledObject::First()"].count, 2,
+                         "Wrong count of First");
+  NS_TEST_ASSERT_MSG_EQ (types["ns3::tests::ProfiledObject::Second()"].count, 1,
+                         "Wrong count of Second");
+  NS_TEST_ASSERT_MSG_EQ (types["ns3::tests::ProfiledFunction()"].count, 1,
+                         "Wrong count of ProfiledFunction");
+#endif
+}
+
+
+#ifdef ENABLE_EVENT_PROFILER
+/**
+ * \ingroup core-tests
+ * Check the event profile written by DefaultSimulatorImpl.
+ */
+class EventProfilerSimulatorTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  EventProfilerSimulatorTestCase ();
+  virtual void DoRun (void);
+};
+
+EventProfilerSimulatorTestCase::EventProfilerSimulatorTestCase ()
+  : TestCase ("Check the event profile of DefaultSimulatorImpl")
+{}
+
+void
+EventProfilerSimulatorTestCase::DoRun (void)
+{
+  std::string filename = CreateTempDirFilename ("event-profile.txt");
+  Simulator::Destroy ();
+  Config::SetDefault ("ns3::DefaultSimulatorImpl::EventProfileFile", StringValue (filename));
+  ProfiledObject object;
+  Simulator::Schedule (Seconds (1), &ProfiledObject::First, &object);
+  Simulator::Schedule (Seconds (2), &ProfiledObject::First, &object);
+  Simulator::Schedule (Seconds (3), &ProfiledObject::Second, &object);
+  Simulator::Run ();
+  Simulator::Destroy ();
+  Config::SetDefault ("ns3::DefaultSimulatorImpl::EventProfileFile", StringValue (""));
+
+  std::ifstream ifs (filename.c_str ());
+  NS_TEST_ASSERT_MSG_EQ (ifs.is_open (), true, "Event profile not written");
+  std::ostringstream profile;
+  profile << ifs.rdbuf ();
+  NS_TEST_ASSERT_MSG_NE (profile.str ().find ("Event profile: 3 events"), std::string::npos,
+                         "Wrong number of events");
+#ifdef __GLIBC__
+  NS_TEST_ASSERT_MSG_NE (profile.str ().find ("ns3::tests::ProfiledObject::First()"), std::string::npos,
+                         "No entry for First");
+  NS_TEST_ASSERT_MSG_NE (profile.str ().find ("ns3::tests::ProfiledObject::Second()"), std::string::npos,
+                         "No entry for Second");
+#endif
+}
+#endif /* ENABLE_EVENT_PROFILER */
+
+
+/**
+ * \ingroup core-tests
+ * EventProfiler test suite
+ */
+class EventProfilerTestSuite : public TestSuite
+{
+public:
+  /** Constructor. */
+  EventProfilerTestSuite ()
+    : TestSuite ("event-profiler")
+  {
+    AddTestCase (new EventProfilerTestCase ());
+    AddTestCase (new EventProfilerFunctionTestCase ());
+#ifdef ENABLE_EVENT_PROFILER
+    AddTestCase (new EventProfilerSimulatorTestCase ());
+#endif
+  }
+};
+
+/**
+ * \ingroup core-tests
+ * EventProfilerTestSuite instance variable.
+ */
+static EventProfilerTestSuite g_eventProfilerTestSuite;
+
+
+}    // namespace tests
+
+}  // namespace ns3
@@ -0,0 +1,232 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/metrics-registry.h"
+#include "ns3/test.h"
+
+#include <sstream>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup metrics
+ * MetricsRegistry test suite.
+ */
+
+namespace ns3 {
+
+namespace tests {
+
+
+/**
+ * \ingroup core-tests
+ * Check the HDR bucket layout of MetricHistogram.
+ */
+class MetricHistogramBucketTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  MetricHistogramBucketTestCase ();
+  virtual void DoRun (void);
+};
+
+MetricHistogramBucketTestCase::MetricHistogramBucketTestCase ()
+  : TestCase ("Check MetricHistogram bucket layout")
+{}
+
+void
+MetricHistogramBucketTestCase::DoRun (void)
+{
+  for (uint64_t v = 0; v < 16; v++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (MetricHistogram::GetBucket (v), v, "Small values have their own bucket");
+    }
+  NS_TEST_ASSERT_MSG_EQ (MetricHistogram::GetBucket (16), MetricHistogram::GetBucket (17), "Wrong bucket width");
+  NS_TEST_ASSERT_MSG_LT (MetricHistogram::GetBucket (~0ULL), MetricHistogram::N_BUCKETS, "Bucket out of range");
+
+  // Each bucket starts right after the previous one, and every value
+  // is within 12.5% of the lower bound of its bucket.
+  for (uint32_t b = 1; b <= MetricHistogram::GetBucket (~0ULL); b++)
+    {
+      uint64_t lower = MetricHistogram::GetBucketLowerBound (b);
+      NS_TEST_ASSERT_MSG_EQ (MetricHistogram::GetBucket (lower), b, "Wrong lower bound for bucket " << b);
+      NS_TEST_ASSERT_MSG_EQ (MetricHistogram::GetBucket (lower - 1), b - 1, "Gap before bucket " << b);
+    }
+  uint64_t v = 1000003;
+  uint64_t lower = MetricHistogram::GetBucketLowerBound (MetricHistogram::GetBucket (v));
+  NS_TEST_ASSERT_MSG_LT_OR_EQ (lower, v, "Lower bound above the value");
+  NS_TEST_ASSERT_MSG_GT_OR_EQ (lower, v - v / 8, "Bucket too wide");
+}
+
+
+/**
+ * \ingroup core-tests
+ * Check counters, histogram summaries and registry snapshots.
+ */
+class MetricsRegistryTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  MetricsRegistryTestCase ();
+  virtual void DoRun (void);
+};
+
+MetricsRegistryTestCase::MetricsRegistryTestCase ()
+  : TestCase ("Check MetricsRegistry counters, histograms and snapshots")
+{}
+
+void
+MetricsRegistryTestCase::DoRun (void)
+{
+  MetricsRegistry *registry = MetricsRegistry::Get ();
+  MetricCounter *counter = registry->GetCounter ("Test/Counter");
+  NS_TEST_ASSERT_MSG_EQ (counter, registry->GetCounter ("Test/Counter"), "Counter not shared by name");
+  counter->Reset ();
+  counter->Increment ();
+  counter->Increment (4);
+  NS_TEST_ASSERT_MSG_EQ (counter->GetValue (), 5, "Wrong counter value");
+
+  MetricHistogram *histogram = registry->GetHistogram ("Test/Histogram");
+  histogram->Reset ();
+  for (uint64_t i = 1; i <= 100; i++)
+    {
+      histogram->Record (i);
+    }
+  MetricHistogram::Summary s = histogram->GetSummary ();
+  NS_TEST_ASSERT_MSG_EQ (s.count, 100, "Wrong sample count");
+  NS_TEST_ASSERT_MSG_EQ (s.sum, 5050, "Wrong sample sum");
+  NS_TEST_ASSERT_MSG_EQ (s.max, 100, "Wrong maximum");
+  NS_TEST_ASSERT_MSG_EQ (s.p50, MetricHistogram::GetBucketLowerBound (MetricHistogram::GetBucket (50)), "Wrong median");
+  NS_TEST_ASSERT_MSG_EQ (s.p99, MetricHistogram::GetBucketLowerBound (MetricHistogram::GetBucket (99)), "Wrong 99th percentile");
+
+  std::string snapshot = registry->Snapshot ();
+  NS_TEST_ASSERT_MSG_NE (snapshot.find ("\"Test/Counter\":5"), std::string::npos, "Counter missing from snapshot");
+  NS_TEST_ASSERT_MSG_NE (snapshot.find ("\"Test/Histogram\":{\"count\":100,\"sum\":5050,\"max\":100"), std::string::npos,
+                         "Histogram missing from snapshot");
+  NS_TEST_ASSERT_MSG_EQ (counter->GetValue (), 5, "Counter reset by snapshot");
+  NS_TEST_ASSERT_MSG_EQ (histogram->GetSummary ().count, 100, "Histogram reset by snapshot");
+
+  // Timers only measure while the registry is enabled, by any consumer.
+  histogram->Reset ();
+  NS_TEST_ASSERT_MSG_EQ (registry->IsEnabled (), false, "Registry enabled without consumer");
+  {
+    MetricTimer timer (histogram);
+  }
+  NS_TEST_ASSERT_MSG_EQ (histogram->GetSummary ().count, 0, "Disabled timer recorded a sample");
+  registry->Enable ();
+  registry->Enable ();
+  registry->Disable ();
+  {
+    MetricTimer timer (histogram);
+  }
+  registry->Disable ();
+  NS_TEST_ASSERT_MSG_EQ (histogram->GetSummary ().count, 1, "Enabled timer did not record a sample");
+  NS_TEST_ASSERT_MSG_EQ (registry->IsEnabled (), false, "Registry still enabled");
+}
+
+
+/**
+ * \ingroup core-tests
+ * Check that MetricsReader instances report the metrics of their own
+ * intervals.
+ */
+class MetricsReaderTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  MetricsReaderTestCase ();
+  virtual void DoRun (void);
+};
+
+MetricsReaderTestCase::MetricsReaderTestCase ()
+  : TestCase ("Check MetricsReader intervals")
+{}
+
+void
+MetricsReaderTestCase::DoRun (void)
+{
+  MetricsRegistry *registry = MetricsRegistry::Get ();
+  MetricCounter *counter = registry->GetCounter ("Test/ReaderCounter");
+  MetricHistogram *histogram = registry->GetHistogram ("Test/ReaderHistogram");
+  counter->Reset ();
+  histogram->Reset ();
+  counter->Increment (3);
+  histogram->Record (1000);
+
+  Ptr<MetricsReader> first = Create<MetricsReader> ();
+  NS_TEST_ASSERT_MSG_EQ (registry->IsEnabled (), true, "Reader did not enable the registry");
+  counter->Increment (2);
+  histogram->Record (10);
+  Ptr<MetricsReader> second = Create<MetricsReader> ();
+  counter->Increment (4);
+  histogram->Record (20);
+
+  std::string snapshot = first->Snapshot ();
+  NS_TEST_ASSERT_MSG_NE (snapshot.find ("\"Test/ReaderCounter\":6"), std::string::npos, "Wrong counter of the first reader");
+  // the maximum below the one of a previous interval is known to the bucket resolution
+  std::ostringstream histogramOss;
+  histogramOss << "\"Test/ReaderHistogram\":{\"count\":2,\"sum\":30,\"max\":"
+               << MetricHistogram::GetBucketLowerBound (MetricHistogram::GetBucket (20));
+  NS_TEST_ASSERT_MSG_NE (snapshot.find (histogramOss.str ()), std::string::npos, "Wrong histogram of the first reader");
+  NS_TEST_ASSERT_MSG_EQ (counter->GetValue (), 9, "Counter reset by a reader");
+
+  // the snapshot of the first reader does not reset the interval of the second
+  counter->Increment ();
+  histogram->Record (2000);
+  snapshot = second->Snapshot ();
+  NS_TEST_ASSERT_MSG_NE (snapshot.find ("\"Test/ReaderCounter\":5"), std::string::npos, "Wrong counter of the second reader");
+  NS_TEST_ASSERT_MSG_NE (snapshot.find ("\"Test/ReaderHistogram\":{\"count\":2,\"sum\":2020,\"max\":2000"), std::string::npos,
+                         "Wrong histogram of the second reader");
+  snapshot = first->Snapshot ();
+  NS_TEST_ASSERT_MSG_NE (snapshot.find ("\"Test/ReaderCounter\":1"), std::string::npos, "Wrong next interval of the first reader");
+  snapshot = first->Snapshot ();
+  NS_TEST_ASSERT_MSG_NE (snapshot.find ("\"Test/ReaderHistogram\":{\"count\":0,\"sum\":0,\"max\":0"), std::string::npos,
+                         "Empty interval of the first reader not empty");
+
+  first = 0;
+  NS_TEST_ASSERT_MSG_EQ (registry->IsEnabled (), true, "Registry disabled while a reader exists");
+  second = 0;
+  NS_TEST_ASSERT_MSG_EQ (registry->IsEnabled (), false, "Registry enabled without reader");
+}
+
+
+/**
+ * \ingroup core-tests
+ * MetricsRegistry test suite
+ */
+class MetricsRegistryTestSuite : public TestSuite
+{
+public:
+  /** Constructor. */
+  MetricsRegistryTestSuite ()
+    : TestSuite ("metrics-registry")
+  {
+    AddTestCase (new MetricHistogramBucketTestCase ());
+    AddTestCase (new MetricsRegistryTestCase ());
+    AddTestCase (new MetricsReaderTestCase ());
+  }
+};
+
+/**
+ * \ingroup core-tests
+ * MetricsRegistryTestSuite instance variable.
+ */
+static MetricsRegistryTestSuite g_metricsRegistryTestSuite;
+
+
+}    // namespace tests
+
+}  // namespace ns3
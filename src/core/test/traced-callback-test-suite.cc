@@ -19,6 +19,7 @@
 #include "ns3/test.h"
 #include "ns3/traced-callback.h"
 #include "ns3/unused.h"
+#include <vector>
 
 using namespace ns3;
 
@@ -113,6 +114,77 @@ BasicTracedCallbackTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (m_two, true, "Callback CbTwo not called");
 }
 
+class OrderTracedCallbackTestCase : public TestCase
+{
+public:
+  OrderTracedCallbackTestCase ();
+  virtual ~OrderTracedCallbackTestCase ()
+  {}
+
+private:
+  virtual void DoRun (void);
+
+  static void Cb (std::vector<uint32_t> *calls, uint32_t id);
+};
+
+OrderTracedCallbackTestCase::OrderTracedCallbackTestCase ()
+  : TestCase ("Check TracedCallback ordering beyond the inline storage")
+{}
+
+void
+OrderTracedCallbackTestCase::Cb (std::vector<uint32_t> *calls, uint32_t id)
+{
+  calls->push_back (id);
+}
+
+void
+OrderTracedCallbackTestCase::DoRun (void)
+{
+  std::vector<uint32_t> calls;
+  TracedCallback<> trace;
+  NS_TEST_ASSERT_MSG_EQ (trace.IsEmpty (), true, "New TracedCallback is not empty");
+
+  //
+  // Connect more callbacks than fit in the inline storage.  They must be
+  // called in the order they were connected.
+  //
+  for (uint32_t i = 0; i < 5; i++)
+    {
+      trace.ConnectWithoutContext (MakeBoundCallback (&OrderTracedCallbackTestCase::Cb, &calls, i));
+    }
+  NS_TEST_ASSERT_MSG_EQ (trace.IsEmpty (), false, "TracedCallback is empty");
+  NS_TEST_ASSERT_MSG_EQ (trace.GetSize (), 5, "Wrong number of callbacks");
+  calls.clear ();
+  trace ();
+  NS_TEST_ASSERT_MSG_EQ (calls.size (), 5, "Wrong number of calls");
+  for (uint32_t i = 0; i < calls.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (calls[i], i, "Callback called out of order");
+    }
+
+  //
+  // Disconnect one inline and one overflow callback; the remaining ones
+  // keep their relative order.
+  //
+  trace.DisconnectWithoutContext (MakeBoundCallback (&OrderTracedCallbackTestCase::Cb, &calls, 1));
+  trace.DisconnectWithoutContext (MakeBoundCallback (&OrderTracedCallbackTestCase::Cb, &calls, 3));
+  NS_TEST_ASSERT_MSG_EQ (trace.GetSize (), 3, "Wrong number of callbacks");
+  calls.clear ();
+  trace ();
+  NS_TEST_ASSERT_MSG_EQ (calls.size (), 3, "Wrong number of calls");
+  NS_TEST_ASSERT_MSG_EQ (calls[0], 0, "Callback called out of order");
+  NS_TEST_ASSERT_MSG_EQ (calls[1], 2, "Callback called out of order");
+  NS_TEST_ASSERT_MSG_EQ (calls[2], 4, "Callback called out of order");
+
+  trace.DisconnectWithoutContext (MakeBoundCallback (&OrderTracedCallbackTestCase::Cb, &calls, 0));
+  trace.DisconnectWithoutContext (MakeBoundCallback (&OrderTracedCallbackTestCase::Cb, &calls, 2));
+  trace.DisconnectWithoutContext (MakeBoundCallback (&OrderTracedCallbackTestCase::Cb, &calls, 4));
+  NS_TEST_ASSERT_MSG_EQ (trace.IsEmpty (), true, "TracedCallback is not empty");
+  calls.clear ();
+  trace ();
+  NS_TEST_ASSERT_MSG_EQ (calls.size (), 0, "Callback unexpectedly called");
+}
+
 class TracedCallbackTestSuite : public TestSuite
 {
 public:
@@ -123,6 +195,7 @@ TracedCallbackTestSuite::TracedCallbackTestSuite ()
   : TestSuite ("traced-callback", UNIT)
 {
   AddTestCase (new BasicTracedCallbackTestCase, TestCase::QUICK);
+  AddTestCase (new OrderTracedCallbackTestCase, TestCase::QUICK);
 }
 
 static TracedCallbackTestSuite tracedCallbackTestSuite;
@@ -54,7 +54,9 @@ Ipv4StaticRouting::GetTypeId (void)
 }
 
 Ipv4StaticRouting::Ipv4StaticRouting () 
-  : m_ipv4 (0)
+  : m_trieValid (false),
+    m_trieUsable (false),
+    m_ipv4 (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -77,6 +79,7 @@ Ipv4StaticRouting::AddNetworkRouteTo (Ipv4Address network,
     {
       Ipv4RoutingTableEntry *routePtr = new Ipv4RoutingTableEntry (route);
       m_networkRoutes.push_back (make_pair (routePtr, metric));
+      InvalidateLookups ();
     }
 }
 
@@ -96,6 +99,7 @@ Ipv4StaticRouting::AddNetworkRouteTo (Ipv4Address network,
       Ipv4RoutingTableEntry *routePtr = new Ipv4RoutingTableEntry (route);
 
       m_networkRoutes.push_back (make_pair (routePtr, metric));
+      InvalidateLookups ();
     }
 }
 
@@ -154,6 +158,7 @@ Ipv4StaticRouting::SetDefaultMulticastRoute (uint32_t outputInterface)
                                                         networkMask,
                                                         outputInterface);
   m_networkRoutes.push_back (make_pair (route,0));
+  InvalidateLookups ();
 }
 
 uint32_t 
@@ -269,56 +274,67 @@ Ipv4StaticRouting::LookupStatic (Ipv4Address dest, Ptr<NetDevice> oif)
     }
 
 
-  for (NetworkRoutesI i = m_networkRoutes.begin (); 
-       i != m_networkRoutes.end (); 
-       i++) 
+  Ipv4RoutingTableEntry *route = 0;
+  if (oif == 0 && (m_trieValid || BuildTrie ()) && m_trieUsable)
     {
-      Ipv4RoutingTableEntry *j=i->first;
-      uint32_t metric =i->second;
-      Ipv4Mask mask = (j)->GetDestNetworkMask ();
-      uint16_t masklen = mask.GetPrefixLength ();
-      Ipv4Address entry = (j)->GetDestNetwork ();
-      NS_LOG_LOGIC ("Searching for route to " << dest << ", checking against route to " << entry << "/" << masklen);
-      if (mask.IsMatch (dest, entry)) 
+      route = LookupPrefix (dest);
+    }
+  else
+    {
+      for (NetworkRoutesI i = m_networkRoutes.begin (); 
+           i != m_networkRoutes.end (); 
+           i++) 
         {
-          NS_LOG_LOGIC ("Found global network route " << j << ", mask length " << masklen << ", metric " << metric);
-          if (oif != 0)
+          Ipv4RoutingTableEntry *j=i->first;
+          uint32_t metric =i->second;
+          Ipv4Mask mask = (j)->GetDestNetworkMask ();
+          uint16_t masklen = mask.GetPrefixLength ();
+          Ipv4Address entry = (j)->GetDestNetwork ();
+          NS_LOG_LOGIC ("Searching for route to " << dest << ", checking against route to " << entry << "/" << masklen);
+          if (mask.IsMatch (dest, entry)) 
             {
-              if (oif != m_ipv4->GetNetDevice (j->GetInterface ()))
+              NS_LOG_LOGIC ("Found global network route " << j << ", mask length " << masklen << ", metric " << metric);
+              if (oif != 0)
                 {
-                  NS_LOG_LOGIC ("Not on requested interface, skipping");
+                  if (oif != m_ipv4->GetNetDevice (j->GetInterface ()))
+                    {
+                      NS_LOG_LOGIC ("Not on requested interface, skipping");
+                      continue;
+                    }
+                }
+              if (masklen < longest_mask) // Not interested if got shorter mask
+                {
+                  NS_LOG_LOGIC ("Previous match longer, skipping");
                   continue;
                 }
-            }
-          if (masklen < longest_mask) // Not interested if got shorter mask
-            {
-              NS_LOG_LOGIC ("Previous match longer, skipping");
-              continue;
-            }
-          if (masklen > longest_mask) // Reset metric if longer masklen
-            {
-              shortest_metric = 0xffffffff;
-            }
-          longest_mask = masklen;
-          if (metric > shortest_metric)
-            {
-              NS_LOG_LOGIC ("Equal mask length, but previous metric shorter, skipping");
-              continue;
-            }
-          shortest_metric = metric;
-          Ipv4RoutingTableEntry* route = (j);
-          uint32_t interfaceIdx = route->GetInterface ();
-          rtentry = Create<Ipv4Route> ();
-          rtentry->SetDestination (route->GetDest ());
-          rtentry->SetSource (m_ipv4->SourceAddressSelection (interfaceIdx, route->GetDest ()));
-          rtentry->SetGateway (route->GetGateway ());
-          rtentry->SetOutputDevice (m_ipv4->GetNetDevice (interfaceIdx));
-          if (masklen == 32)
-            {
-              break;
+              if (masklen > longest_mask) // Reset metric if longer masklen
+                {
+                  shortest_metric = 0xffffffff;
+                }
+              longest_mask = masklen;
+              if (metric > shortest_metric)
+                {
+                  NS_LOG_LOGIC ("Equal mask length, but previous metric shorter, skipping");
+                  continue;
+                }
+              shortest_metric = metric;
+              route = (j);
+              if (masklen == 32)
+                {
+                  break;
+                }
             }
         }
     }
+  if (route != 0)
+    {
+      uint32_t interfaceIdx = route->GetInterface ();
+      rtentry = Create<Ipv4Route> ();
+      rtentry->SetDestination (route->GetDest ());
+      rtentry->SetSource (m_ipv4->SourceAddressSelection (interfaceIdx, route->GetDest ()));
+      rtentry->SetGateway (route->GetGateway ());
+      rtentry->SetOutputDevice (m_ipv4->GetNetDevice (interfaceIdx));
+    }
   if (rtentry != 0)
     {
       NS_LOG_LOGIC ("Matching route via " << rtentry->GetGateway () << " at the end");
@@ -330,6 +346,102 @@ Ipv4StaticRouting::LookupStatic (Ipv4Address dest, Ptr<NetDevice> oif)
   return rtentry;
 }
 
+Ipv4RoutingTableEntry *
+Ipv4StaticRouting::LookupPrefix (Ipv4Address dest)
+{
+  NS_LOG_FUNCTION (this << dest);
+  uint32_t addr = dest.Get ();
+  std::unordered_map<uint32_t, Ipv4RoutingTableEntry *>::const_iterator it = m_lookupCache.find (addr);
+  if (it != m_lookupCache.end ())
+    {
+      return it->second;
+    }
+
+  // walk down the trie along the bits of the destination: the deepest
+  // node holding a route has the longest matching prefix
+  Ipv4RoutingTableEntry *route = 0;
+  int32_t node = 0;
+  for (uint32_t depth = 0; node >= 0; ++depth)
+    {
+      if (m_trie[node].m_route != 0)
+        {
+          route = m_trie[node].m_route;
+        }
+      if (depth == 32)
+        {
+          break;
+        }
+      node = m_trie[node].m_child[(addr >> (31 - depth)) & 1];
+    }
+  NS_LOG_LOGIC ("Route to " << dest << " found in the trie: " << route);
+
+  if (m_lookupCache.size () >= MAX_CACHED_LOOKUPS)
+    {
+      m_lookupCache.clear ();
+    }
+  m_lookupCache[addr] = route;
+  return route;
+}
+
+bool
+Ipv4StaticRouting::BuildTrie (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_trie.clear ();
+  m_lookupCache.clear ();
+  TrieNode root = {{-1, -1}, 0, 0};
+  m_trie.push_back (root);
+  m_trieValid = true;
+  m_trieUsable = true;
+
+  for (NetworkRoutesCI i = m_networkRoutes.begin (); i != m_networkRoutes.end (); i++)
+    {
+      Ipv4RoutingTableEntry *route = i->first;
+      uint32_t metric = i->second;
+      Ipv4Mask mask = route->GetDestNetworkMask ();
+      uint16_t masklen = mask.GetPrefixLength ();
+      if (mask.Get () != (masklen == 0 ? 0 : 0xffffffff << (32 - masklen)))
+        {
+          NS_LOG_LOGIC ("Non-contiguous mask " << mask << ", falling back to the linear search");
+          m_trie.clear ();
+          m_trieUsable = false;
+          return false;
+        }
+
+      uint32_t network = route->GetDestNetwork ().Get ();
+      int32_t node = 0;
+      for (uint16_t depth = 0; depth < masklen; ++depth)
+        {
+          uint32_t bit = (network >> (31 - depth)) & 1;
+          if (m_trie[node].m_child[bit] < 0)
+            {
+              TrieNode child = {{-1, -1}, 0, 0};
+              m_trie[node].m_child[bit] = m_trie.size ();
+              m_trie.push_back (child);
+            }
+          node = m_trie[node].m_child[bit];
+        }
+
+      // same tie-breaking as the linear search: the first host route,
+      // otherwise the lowest metric and the last route among equals
+      TrieNode &leaf = m_trie[node];
+      if (leaf.m_route == 0 || (masklen < 32 && metric <= leaf.m_metric))
+        {
+          leaf.m_route = route;
+          leaf.m_metric = metric;
+        }
+    }
+  return true;
+}
+
+void
+Ipv4StaticRouting::InvalidateLookups (void)
+{
+  m_trieValid = false;
+  m_trie.clear ();
+  m_lookupCache.clear ();
+}
+
 Ptr<Ipv4MulticastRoute>
 Ipv4StaticRouting::LookupStatic (
   Ipv4Address origin, 
@@ -478,6 +590,7 @@ Ipv4StaticRouting::RemoveRoute (uint32_t index)
         {
           delete j->first;
           m_networkRoutes.erase (j);
+          InvalidateLookups ();
           return;
         }
       tmp++;
@@ -604,6 +717,7 @@ Ipv4StaticRouting::DoDispose (void)
     {
       delete (j->first);
     }
+  InvalidateLookups ();
   for (MulticastRoutesI i = m_multicastRoutes.begin (); 
        i != m_multicastRoutes.end (); 
        i = m_multicastRoutes.erase (i)) 
@@ -644,6 +758,7 @@ Ipv4StaticRouting::NotifyInterfaceDown (uint32_t i)
         {
           delete it->first;
           it = m_networkRoutes.erase (it);
+          InvalidateLookups ();
         }
       else
         {
@@ -691,6 +806,7 @@ Ipv4StaticRouting::NotifyRemoveAddress (uint32_t interface, Ipv4InterfaceAddress
         {
           delete it->first;
           it = m_networkRoutes.erase (it);
+          InvalidateLookups ();
         }
       else
         {
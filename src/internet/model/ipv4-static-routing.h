@@ -24,6 +24,8 @@
 
 #include <list>
 #include <utility>
+#include <vector>
+#include <unordered_map>
 #include <stdint.h>
 #include "ns3/ipv4-address.h"
 #include "ns3/ipv4-header.h"
@@ -58,6 +60,14 @@ class Node;
  * Ipv4RoutingProtocol that defines the interface methods that a routing 
  * protocol must support.
  *
+ * The unicast lookups that are not bound to an output device are
+ * answered by a binary trie of the network routes, rebuilt at the first
+ * lookup after a change of the routes, and the results are cached per
+ * destination address.  The trie follows the same rules as the
+ * linear search of the routes: the longest prefix wins, then the
+ * lowest metric, and the last added among routes with equal metrics,
+ * except for host routes, where the first added wins.
+ *
  * \see Ipv4RoutingProtocol
  * \see Ipv4ListRouting
  * \see Ipv4ListRouting::AddRoutingProtocol
@@ -402,6 +412,38 @@ private:
   Ptr<Ipv4MulticastRoute> LookupStatic (Ipv4Address origin, Ipv4Address group,
                                         uint32_t interface);
 
+  /**
+   * \brief Lookup the best network route for destination, with the
+   * longest prefix match trie.
+   * \param dest destination address
+   * \return the route, or 0 if there is none
+   */
+  Ipv4RoutingTableEntry *LookupPrefix (Ipv4Address dest);
+
+  /**
+   * \brief Rebuild the longest prefix match trie from the network routes.
+   * \return false if the routes cannot be stored in the trie, i.e.,
+   * if a route has a non-contiguous network mask
+   */
+  bool BuildTrie (void);
+
+  /**
+   * \brief Discard the trie and the cached lookups, after a change of
+   * the network routes.
+   */
+  void InvalidateLookups (void);
+
+  /// Node of the longest prefix match trie
+  struct TrieNode
+  {
+    int32_t m_child[2];              //!< index of the children for the next bit, or -1
+    Ipv4RoutingTableEntry *m_route;  //!< the best route with the prefix of the node, or 0
+    uint32_t m_metric;               //!< the metric of m_route
+  };
+
+  /// Maximum number of destinations in the lookup cache
+  static const uint32_t MAX_CACHED_LOOKUPS = 4096;
+
   /**
    * \brief the forwarding table for network.
    */
@@ -412,6 +454,27 @@ private:
    */
   MulticastRoutes m_multicastRoutes;
 
+  /**
+   * \brief the longest prefix match trie of m_networkRoutes; the root
+   * is the first node.
+   */
+  std::vector<TrieNode> m_trie;
+
+  /**
+   * \brief true if m_trie matches m_networkRoutes.
+   */
+  bool m_trieValid;
+
+  /**
+   * \brief false if m_networkRoutes cannot be stored in the trie.
+   */
+  bool m_trieUsable;
+
+  /**
+   * \brief the routes found by LookupPrefix, by destination address.
+   */
+  std::unordered_map<uint32_t, Ipv4RoutingTableEntry *> m_lookupCache;
+
   /**
    * \brief Ipv4 reference.
    */
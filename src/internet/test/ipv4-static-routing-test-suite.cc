@@ -35,6 +35,8 @@
 #include "ns3/simple-net-device-helper.h"
 #include "ns3/socket-factory.h"
 #include "ns3/udp-socket-factory.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/ipv4-routing-table-entry.h"
 
 using namespace ns3;
 
@@ -201,6 +203,165 @@ Ipv4StaticRoutingSlash32TestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv4 StaticRouting longest prefix match Test
+ *
+ * Checks that the routes found by the longest prefix match trie are the
+ * routes the linear search of the routing table would select, including
+ * the metric tie-breaking, while routes are added and removed.
+ */
+class Ipv4StaticRoutingLongestPrefixMatchTestCase : public TestCase
+{
+public:
+  Ipv4StaticRoutingLongestPrefixMatchTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \brief Linear search of the routing table, as a reference.
+   * \param routing The static routing.
+   * \param dest The destination.
+   * \return The index of the selected route, or -1.
+   */
+  int32_t LookupReference (Ptr<Ipv4StaticRouting> routing, Ipv4Address dest);
+
+  /**
+   * \brief Check the route of random destinations against the reference.
+   * \param ipv4 The IPv4 stack.
+   * \param routing The static routing.
+   * \param dests The destinations.
+   */
+  void CheckRoutes (Ptr<Ipv4> ipv4, Ptr<Ipv4StaticRouting> routing, const std::vector<Ipv4Address> &dests);
+};
+
+Ipv4StaticRoutingLongestPrefixMatchTestCase::Ipv4StaticRoutingLongestPrefixMatchTestCase ()
+  : TestCase ("Longest prefix match of static routes")
+{
+}
+
+int32_t
+Ipv4StaticRoutingLongestPrefixMatchTestCase::LookupReference (Ptr<Ipv4StaticRouting> routing, Ipv4Address dest)
+{
+  int32_t best = -1;
+  uint16_t longestMask = 0;
+  uint32_t shortestMetric = 0xffffffff;
+  for (uint32_t i = 0; i < routing->GetNRoutes (); i++)
+    {
+      Ipv4RoutingTableEntry route = routing->GetRoute (i);
+      uint32_t metric = routing->GetMetric (i);
+      uint16_t masklen = route.GetDestNetworkMask ().GetPrefixLength ();
+      if (!route.GetDestNetworkMask ().IsMatch (dest, route.GetDestNetwork ()) || masklen < longestMask)
+        {
+          continue;
+        }
+      if (masklen > longestMask)
+        {
+          shortestMetric = 0xffffffff;
+        }
+      longestMask = masklen;
+      if (metric > shortestMetric)
+        {
+          continue;
+        }
+      shortestMetric = metric;
+      best = i;
+      if (masklen == 32)
+        {
+          break;
+        }
+    }
+  return best;
+}
+
+void
+Ipv4StaticRoutingLongestPrefixMatchTestCase::CheckRoutes (Ptr<Ipv4> ipv4, Ptr<Ipv4StaticRouting> routing,
+                                                          const std::vector<Ipv4Address> &dests)
+{
+  // twice, the second time from the lookup cache
+  for (uint32_t pass = 0; pass < 2; pass++)
+    {
+      for (std::vector<Ipv4Address>::const_iterator it = dests.begin (); it != dests.end (); it++)
+        {
+          Ipv4Header header;
+          header.SetDestination (*it);
+          Socket::SocketErrno sockerr;
+          Ptr<Ipv4Route> route = routing->RouteOutput (Create<Packet> (), header, 0, sockerr);
+          int32_t expected = LookupReference (routing, *it);
+          if (expected < 0)
+            {
+              NS_TEST_EXPECT_MSG_EQ (route, 0, "Unexpected route to " << *it);
+              continue;
+            }
+          NS_TEST_ASSERT_MSG_NE (route, 0, "No route to " << *it);
+          Ipv4RoutingTableEntry entry = routing->GetRoute (expected);
+          NS_TEST_EXPECT_MSG_EQ (route->GetGateway (), entry.GetGateway (), "Wrong gateway to " << *it);
+          NS_TEST_EXPECT_MSG_EQ (route->GetOutputDevice (), ipv4->GetNetDevice (entry.GetInterface ()),
+                                 "Wrong device to " << *it);
+        }
+    }
+}
+
+void
+Ipv4StaticRoutingLongestPrefixMatchTestCase::DoRun (void)
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  SimpleNetDeviceHelper devHelper;
+  NetDeviceContainer devs = devHelper.Install (NodeContainer (node, node, node));
+  InternetStackHelper internet;
+  internet.Install (node);
+  Ipv4AddressHelper ipv4Helper;
+  ipv4Helper.SetBase ("172.16.0.0", "255.255.255.0");
+  for (uint32_t i = 0; i < devs.GetN (); i++)
+    {
+      ipv4Helper.Assign (NetDeviceContainer (devs.Get (i)));
+      ipv4Helper.NewNetwork ();
+    }
+  Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
+  Ipv4StaticRoutingHelper routingHelper;
+  Ptr<Ipv4StaticRouting> routing = routingHelper.GetStaticRouting (ipv4);
+
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  rng->SetStream (1);
+  uint16_t prefixes[] = {0, 8, 12, 16, 20, 24, 28, 31, 32};
+
+  // overlapping routes, with duplicated prefixes of different metrics
+  for (uint32_t r = 0; r < 300; r++)
+    {
+      uint32_t masklen = prefixes[rng->GetInteger (0, sizeof (prefixes) / sizeof (prefixes[0]) - 1)];
+      uint32_t network = 0x0a000000 | (rng->GetInteger (0, 3) << 16) | (rng->GetInteger (0, 3) << 8) | rng->GetInteger (0, 7);
+      uint32_t mask = masklen == 0 ? 0 : 0xffffffff << (32 - masklen);
+      uint32_t interface = rng->GetInteger (1, 3);
+      Ipv4Address gateway (0xac100000 | ((interface - 1) << 8) | rng->GetInteger (2, 254));
+      routing->AddNetworkRouteTo (Ipv4Address (network & mask), Ipv4Mask (mask), gateway, interface,
+                                  rng->GetInteger (0, 3));
+    }
+
+  std::vector<Ipv4Address> dests;
+  for (uint32_t d = 0; d < 500; d++)
+    {
+      dests.push_back (Ipv4Address (0x0a000000 | (rng->GetInteger (0, 4) << 16) | (rng->GetInteger (0, 4) << 8) | rng->GetInteger (0, 9)));
+    }
+  dests.push_back (Ipv4Address ("172.16.1.1"));
+  dests.push_back (Ipv4Address ("192.168.0.1"));
+  CheckRoutes (ipv4, routing, dests);
+
+  // the trie and the cache follow the changes of the table
+  for (uint32_t r = 0; r < 100; r++)
+    {
+      routing->RemoveRoute (rng->GetInteger (0, routing->GetNRoutes () - 1));
+    }
+  CheckRoutes (ipv4, routing, dests);
+  routing->AddHostRouteTo (Ipv4Address ("192.168.0.1"), Ipv4Address ("172.16.2.2"), 3, 5);
+  routing->AddHostRouteTo (Ipv4Address ("192.168.0.1"), Ipv4Address ("172.16.0.2"), 1, 1);
+  CheckRoutes (ipv4, routing, dests);
+
+  Simulator::Destroy ();
+}
+
 /**
  * \ingroup internet-test
  * \ingroup tests
@@ -217,6 +378,7 @@ Ipv4StaticRoutingTestSuite::Ipv4StaticRoutingTestSuite ()
   : TestSuite ("ipv4-static-routing", UNIT)
 {
   AddTestCase (new Ipv4StaticRoutingSlash32TestCase, TestCase::QUICK);
+  AddTestCase (new Ipv4StaticRoutingLongestPrefixMatchTestCase, TestCase::QUICK);
 }
 
 static Ipv4StaticRoutingTestSuite ipv4StaticRoutingTestSuite; //!< Static variable for test initialization
@@ -45,6 +45,7 @@
 #include <ns3/ff-mac-scheduler.h>
 #include <ns3/lte-ffr-algorithm.h>
 #include <ns3/lte-handover-algorithm.h>
+#include <ns3/a3-rsrp-table-handover-algorithm.h>
 #include <ns3/lte-enb-component-carrier-manager.h>
 #include <ns3/lte-ue-component-carrier-manager.h>
 #include <ns3/lte-anr.h>
@@ -65,6 +66,7 @@
 #include <ns3/epc-x2.h>
 #include <ns3/object-map.h>
 #include <ns3/object-factory.h>
+#include <ns3/enum.h>
 #include <ns3/channel-condition-model.h>//0501
 
 namespace ns3 {
@@ -84,6 +86,7 @@ LteHelper::LteHelper (void)
   m_ueNetDeviceFactory.SetTypeId (LteUeNetDevice::GetTypeId ());
   m_ueAntennaModelFactory.SetTypeId (IsotropicAntennaModel::GetTypeId ());
   m_channelFactory.SetTypeId (MultiModelSpectrumChannel::GetTypeId ());
+  m_cellIndividualOffsetTable = CreateObject<CellIndividualOffset> ();
 }
 
 void 
@@ -205,6 +208,7 @@ LteHelper::DoDispose ()
   NS_LOG_FUNCTION (this);
   m_downlinkChannel = 0;
   m_uplinkChannel = 0;
+  m_cellIndividualOffsetTable = 0;
   m_componentCarrierPhyParams.clear();
   Object::DoDispose ();
 }
@@ -221,6 +225,12 @@ LteHelper::GetDownlinkSpectrumChannel (void) const
   return m_downlinkChannel;
 }
 
+Ptr<CellIndividualOffset>
+LteHelper::GetCellIndividualOffsetTable (void) const
+{
+  return m_cellIndividualOffsetTable;
+}
+
 void
 LteHelper::ChannelModelInitialization (void)
 {
@@ -692,6 +702,14 @@ LteHelper::InstallSingleEnbDevice (Ptr<Node> n, Ptr<MyGymEnv> son_server, int to
 
   rrc->SetLteHandoverManagementSapProvider (handoverAlgorithm->GetLteHandoverManagementSapProvider ());
   handoverAlgorithm->SetLteHandoverManagementSapUser (rrc->GetLteHandoverManagementSapUser ());
+  Ptr<A3RsrpTableHandoverAlgorithm> a3TableAlgorithm = DynamicCast<A3RsrpTableHandoverAlgorithm> (handoverAlgorithm);
+  if (a3TableAlgorithm != 0)
+    {
+      // the offset of the serving cell applies to the reports of its UEs
+      a3TableAlgorithm->SetCellId (cellId);
+      a3TableAlgorithm->SetCellIndividualOffsetTable (m_cellIndividualOffsetTable);
+    }
+  rrc->SetCellIndividualOffsetTable (m_cellIndividualOffsetTable);
  
   // This RRC attribute is used to connect each new RLC instance with the MAC layer
   // (for function such as TransmitPdu, ReportBufferStatusReport).
@@ -955,6 +973,14 @@ LteHelper::InstallSingleEnbDevice (Ptr<Node> n,  int totalN)
 
   rrc->SetLteHandoverManagementSapProvider (handoverAlgorithm->GetLteHandoverManagementSapProvider ());
   handoverAlgorithm->SetLteHandoverManagementSapUser (rrc->GetLteHandoverManagementSapUser ());
+  Ptr<A3RsrpTableHandoverAlgorithm> a3TableAlgorithm = DynamicCast<A3RsrpTableHandoverAlgorithm> (handoverAlgorithm);
+  if (a3TableAlgorithm != 0)
+    {
+      // the offset of the serving cell applies to the reports of its UEs
+      a3TableAlgorithm->SetCellId (cellId);
+      a3TableAlgorithm->SetCellIndividualOffsetTable (m_cellIndividualOffsetTable);
+    }
+  rrc->SetCellIndividualOffsetTable (m_cellIndividualOffsetTable);
  
   // This RRC attribute is used to connect each new RLC instance with the MAC layer
   // (for function such as TransmitPdu, ReportBufferStatusReport).
@@ -1264,6 +1290,7 @@ LteHelper::InstallSingleUeDevice (Ptr<Node> n)
       ccPhy->GetDlSpectrumPhy ()->SetDevice (dev);
       ccPhy->GetDlSpectrumPhy ()->SetLtePhyRxDataEndOkCallback (MakeCallback (&LteUePhy::PhyPduReceived, ccPhy));
       ccPhy->GetDlSpectrumPhy ()->SetLtePhyRxCtrlEndOkCallback (MakeCallback (&LteUePhy::ReceiveLteControlMessageList, ccPhy));
+      ccPhy->GetDlSpectrumPhy ()->SetLtePhyRxDlCtrlEndOkCallback (MakeCallback (&LteUePhy::ReceiveLteControlMessageFrame, ccPhy));
       ccPhy->GetDlSpectrumPhy ()->SetLtePhyRxPssCallback (MakeCallback (&LteUePhy::ReceivePss, ccPhy));
       ccPhy->GetDlSpectrumPhy ()->SetLtePhyDlHarqFeedbackCallback (MakeCallback (&LteUePhy::EnqueueDlHarqFeedback, ccPhy));
     }
@@ -1463,6 +1490,7 @@ LteHelper::InstallSingleUeDevice (Ptr<Node> n, Ptr<MyGymEnv> son_server)
       ccPhy->GetDlSpectrumPhy ()->SetDevice (dev);
       ccPhy->GetDlSpectrumPhy ()->SetLtePhyRxDataEndOkCallback (MakeCallback (&LteUePhy::PhyPduReceived, ccPhy));
       ccPhy->GetDlSpectrumPhy ()->SetLtePhyRxCtrlEndOkCallback (MakeCallback (&LteUePhy::ReceiveLteControlMessageList, ccPhy));
+      ccPhy->GetDlSpectrumPhy ()->SetLtePhyRxDlCtrlEndOkCallback (MakeCallback (&LteUePhy::ReceiveLteControlMessageFrame, ccPhy));
       ccPhy->GetDlSpectrumPhy ()->SetLtePhyRxPssCallback (MakeCallback (&LteUePhy::ReceivePss, ccPhy));
       ccPhy->GetDlSpectrumPhy ()->SetLtePhyDlHarqFeedbackCallback (MakeCallback (&LteUePhy::EnqueueDlHarqFeedback, ccPhy));
     }
@@ -1718,6 +1746,11 @@ DrbActivator::ActivateDrb (uint64_t imsi, uint16_t cellId, uint16_t rnti)
       params.bearer = m_bearer;
       params.bearerId = 0;
       params.gtpTeid = 0; // don't care
+      // without EPC, the RLC of the bearer of the UE has to match the RLC
+      // created by the eNB, which depends on its mapping at this time
+      EnumValue mapping;
+      enbRrc->GetAttribute ("EpsBearerToRlcMapping", mapping);
+      ueRrc->SetUseRlcSm (mapping.Get () == LteEnbRrc::RLC_SM_ALWAYS);
       enbRrc->GetS1SapUser ()->DataRadioBearerSetupRequest (params);
       m_active = true;
     }
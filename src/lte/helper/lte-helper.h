@@ -41,6 +41,7 @@
 #include <ns3/mobility-model.h>
 #include <ns3/component-carrier-enb.h>
 #include <ns3/cc-helper.h>
+#include <ns3/cell-individual-offset.h>
 #include <ns3/mygym.h>
 #include <map>
 
@@ -687,6 +688,12 @@ public:
    */
   Ptr<SpectrumChannel> GetDownlinkSpectrumChannel (void) const;
 
+  /**
+   * \return the cell individual offsets of the cells installed by this
+   *         helper, shared by their eNodeB RRCs and handover algorithms
+   */
+  Ptr<CellIndividualOffset> GetCellIndividualOffsetTable (void) const;
+
 
 protected:
   // inherited from Object
@@ -753,6 +760,8 @@ private:
    * \brief This function create the component carrier based on provided configuration parameters
    */
 
+  /// The cell individual offsets of the cells installed by this helper.
+  Ptr<CellIndividualOffset> m_cellIndividualOffsetTable;
   /// The downlink LTE channel used in the simulation.
   Ptr<SpectrumChannel> m_downlinkChannel;
   /// The uplink LTE channel used in the simulation.
@@ -46,6 +46,38 @@ NS_LOG_COMPONENT_DEFINE ("NoBackhaulEpcHelper");
 NS_OBJECT_ENSURE_REGISTERED (NoBackhaulEpcHelper);
 
 
+/**
+ * Deliver a user-plane packet to an EPC application.
+ *
+ * \param recv the receive method of the EPC application
+ * \param packet the packet, without any GTP-U header
+ * \param teid the Tunnel Endpoint IDentifier of the packet
+ */
+static void
+IdealBackhaulReceive (Callback<void, Ptr<Packet>, uint32_t> recv,
+                      Ptr<Packet> packet, uint32_t teid)
+{
+  recv (packet, teid);
+}
+
+/**
+ * Hand a user-plane packet to an EPC application after the delay of an
+ * ideal backhaul interface.
+ *
+ * \param delay the delay of the interface
+ * \param nodeId the ID of the node of the peer EPC application
+ * \param recv the receive method of the peer EPC application
+ * \param packet the packet, without any GTP-U header
+ * \param teid the Tunnel Endpoint IDentifier of the packet
+ */
+static void
+IdealBackhaulSend (Time delay, uint32_t nodeId, Callback<void, Ptr<Packet>, uint32_t> recv,
+                   Ptr<Packet> packet, uint32_t teid)
+{
+  Simulator::ScheduleWithContext (nodeId, delay, &IdealBackhaulReceive, recv, packet, teid);
+}
+
+
 NoBackhaulEpcHelper::NoBackhaulEpcHelper () 
   : m_gtpuUdpPort (2152),  // fixed by the standard
     m_s11LinkDataRate (DataRate ("10Gb/s")),
@@ -54,7 +86,9 @@ NoBackhaulEpcHelper::NoBackhaulEpcHelper ()
     m_gtpcUdpPort (2123),  // fixed by the standard
     m_s5LinkDataRate (DataRate ("10Gb/s")),
     m_s5LinkDelay (Seconds (0)),
-    m_s5LinkMtu (3000)
+    m_s5LinkMtu (3000),
+    m_idealBackhaul (false),
+    m_idealX2 (false)
 {
   NS_LOG_FUNCTION (this);
   // To access the attribute value within the constructor
@@ -176,6 +210,15 @@ NoBackhaulEpcHelper::NoBackhaulEpcHelper ()
   m_sgwApp->AddPgw (pgwS5Address);
   m_pgwApp->AddSgw (sgwS5Address);
 
+  if (m_idealBackhaul)
+    {
+      NS_LOG_INFO ("Connect the S5 user plane directly");
+      m_sgwApp->SetS5uDirectPath (MakeBoundCallback (&IdealBackhaulSend, m_idealS5uDelay, m_pgw->GetId (),
+                                                     MakeCallback (&EpcPgwApplication::RecvFromS5u, m_pgwApp)));
+      m_pgwApp->SetS5uDirectPath (MakeBoundCallback (&IdealBackhaulSend, m_idealS5uDelay, m_sgw->GetId (),
+                                                     MakeCallback (&EpcSgwApplication::RecvFromS5u, m_sgwApp)));
+    }
+
 
   // Create S11 link between MME and SGW
   PointToPointHelper s11P2ph;
@@ -281,6 +324,32 @@ NoBackhaulEpcHelper::GetTypeId (void)
                    BooleanValue (false),
                    MakeBooleanAccessor (&NoBackhaulEpcHelper::m_x2LinkEnablePcap),
                    MakeBooleanChecker ())
+    .AddAttribute ("IdealBackhaul",
+                   "If true, the user-plane packets are handed directly between the "
+                   "EPC applications of the eNBs, SGW and PGW instead of being "
+                   "tunneled over GTP-U/UDP/IP on the S1-U and S5 interfaces",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&NoBackhaulEpcHelper::m_idealBackhaul),
+                   MakeBooleanChecker ())
+    .AddAttribute ("IdealS1uDelay",
+                   "The delay of the user-plane packets on the S1-U interface, "
+                   "when IdealBackhaul is enabled",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&NoBackhaulEpcHelper::m_idealS1uDelay),
+                   MakeTimeChecker ())
+    .AddAttribute ("IdealS5uDelay",
+                   "The delay of the user-plane packets on the S5 interface, "
+                   "when IdealBackhaul is enabled",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&NoBackhaulEpcHelper::m_idealS5uDelay),
+                   MakeTimeChecker ())
+    .AddAttribute ("IdealX2",
+                   "If true, the X2 messages are handed directly between the EpcX2 "
+                   "entities of the eNBs, after the X2LinkDelay delay, instead of "
+                   "being serialized and sent over a PointToPoint link",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&NoBackhaulEpcHelper::m_idealX2),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -365,6 +434,14 @@ NoBackhaulEpcHelper::AddX2Interface (Ptr<Node> enb1, Ptr<Node> enb2)
 {
   NS_LOG_FUNCTION (this << enb1 << enb2);
 
+  if (m_idealX2)
+    {
+      // No link nor address, the messages are delivered by DoAddX2Interface
+      DoAddX2Interface (enb1->GetObject<EpcX2> (), enb1->GetDevice (0), Ipv4Address (),
+                        enb2->GetObject<EpcX2> (), enb2->GetDevice (0), Ipv4Address ());
+      return;
+    }
+
   // Create a point to point link between the two eNBs with
   // the corresponding new NetDevices on each side
   PointToPointHelper p2ph;
@@ -418,8 +495,16 @@ NoBackhaulEpcHelper::DoAddX2Interface (const Ptr<EpcX2> &enb1X2, const Ptr<NetDe
   NS_LOG_LOGIC ("LteEnbNetDevice #1 = " << enb1LteDev << " - CellId = " << enb1CellId);
   NS_LOG_LOGIC ("LteEnbNetDevice #2 = " << enb2LteDev << " - CellId = " << enb2CellId);
 
-  enb1X2->AddX2Interface (enb1CellId, enb1X2Address, enb2CellId, enb2X2Address);
-  enb2X2->AddX2Interface (enb2CellId, enb2X2Address, enb1CellId, enb1X2Address);
+  if (m_idealX2)
+    {
+      enb1X2->AddIdealX2Interface (enb1CellId, enb2CellId, enb2X2, m_x2LinkDelay);
+      enb2X2->AddIdealX2Interface (enb2CellId, enb1CellId, enb1X2, m_x2LinkDelay);
+    }
+  else
+    {
+      enb1X2->AddX2Interface (enb1CellId, enb1X2Address, enb2CellId, enb2X2Address);
+      enb2X2->AddX2Interface (enb2CellId, enb2X2Address, enb1CellId, enb1X2Address);
+    }
 
   enb1LteDevice->GetRrc ()->AddX2Neighbour (enb2CellId);
   enb2LteDevice->GetRrc ()->AddX2Neighbour (enb1CellId);
@@ -565,6 +650,16 @@ NoBackhaulEpcHelper::AddS1Interface (Ptr<Node> enb, Ipv4Address enbAddress, Ipv4
   m_mmeApp->AddEnb (cellId, enbAddress, enbApp->GetS1apSapEnb ());
   m_sgwApp->AddEnb (cellId, enbAddress, sgwAddress);
   enbApp->SetS1apSapMme (m_mmeApp->GetS1apSapMme ());
+
+  if (m_idealBackhaul)
+    {
+      NS_LOG_INFO ("Connect the S1-U user plane directly");
+      enbApp->SetS1uDirectPath (MakeBoundCallback (&IdealBackhaulSend, m_idealS1uDelay, m_sgw->GetId (),
+                                                   MakeCallback (&EpcSgwApplication::RecvFromS1u, m_sgwApp)));
+      m_sgwApp->AddS1uDirectPath (enbAddress,
+                                  MakeBoundCallback (&IdealBackhaulSend, m_idealS1uDelay, enb->GetId (),
+                                                     MakeCallback (&EpcEnbApplication::RecvFromS1u, enbApp)));
+    }
 }
 
 } // namespace ns3
@@ -42,6 +42,19 @@ class EpcMmeApplication;
  * You have to build your own backhaul network in the simulation program.
  * Or you can use PointToPointEpcHelper or CsmaEpcHelper
  * (instead of this NoBackhaulEpcHelper) to use reference backhaul networks.
+ *
+ * With the IdealBackhaul attribute, the user-plane packets are handed
+ * directly between the EPC applications of the eNBs, SGW and PGW, after
+ * the IdealS1uDelay and IdealS5uDelay delays, instead of being tunneled
+ * over GTP-U/UDP/IP on the S1-U and S5 links. The control plane, and the
+ * TEID bookkeeping of the EPC applications, are unchanged. Since the S5
+ * interface is set up by the constructor, this attribute and the S5
+ * delay must be set with Config::SetDefault.
+ *
+ * Likewise, with the IdealX2 attribute, AddX2Interface does not create
+ * any link: the X2 messages are handed directly between the EpcX2
+ * entities of the eNBs after the X2LinkDelay delay, as the ideal RRC
+ * protocol does for the RRC messages.
  */
 class NoBackhaulEpcHelper : public EpcHelper
 {
@@ -209,6 +222,26 @@ private:
    */
   std::map<uint64_t, Ptr<NetDevice> > m_imsiEnbDeviceMap;
 
+  /**
+   * Hand the user-plane packets directly between the EPC applications
+   */
+  bool m_idealBackhaul;
+
+  /**
+   * The delay of the user-plane packets on the ideal S1-U interface
+   */
+  Time m_idealS1uDelay;
+
+  /**
+   * The delay of the user-plane packets on the ideal S5 interface
+   */
+  Time m_idealS5uDelay;
+
+  /**
+   * Whether the X2 messages bypass the X2 links
+   */
+  bool m_idealX2;
+
   /**
    * helper to assign addresses to X2 NetDevices
    */
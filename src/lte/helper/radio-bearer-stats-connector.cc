@@ -20,6 +20,17 @@
  */
 
 #include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/pointer.h"
+#include "ns3/object-map.h"
+#include "ns3/lte-enb-net-device.h"
+#include "ns3/lte-ue-net-device.h"
+#include "ns3/lte-enb-rrc.h"
+#include "ns3/lte-ue-rrc.h"
+#include "ns3/lte-radio-bearer-info.h"
+#include "ns3/lte-rlc.h"
+#include "ns3/lte-pdcp.h"
 #include "radio-bearer-stats-calculator.h"
 #include "radio-bearer-stats-connector.h"
 
@@ -27,15 +38,6 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("RadioBearerStatsConnector");
 
-/**
-  * Less than operator for CellIdRnti, because it is used as key in map
-  */
-bool
-operator < (const RadioBearerStatsConnector::CellIdRnti& a, const RadioBearerStatsConnector::CellIdRnti& b)
-{
-  return ( (a.cellId < b.cellId) || ( (a.cellId == b.cellId) && (a.rnti < b.rnti) ) );
-}
-
 /**
  * This structure is used as interface between trace
  * sources and RadioBearerStatsCalculator. It stores
@@ -53,69 +55,107 @@ public:
 /**
  * Callback function for DL TX statistics for both RLC and PDCP
  * \param arg
- * \param path
  * \param rnti
  * \param lcid
  * \param packetSize
  */
 void
-DlTxPduCallback (Ptr<BoundCallbackArgument> arg, std::string path,
+DlTxPduCallback (Ptr<BoundCallbackArgument> arg,
                  uint16_t rnti, uint8_t lcid, uint32_t packetSize)
 {
-  NS_LOG_FUNCTION (path << rnti << (uint16_t)lcid << packetSize);
+  NS_LOG_FUNCTION (arg->cellId << rnti << (uint16_t)lcid << packetSize);
   arg->stats->DlTxPdu (arg->cellId, arg->imsi, rnti, lcid, packetSize);
 }
 
 /**
  * Callback function for DL RX statistics for both RLC and PDCP
  * \param arg
- * \param path
  * \param rnti
  * \param lcid
  * \param packetSize
  * \param delay
  */
 void
-DlRxPduCallback (Ptr<BoundCallbackArgument> arg, std::string path,
+DlRxPduCallback (Ptr<BoundCallbackArgument> arg,
                  uint16_t rnti, uint8_t lcid, uint32_t packetSize, uint64_t delay)
 {
-  NS_LOG_FUNCTION (path << rnti << (uint16_t)lcid << packetSize << delay);
+  NS_LOG_FUNCTION (arg->cellId << rnti << (uint16_t)lcid << packetSize << delay);
   arg->stats->DlRxPdu (arg->cellId, arg->imsi, rnti, lcid, packetSize, delay);
 }
 
 /**
  * Callback function for UL TX statistics for both RLC and PDCP
  * \param arg
- * \param path
  * \param rnti
  * \param lcid
  * \param packetSize
  */
 void
-UlTxPduCallback (Ptr<BoundCallbackArgument> arg, std::string path,
+UlTxPduCallback (Ptr<BoundCallbackArgument> arg,
                  uint16_t rnti, uint8_t lcid, uint32_t packetSize)
 {
-  NS_LOG_FUNCTION (path << rnti << (uint16_t)lcid << packetSize);
+  NS_LOG_FUNCTION (arg->cellId << rnti << (uint16_t)lcid << packetSize);
   arg->stats->UlTxPdu (arg->cellId, arg->imsi, rnti, lcid, packetSize);
 }
 
 /**
  * Callback function for UL RX statistics for both RLC and PDCP
  * \param arg
- * \param path
  * \param rnti
  * \param lcid
  * \param packetSize
  * \param delay
  */
 void
-UlRxPduCallback (Ptr<BoundCallbackArgument> arg, std::string path,
+UlRxPduCallback (Ptr<BoundCallbackArgument> arg,
                  uint16_t rnti, uint8_t lcid, uint32_t packetSize, uint64_t delay)
 {
-  NS_LOG_FUNCTION (path << rnti << (uint16_t)lcid << packetSize << delay);
+  NS_LOG_FUNCTION (arg->cellId << rnti << (uint16_t)lcid << packetSize << delay);
   arg->stats->UlRxPdu (arg->cellId, arg->imsi, rnti, lcid, packetSize, delay);
 }
 
+/**
+ * Get a signaling radio bearer of a UE RRC or of a UE manager.
+ * \param rrc the LteUeRrc or UeManager
+ * \param name the name of the bearer attribute, "Srb0" or "Srb1"
+ * \return the bearer
+ */
+static Ptr<LteRadioBearerInfo>
+GetSignalingRadioBearer (Ptr<Object> rrc, std::string name)
+{
+  PointerValue bearer;
+  rrc->GetAttribute (name, bearer);
+  return bearer.Get<LteRadioBearerInfo> ();
+}
+
+/**
+ * Get a data radio bearer of a UE RRC or of a UE manager.
+ * \param rrc the LteUeRrc or UeManager
+ * \param key the key of the bearer in the DataRadioBearerMap attribute
+ * \return the bearer, or 0 if none
+ */
+static Ptr<LteRadioBearerInfo>
+GetDataRadioBearer (Ptr<Object> rrc, uint8_t key)
+{
+  ObjectMapValue bearers;
+  rrc->GetAttribute ("DataRadioBearerMap", bearers);
+  Ptr<Object> bearer = bearers.Get (key);
+  return bearer == 0 ? 0 : bearer->GetObject<LteRadioBearerInfo> ();
+}
+
+/**
+ * Connect the TxPDU and RxPDU trace sources of an RLC or PDCP entity.
+ * \param entity the LteRlc or LtePdcp
+ * \param txSink the sink of the TxPDU trace source
+ * \param rxSink the sink of the RxPDU trace source
+ */
+static void
+ConnectPduTraces (Ptr<Object> entity, const CallbackBase &txSink, const CallbackBase &rxSink)
+{
+  entity->TraceConnectWithoutContext ("TxPDU", txSink);
+  entity->TraceConnectWithoutContext ("RxPDU", rxSink);
+}
+
 
 RadioBearerStatsConnector::RadioBearerStatsConnector ()
   : m_connected (false)
@@ -142,130 +182,131 @@ RadioBearerStatsConnector::EnsureConnected ()
   NS_LOG_FUNCTION (this);
   if (!m_connected)
     {
-      Config::Connect ("/NodeList/*/DeviceList/*/LteEnbRrc/NewUeContext",
-                       MakeBoundCallback (&RadioBearerStatsConnector::NotifyNewUeContextEnb, this));
-
-      Config::Connect ("/NodeList/*/DeviceList/*/LteUeRrc/RandomAccessSuccessful",
-                       MakeBoundCallback (&RadioBearerStatsConnector::NotifyRandomAccessSuccessfulUe, this));
-
-      Config::Connect ("/NodeList/*/DeviceList/*/LteUeRrc/Srb1Created",
-                       MakeBoundCallback (&RadioBearerStatsConnector::CreatedSrb1Ue, this));
-
-      Config::Connect ("/NodeList/*/DeviceList/*/LteUeRrc/DrbCreated",
-                       MakeBoundCallback (&RadioBearerStatsConnector::CreatedDrbUe, this));
+      // the RRCs are bound to the sinks, which then reach the bearers
+      // through them instead of resolving configuration paths
+      for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); ++node)
+        {
+          for (uint32_t i = 0; i < (*node)->GetNDevices (); ++i)
+            {
+              Ptr<NetDevice> device = (*node)->GetDevice (i);
+              Ptr<LteEnbNetDevice> enbDevice = DynamicCast<LteEnbNetDevice> (device);
+              if (enbDevice != 0)
+                {
+                  LteEnbRrc *enbRrc = PeekPointer (enbDevice->GetRrc ());
+                  enbRrc->TraceConnectWithoutContext ("NewUeContext",
+                                                      MakeBoundCallback (&RadioBearerStatsConnector::NotifyNewUeContextEnb, this, enbRrc));
+                }
+              Ptr<LteUeNetDevice> ueDevice = DynamicCast<LteUeNetDevice> (device);
+              if (ueDevice != 0)
+                {
+                  LteUeRrc *ueRrc = PeekPointer (ueDevice->GetRrc ());
+                  ueRrc->TraceConnectWithoutContext ("RandomAccessSuccessful",
+                                                     MakeBoundCallback (&RadioBearerStatsConnector::NotifyRandomAccessSuccessfulUe, this, ueRrc));
+                  ueRrc->TraceConnectWithoutContext ("Srb1Created",
+                                                     MakeBoundCallback (&RadioBearerStatsConnector::CreatedSrb1Ue, this, ueRrc));
+                  ueRrc->TraceConnectWithoutContext ("DrbCreated",
+                                                     MakeBoundCallback (&RadioBearerStatsConnector::CreatedDrbUe, this, ueRrc));
+                }
+            }
+        }
 
       m_connected = true;
     }
 }
 
 void
-RadioBearerStatsConnector::StoreUeManagerPath (std::string context, uint16_t cellId, uint16_t rnti)
+RadioBearerStatsConnector::StoreEnbRrc (LteEnbRrc *enbRrc, uint16_t cellId, uint16_t rnti)
 {
-  NS_LOG_FUNCTION (this << context << cellId << rnti);
-  std::string ueManagerPath;
-  ueManagerPath = context.substr (0, context.rfind ("/")) + "/UeMap/" + std::to_string (rnti);
-  NS_LOG_DEBUG ("ueManagerPath = " << ueManagerPath);
-  CellIdRnti key;
-  key.cellId = cellId;
-  key.rnti = rnti;
-  m_ueManagerPathByCellIdRnti[key] = ueManagerPath;
-
-  Config::Connect (ueManagerPath + "/DrbCreated",
-                   MakeBoundCallback (&RadioBearerStatsConnector::CreatedDrbEnb, this));
+  NS_LOG_FUNCTION (this << enbRrc << cellId << rnti);
+  m_enbRrcByCellId[cellId] = enbRrc;
+
+  Ptr<UeManager> ueManager = enbRrc->GetUeManager (rnti);
+  ueManager->TraceConnectWithoutContext ("DrbCreated",
+                                         MakeBoundCallback (&RadioBearerStatsConnector::CreatedDrbEnb, this, PeekPointer (ueManager)));
+}
+
+Ptr<UeManager>
+RadioBearerStatsConnector::GetUeManager (uint16_t cellId, uint16_t rnti) const
+{
+  std::map<uint16_t, Ptr<LteEnbRrc> >::const_iterator it = m_enbRrcByCellId.find (cellId);
+  NS_ASSERT (it != m_enbRrcByCellId.end ());
+  return it->second->GetUeManager (rnti);
 }
 
 void
-RadioBearerStatsConnector::NotifyNewUeContextEnb (RadioBearerStatsConnector* c, std::string context, uint16_t cellId, uint16_t rnti)
+RadioBearerStatsConnector::NotifyNewUeContextEnb (RadioBearerStatsConnector* c, LteEnbRrc* enbRrc, uint16_t cellId, uint16_t rnti)
 {
-  NS_LOG_FUNCTION (c << context << cellId << rnti);
-  c->StoreUeManagerPath (context, cellId, rnti);
+  NS_LOG_FUNCTION (c << enbRrc << cellId << rnti);
+  c->StoreEnbRrc (enbRrc, cellId, rnti);
 }
 
 void
-RadioBearerStatsConnector::NotifyRandomAccessSuccessfulUe (RadioBearerStatsConnector* c, std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
+RadioBearerStatsConnector::NotifyRandomAccessSuccessfulUe (RadioBearerStatsConnector* c, LteUeRrc* ueRrc, uint64_t imsi, uint16_t cellId, uint16_t rnti)
 {
-  NS_LOG_FUNCTION (c << context << imsi << cellId << rnti);
-  c->ConnectTracesSrb0 (context, imsi, cellId, rnti);
+  NS_LOG_FUNCTION (c << ueRrc << imsi << cellId << rnti);
+  c->ConnectTracesSrb0 (ueRrc, imsi, cellId, rnti);
 }
 
 void
-RadioBearerStatsConnector::CreatedDrbEnb (RadioBearerStatsConnector* c, std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti, uint8_t lcid)
+RadioBearerStatsConnector::CreatedDrbEnb (RadioBearerStatsConnector* c, UeManager* ueManager, uint64_t imsi, uint16_t cellId, uint16_t rnti, uint8_t lcid)
 {
-  NS_LOG_FUNCTION (c << context << imsi << cellId << rnti << (uint16_t)lcid);
-  c->ConnectTracesDrbEnb (context, imsi, cellId, rnti, lcid);
+  NS_LOG_FUNCTION (c << ueManager << imsi << cellId << rnti << (uint16_t)lcid);
+  c->ConnectTracesDrbEnb (ueManager, imsi, cellId, rnti, lcid);
 }
 
 void
-RadioBearerStatsConnector::CreatedSrb1Ue (RadioBearerStatsConnector* c, std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
+RadioBearerStatsConnector::CreatedSrb1Ue (RadioBearerStatsConnector* c, LteUeRrc* ueRrc, uint64_t imsi, uint16_t cellId, uint16_t rnti)
 {
-  NS_LOG_FUNCTION (c << context << imsi << cellId << rnti);
-  c->ConnectTracesSrb1 (context, imsi, cellId, rnti);
+  NS_LOG_FUNCTION (c << ueRrc << imsi << cellId << rnti);
+  c->ConnectTracesSrb1 (ueRrc, imsi, cellId, rnti);
 }
 
 void
-RadioBearerStatsConnector::CreatedDrbUe (RadioBearerStatsConnector* c, std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti, uint8_t lcid)
+RadioBearerStatsConnector::CreatedDrbUe (RadioBearerStatsConnector* c, LteUeRrc* ueRrc, uint64_t imsi, uint16_t cellId, uint16_t rnti, uint8_t lcid)
 {
-  NS_LOG_FUNCTION (c << context << imsi << cellId << rnti << (uint16_t)lcid);
-  c->ConnectTracesDrbUe (context, imsi, cellId, rnti, lcid);
+  NS_LOG_FUNCTION (c << ueRrc << imsi << cellId << rnti << (uint16_t)lcid);
+  c->ConnectTracesDrbUe (ueRrc, imsi, cellId, rnti, lcid);
 }
 
 void
-RadioBearerStatsConnector::ConnectTracesSrb0 (std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
+RadioBearerStatsConnector::ConnectTracesSrb0 (LteUeRrc *ueRrc, uint64_t imsi, uint16_t cellId, uint16_t rnti)
 {
-  NS_LOG_FUNCTION (this << context << imsi << cellId << rnti);
-  std::string ueRrcPath = context.substr (0, context.rfind ("/"));
-  NS_LOG_LOGIC ("ueRrcPath = " << ueRrcPath);
-  CellIdRnti key;
-  key.cellId = cellId;
-  key.rnti = rnti;
-  std::map<CellIdRnti, std::string>::iterator it = m_ueManagerPathByCellIdRnti.find (key);
-  NS_ASSERT (it != m_ueManagerPathByCellIdRnti.end ());
-  std::string ueManagerPath = it->second;
-  NS_LOG_LOGIC ("ueManagerPath = " << ueManagerPath);
+  NS_LOG_FUNCTION (this << ueRrc << imsi << cellId << rnti);
+  Ptr<UeManager> ueManager = GetUeManager (cellId, rnti);
   if (m_rlcStats)
     {
       Ptr<BoundCallbackArgument> arg = Create<BoundCallbackArgument> ();
       arg->imsi = imsi;
       arg->cellId = cellId;
       arg->stats = m_rlcStats;
-      Config::Connect (ueRrcPath + "/Srb0/LteRlc/TxPDU",
-                       MakeBoundCallback (&UlTxPduCallback, arg));
-      Config::Connect (ueRrcPath + "/Srb0/LteRlc/RxPDU",
-                       MakeBoundCallback (&DlRxPduCallback, arg));
-      Config::Connect (ueManagerPath + "/Srb0/LteRlc/TxPDU",
-                       MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Connect (ueManagerPath + "/Srb0/LteRlc/RxPDU",
-                       MakeBoundCallback (&UlRxPduCallback, arg));
+      ConnectPduTraces (GetSignalingRadioBearer (ueRrc, "Srb0")->m_rlc,
+                        MakeBoundCallback (&UlTxPduCallback, arg),
+                        MakeBoundCallback (&DlRxPduCallback, arg));
+      ConnectPduTraces (GetSignalingRadioBearer (ueManager, "Srb0")->m_rlc,
+                        MakeBoundCallback (&DlTxPduCallback, arg),
+                        MakeBoundCallback (&UlRxPduCallback, arg));
     }
 }
 
 void
-RadioBearerStatsConnector::ConnectTracesSrb1 (std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
+RadioBearerStatsConnector::ConnectTracesSrb1 (LteUeRrc *ueRrc, uint64_t imsi, uint16_t cellId, uint16_t rnti)
 {
-  NS_LOG_FUNCTION (this << context << imsi << cellId << rnti);
-  std::string ueRrcPath = context.substr (0, context.rfind ("/"));
-  NS_LOG_LOGIC ("ueRrcPath = " << ueRrcPath);
-  CellIdRnti key;
-  key.cellId = cellId;
-  key.rnti = rnti;
-  std::map<CellIdRnti, std::string>::iterator it = m_ueManagerPathByCellIdRnti.find (key);
-  NS_ASSERT (it != m_ueManagerPathByCellIdRnti.end ());
-  std::string ueManagerPath = it->second;
-  NS_LOG_LOGIC ("ueManagerPath = " << ueManagerPath);
+  NS_LOG_FUNCTION (this << ueRrc << imsi << cellId << rnti);
+  Ptr<UeManager> ueManager = GetUeManager (cellId, rnti);
+  Ptr<LteRadioBearerInfo> ueSrb1 = GetSignalingRadioBearer (ueRrc, "Srb1");
+  Ptr<LteRadioBearerInfo> enbSrb1 = GetSignalingRadioBearer (ueManager, "Srb1");
   if (m_rlcStats)
     {
       Ptr<BoundCallbackArgument> arg = Create<BoundCallbackArgument> ();
       arg->imsi = imsi;
       arg->cellId = cellId;
       arg->stats = m_rlcStats;
-      Config::Connect (ueRrcPath + "/Srb1/LteRlc/TxPDU",
-                       MakeBoundCallback (&UlTxPduCallback, arg));
-      Config::Connect (ueRrcPath + "/Srb1/LteRlc/RxPDU",
-                       MakeBoundCallback (&DlRxPduCallback, arg));
-      Config::Connect (ueManagerPath + "/Srb1/LteRlc/TxPDU",
-                       MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Connect (ueManagerPath + "/Srb1/LteRlc/RxPDU",
-                       MakeBoundCallback (&UlRxPduCallback, arg));
+      ConnectPduTraces (ueSrb1->m_rlc,
+                        MakeBoundCallback (&UlTxPduCallback, arg),
+                        MakeBoundCallback (&DlRxPduCallback, arg));
+      ConnectPduTraces (enbSrb1->m_rlc,
+                        MakeBoundCallback (&DlTxPduCallback, arg),
+                        MakeBoundCallback (&UlRxPduCallback, arg));
     }
   if (m_pdcpStats)
     {
@@ -273,35 +314,31 @@ RadioBearerStatsConnector::ConnectTracesSrb1 (std::string context, uint64_t imsi
       arg->imsi = imsi;
       arg->cellId = cellId;
       arg->stats = m_pdcpStats;
-      Config::Connect (ueRrcPath + "/Srb1/LtePdcp/TxPDU",
-                       MakeBoundCallback (&UlTxPduCallback, arg));
-      Config::Connect (ueRrcPath + "/Srb1/LtePdcp/RxPDU",
-                       MakeBoundCallback (&DlRxPduCallback, arg));
-      Config::Connect (ueManagerPath + "/Srb1/LtePdcp/TxPDU",
-                       MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Connect (ueManagerPath + "/Srb1/LtePdcp/RxPDU",
-                       MakeBoundCallback (&UlRxPduCallback, arg));
+      ConnectPduTraces (ueSrb1->m_pdcp,
+                        MakeBoundCallback (&UlTxPduCallback, arg),
+                        MakeBoundCallback (&DlRxPduCallback, arg));
+      ConnectPduTraces (enbSrb1->m_pdcp,
+                        MakeBoundCallback (&DlTxPduCallback, arg),
+                        MakeBoundCallback (&UlRxPduCallback, arg));
     }
 }
 
 void
-RadioBearerStatsConnector::ConnectTracesDrbEnb (std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti, uint8_t lcid)
+RadioBearerStatsConnector::ConnectTracesDrbEnb (UeManager *ueManager, uint64_t imsi, uint16_t cellId, uint16_t rnti, uint8_t lcid)
 {
-  NS_LOG_FUNCTION (this << context << imsi << cellId << rnti << (uint16_t)lcid);
-  NS_LOG_LOGIC ("expected context should match /NodeList/*/DeviceList/*/LteEnbRrc/");
-  std::string basePath;
-  basePath = context.substr (0, context.rfind ("/")) + "/DataRadioBearerMap/" + std::to_string (lcid - 2);
-  NS_LOG_LOGIC ("basePath = " << basePath);
+  NS_LOG_FUNCTION (this << ueManager << imsi << cellId << rnti << (uint16_t)lcid);
+  // the DRBs of the UE manager are indexed by DRBID
+  Ptr<LteRadioBearerInfo> drb = GetDataRadioBearer (ueManager, lcid - 2);
+  NS_ASSERT_MSG (drb != 0, "no DRB with LCID " << (uint16_t)lcid << " at the eNB");
   if (m_rlcStats)
     {
       Ptr<BoundCallbackArgument> arg = Create<BoundCallbackArgument> ();
       arg->imsi = imsi;
       arg->cellId = cellId;
       arg->stats = m_rlcStats;
-      Config::Connect (basePath + "/LteRlc/TxPDU",
-                       MakeBoundCallback (&DlTxPduCallback, arg));
-      Config::Connect (basePath + "/LteRlc/RxPDU",
-                       MakeBoundCallback (&UlRxPduCallback, arg));
+      ConnectPduTraces (drb->m_rlc,
+                        MakeBoundCallback (&DlTxPduCallback, arg),
+                        MakeBoundCallback (&UlRxPduCallback, arg));
     }
   if (m_pdcpStats)
     {
@@ -309,11 +346,13 @@ RadioBearerStatsConnector::ConnectTracesDrbEnb (std::string context, uint64_t im
       arg->imsi = imsi;
       arg->cellId = cellId;
       arg->stats = m_pdcpStats;
-      bool foundTxPdcp = Config::ConnectFailSafe (basePath + "/LtePdcp/TxPDU",
-                       MakeBoundCallback (&DlTxPduCallback, arg));
-      bool foundRxPdcp = Config::ConnectFailSafe (basePath + "/LtePdcp/RxPDU",
-                       MakeBoundCallback (&UlRxPduCallback, arg));
-      if (!foundTxPdcp && !foundRxPdcp)
+      if (drb->m_pdcp != 0)
+        {
+          ConnectPduTraces (drb->m_pdcp,
+                            MakeBoundCallback (&DlTxPduCallback, arg),
+                            MakeBoundCallback (&UlRxPduCallback, arg));
+        }
+      else
         {
           NS_LOG_WARN ("Unable to connect PDCP traces. This may happen if RlcSm is used");
         }
@@ -321,23 +360,20 @@ RadioBearerStatsConnector::ConnectTracesDrbEnb (std::string context, uint64_t im
 }
 
 void
-RadioBearerStatsConnector::ConnectTracesDrbUe (std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti, uint8_t lcid)
+RadioBearerStatsConnector::ConnectTracesDrbUe (LteUeRrc *ueRrc, uint64_t imsi, uint16_t cellId, uint16_t rnti, uint8_t lcid)
 {
-  NS_LOG_FUNCTION (this << context << imsi << cellId << rnti << (uint16_t)lcid);
-  NS_LOG_LOGIC ("expected context should match /NodeList/*/DeviceList/*/LteUeRrc/");
-  std::string basePath;
-  basePath = context.substr (0, context.rfind ("/")) + "/DataRadioBearerMap/" + std::to_string (lcid);
-  NS_LOG_LOGIC ("basePath = " << basePath);
+  NS_LOG_FUNCTION (this << ueRrc << imsi << cellId << rnti << (uint16_t)lcid);
+  Ptr<LteRadioBearerInfo> drb = GetDataRadioBearer (ueRrc, lcid);
+  NS_ASSERT_MSG (drb != 0, "no DRB " << (uint16_t)lcid << " at the UE");
   if (m_rlcStats)
     {
       Ptr<BoundCallbackArgument> arg = Create<BoundCallbackArgument> ();
       arg->imsi = imsi;
       arg->cellId = cellId;
       arg->stats = m_rlcStats;
-      Config::Connect (basePath + "/LteRlc/TxPDU",
-                       MakeBoundCallback (&UlTxPduCallback, arg));
-      Config::Connect (basePath + "/LteRlc/RxPDU",
-                       MakeBoundCallback (&DlRxPduCallback, arg));
+      ConnectPduTraces (drb->m_rlc,
+                        MakeBoundCallback (&UlTxPduCallback, arg),
+                        MakeBoundCallback (&DlRxPduCallback, arg));
     }
   if (m_pdcpStats)
     {
@@ -345,11 +381,13 @@ RadioBearerStatsConnector::ConnectTracesDrbUe (std::string context, uint64_t ims
       arg->imsi = imsi;
       arg->cellId = cellId;
       arg->stats = m_pdcpStats;
-      bool foundTxPdcp = Config::ConnectFailSafe (basePath + "/LtePdcp/TxPDU",
-                       MakeBoundCallback (&UlTxPduCallback, arg));
-      bool foundRxPdcp = Config::ConnectFailSafe (basePath + "/LtePdcp/RxPDU",
-                       MakeBoundCallback (&DlRxPduCallback, arg));
-      if (!foundTxPdcp && !foundRxPdcp)
+      if (drb->m_pdcp != 0)
+        {
+          ConnectPduTraces (drb->m_pdcp,
+                            MakeBoundCallback (&UlTxPduCallback, arg),
+                            MakeBoundCallback (&DlRxPduCallback, arg));
+        }
+      else
         {
           NS_LOG_WARN ("Unable to connect PDCP traces. This may happen if RlcSm is used");
         }
@@ -32,6 +32,9 @@
 namespace ns3 {
 
 class RadioBearerStatsCalculator;
+class LteEnbRrc;
+class LteUeRrc;
+class UeManager;
 
 /**
  * \ingroup lte
@@ -39,6 +42,10 @@ class RadioBearerStatsCalculator;
  * This class is very useful when user needs to collect
  * statistics from PDCP and RLC. It automatically connects
  * RadioBearerStatsCalculator to appropriate trace sinks.
+ * The RRC trace sources are connected once, to the eNB and UE
+ * devices existing when the statistics are enabled; the RLC and PDCP
+ * trace sources of each new bearer are then connected directly on the
+ * entities of the bearer, without resolving configuration paths.
  * Usually user does not use this class. All he/she needs
  * to do is to call: LteHelper::EnablePdcpTraces() and/or
  * LteHelper::EnableRlcTraces().
@@ -74,64 +81,64 @@ public:
   /**
    * Function hooked to NewUeContext trace source at eNB RRC,
    * which is fired upon creation of a new UE context.
-   * It stores the UE manager path and connects the callback that will be called
-   * when the DRB is created in the eNB.
+   * It stores the eNB RRC of the cell and connects the callback that will
+   * be called when the DRB is created in the eNB.
    * \param c
-   * \param context
+   * \param enbRrc the eNB RRC
    * \param cellid
    * \param rnti
    */
-  static void NotifyNewUeContextEnb (RadioBearerStatsConnector* c, std::string context, uint16_t cellid, uint16_t rnti);
+  static void NotifyNewUeContextEnb (RadioBearerStatsConnector* c, LteEnbRrc* enbRrc, uint16_t cellid, uint16_t rnti);
 
   /**
    * Function hooked to RandomAccessSuccessful trace source at UE RRC,
    * which is fired upon successful completion of the random access procedure.
    * It connects the callbacks for the SRB0 at the eNB and the UE.
    * \param c
-   * \param context
+   * \param ueRrc the UE RRC
    * \param imsi
    * \param cellid
    * \param rnti
    */
-  static void NotifyRandomAccessSuccessfulUe (RadioBearerStatsConnector* c, std::string context, uint64_t imsi, uint16_t cellid, uint16_t rnti);
+  static void NotifyRandomAccessSuccessfulUe (RadioBearerStatsConnector* c, LteUeRrc* ueRrc, uint64_t imsi, uint16_t cellid, uint16_t rnti);
 
   /**
    * Function hooked to Srb1Created trace source at UE RRC,
    * which is fired when SRB1 is created, i.e. RLC and PDCP are created for one LC = 1.
-   * It connects the callbacks for the DRB at the eNB.
+   * It connects the callbacks for the SRB1 at the eNB and the UE.
    * \param c
-   * \param context
+   * \param ueRrc the UE RRC
    * \param imsi
    * \param cellid
    * \param rnti
    */
-  static void CreatedSrb1Ue (RadioBearerStatsConnector* c, std::string context, uint64_t imsi, uint16_t cellid, uint16_t rnti);
+  static void CreatedSrb1Ue (RadioBearerStatsConnector* c, LteUeRrc* ueRrc, uint64_t imsi, uint16_t cellid, uint16_t rnti);
 
   /**
    * Function hooked to DrbCreated trace source at UE manager in eNB RRC,
    * which is fired when DRB is created, i.e. RLC and PDCP are created for LC = lcid.
    * It connects the callbacks for the DRB at the eNB.
    * \param c
-   * \param context
+   * \param ueManager the UE manager
    * \param imsi
    * \param cellid
    * \param rnti
    * \param lcid
    */
-  static void CreatedDrbEnb (RadioBearerStatsConnector* c, std::string context, uint64_t imsi, uint16_t cellid, uint16_t rnti, uint8_t lcid);
+  static void CreatedDrbEnb (RadioBearerStatsConnector* c, UeManager* ueManager, uint64_t imsi, uint16_t cellid, uint16_t rnti, uint8_t lcid);
 
   /**
    * Function hooked to DrbCreated trace source at UE RRC,
    * which is fired when DRB is created, i.e. RLC and PDCP are created for LC = lcid.
    * It connects the callbacks for the DRB at the UE.
    * \param c
-   * \param context
+   * \param ueRrc the UE RRC
    * \param imsi
    * \param cellid
    * \param rnti
    * \param lcid
    */
-  static void CreatedDrbUe (RadioBearerStatsConnector* c, std::string context, uint64_t imsi, uint16_t cellid, uint16_t rnti, uint8_t lcid);
+  static void CreatedDrbUe (RadioBearerStatsConnector* c, LteUeRrc* ueRrc, uint64_t imsi, uint16_t cellid, uint16_t rnti, uint8_t lcid);
 
   /**
    * Disconnects all trace sources at eNB to RLC and PDCP calculators.
@@ -156,50 +163,59 @@ public:
 
 private:
   /**
-   * Creates UE Manager path and stores it in m_ueManagerPathByCellIdRnti
-   * \param ueManagerPath
+   * Stores the eNB RRC of a cell in m_enbRrcByCellId and connects the
+   * DrbCreated trace source of the new UE manager
+   * \param enbRrc the eNB RRC
+   * \param cellId
+   * \param rnti
+   */
+  void StoreEnbRrc (LteEnbRrc *enbRrc, uint16_t cellId, uint16_t rnti);
+
+  /**
+   * Get the UE manager of a UE at the eNB RRC of a cell
    * \param cellId
    * \param rnti
+   * \return the UE manager
    */
-  void StoreUeManagerPath (std::string ueManagerPath, uint16_t cellId, uint16_t rnti);
+  Ptr<UeManager> GetUeManager (uint16_t cellId, uint16_t rnti) const;
 
   /**
    * Connects SRB0 trace sources at UE and eNB to RLC and PDCP calculators
-   * \param context
+   * \param ueRrc the UE RRC
    * \param imsi
    * \param cellId
    * \param rnti
    */
-  void ConnectTracesSrb0 (std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti);
+  void ConnectTracesSrb0 (LteUeRrc *ueRrc, uint64_t imsi, uint16_t cellId, uint16_t rnti);
 
   /**
    * Connects SRB1 trace sources at UE and eNB to RLC and PDCP calculators
-   * \param context
+   * \param ueRrc the UE RRC
    * \param imsi
    * \param cellId
    * \param rnti
    */
-  void ConnectTracesSrb1 (std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti);
+  void ConnectTracesSrb1 (LteUeRrc *ueRrc, uint64_t imsi, uint16_t cellId, uint16_t rnti);
 
   /**
    * Connects DRB trace sources at eNB to RLC and PDCP calculators
-   * \param context
+   * \param ueManager the UE manager
    * \param imsi
    * \param cellId
    * \param rnti
    * \param lcid
    */
-  void ConnectTracesDrbEnb (std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti, uint8_t lcid);
+  void ConnectTracesDrbEnb (UeManager *ueManager, uint64_t imsi, uint16_t cellId, uint16_t rnti, uint8_t lcid);
 
   /**
    * Connects DRB trace sources at UE to RLC and PDCP calculators
-   * \param context
+   * \param ueRrc the UE RRC
    * \param imsi
    * \param cellId
    * \param rnti
    * \param lcid
    */
-  void ConnectTracesDrbUe (std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti, uint8_t lcid);
+  void ConnectTracesDrbUe (LteUeRrc *ueRrc, uint64_t imsi, uint16_t cellId, uint16_t rnti, uint8_t lcid);
 
   Ptr<RadioBearerStatsCalculator> m_rlcStats; //!< Calculator for RLC Statistics
   Ptr<RadioBearerStatsCalculator> m_pdcpStats; //!< Calculator for PDCP Statistics
@@ -207,27 +223,9 @@ private:
   bool m_connected; //!< true if traces are connected to sinks, initially set to false
 
   /**
-   * Struct used as key in m_ueManagerPathByCellIdRnti map
-   */
-  struct CellIdRnti
-  {
-    uint16_t cellId; //!< Cell Id
-    uint16_t rnti; //!< RNTI
-  };
-
-  /**
-   * Less than operator for CellIdRnti, because it is used as key in map
-   *
-   * \param a the lhs operand
-   * \param b the rhs operand
-   * \returns true if less than
-   */
-  friend bool operator < (const CellIdRnti &a, const CellIdRnti &b);
-
-  /**
-   * List UE Manager Paths by CellIdRnti
+   * eNB RRCs by cell ID, of the cells where a UE context was created
    */
-  std::map<CellIdRnti, std::string> m_ueManagerPathByCellIdRnti;
+  std::map<uint16_t, Ptr<LteEnbRrc> > m_enbRrcByCellId;
 
 };
 
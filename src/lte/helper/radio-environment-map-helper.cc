@@ -36,10 +36,26 @@
 #include <ns3/simulator.h>
 #include <ns3/node.h>
 #include <ns3/buildings-helper.h>
+#include <ns3/building-list.h>
 #include <ns3/lte-spectrum-value-helper.h>
-
+#include <ns3/enum.h>
+#include <ns3/node-list.h>
+#include <ns3/lte-enb-net-device.h>
+#include <ns3/component-carrier-enb.h>
+#include <ns3/lte-enb-phy.h>
+#include <ns3/lte-spectrum-phy.h>
+#include <ns3/spectrum-converter.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/spectrum-propagation-loss-model.h>
+#include <ns3/antenna-model.h>
+#include <ns3/angles.h>
+#include <ns3/system-thread.h>
+
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <limits>
+#include <sstream>
 
 namespace ns3 {
 
@@ -47,6 +63,44 @@ NS_LOG_COMPONENT_DEFINE ("RadioEnvironmentMapHelper");
 
 NS_OBJECT_ENSURE_REGISTERED (RadioEnvironmentMapHelper);
 
+namespace {
+
+/**
+ * Check whether a file name has the ".npy" extension.
+ *
+ * \param filename the file name
+ * \return true if the map is to be saved in numpy format
+ */
+bool
+HasNpyExtension (const std::string &filename)
+{
+  return filename.size () >= 4
+         && filename.compare (filename.size () - 4, 4, ".npy") == 0;
+}
+
+/**
+ * Create a static copy of a mobility model at its current position,
+ * including its building information, if any.
+ *
+ * \param mobility the mobility model
+ * \return the copy
+ */
+Ptr<MobilityModel>
+CopyPosition (Ptr<MobilityModel> mobility)
+{
+  Ptr<MobilityModel> copy = CreateObject<ConstantPositionMobilityModel> ();
+  copy->SetPosition (mobility->GetPosition ());
+  if (mobility->GetObject<MobilityBuildingInfo> () != 0)
+    {
+      Ptr<MobilityBuildingInfo> buildingInfo = CreateObject<MobilityBuildingInfo> ();
+      copy->AggregateObject (buildingInfo);
+      buildingInfo->MakeConsistent (copy);
+    }
+  return copy;
+}
+
+} // unnamed namespace
+
 RadioEnvironmentMapHelper::RadioEnvironmentMapHelper ()
 {
 }
@@ -62,6 +116,11 @@ void
 RadioEnvironmentMapHelper::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
+  m_transmitters.clear ();
+  m_workerTxMobility.clear ();
+  m_workerRxMobility.clear ();
+  m_propagationLoss = 0;
+  m_spectrumLoss = 0;
 }
 
 TypeId
@@ -144,6 +203,20 @@ RadioEnvironmentMapHelper::GetTypeId (void)
                    IntegerValue (-1),
                    MakeIntegerAccessor (&RadioEnvironmentMapHelper::m_rbId),
                    MakeIntegerChecker<int32_t> ())
+    .AddAttribute ("Mode",
+                   "How the map is computed: by RemSpectrumPhy listeners attached to the "
+                   "channel, or analytically from the channel models",
+                   EnumValue (RadioEnvironmentMapHelper::EVENT_DRIVEN),
+                   MakeEnumAccessor (&RadioEnvironmentMapHelper::m_mode),
+                   MakeEnumChecker (RadioEnvironmentMapHelper::EVENT_DRIVEN, "EventDriven",
+                                    RadioEnvironmentMapHelper::ANALYTICAL, "Analytical"))
+    .AddAttribute ("Threads",
+                   "Number of threads computing the map in Analytical mode. "
+                   "More than one thread is used only if the propagation loss models of the "
+                   "channel are stateless (see IsThreadSafe).",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&RadioEnvironmentMapHelper::m_nThreads),
+                   MakeUintegerChecker<uint32_t> (1,std::numeric_limits<uint32_t>::max ()))
   ;
   return tid;
 }
@@ -181,7 +254,7 @@ void
 RadioEnvironmentMapHelper::Install ()
 {
   NS_LOG_FUNCTION (this);
-  if (!m_rem.empty ())
+  if (!m_rem.empty () || !m_sinr.empty ())
     {
       NS_FATAL_ERROR ("only one REM supported per instance of RadioEnvironmentMapHelper");
     }
@@ -193,7 +266,14 @@ RadioEnvironmentMapHelper::Install ()
   m_channel = match.Get (0)->GetObject<SpectrumChannel> ();
   NS_ABORT_MSG_IF (m_channel == 0, "object at " << m_channelPath << "is not of type SpectrumChannel");
 
-  m_outFile.open (m_outputFile.c_str ());
+  if (m_mode == ANALYTICAL && HasNpyExtension (m_outputFile))
+    {
+      m_outFile.open (m_outputFile.c_str (), std::ios::out | std::ios::binary);
+    }
+  else
+    {
+      m_outFile.open (m_outputFile.c_str ());
+    }
   if (!m_outFile.is_open ())
     {
       NS_FATAL_ERROR ("Can't open file " << (m_outputFile));
@@ -220,6 +300,13 @@ RadioEnvironmentMapHelper::DelayedInstall ()
   NS_LOG_FUNCTION (this);
   m_xStep = (m_xMax - m_xMin)/(m_xRes-1);
   m_yStep = (m_yMax - m_yMin)/(m_yRes-1);
+
+  if (m_mode == ANALYTICAL)
+    {
+      RunAnalytical ();
+      Finalize ();
+      return;
+    }
   
   if ((double)m_xRes * (double) m_yRes < (double) m_maxPointsPerIteration)
     {
@@ -352,5 +439,261 @@ RadioEnvironmentMapHelper::Finalize ()
     }
 }
 
+bool
+RadioEnvironmentMapHelper::IsThreadSafe (Ptr<PropagationLossModel> model)
+{
+  // models whose DoCalcRxPower only reads their attributes and the positions
+  static const char *stateless[] = {
+    "ns3::FriisPropagationLossModel",
+    "ns3::TwoRayGroundPropagationLossModel",
+    "ns3::LogDistancePropagationLossModel",
+    "ns3::ThreeLogDistancePropagationLossModel",
+    "ns3::FixedRssLossModel",
+    "ns3::RangePropagationLossModel",
+    "ns3::Cost231PropagationLossModel",
+    "ns3::OkumuraHataPropagationLossModel",
+    "ns3::ItuR1411LosPropagationLossModel",
+    "ns3::ItuR1411NlosOverRooftopPropagationLossModel",
+    "ns3::Kun2600MhzPropagationLossModel"
+  };
+  const char **end = stateless + sizeof (stateless) / sizeof (stateless[0]);
+  for (; model != 0; model = model->GetNext ())
+    {
+      std::string name = model->GetInstanceTypeId ().GetName ();
+      if (std::find (stateless, end, name) == end)
+        {
+          NS_LOG_LOGIC (name << " is not thread safe");
+          return false;
+        }
+    }
+  return true;
+}
+
+void
+RadioEnvironmentMapHelper::RunAnalytical ()
+{
+  NS_LOG_FUNCTION (this);
+  NS_ABORT_MSG_IF (m_useDataChannel, "UseDataChannel is not supported in Analytical mode");
+
+  // Same transmissions as received by RemSpectrumPhy: the full-bandwidth
+  // DL control frame of each eNB attached to the channel (see
+  // LteEnbPhy::SendControlChannels), converted to the spectrum model of
+  // the map as done by MultiModelSpectrumChannel.
+  Ptr<const SpectrumModel> remModel = LteSpectrumValueHelper::GetSpectrumModel (m_earfcn, m_bandwidth);
+  std::vector<Ptr<MobilityModel> > txMobility;
+  for (NodeList::Iterator nodeIt = NodeList::Begin (); nodeIt != NodeList::End (); ++nodeIt)
+    {
+      for (uint32_t i = 0; i < (*nodeIt)->GetNDevices (); ++i)
+        {
+          Ptr<LteEnbNetDevice> enbDev = DynamicCast<LteEnbNetDevice> ((*nodeIt)->GetDevice (i));
+          if (enbDev == 0)
+            {
+              continue;
+            }
+          std::map<uint8_t, Ptr<ComponentCarrierBaseStation> > ccMap = enbDev->GetCcMap ();
+          for (std::map<uint8_t, Ptr<ComponentCarrierBaseStation> >::iterator ccIt = ccMap.begin ();
+               ccIt != ccMap.end (); ++ccIt)
+            {
+              Ptr<ComponentCarrierEnb> cc = DynamicCast<ComponentCarrierEnb> (ccIt->second);
+              Ptr<LteSpectrumPhy> dlPhy = cc->GetPhy ()->GetDownlinkSpectrumPhy ();
+              if (dlPhy->GetChannel () != m_channel || dlPhy->GetMobility () == 0)
+                {
+                  continue;
+                }
+              std::vector<int> dlRb;
+              for (uint16_t rb = 0; rb < cc->GetDlBandwidth (); ++rb)
+                {
+                  dlRb.push_back (rb);
+                }
+              Ptr<SpectrumValue> psd = LteSpectrumValueHelper::CreateTxPowerSpectralDensity (cc->GetDlEarfcn (),
+                                                                                             cc->GetDlBandwidth (),
+                                                                                             cc->GetPhy ()->GetTxPower (),
+                                                                                             dlRb);
+              Ptr<const SpectrumModel> txModel = psd->GetSpectrumModel ();
+              if (txModel->GetUid () != remModel->GetUid ())
+                {
+                  if (txModel->IsOrthogonal (*remModel))
+                    {
+                      continue;
+                    }
+                  SpectrumConverter converter (txModel, remModel);
+                  psd = converter.Convert (psd);
+                }
+              RemTransmitter tx;
+              tx.antenna = dlPhy->GetRxAntenna ();
+              tx.psd = psd;
+              tx.power = (m_rbId >= 0) ? (*psd)[m_rbId] * 180000 : Integral (*psd);
+              m_transmitters.push_back (tx);
+              txMobility.push_back (dlPhy->GetMobility ());
+            }
+        }
+    }
+  NS_LOG_LOGIC ("found " << m_transmitters.size () << " transmitters");
+
+  m_propagationLoss = m_channel->GetPropagationLossModel ();
+  m_spectrumLoss = m_channel->GetSpectrumPropagationLossModel ();
+  DoubleValue maxLossDb;
+  m_channel->GetAttribute ("MaxLossDb", maxLossDb);
+  m_maxLossDb = maxLossDb.Get ();
+
+  // same grid points as the event-driven iterations
+  double x = m_xMin;
+  for (uint32_t i = 0; i < m_xRes; ++i, x += m_xStep)
+    {
+      m_x.push_back (x);
+    }
+  double y = m_yMin;
+  for (uint32_t j = 0; j < m_yRes; ++j, y += m_yStep)
+    {
+      m_y.push_back (y);
+    }
+  m_sinr.assign (m_x.size () * m_y.size (), 0.0);
+
+  m_nWorkers = std::min<uint32_t> (m_nThreads, m_xRes);
+#ifndef HAVE_PTHREAD_H
+  m_nWorkers = 1;
+#endif
+  if (m_nWorkers > 1 && (m_spectrumLoss != 0 || BuildingList::GetNBuildings () > 0
+                         || !IsThreadSafe (m_propagationLoss)))
+    {
+      // spectrum models and other propagation loss models keep per-link
+      // state or draw random variables, and buildings are shared by the
+      // mobility models of all workers
+      NS_LOG_WARN ("propagation loss models not thread safe or buildings found, using one thread");
+      m_nWorkers = 1;
+    }
+
+  // Every worker gets its own mobility models, so that the workers do
+  // not share any reference count.  A single worker uses the mobility
+  // of the transmitters itself, like the channel does.
+  for (uint32_t w = 0; w < m_nWorkers; ++w)
+    {
+      std::vector<Ptr<MobilityModel> > workerTx;
+      for (uint32_t t = 0; t < txMobility.size (); ++t)
+        {
+          workerTx.push_back ((m_nWorkers == 1) ? txMobility[t] : CopyPosition (txMobility[t]));
+        }
+      m_workerTxMobility.push_back (workerTx);
+      Ptr<MobilityModel> rx = CreateObject<ConstantPositionMobilityModel> ();
+      Ptr<MobilityBuildingInfo> buildingInfo = CreateObject<MobilityBuildingInfo> ();
+      rx->AggregateObject (buildingInfo); // operation usually done by BuildingsHelper::Install
+      m_workerRxMobility.push_back (rx);
+    }
+
+#ifdef HAVE_PTHREAD_H
+  std::vector<Ptr<SystemThread> > threads;
+  for (uint32_t w = 1; w < m_nWorkers; ++w)
+    {
+      Ptr<SystemThread> thread =
+        Create<SystemThread> (MakeCallback (&RadioEnvironmentMapHelper::ComputeAnalyticalColumns, this).Bind (w));
+      thread->Start ();
+      threads.push_back (thread);
+    }
+#endif
+  ComputeAnalyticalColumns (0);
+#ifdef HAVE_PTHREAD_H
+  for (std::vector<Ptr<SystemThread> >::iterator it = threads.begin (); it != threads.end (); ++it)
+    {
+      (*it)->Join ();
+    }
+#endif
+
+  WriteAnalytical ();
+}
+
+void
+RadioEnvironmentMapHelper::ComputeAnalyticalColumns (uint32_t worker)
+{
+  // Might run outside of the simulator thread: no logging, and only
+  // the mobility models of this worker are referenced.
+  const std::vector<Ptr<MobilityModel> > &txMobility = m_workerTxMobility[worker];
+  Ptr<MobilityModel> rxMobility = m_workerRxMobility[worker];
+  Ptr<MobilityBuildingInfo> buildingInfo = rxMobility->GetObject<MobilityBuildingInfo> ();
+
+  for (uint32_t i = worker; i < m_x.size (); i += m_nWorkers)
+    {
+      for (uint32_t j = 0; j < m_y.size (); ++j)
+        {
+          rxMobility->SetPosition (Vector (m_x[i], m_y[j], m_z));
+          buildingInfo->MakeConsistent (rxMobility);
+          Vector rxPosition = rxMobility->GetPosition ();
+
+          // same computation as MultiModelSpectrumChannel::StartTx
+          // followed by RemSpectrumPhy::StartRx and GetSinr
+          double sumPower = 0;
+          double referenceSignalPower = 0;
+          for (uint32_t t = 0; t < m_transmitters.size (); ++t)
+            {
+              const RemTransmitter &tx = m_transmitters[t];
+              double pathLossDb = 0;
+              if (tx.antenna != 0)
+                {
+                  Angles txAngles (rxPosition, txMobility[t]->GetPosition ());
+                  pathLossDb -= tx.antenna->GetGainDb (txAngles);
+                }
+              if (m_propagationLoss != 0)
+                {
+                  pathLossDb -= m_propagationLoss->CalcRxPower (0, txMobility[t], rxMobility);
+                }
+              if (pathLossDb > m_maxLossDb)
+                {
+                  continue;
+                }
+              double pathGainLinear = std::pow (10.0, (-pathLossDb) / 10.0);
+              double power = tx.power * pathGainLinear;
+              if (m_spectrumLoss != 0)
+                {
+                  Ptr<SpectrumValue> psd = Copy<SpectrumValue> (tx.psd);
+                  *psd *= pathGainLinear;
+                  psd = m_spectrumLoss->CalcRxPowerSpectralDensity (psd, txMobility[t], rxMobility);
+                  power = (m_rbId >= 0) ? (*psd)[m_rbId] * 180000 : Integral (*psd);
+                }
+              sumPower += power;
+              referenceSignalPower = std::max (referenceSignalPower, power);
+            }
+          m_sinr[i * m_y.size () + j] = referenceSignalPower / (sumPower - referenceSignalPower + m_noisePower);
+        }
+    }
+}
+
+void
+RadioEnvironmentMapHelper::WriteAnalytical ()
+{
+  NS_LOG_FUNCTION (this);
+  if (HasNpyExtension (m_outputFile))
+    {
+      // numpy format version 1.0: magic string, little-endian header
+      // length, and a dict literal padded so that the data is 64-byte aligned
+      const uint16_t one = 1;
+      bool littleEndian = *reinterpret_cast<const uint8_t *> (&one) == 1;
+      std::ostringstream header;
+      header << "{'descr': '" << (littleEndian ? '<' : '>') << "f8', 'fortran_order': False, "
+             << "'shape': (" << m_x.size () << ", " << m_y.size () << "), }";
+      std::string dict = header.str ();
+      dict.append ((64 - (10 + dict.size () + 1) % 64) % 64, ' ');
+      dict.push_back ('\n');
+      const char magic[8] = { '\x93', 'N', 'U', 'M', 'P', 'Y', 1, 0 };
+      const char headerLen[2] = { static_cast<char> (dict.size () & 0xff),
+                                  static_cast<char> (dict.size () >> 8) };
+      m_outFile.write (magic, sizeof (magic));
+      m_outFile.write (headerLen, sizeof (headerLen));
+      m_outFile.write (dict.data (), dict.size ());
+      m_outFile.write (reinterpret_cast<const char *> (m_sinr.data ()), m_sinr.size () * sizeof (double));
+      return;
+    }
+
+  for (uint32_t i = 0; i < m_x.size (); ++i)
+    {
+      for (uint32_t j = 0; j < m_y.size (); ++j)
+        {
+          m_outFile << m_x[i] << "\t"
+                    << m_y[j] << "\t"
+                    << m_z << "\t"
+                    << m_sinr[i * m_y.size () + j]
+                    << std::endl;
+        }
+    }
+}
+
 
 } // namespace ns3
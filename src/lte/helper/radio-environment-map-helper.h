@@ -25,6 +25,7 @@
 
 #include <ns3/object.h>
 #include <fstream>
+#include <vector>
 
 
 namespace ns3 {
@@ -35,6 +36,10 @@ class NetDevice;
 class SpectrumChannel;
 //class BuildingsMobilityModel;
 class MobilityModel;
+class AntennaModel;
+class SpectrumValue;
+class PropagationLossModel;
+class SpectrumPropagationLossModel;
 
 /** 
  * \ingroup lte
@@ -42,11 +47,35 @@ class MobilityModel;
  * Generates a 2D map of the SINR from the strongest transmitter in the
  * downlink of an LTE FDD system. For instructions on usage, please refer to
  * the User Documentation.
+ *
+ * In the default EVENT_DRIVEN mode, the map is sampled by RemSpectrumPhy
+ * listeners which receive the signals delivered by the channel, in
+ * batches of at most MaxPointsPerIteration points per simulator
+ * iteration.  In ANALYTICAL mode, the DL control channel power of every
+ * eNB attached to the channel is computed directly from the propagation
+ * loss, antenna and spectrum models of the channel, over a dense grid
+ * which is split among `Threads` worker threads.  If OutputFile ends
+ * with ".npy", the analytical map is saved as a numpy array of shape
+ * (XRes, YRes) instead of the text format.
+ *
+ * Running more than one thread requires the propagation loss model of
+ * the channel to be free of mutable state (e.g., no cached channel
+ * conditions or shadowing, no random variables).  The map is computed
+ * by one thread if the channel has a SpectrumPropagationLossModel or if
+ * there are buildings, since the building-aware models cache per-link
+ * shadowing.
  */
 class RadioEnvironmentMapHelper : public Object
 {
 public:  
 
+  /// How the map is computed.
+  enum RemMode
+  {
+    EVENT_DRIVEN, ///< Sample the signals delivered by the channel to RemSpectrumPhy listeners
+    ANALYTICAL    ///< Compute the received power from the channel models
+  };
+
   RadioEnvironmentMapHelper ();
   virtual ~RadioEnvironmentMapHelper ();
   
@@ -69,6 +98,18 @@ public:
    */
   void SetBandwidth (uint16_t bw);
 
+  /**
+   * Check whether the SINR of several grid points can be computed
+   * concurrently with a propagation loss model in ANALYTICAL mode, i.e.,
+   * whether the model and all the models chained after it compute the loss
+   * from the positions and their attributes only, without caches nor
+   * random variables.
+   *
+   * \param model the propagation loss model, possibly 0
+   * \return true if CalcRxPower can be called by several threads
+   */
+  static bool IsThreadSafe (Ptr<PropagationLossModel> model);
+
   /** 
    * Deploy the RemSpectrumPhy objects that generate the map according to the specified settings.
    * 
@@ -108,6 +149,35 @@ private:
   /// Called when the map generation procedure has been completed.
   void Finalize ();
 
+  /**
+   * Compute the whole map in ANALYTICAL mode and write it to the output
+   * file.
+   */
+  void RunAnalytical ();
+
+  /**
+   * Compute the SINR of the grid columns assigned to a worker in
+   * ANALYTICAL mode, i.e., every m_nWorkers-th column starting with
+   * \p worker.
+   *
+   * \param worker Index of the worker.
+   */
+  void ComputeAnalyticalColumns (uint32_t worker);
+
+  /// Write the analytical map, in text or numpy format.
+  void WriteAnalytical ();
+
+  /// A DL transmitter considered in ANALYTICAL mode.
+  struct RemTransmitter
+  {
+    /// Antenna of the transmitter, or 0 if isotropic.
+    Ptr<AntennaModel> antenna;
+    /// DL control channel PSD, converted to the spectrum model of the map.
+    Ptr<SpectrumValue> psd;
+    /// Power of the PSD over the RBs of the map, in Watts.
+    double power;
+  };
+
   /// A complete Radio Environment Map is composed of many of this structure.
   struct RemPoint 
   {
@@ -152,6 +222,30 @@ private:
   bool m_useDataChannel;  ///< The `UseDataChannel` attribute.
   int32_t m_rbId;         ///< The `RbId` attribute.
 
+  RemMode m_mode;         ///< The `Mode` attribute.
+  uint32_t m_nThreads;    ///< The `Threads` attribute.
+  uint32_t m_nWorkers;    ///< Number of workers of the analytical run.
+
+  /// Propagation loss model of the channel, in ANALYTICAL mode.
+  Ptr<PropagationLossModel> m_propagationLoss;
+  /// Spectrum propagation loss model of the channel, in ANALYTICAL mode.
+  Ptr<SpectrumPropagationLossModel> m_spectrumLoss;
+  /// `MaxLossDb` attribute of the channel, in ANALYTICAL mode.
+  double m_maxLossDb;
+
+  /// Transmitters attached to the channel, in ANALYTICAL mode.
+  std::vector<RemTransmitter> m_transmitters;
+  /// Per-worker copies of the mobility of the transmitters.
+  std::vector<std::vector<Ptr<MobilityModel> > > m_workerTxMobility;
+  /// Per-worker receiver mobility.
+  std::vector<Ptr<MobilityModel> > m_workerRxMobility;
+  /// X coordinates of the grid.
+  std::vector<double> m_x;
+  /// Y coordinates of the grid.
+  std::vector<double> m_y;
+  /// SINR of the grid points, indexed by x * m_yRes + y.
+  std::vector<double> m_sinr;
+
 }; // end of `class RadioEnvironmentMapHelper`
 
 
@@ -0,0 +1,328 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "a3-rsrp-table-handover-algorithm.h"
+#include <ns3/log.h>
+#include <ns3/double.h>
+#include <ns3/simulator.h>
+#include <ns3/lte-common.h>
+#include <list>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("A3RsrpTableHandoverAlgorithm");
+
+NS_OBJECT_ENSURE_REGISTERED (A3RsrpTableHandoverAlgorithm);
+
+
+A3RsrpTableHandoverAlgorithm::UeA3Info::UeA3Info ()
+  : hasParameters (false),
+    hysteresisDb (0.0)
+{
+}
+
+
+A3RsrpTableHandoverAlgorithm::A3RsrpTableHandoverAlgorithm ()
+  : m_measId (0),
+    m_cellId (0),
+    m_handoverManagementSapUser (0)
+{
+  NS_LOG_FUNCTION (this);
+  m_handoverManagementSapProvider = new MemberLteHandoverManagementSapProvider<A3RsrpTableHandoverAlgorithm> (this);
+  m_cellIndividualOffsetTable = CreateObject<CellIndividualOffset> ();
+}
+
+
+A3RsrpTableHandoverAlgorithm::~A3RsrpTableHandoverAlgorithm ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+
+TypeId
+A3RsrpTableHandoverAlgorithm::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::A3RsrpTableHandoverAlgorithm")
+    .SetParent<LteHandoverAlgorithm> ()
+    .SetGroupName ("Lte")
+    .AddConstructor<A3RsrpTableHandoverAlgorithm> ()
+    .AddAttribute ("Hysteresis",
+                   "Handover margin (hysteresis) in dB of the UEs "
+                   "without parameters of their own",
+                   DoubleValue (3.0),
+                   MakeDoubleAccessor (&A3RsrpTableHandoverAlgorithm::m_hysteresisDb),
+                   MakeDoubleChecker<double> (0.0, 30.0))
+    .AddAttribute ("TimeToTrigger",
+                   "Time during which the neighbour cell's RSRP reported "
+                   "by a UE without parameters of its own must continuously "
+                   "be higher than the serving cell's RSRP in order to "
+                   "trigger a handover",
+                   TimeValue (MilliSeconds (320)),
+                   MakeTimeAccessor (&A3RsrpTableHandoverAlgorithm::m_timeToTrigger),
+                   MakeTimeChecker ())
+    .AddAttribute ("ReportInterval",
+                   "Interval of the RSRP reports of the UEs: "
+                   "120, 240, 480, 640, 1024, 2048, 5120 or 10240 ms",
+                   TimeValue (MilliSeconds (120)),
+                   MakeTimeAccessor (&A3RsrpTableHandoverAlgorithm::m_reportInterval),
+                   MakeTimeChecker ())
+  ;
+  return tid;
+}
+
+
+void
+A3RsrpTableHandoverAlgorithm::SetLteHandoverManagementSapUser (LteHandoverManagementSapUser* s)
+{
+  NS_LOG_FUNCTION (this << s);
+  m_handoverManagementSapUser = s;
+}
+
+
+LteHandoverManagementSapProvider*
+A3RsrpTableHandoverAlgorithm::GetLteHandoverManagementSapProvider ()
+{
+  NS_LOG_FUNCTION (this);
+  return m_handoverManagementSapProvider;
+}
+
+
+void
+A3RsrpTableHandoverAlgorithm::SetCellId (uint16_t cellId)
+{
+  NS_LOG_FUNCTION (this << cellId);
+  m_cellId = cellId;
+}
+
+
+void
+A3RsrpTableHandoverAlgorithm::SetCellIndividualOffsetTable (Ptr<CellIndividualOffset> cellIndividualOffset)
+{
+  NS_LOG_FUNCTION (this << cellIndividualOffset);
+  NS_ASSERT (cellIndividualOffset != 0);
+  m_cellIndividualOffsetTable = cellIndividualOffset;
+}
+
+
+Ptr<CellIndividualOffset>
+A3RsrpTableHandoverAlgorithm::GetCellIndividualOffsetTable (void) const
+{
+  return m_cellIndividualOffsetTable;
+}
+
+
+void
+A3RsrpTableHandoverAlgorithm::SetCellIndividualOffset (uint16_t cellId, double offsetDb)
+{
+  NS_LOG_FUNCTION (this << cellId << offsetDb);
+  m_cellIndividualOffsetTable->SetOffset (cellId, offsetDb);
+}
+
+
+double
+A3RsrpTableHandoverAlgorithm::GetCellIndividualOffset (uint16_t cellId) const
+{
+  return m_cellIndividualOffsetTable->GetOffset (cellId);
+}
+
+
+void
+A3RsrpTableHandoverAlgorithm::SetUeParameters (uint16_t rnti, double hysteresisDb, Time timeToTrigger)
+{
+  NS_LOG_FUNCTION (this << rnti << hysteresisDb << timeToTrigger);
+  UeA3Info *ueInfo = m_ueInfo.Find (rnti);
+  if (ueInfo == 0)
+    {
+      m_ueInfo.Insert (rnti, UeA3Info ());
+      ueInfo = m_ueInfo.Find (rnti);
+    }
+  ueInfo->hasParameters = true;
+  ueInfo->hysteresisDb = hysteresisDb;
+  ueInfo->timeToTrigger = timeToTrigger;
+}
+
+
+void
+A3RsrpTableHandoverAlgorithm::ResetUeParameters (uint16_t rnti)
+{
+  NS_LOG_FUNCTION (this << rnti);
+  UeA3Info *ueInfo = m_ueInfo.Find (rnti);
+  if (ueInfo != 0)
+    {
+      ueInfo->hasParameters = false;
+    }
+}
+
+
+void
+A3RsrpTableHandoverAlgorithm::DoInitialize ()
+{
+  NS_LOG_FUNCTION (this);
+
+  LteRrcSap::ReportConfigEutra reportConfig;
+  switch (m_reportInterval.GetMilliSeconds ())
+    {
+    case 120:
+      reportConfig.reportInterval = LteRrcSap::ReportConfigEutra::MS120;
+      break;
+    case 240:
+      reportConfig.reportInterval = LteRrcSap::ReportConfigEutra::MS240;
+      break;
+    case 480:
+      reportConfig.reportInterval = LteRrcSap::ReportConfigEutra::MS480;
+      break;
+    case 640:
+      reportConfig.reportInterval = LteRrcSap::ReportConfigEutra::MS640;
+      break;
+    case 1024:
+      reportConfig.reportInterval = LteRrcSap::ReportConfigEutra::MS1024;
+      break;
+    case 2048:
+      reportConfig.reportInterval = LteRrcSap::ReportConfigEutra::MS2048;
+      break;
+    case 5120:
+      reportConfig.reportInterval = LteRrcSap::ReportConfigEutra::MS5120;
+      break;
+    case 10240:
+      reportConfig.reportInterval = LteRrcSap::ReportConfigEutra::MS10240;
+      break;
+    default:
+      NS_FATAL_ERROR ("unsupported ReportInterval " << m_reportInterval.As (Time::MS));
+    }
+
+  NS_LOG_LOGIC (this << " requesting Event A4 measurements"
+                     << " (threshold=0, reportInterval=" << m_reportInterval.As (Time::MS) << ")");
+
+  // intentionally lowest threshold: the UEs report all the neighbours they measure
+  reportConfig.eventId = LteRrcSap::ReportConfigEutra::EVENT_A4;
+  reportConfig.threshold1.choice = LteRrcSap::ThresholdEutra::THRESHOLD_RSRP;
+  reportConfig.threshold1.range = 0;
+  reportConfig.triggerQuantity = LteRrcSap::ReportConfigEutra::RSRP;
+  m_measId = m_handoverManagementSapUser->AddUeMeasReportConfigForHandover (reportConfig);
+
+  LteHandoverAlgorithm::DoInitialize ();
+}
+
+
+void
+A3RsrpTableHandoverAlgorithm::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  m_ueInfo.Clear ();
+  m_cellIndividualOffsetTable = 0;
+  delete m_handoverManagementSapProvider;
+}
+
+
+void
+A3RsrpTableHandoverAlgorithm::DoReportUeMeas (uint16_t rnti,
+                                              LteRrcSap::MeasResults measResults)
+{
+  NS_LOG_FUNCTION (this << rnti << (uint16_t) measResults.measId);
+
+  if (measResults.measId != m_measId)
+    {
+      NS_LOG_WARN ("Ignoring measId " << (uint16_t) measResults.measId);
+      return;
+    }
+
+  UeA3Info *ueInfo = m_ueInfo.Find (rnti);
+  if (ueInfo == 0)
+    {
+      m_ueInfo.Insert (rnti, UeA3Info ());
+      ueInfo = m_ueInfo.Find (rnti);
+    }
+  double hysteresisDb = ueInfo->hasParameters ? ueInfo->hysteresisDb : m_hysteresisDb;
+  Time timeToTrigger = ueInfo->hasParameters ? ueInfo->timeToTrigger : m_timeToTrigger;
+
+  Time now = Simulator::Now ();
+  double mp = EutranMeasurementMapping::RsrpRange2Dbm (measResults.rsrpResult);
+  double ocp = GetCellIndividualOffset (m_cellId);
+
+  std::vector<std::pair<uint16_t, Time> > enteringCells;
+  uint16_t bestNeighbourCellId = 0;
+  double bestNeighbourValue = 0.0;
+
+  if (measResults.haveMeasResultNeighCells)
+    {
+      for (std::list <LteRrcSap::MeasResultEutra>::const_iterator it = measResults.measResultListEutra.begin ();
+           it != measResults.measResultListEutra.end ();
+           ++it)
+        {
+          if (!it->haveRsrpResult)
+            {
+              NS_LOG_WARN ("RSRP measurement is missing from cell ID " << it->physCellId);
+              continue;
+            }
+
+          double mn = EutranMeasurementMapping::RsrpRange2Dbm (it->rsrpResult);
+          double ocn = GetCellIndividualOffset (it->physCellId);
+
+          // Inequality A3-1 (Entering condition): Mn + Ocn - Hys > Mp + Ocp
+          if (mn + ocn - hysteresisDb > mp + ocp)
+            {
+              // the condition holds since the first of the consecutive reports meeting it
+              Time since = now;
+              for (std::vector<std::pair<uint16_t, Time> >::const_iterator enteringIt = ueInfo->enteringCells.begin ();
+                   enteringIt != ueInfo->enteringCells.end ();
+                   ++enteringIt)
+                {
+                  if (enteringIt->first == it->physCellId)
+                    {
+                      since = enteringIt->second;
+                      break;
+                    }
+                }
+              enteringCells.push_back (std::make_pair (it->physCellId, since));
+
+              if (now - since >= timeToTrigger
+                  && (bestNeighbourCellId == 0 || mn + ocn > bestNeighbourValue))
+                {
+                  bestNeighbourCellId = it->physCellId;
+                  bestNeighbourValue = mn + ocn;
+                }
+            }
+
+          NS_LOG_LOGIC (this << " RNTI " << rnti << " neighbour cell " << it->physCellId
+                             << " mn=" << mn << " ocn=" << ocn << " mp=" << mp << " ocp=" << ocp
+                             << " hys=" << hysteresisDb);
+        }
+    }
+  ueInfo->enteringCells.swap (enteringCells);
+
+  if (bestNeighbourCellId > 0)
+    {
+      NS_LOG_LOGIC ("Trigger Handover of RNTI " << rnti << " to cellId " << bestNeighbourCellId);
+      ueInfo->enteringCells.clear ();
+
+      // Inform eNodeB RRC about handover
+      m_handoverManagementSapUser->TriggerHandover (rnti, bestNeighbourCellId);
+    }
+
+} // end of DoReportUeMeas
+
+
+void
+A3RsrpTableHandoverAlgorithm::DoRemoveUe (uint16_t rnti)
+{
+  NS_LOG_FUNCTION (this << rnti);
+  // a UE which gets the RNTI later starts with the default parameters
+  // and no neighbour meeting the entering condition
+  m_ueInfo.Erase (rnti);
+}
+
+
+} // end of namespace ns3
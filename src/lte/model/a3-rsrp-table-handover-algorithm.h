@@ -0,0 +1,183 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef A3_RSRP_TABLE_HANDOVER_ALGORITHM_H
+#define A3_RSRP_TABLE_HANDOVER_ALGORITHM_H
+
+#include <ns3/lte-handover-algorithm.h>
+#include <ns3/lte-handover-management-sap.h>
+#include <ns3/lte-rrc-sap.h>
+#include <ns3/rnti-table.h>
+#include <ns3/cell-individual-offset.h>
+#include <ns3/nstime.h>
+
+#include <utility>
+#include <vector>
+
+namespace ns3 {
+
+
+/**
+ * \brief Event A3 handover algorithm evaluated by the eNodeB, with per-UE
+ *        handover margin and time-to-trigger and per-cell individual offsets.
+ *
+ * Unlike A3RsrpHandoverAlgorithm, the UEs do not evaluate Event A3: they
+ * periodically report the RSRP of the serving cell and of up to
+ * LteRrcSap::MaxReportCells neighbour cells, through an Event A4
+ * configuration with the lowest threshold, and the algorithm evaluates the
+ * entering condition of Event A3 (Section 5.5.4.4 of 3GPP TS 36.331) on
+ * each report:
+ *
+ *     Mn + Ocn - Hys > Mp + Ocp
+ *
+ * where Ocn and Ocp are the cell individual offsets of the neighbour and
+ * serving cells. A handover is triggered towards the best neighbour, by
+ * Mn + Ocn, whose condition held in all the reports of the UE received
+ * during the time-to-trigger of the UE.
+ *
+ * The handover margin (Hys), time-to-trigger and cell individual offsets
+ * are kept by the eNodeB, so that SetUeParameters and
+ * SetCellIndividualOffset take effect from the next report, without any
+ * RRC reconfiguration of the UEs. The UEs without parameters of their own
+ * use the Hysteresis and TimeToTrigger attributes. The offsets are those of
+ * a CellIndividualOffset table, which LteHelper shares between the cells it
+ * installs.
+ *
+ * \note The time-to-trigger is evaluated with the resolution of the
+ *       ReportInterval attribute, on the quantized RSRP of the reports, and
+ *       the algorithm needs the ID of its cell for the offset of the serving
+ *       cell, which LteHelper sets with SetCellId.
+ */
+class A3RsrpTableHandoverAlgorithm : public LteHandoverAlgorithm
+{
+public:
+  /// Creates an A3 table handover algorithm instance.
+  A3RsrpTableHandoverAlgorithm ();
+
+  virtual ~A3RsrpTableHandoverAlgorithm ();
+
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId ();
+
+  // inherited from LteHandoverAlgorithm
+  virtual void SetLteHandoverManagementSapUser (LteHandoverManagementSapUser* s);
+  virtual LteHandoverManagementSapProvider* GetLteHandoverManagementSapProvider ();
+
+  /// let the forwarder class access the protected and private members
+  friend class MemberLteHandoverManagementSapProvider<A3RsrpTableHandoverAlgorithm>;
+
+  /**
+   * \param cellId the ID of the cell of the eNodeB
+   */
+  void SetCellId (uint16_t cellId);
+
+  /**
+   * \param cellIndividualOffset the table of the offsets of the cells,
+   *        instead of the table of the algorithm
+   */
+  void SetCellIndividualOffsetTable (Ptr<CellIndividualOffset> cellIndividualOffset);
+
+  /**
+   * \return the table of the offsets of the cells
+   */
+  Ptr<CellIndividualOffset> GetCellIndividualOffsetTable (void) const;
+
+  /**
+   * \brief Set the cell individual offset (Ocn, Ocp) of a cell in the table.
+   * \param cellId the ID of the cell
+   * \param offsetDb the offset in dB
+   */
+  void SetCellIndividualOffset (uint16_t cellId, double offsetDb);
+
+  /**
+   * \param cellId the ID of the cell
+   * \return the cell individual offset of the cell in dB, 0 if not set
+   */
+  double GetCellIndividualOffset (uint16_t cellId) const;
+
+  /**
+   * \brief Set the handover margin and time-to-trigger of a UE.
+   * \param rnti the RNTI of the UE
+   * \param hysteresisDb the handover margin in dB
+   * \param timeToTrigger the time-to-trigger
+   *
+   * The parameters apply until the context of the UE is removed from the
+   * eNodeB.
+   */
+  void SetUeParameters (uint16_t rnti, double hysteresisDb, Time timeToTrigger);
+
+  /**
+   * \brief Restore the Hysteresis and TimeToTrigger attributes as the
+   *        parameters of a UE.
+   * \param rnti the RNTI of the UE
+   */
+  void ResetUeParameters (uint16_t rnti);
+
+protected:
+  // inherited from Object
+  virtual void DoInitialize ();
+  virtual void DoDispose ();
+
+  // inherited from LteHandoverAlgorithm as a Handover Management SAP implementation
+  void DoReportUeMeas (uint16_t rnti, LteRrcSap::MeasResults measResults);
+  virtual void DoRemoveUe (uint16_t rnti);
+
+private:
+  /// Per-UE parameters and state of Event A3.
+  struct UeA3Info
+  {
+    UeA3Info ();
+
+    bool hasParameters; ///< true if the UE has parameters of its own
+    double hysteresisDb; ///< the handover margin of the UE
+    Time timeToTrigger; ///< the time-to-trigger of the UE
+    /// neighbour cells meeting the entering condition, with the time of the first report meeting it
+    std::vector<std::pair<uint16_t, Time> > enteringCells;
+  };
+
+  /// The expected measurement identity for the periodic RSRP reports.
+  uint8_t m_measId;
+
+  /// The ID of the cell of the eNodeB.
+  uint16_t m_cellId;
+
+  /// The `Hysteresis` attribute. Default handover margin in dB.
+  double m_hysteresisDb;
+  /// The `TimeToTrigger` attribute. Default time-to-trigger.
+  Time m_timeToTrigger;
+  /// The `ReportInterval` attribute. Interval of the reports of the UEs.
+  Time m_reportInterval;
+
+  /// Cell individual offsets of the cells.
+  Ptr<CellIndividualOffset> m_cellIndividualOffsetTable;
+  /// Parameters and state of the UEs, indexed by RNTI.
+  RntiTable<UeA3Info> m_ueInfo;
+
+  /// Interface to the eNodeB RRC instance.
+  LteHandoverManagementSapUser* m_handoverManagementSapUser;
+  /// Receive API calls from the eNodeB RRC instance.
+  LteHandoverManagementSapProvider* m_handoverManagementSapProvider;
+
+}; // end of class A3RsrpTableHandoverAlgorithm
+
+
+} // end of namespace ns3
+
+
+#endif /* A3_RSRP_TABLE_HANDOVER_ALGORITHM_H */
@@ -1,15 +1,84 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
 #include "cell-individual-offset.h"
+#include <ns3/log.h>
+#include <ns3/assert.h>
+
+#include <algorithm>
+
+namespace ns3 {
 
+NS_LOG_COMPONENT_DEFINE ("CellIndividualOffset");
+
+NS_OBJECT_ENSURE_REGISTERED (CellIndividualOffset);
+
+CellIndividualOffset::CellIndividualOffset ()
+  : m_version (0)
+{
+  NS_LOG_FUNCTION (this);
+}
 
-std::vector<double> CellIndividualOffset::OffsetList(40,0);
+CellIndividualOffset::~CellIndividualOffset ()
+{
+  NS_LOG_FUNCTION (this);
+}
 
-void CellIndividualOffset::setOffsetList(std::vector<double>& CioList)
+TypeId
+CellIndividualOffset::GetTypeId (void)
 {
-		OffsetList = CioList;
+  static TypeId tid = TypeId ("ns3::CellIndividualOffset")
+    .SetParent<Object> ()
+    .SetGroupName ("Lte")
+    .AddConstructor<CellIndividualOffset> ()
+  ;
+  return tid;
 }
 
+void
+CellIndividualOffset::SetOffset (uint16_t cellId, double offsetDb)
+{
+  NS_LOG_FUNCTION (this << cellId << offsetDb);
+  NS_ASSERT_MSG (cellId >= 1, "invalid cell ID " << cellId);
+  if (cellId > m_offsets.size ())
+    {
+      m_offsets.resize (cellId, 0.0);
+    }
+  else if (m_offsets[cellId - 1] == offsetDb)
+    {
+      return;
+    }
+  m_offsets[cellId - 1] = offsetDb;
+  m_version.fetch_add (1, std::memory_order_release);
+}
 
-std::vector<double> CellIndividualOffset::getOffsetList()
+void
+CellIndividualOffset::SetOffsetList (const std::vector<double> &offsets)
 {
-		return OffsetList;
+  NS_LOG_FUNCTION (this << offsets.size ());
+  if (offsets.size () > m_offsets.size ())
+    {
+      m_offsets.resize (offsets.size (), 0.0);
+    }
+  else if (std::equal (offsets.begin (), offsets.end (), m_offsets.begin ()))
+    {
+      return;
+    }
+  std::copy (offsets.begin (), offsets.end (), m_offsets.begin ());
+  m_version.fetch_add (1, std::memory_order_release);
 }
+
+} // namespace ns3
@@ -1,20 +1,152 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
 
 #ifndef CELL_INDIVIDUAL_OFFSET_H
 #define CELL_INDIVIDUAL_OFFSET_H
 
+#include <ns3/object.h>
+
+#include <atomic>
+#include <cstddef>
 #include <vector>
 
-class CellIndividualOffset
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * \brief The cell individual offsets (CIO) of the cells of a simulation.
+ *
+ * LteHelper owns one instance, shared by the eNodeB RRCs and the handover
+ * algorithms of the cells it installs (see
+ * LteHelper::GetCellIndividualOffsetTable), so that the offsets are set once
+ * for the whole network and that several helpers, each with its own offsets,
+ * can coexist in one process.
+ *
+ * The offsets are written by the thread running the simulation. Every change
+ * increments the version, an atomic counter which readers compare with the
+ * version of the offsets they last read, to skip the unchanged offsets
+ * without reading them; GetOffsetList returns a view of the offsets, not a
+ * copy.
+ */
+class CellIndividualOffset : public Object
 {
+public:
+  /// Read-only view of the offsets, indexed by cell ID - 1.
+  class ConstSpan
+  {
+  public:
+    /**
+     * \param data the first offset
+     * \param size the number of offsets
+     */
+    ConstSpan (const double *data, std::size_t size)
+      : m_data (data),
+        m_size (size)
+    {
+    }
+
+    /// \return the first offset
+    const double *begin (void) const
+    {
+      return m_data;
+    }
+    /// \return past the last offset
+    const double *end (void) const
+    {
+      return m_data + m_size;
+    }
+    /// \return the number of offsets
+    std::size_t size (void) const
+    {
+      return m_size;
+    }
+    /// \return true if there is no offset
+    bool empty (void) const
+    {
+      return m_size == 0;
+    }
+    /**
+     * \param i the index of the offset, the cell ID - 1
+     * \return the offset in dB
+     */
+    const double &operator[] (std::size_t i) const
+    {
+      return m_data[i];
+    }
+
+  private:
+    const double *m_data; ///< the first offset
+    std::size_t m_size; ///< the number of offsets
+  };
+
+  CellIndividualOffset ();
+  virtual ~CellIndividualOffset ();
 
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
 
-	
-	static std::vector<double> OffsetList;
-	public:	
-		static void setOffsetList(std::vector<double>& CioList);
-		static std::vector<double> getOffsetList();
+  /**
+   * \brief Set the offset of a cell.
+   * \param cellId the ID of the cell, from 1
+   * \param offsetDb the offset in dB
+   */
+  void SetOffset (uint16_t cellId, double offsetDb);
 
+  /**
+   * \param cellId the ID of the cell
+   * \return the offset of the cell in dB, 0 if not set
+   */
+  double GetOffset (uint16_t cellId) const
+  {
+    return cellId >= 1 && cellId <= m_offsets.size () ? m_offsets[cellId - 1] : 0.0;
+  }
 
+  /**
+   * \brief Set the offsets of the cells 1 to offsets.size ().
+   * \param offsets the offsets in dB, indexed by cell ID - 1
+   */
+  void SetOffsetList (const std::vector<double> &offsets);
+
+  /**
+   * \return a view of the offsets, indexed by cell ID - 1, valid until the
+   *         offset of a cell beyond its size is set
+   */
+  ConstSpan GetOffsetList (void) const
+  {
+    return ConstSpan (m_offsets.data (), m_offsets.size ());
+  }
+
+  /**
+   * \return the version of the offsets, incremented by every change of an
+   *         offset; it can be read from any thread
+   */
+  uint64_t GetVersion (void) const
+  {
+    return m_version.load (std::memory_order_acquire);
+  }
+
+private:
+  std::vector<double> m_offsets; ///< the offsets in dB, indexed by cell ID - 1
+  std::atomic<uint64_t> m_version; ///< the version of the offsets
 };
 
-#endif
+} // namespace ns3
+
+#endif /* CELL_INDIVIDUAL_OFFSET_H */
@@ -0,0 +1,267 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "dqn-policy.h"
+
+#include <ns3/log.h>
+#include <ns3/abort.h>
+#include <ns3/little-endian.h>
+
+#include <cstring>
+#include <fstream>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("DqnPolicy");
+
+/// Magic number of the binary files
+static const char DQN_MAGIC[4] = { 'S', 'L', 'C', 'D' };
+/// Version of the binary format
+static const uint32_t DQN_VERSION = 1;
+/// Number of partial sums of the GEMV kernel, i.e., of SIMD lanes
+static const uint32_t GEMV_LANES = 8;
+
+/**
+ * Write single precision values in little endian order.
+ *
+ * \param os the output stream
+ * \param values the values
+ */
+static void
+WriteFloats (std::ostream &os, const std::vector<float> &values)
+{
+  for (size_t i = 0; i < values.size (); ++i)
+    {
+      uint32_t v;
+      std::memcpy (&v, &values[i], sizeof (v));
+      LittleEndian::WriteU32 (os, v);
+    }
+}
+
+/**
+ * Read single precision values in little endian order.
+ *
+ * \param is the input stream
+ * \param [out] values the values, read up to the size of the vector
+ * \return false on a read error
+ */
+static bool
+ReadFloats (std::istream &is, std::vector<float> &values)
+{
+  for (size_t i = 0; i < values.size (); ++i)
+    {
+      uint32_t v;
+      if (!LittleEndian::ReadU32 (is, v))
+        {
+          return false;
+        }
+      std::memcpy (&values[i], &v, sizeof (v));
+    }
+  return true;
+}
+
+DqnPolicy::DqnPolicy ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+DqnPolicy::AddLayer (uint32_t nInputs, uint32_t nOutputs,
+                     const std::vector<float> &weights, const std::vector<float> &bias)
+{
+  NS_LOG_FUNCTION (this << nInputs << nOutputs);
+  NS_ABORT_MSG_IF (nInputs == 0 || nOutputs == 0, "empty layer");
+  NS_ABORT_MSG_IF (!m_layers.empty () && m_layers.back ().nOutputs != nInputs,
+                   "the layer has " << nInputs << " inputs, the previous one "
+                                    << m_layers.back ().nOutputs << " outputs");
+  NS_ABORT_MSG_IF (weights.size () != static_cast<size_t> (nInputs) * nOutputs,
+                   "the layer has " << weights.size () << " weights instead of "
+                                    << nInputs * nOutputs);
+  NS_ABORT_MSG_IF (bias.size () != nOutputs,
+                   "the layer has " << bias.size () << " biases instead of " << nOutputs);
+  Layer layer;
+  layer.nInputs = nInputs;
+  layer.nOutputs = nOutputs;
+  layer.weights = weights;
+  layer.bias = bias;
+  m_layers.push_back (layer);
+}
+
+bool
+DqnPolicy::Load (std::string filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  std::ifstream ifs (filename.c_str (), std::ios::binary);
+  if (!ifs.is_open ())
+    {
+      NS_LOG_ERROR ("cannot open " << filename);
+      return false;
+    }
+  char magic[4];
+  uint32_t version;
+  uint32_t nLayers;
+  if (!ifs.read (magic, 4) || std::memcmp (magic, DQN_MAGIC, 4) != 0
+      || !LittleEndian::ReadU32 (ifs, version) || version != DQN_VERSION
+      || !LittleEndian::ReadU32 (ifs, nLayers) || nLayers == 0)
+    {
+      NS_LOG_ERROR (filename << ": not a DQN file of version " << DQN_VERSION);
+      return false;
+    }
+  std::vector<Layer> layers (nLayers);
+  for (uint32_t l = 0; l < nLayers; ++l)
+    {
+      Layer &layer = layers[l];
+      if (!LittleEndian::ReadU32 (ifs, layer.nInputs)
+          || !LittleEndian::ReadU32 (ifs, layer.nOutputs)
+          || layer.nInputs == 0 || layer.nOutputs == 0
+          || (l > 0 && layer.nInputs != layers[l - 1].nOutputs))
+        {
+          NS_LOG_ERROR (filename << ": invalid layer " << l);
+          return false;
+        }
+      layer.weights.resize (static_cast<size_t> (layer.nInputs) * layer.nOutputs);
+      layer.bias.resize (layer.nOutputs);
+      if (!ReadFloats (ifs, layer.weights) || !ReadFloats (ifs, layer.bias))
+        {
+          NS_LOG_ERROR (filename << ": truncated layer " << l);
+          return false;
+        }
+    }
+  m_layers.swap (layers);
+  return true;
+}
+
+bool
+DqnPolicy::Save (std::string filename) const
+{
+  NS_LOG_FUNCTION (this << filename);
+  std::ofstream ofs (filename.c_str (), std::ios::binary | std::ios::trunc);
+  if (!ofs.is_open ())
+    {
+      NS_LOG_ERROR ("cannot open " << filename);
+      return false;
+    }
+  ofs.write (DQN_MAGIC, 4);
+  LittleEndian::WriteU32 (ofs, DQN_VERSION);
+  LittleEndian::WriteU32 (ofs, m_layers.size ());
+  for (uint32_t l = 0; l < m_layers.size (); ++l)
+    {
+      LittleEndian::WriteU32 (ofs, m_layers[l].nInputs);
+      LittleEndian::WriteU32 (ofs, m_layers[l].nOutputs);
+      WriteFloats (ofs, m_layers[l].weights);
+      WriteFloats (ofs, m_layers[l].bias);
+    }
+  ofs.close ();
+  return !ofs.fail ();
+}
+
+uint32_t
+DqnPolicy::GetNLayers (void) const
+{
+  return m_layers.size ();
+}
+
+uint32_t
+DqnPolicy::GetNInputs (void) const
+{
+  return m_layers.empty () ? 0 : m_layers.front ().nInputs;
+}
+
+uint32_t
+DqnPolicy::GetNOutputs (void) const
+{
+  return m_layers.empty () ? 0 : m_layers.back ().nOutputs;
+}
+
+void
+DqnPolicy::Gemv (const float *w, const float *b, const float *x, float *y,
+                 uint32_t nInputs, uint32_t nOutputs)
+{
+  // independent partial sums over the inputs, which the compiler maps to
+  // the SIMD lanes of the target, then a scalar tail
+  uint32_t nBlocked = nInputs - nInputs % GEMV_LANES;
+  for (uint32_t o = 0; o < nOutputs; ++o)
+    {
+      const float *row = w + static_cast<size_t> (o) * nInputs;
+      float acc[GEMV_LANES] = { 0 };
+      for (uint32_t i = 0; i < nBlocked; i += GEMV_LANES)
+        {
+          for (uint32_t k = 0; k < GEMV_LANES; ++k)
+            {
+              acc[k] += row[i + k] * x[i + k];
+            }
+        }
+      float sum = 0;
+      for (uint32_t k = 0; k < GEMV_LANES; ++k)
+        {
+          sum += acc[k];
+        }
+      for (uint32_t i = nBlocked; i < nInputs; ++i)
+        {
+          sum += row[i] * x[i];
+        }
+      y[o] = sum + b[o];
+    }
+}
+
+const std::vector<float> &
+DqnPolicy::Forward (const std::vector<float> &input) const
+{
+  NS_ABORT_MSG_IF (m_layers.empty (), "no network loaded");
+  NS_ABORT_MSG_IF (input.size () != m_layers.front ().nInputs,
+                   "the network has " << m_layers.front ().nInputs << " inputs, not "
+                                      << input.size ());
+  const float *x = &input[0];
+  for (uint32_t l = 0; l < m_layers.size (); ++l)
+    {
+      const Layer &layer = m_layers[l];
+      std::vector<float> &y = m_buffers[l % 2];
+      y.resize (layer.nOutputs);
+      Gemv (&layer.weights[0], &layer.bias[0], x, &y[0], layer.nInputs, layer.nOutputs);
+      if (l + 1 < m_layers.size ())
+        {
+          for (uint32_t o = 0; o < layer.nOutputs; ++o)
+            {
+              y[o] = y[o] > 0 ? y[o] : 0;
+            }
+        }
+      x = &y[0];
+    }
+  return m_buffers[(m_layers.size () - 1) % 2];
+}
+
+void
+DqnPolicy::Evaluate (const std::vector<float> &input, std::vector<float> &output) const
+{
+  output = Forward (input);
+}
+
+uint32_t
+DqnPolicy::GetGreedyAction (const std::vector<float> &input) const
+{
+  const std::vector<float> &q = Forward (input);
+  uint32_t best = 0;
+  for (uint32_t a = 1; a < q.size (); ++a)
+    {
+      if (q[a] > q[best])
+        {
+          best = a;
+        }
+    }
+  return best;
+}
+
+} // namespace ns3
@@ -0,0 +1,136 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef DQN_POLICY_H
+#define DQN_POLICY_H
+
+#include <ns3/simple-ref-count.h>
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * Greedy policy of a deep Q-network, such as the coordinator of the SLC2
+ * agents: a multilayer perceptron of fully connected layers with ReLU
+ * activations, except for the output layer, whose largest output is the
+ * greedy action. The forward pass runs in single precision, as PyTorch
+ * does on the CPU, with preallocated buffers.
+ *
+ * The network is loaded from a flat binary file: the "SLCD" magic, the
+ * format version and the number of layers, followed, for each layer, by
+ * its number of inputs and of outputs, its weights, output by output,
+ * i.e., the layout of the weight of a torch.nn.Linear, and its biases.
+ * The counts are little endian 32-bit unsigned integers, the weights and
+ * biases little endian IEEE 754 single precision values.
+ */
+class DqnPolicy : public SimpleRefCount<DqnPolicy>
+{
+public:
+  DqnPolicy ();
+
+  /**
+   * Append a fully connected layer to the network.
+   *
+   * \param nInputs the number of inputs, which must be the number of
+   * outputs of the previous layer
+   * \param nOutputs the number of outputs
+   * \param weights the nOutputs x nInputs weights, output by output
+   * \param bias the nOutputs biases
+   */
+  void AddLayer (uint32_t nInputs, uint32_t nOutputs,
+                 const std::vector<float> &weights, const std::vector<float> &bias);
+
+  /**
+   * Load the network from a binary file.
+   *
+   * \param filename the name of the file
+   * \return false if the file cannot be read or is not a valid network
+   */
+  bool Load (std::string filename);
+
+  /**
+   * Save the network to a binary file.
+   *
+   * \param filename the name of the file
+   * \return false if the file cannot be written
+   */
+  bool Save (std::string filename) const;
+
+  /// \return the number of layers
+  uint32_t GetNLayers (void) const;
+  /// \return the number of inputs of the network, i.e., the state size
+  uint32_t GetNInputs (void) const;
+  /// \return the number of outputs of the network, i.e., the number of actions
+  uint32_t GetNOutputs (void) const;
+
+  /**
+   * Run the forward pass.
+   *
+   * \param input the GetNInputs () inputs
+   * \param [out] output the GetNOutputs () Q-values
+   */
+  void Evaluate (const std::vector<float> &input, std::vector<float> &output) const;
+
+  /**
+   * \param input the GetNInputs () inputs
+   * \return the greedy action, i.e., the first output with the largest
+   * Q-value, as torch.argmax
+   */
+  uint32_t GetGreedyAction (const std::vector<float> &input) const;
+
+  /**
+   * Matrix-vector product of a fully connected layer, y = W x + b.
+   *
+   * \param w the nOutputs x nInputs weights, output by output
+   * \param b the nOutputs biases
+   * \param x the nInputs inputs
+   * \param [out] y the nOutputs outputs
+   * \param nInputs the number of inputs
+   * \param nOutputs the number of outputs
+   */
+  static void Gemv (const float *w, const float *b, const float *x, float *y,
+                    uint32_t nInputs, uint32_t nOutputs);
+
+private:
+  /// Fully connected layer
+  struct Layer
+  {
+    uint32_t nInputs;            ///< the number of inputs
+    uint32_t nOutputs;           ///< the number of outputs
+    std::vector<float> weights;  ///< the weights, output by output
+    std::vector<float> bias;     ///< the biases
+  };
+
+  /**
+   * Run the forward pass in the buffers.
+   *
+   * \param input the inputs
+   * \return the outputs of the last layer
+   */
+  const std::vector<float> & Forward (const std::vector<float> &input) const;
+
+  std::vector<Layer> m_layers;                  ///< the layers
+  mutable std::vector<float> m_buffers[2];      ///< the outputs of the layers, alternately
+};
+
+} // namespace ns3
+
+#endif // DQN_POLICY_H
@@ -83,6 +83,7 @@ EpcEnbApplication::DoDispose (void)
   m_lteSocket = 0;
   m_lteSocket6 = 0;
   m_s1uSocket = 0;
+  m_s1uDirectPath = MakeNullCallback<void, Ptr<Packet>, uint32_t> ();
   delete m_s1SapProvider;
   delete m_s1apSapEnb;
 }
@@ -116,6 +117,13 @@ EpcEnbApplication::AddS1Interface (Ptr<Socket> s1uSocket, Ipv4Address enbAddress
 }
 
 
+void
+EpcEnbApplication::SetS1uDirectPath (Callback<void, Ptr<Packet>, uint32_t> sendToSgw)
+{
+  NS_LOG_FUNCTION (this);
+  m_s1uDirectPath = sendToSgw;
+}
+
 EpcEnbApplication::~EpcEnbApplication (void)
 {
   NS_LOG_FUNCTION (this);
@@ -304,7 +312,13 @@ EpcEnbApplication::RecvFromS1uSocket (Ptr<Socket> socket)
   Ptr<Packet> packet = socket->Recv ();
   GtpuHeader gtpu;
   packet->RemoveHeader (gtpu);
-  uint32_t teid = gtpu.GetTeid ();
+  RecvFromS1u (packet, gtpu.GetTeid ());
+}
+
+void 
+EpcEnbApplication::RecvFromS1u (Ptr<Packet> packet, uint32_t teid)
+{
+  NS_LOG_FUNCTION (this << packet << teid);
   std::map<uint32_t, EpsFlowId_t>::iterator it = m_teidRbidMap.find (teid);
   if (it == m_teidRbidMap.end ())
     {
@@ -350,6 +364,11 @@ void
 EpcEnbApplication::SendToS1uSocket (Ptr<Packet> packet, uint32_t teid)
 {
   NS_LOG_FUNCTION (this << packet << teid <<  packet->GetSize ());  
+  if (!m_s1uDirectPath.IsNull ())
+    {
+      m_s1uDirectPath (packet, teid);
+      return;
+    }
   GtpuHeader gtpu;
   gtpu.SetTeid (teid);
   // From 3GPP TS 29.281 v10.0.0 Section 5.1
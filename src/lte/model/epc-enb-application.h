@@ -86,6 +86,15 @@ public:
    */
   void AddS1Interface (Ptr<Socket> s1uSocket, Ipv4Address enbAddress, Ipv4Address sgwAddress);
 
+  /**
+   * Hand the uplink data packets directly to the SGW, instead of
+   * sending them over GTP-U/UDP/IP through the S1-U socket.
+   *
+   * \param sendToSgw the callback receiving each packet, without any
+   * GTP-U header, and its TEID; a null callback restores the S1-U socket
+   */
+  void SetS1uDirectPath (Callback<void, Ptr<Packet>, uint32_t> sendToSgw);
+
 
   /**
    * Destructor
@@ -135,6 +144,15 @@ public:
    */
   void RecvFromS1uSocket (Ptr<Socket> socket);
 
+  /**
+   * Receive a data packet from the SGW, once the GTP-U header is
+   * removed, that is to be forwarded to the UE.
+   *
+   * \param packet the data packet
+   * \param teid the Tunnel Endpoint IDentifier of the packet
+   */
+  void RecvFromS1u (Ptr<Packet> packet, uint32_t teid);
+
   /**
    * TracedCallback signature for data Packet reception event.
    *
@@ -270,6 +288,12 @@ private:
    */
   Ptr<Socket> m_s1uSocket;
 
+  /**
+   * direct path to the SGW for the uplink data packets, bypassing
+   * the S1-U socket when not null
+   */
+  Callback<void, Ptr<Packet>, uint32_t> m_s1uDirectPath;
+
   /**
    * address of the eNB for S1-U communications
    */
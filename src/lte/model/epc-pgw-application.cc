@@ -138,6 +138,7 @@ EpcPgwApplication::DoDispose ()
   m_s5uSocket = 0;
   m_s5cSocket->SetRecvCallback (MakeNullCallback<void, Ptr<Socket> > ());
   m_s5cSocket = 0;
+  m_s5uDirectPath = MakeNullCallback<void, Ptr<Packet>, uint32_t> ();
 }
 
 EpcPgwApplication::EpcPgwApplication (const Ptr<VirtualNetDevice> tunDevice, Ipv4Address s5Addr,
@@ -247,6 +248,31 @@ EpcPgwApplication::RecvFromS5uSocket (Ptr<Socket> socket)
   SendToTunDevice (packet, teid);
 }
 
+void
+EpcPgwApplication::RecvFromS5u (Ptr<Packet> packet, uint32_t teid)
+{
+  NS_LOG_FUNCTION (this << packet << teid);
+  if (!m_rxS5PktTrace.IsEmpty ())
+    {
+      // trace the packet as received from the S5-U socket, with the
+      // GTP-U header built by the SGW
+      Ptr<Packet> tracedPacket = packet->Copy ();
+      GtpuHeader gtpu;
+      gtpu.SetTeid (teid);
+      gtpu.SetLength (packet->GetSize () + gtpu.GetSerializedSize () - 8);
+      tracedPacket->AddHeader (gtpu);
+      m_rxS5PktTrace (tracedPacket);
+    }
+  SendToTunDevice (packet, teid);
+}
+
+void
+EpcPgwApplication::SetS5uDirectPath (Callback<void, Ptr<Packet>, uint32_t> sendToSgw)
+{
+  NS_LOG_FUNCTION (this);
+  m_s5uDirectPath = sendToSgw;
+}
+
 void
 EpcPgwApplication::RecvFromS5cSocket (Ptr<Socket> socket)
 {
@@ -461,6 +487,12 @@ EpcPgwApplication::SendToS5uSocket (Ptr<Packet> packet, Ipv4Address sgwAddr, uin
 {
   NS_LOG_FUNCTION (this << packet << sgwAddr << teid);
 
+  if (!m_s5uDirectPath.IsNull ())
+    {
+      m_s5uDirectPath (packet, teid);
+      return;
+    }
+
   GtpuHeader gtpu;
   gtpu.SetTeid (teid);
   // From 3GPP TS 29.281 v10.0.0 Section 5.1
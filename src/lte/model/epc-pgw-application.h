@@ -98,6 +98,24 @@ public:
    */
   void RecvFromS5uSocket (Ptr<Socket> socket);
 
+  /**
+   * Receive a data packet from the SGW, without GTP-U header, that is
+   * to be forwarded to the internet.
+   *
+   * \param packet the data packet
+   * \param teid the Tunnel Endpoint IDentifier of the packet
+   */
+  void RecvFromS5u (Ptr<Packet> packet, uint32_t teid);
+
+  /**
+   * Hand the data packets directly to the SGW, instead of sending them
+   * over GTP-U/UDP/IP through the S5-U socket.
+   *
+   * \param sendToSgw the callback receiving each packet, without any
+   * GTP-U header, and its TEID
+   */
+  void SetS5uDirectPath (Callback<void, Ptr<Packet>, uint32_t> sendToSgw);
+
   /**
    * Method to be assigned to the receiver callback of the S5-C socket.
    * It is called when the PGW receives a control packet from the SGW.
@@ -286,6 +304,11 @@ private:
    */
   Ptr<Socket> m_s5uSocket;
 
+  /**
+   * direct path to the SGW, bypassing the S5-U socket when not null
+   */
+  Callback<void, Ptr<Packet>, uint32_t> m_s5uDirectPath;
+
   /**
    * UDP socket to send/receive GTPv2-C packets to/from the S5 interface
    */
@@ -333,7 +356,8 @@ private:
   TracedCallback<Ptr<Packet> > m_rxTunPktTrace;
 
   /**
-   * \brief Callback to trace received data packets from S5 socket.
+   * \brief Callback to trace received data packets from S5 socket, with
+   * their GTP-U header, also added to the packets of the direct path.
    */
   TracedCallback<Ptr<Packet> > m_rxS5PktTrace;
 };
@@ -59,6 +59,8 @@ EpcSgwApplication::DoDispose ()
   m_s5uSocket = 0;
   m_s5cSocket->SetRecvCallback (MakeNullCallback<void, Ptr<Socket> > ());
   m_s5cSocket = 0;
+  m_s5uDirectPath = MakeNullCallback<void, Ptr<Packet>, uint32_t> ();
+  m_s1uDirectPaths.clear ();
 }
 
 TypeId
@@ -97,6 +99,20 @@ EpcSgwApplication::AddEnb (uint16_t cellId, Ipv4Address enbAddr, Ipv4Address sgw
   m_enbInfoByCellId[cellId] = enbInfo;
 }
 
+void
+EpcSgwApplication::SetS5uDirectPath (Callback<void, Ptr<Packet>, uint32_t> sendToPgw)
+{
+  NS_LOG_FUNCTION (this);
+  m_s5uDirectPath = sendToPgw;
+}
+
+void
+EpcSgwApplication::AddS1uDirectPath (Ipv4Address enbAddr, Callback<void, Ptr<Packet>, uint32_t> sendToEnb)
+{
+  NS_LOG_FUNCTION (this << enbAddr);
+  m_s1uDirectPaths[enbAddr] = sendToEnb;
+}
+
 
 void
 EpcSgwApplication::RecvFromS11Socket (Ptr<Socket> socket)
@@ -141,8 +157,13 @@ EpcSgwApplication::RecvFromS5uSocket (Ptr<Socket> socket)
   Ptr<Packet> packet = socket->Recv ();
   GtpuHeader gtpu;
   packet->RemoveHeader (gtpu);
-  uint32_t teid = gtpu.GetTeid ();
+  RecvFromS5u (packet, gtpu.GetTeid ());
+}
 
+void
+EpcSgwApplication::RecvFromS5u (Ptr<Packet> packet, uint32_t teid)
+{
+  NS_LOG_FUNCTION (this << packet << teid);
   Ipv4Address enbAddr = m_enbByTeidMap[teid];
   NS_LOG_DEBUG ("eNB " << enbAddr << " TEID " << teid);
   SendToS1uSocket (packet, enbAddr, teid);
@@ -186,8 +207,13 @@ EpcSgwApplication::RecvFromS1uSocket (Ptr<Socket> socket)
   Ptr<Packet> packet = socket->Recv ();
   GtpuHeader gtpu;
   packet->RemoveHeader (gtpu);
-  uint32_t teid = gtpu.GetTeid ();
+  RecvFromS1u (packet, gtpu.GetTeid ());
+}
 
+void
+EpcSgwApplication::RecvFromS1u (Ptr<Packet> packet, uint32_t teid)
+{
+  NS_LOG_FUNCTION (this << packet << teid);
   SendToS5uSocket (packet, m_pgwAddr, teid);
 }
 
@@ -196,6 +222,13 @@ EpcSgwApplication::SendToS1uSocket (Ptr<Packet> packet, Ipv4Address enbAddr, uin
 {
   NS_LOG_FUNCTION (this << packet << enbAddr << teid);
 
+  std::map<Ipv4Address, Callback<void, Ptr<Packet>, uint32_t> >::iterator it = m_s1uDirectPaths.find (enbAddr);
+  if (it != m_s1uDirectPaths.end ())
+    {
+      it->second (packet, teid);
+      return;
+    }
+
   GtpuHeader gtpu;
   gtpu.SetTeid (teid);
   // From 3GPP TS 29.281 v10.0.0 Section 5.1
@@ -210,6 +243,12 @@ EpcSgwApplication::SendToS5uSocket (Ptr<Packet> packet, Ipv4Address pgwAddr, uin
 {
   NS_LOG_FUNCTION (this << packet << pgwAddr << teid);
 
+  if (!m_s5uDirectPath.IsNull ())
+    {
+      m_s5uDirectPath (packet, teid);
+      return;
+    }
+
   GtpuHeader gtpu;
   gtpu.SetTeid (teid);
   // From 3GPP TS 29.281 v10.0.0 Section 5.1
@@ -95,6 +95,43 @@ public:
    */
   void AddEnb (uint16_t cellId, Ipv4Address enbAddr, Ipv4Address sgwAddr);
 
+  /**
+   * Hand the data packets directly to the PGW, instead of sending them
+   * over GTP-U/UDP/IP through the S5-U socket.
+   *
+   * \param sendToPgw the callback receiving each packet, without any
+   * GTP-U header, and its TEID
+   */
+  void SetS5uDirectPath (Callback<void, Ptr<Packet>, uint32_t> sendToPgw);
+
+  /**
+   * Hand the data packets for an eNB directly to it, instead of sending
+   * them over GTP-U/UDP/IP through the S1-U socket.
+   *
+   * \param enbAddr the address of the S1-U interface of the eNB
+   * \param sendToEnb the callback receiving each packet, without any
+   * GTP-U header, and its TEID
+   */
+  void AddS1uDirectPath (Ipv4Address enbAddr, Callback<void, Ptr<Packet>, uint32_t> sendToEnb);
+
+  /**
+   * Receive a data packet from an eNB, once the GTP-U header is
+   * removed, that is to be forwarded to the PGW.
+   *
+   * \param packet the data packet
+   * \param teid the Tunnel Endpoint IDentifier of the packet
+   */
+  void RecvFromS1u (Ptr<Packet> packet, uint32_t teid);
+
+  /**
+   * Receive a data packet from the PGW, once the GTP-U header is
+   * removed, that is to be forwarded to an eNB.
+   *
+   * \param packet the data packet
+   * \param teid the Tunnel Endpoint IDentifier of the packet
+   */
+  void RecvFromS5u (Ptr<Packet> packet, uint32_t teid);
+
 
 private:
   /**
@@ -233,6 +270,16 @@ private:
   */
   Ptr<Socket> m_s1uSocket;
 
+  /**
+   * direct path to the PGW, bypassing the S5-U socket when not null
+   */
+  Callback<void, Ptr<Packet>, uint32_t> m_s5uDirectPath;
+
+  /**
+   * direct paths to the eNBs, by S1-U address, bypassing the S1-U socket
+   */
+  std::map<Ipv4Address, Callback<void, Ptr<Packet>, uint32_t> > m_s1uDirectPaths;
+
   /**
    * UDP port to be used for GTP-U
    */
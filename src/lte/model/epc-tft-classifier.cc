@@ -26,11 +26,10 @@
 #include "epc-tft-classifier.h"
 #include "epc-tft.h"
 #include "ns3/log.h"
+#include "ns3/abort.h"
 #include "ns3/packet.h"
-#include "ns3/ipv4-header.h"
-#include "ns3/ipv6-header.h"
-#include "ns3/udp-header.h"
-#include "ns3/tcp-header.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/ipv6-address.h"
 #include "ns3/ipv4-l3-protocol.h"
 #include "ns3/icmpv4-l4-protocol.h"
 #include "ns3/udp-l4-protocol.h"
@@ -38,6 +37,8 @@
 #include "ns3/ipv6-l3-protocol.h"
 #include "ns3/icmpv6-l4-protocol.h"
 
+#include <cstring>
+
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("EpcTftClassifier");
@@ -52,6 +53,7 @@ EpcTftClassifier::Add (Ptr<EpcTft> tft, uint32_t id)
 {
   NS_LOG_FUNCTION (this << tft << id);
   m_tftMap[id] = tft;
+  m_flowCache.clear ();
 
   // simple sanity check: there shouldn't be more than 16 bearers (hence TFTs) per UE
   NS_ASSERT (m_tftMap.size () <= 16);
@@ -62,6 +64,26 @@ EpcTftClassifier::Delete (uint32_t id)
 {
   NS_LOG_FUNCTION (this << id);
   m_tftMap.erase (id);
+  m_flowCache.clear ();
+}
+
+bool
+EpcTftClassifier::FlowKeyEqual::operator() (const FlowKey &a, const FlowKey &b) const
+{
+  return std::memcmp (&a, &b, sizeof (FlowKey)) == 0;
+}
+
+std::size_t
+EpcTftClassifier::FlowKeyHash::operator() (const FlowKey &k) const
+{
+  // FNV-1a over the bytes of the key, which has no padding
+  const uint8_t *bytes = reinterpret_cast<const uint8_t *> (&k);
+  uint32_t hash = 2166136261U;
+  for (uint32_t i = 0; i < sizeof (FlowKey); ++i)
+    {
+      hash = (hash ^ bytes[i]) * 16777619U;
+    }
+  return hash;
 }
 
 uint32_t 
@@ -69,47 +91,46 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction, uint16_t
 {
   NS_LOG_FUNCTION (this << p << p->GetSize () << direction);
 
-  Ptr<Packet> pCopy = p->Copy ();
-
-  Ipv4Address localAddressIpv4;
-  Ipv4Address remoteAddressIpv4;
+  // Only the IP header and the port numbers are needed: read them from
+  // the packet buffer instead of deserializing the headers of a copy of
+  // the packet.  Sizes: IPv4 header with options (60) or IPv6 header
+  // (40), plus the UDP/TCP ports (4).
+  uint8_t buffer[64];
+  uint32_t size = p->CopyData (buffer, sizeof (buffer));
 
-  Ipv6Address localAddressIpv6;
-  Ipv6Address remoteAddressIpv6;
+  FlowKey key;
+  std::memset (&key, 0, sizeof (key));
+  key.protocolNumber = protocolNumber;
+  key.direction = direction;
 
-  uint8_t protocol;
-  uint8_t tos;
-
-  uint16_t localPort = 0;
-  uint16_t remotePort = 0;
+  uint8_t *sourceAddress = (direction == EpcTft::UPLINK) ? key.localAddress : key.remoteAddress;
+  uint8_t *destinationAddress = (direction == EpcTft::UPLINK) ? key.remoteAddress : key.localAddress;
+  uint16_t *sourcePort = (direction == EpcTft::UPLINK) ? &key.localPort : &key.remotePort;
+  uint16_t *destinationPort = (direction == EpcTft::UPLINK) ? &key.remotePort : &key.localPort;
+  NS_ASSERT (direction == EpcTft::UPLINK || direction == EpcTft::DOWNLINK);
 
   if (protocolNumber == Ipv4L3Protocol::PROT_NUMBER)
     {
-      Ipv4Header ipv4Header;
-      pCopy->RemoveHeader (ipv4Header);
-
-      if (direction ==  EpcTft::UPLINK)
-        {
-          localAddressIpv4 = ipv4Header.GetSource ();
-          remoteAddressIpv4 = ipv4Header.GetDestination ();
-        }
-      else
-        {
-          NS_ASSERT (direction ==  EpcTft::DOWNLINK);
-          remoteAddressIpv4 = ipv4Header.GetSource ();
-          localAddressIpv4 = ipv4Header.GetDestination ();
-        }
-      NS_LOG_INFO ("local address: " << localAddressIpv4 << " remote address: " << remoteAddressIpv4);
-
-      uint16_t payloadSize = ipv4Header.GetPayloadSize ();
-      uint16_t fragmentOffset = ipv4Header.GetFragmentOffset ();
-      bool isLastFragment = ipv4Header.IsLastFragment ();
+      NS_ABORT_MSG_IF (size < 20, "EpcTftClassifier::Classify - truncated IPv4 header");
+      uint32_t headerSize = (buffer[0] & 0x0f) * 4;
+      key.tos = buffer[1];
+      uint16_t payloadSize = ((buffer[2] << 8) | buffer[3]) - headerSize;
+      uint16_t identification = (buffer[4] << 8) | buffer[5];
+      uint16_t fragment = (buffer[6] << 8) | buffer[7];
+      uint16_t fragmentOffset = fragment & 0x1fff;
+      bool isLastFragment = (fragment & 0x2000) == 0;
+      uint8_t protocol = buffer[9];
+      std::memcpy (sourceAddress, buffer + 12, 4);
+      std::memcpy (destinationAddress, buffer + 16, 4);
 
       // NS_LOG_DEBUG ("PayloadSize = " << payloadSize);
       // NS_LOG_DEBUG ("fragmentOffset " << fragmentOffset << " isLastFragment " << isLastFragment);
 
-      protocol = ipv4Header.GetProtocol ();
-      tos = ipv4Header.GetTos ();
+      std::tuple<uint32_t, uint32_t, uint8_t, uint16_t> fragmentKey =
+          std::make_tuple (Ipv4Address::Deserialize (buffer + 12).Get (),
+                           Ipv4Address::Deserialize (buffer + 16).Get (),
+                           protocol,
+                           identification);
 
       // Port info only can be get if it is the first fragment and
       // there is enough data in the payload
@@ -117,55 +138,15 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction, uint16_t
       // i.e. it is the first one but it is not the last one
       if (fragmentOffset == 0)
         {
-          if (protocol == UdpL4Protocol::PROT_NUMBER && payloadSize >= 8)
+          if ((protocol == UdpL4Protocol::PROT_NUMBER && payloadSize >= 8)
+              || (protocol == TcpL4Protocol::PROT_NUMBER && payloadSize >= 20))
             {
-              UdpHeader udpHeader;
-              pCopy->RemoveHeader (udpHeader);
-              if (direction ==  EpcTft::UPLINK)
-                {
-                  localPort = udpHeader.GetSourcePort ();
-                  remotePort = udpHeader.GetDestinationPort ();
-                }
-              else
-                {
-                  remotePort = udpHeader.GetSourcePort ();
-                  localPort = udpHeader.GetDestinationPort ();
-                }
+              NS_ABORT_MSG_IF (size < headerSize + 4, "EpcTftClassifier::Classify - truncated L4 header");
+              *sourcePort = (buffer[headerSize] << 8) | buffer[headerSize + 1];
+              *destinationPort = (buffer[headerSize + 2] << 8) | buffer[headerSize + 3];
               if (!isLastFragment)
                 {
-                  std::tuple<uint32_t, uint32_t, uint8_t, uint16_t> fragmentKey =
-                      std::make_tuple (ipv4Header.GetSource ().Get (),
-                                       ipv4Header.GetDestination ().Get (),
-                                       protocol,
-                                       ipv4Header.GetIdentification ());
-
-                  m_classifiedIpv4Fragments[fragmentKey] = std::make_pair (localPort, remotePort);
-                }
-            }
-          else if (protocol == TcpL4Protocol::PROT_NUMBER && payloadSize >= 20)
-            {
-              TcpHeader tcpHeader;
-              pCopy->RemoveHeader (tcpHeader);
-              if (direction ==  EpcTft::UPLINK)
-                {
-                  localPort = tcpHeader.GetSourcePort ();
-                  remotePort = tcpHeader.GetDestinationPort ();
-                }
-              else
-                {
-                  remotePort = tcpHeader.GetSourcePort ();
-                  localPort = tcpHeader.GetDestinationPort ();
-                }
-
-              if (!isLastFragment)
-                {
-                  std::tuple<uint32_t, uint32_t, uint8_t, uint16_t> fragmentKey =
-                      std::make_tuple (ipv4Header.GetSource ().Get (),
-                                       ipv4Header.GetDestination ().Get (),
-                                       protocol,
-                                       ipv4Header.GetIdentification ());
-
-                  m_classifiedIpv4Fragments[fragmentKey] = std::make_pair (localPort, remotePort);
+                  m_classifiedIpv4Fragments[fragmentKey] = std::make_pair (key.localPort, key.remotePort);
                 }
             }
 
@@ -177,79 +158,35 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction, uint16_t
         {
           // Not first fragment, so port info is not available but
           // port info should already be known (if there is not fragment reordering)
-          std::tuple<uint32_t, uint32_t, uint8_t, uint16_t> fragmentKey =
-              std::make_tuple (ipv4Header.GetSource ().Get (),
-                               ipv4Header.GetDestination ().Get (),
-                               protocol,
-                               ipv4Header.GetIdentification ());
-
           std::map< std::tuple<uint32_t, uint32_t, uint8_t, uint16_t>,
                     std::pair<uint32_t, uint32_t> >::iterator it =
               m_classifiedIpv4Fragments.find (fragmentKey);
 
           if (it != m_classifiedIpv4Fragments.end ())
             {
-              localPort = it->second.first;
-              remotePort = it->second.second;
+              key.localPort = it->second.first;
+              key.remotePort = it->second.second;
 
               if (isLastFragment)
                 {
-                  m_classifiedIpv4Fragments.erase (fragmentKey);
+                  m_classifiedIpv4Fragments.erase (it);
                 }
             }
         }
     }
   else if (protocolNumber == Ipv6L3Protocol::PROT_NUMBER)
     {
-      Ipv6Header ipv6Header;
-      pCopy->RemoveHeader (ipv6Header);
-
-      if (direction ==  EpcTft::UPLINK)
-        {
-          localAddressIpv6 = ipv6Header.GetSourceAddress ();
-          remoteAddressIpv6 = ipv6Header.GetDestinationAddress ();
-        }
-      else
-        {
-          NS_ASSERT (direction ==  EpcTft::DOWNLINK);
-          remoteAddressIpv6 = ipv6Header.GetSourceAddress ();
-          localAddressIpv6 = ipv6Header.GetDestinationAddress ();
-        }
-      NS_LOG_INFO ("local address: " << localAddressIpv6 << " remote address: " << remoteAddressIpv6);
-
-      protocol = ipv6Header.GetNextHeader ();
-      tos = ipv6Header.GetTrafficClass ();
+      NS_ABORT_MSG_IF (size < 40, "EpcTftClassifier::Classify - truncated IPv6 header");
+      key.tos = ((buffer[0] & 0x0f) << 4) | (buffer[1] >> 4);
+      uint8_t protocol = buffer[6];
+      std::memcpy (sourceAddress, buffer + 8, 16);
+      std::memcpy (destinationAddress, buffer + 24, 16);
 
-      if (protocol == UdpL4Protocol::PROT_NUMBER)
+      if (protocol == UdpL4Protocol::PROT_NUMBER || protocol == TcpL4Protocol::PROT_NUMBER)
         {
-          UdpHeader udpHeader;
-          pCopy->RemoveHeader (udpHeader);
-
-          if (direction ==  EpcTft::UPLINK)
-            {
-              localPort = udpHeader.GetSourcePort ();
-              remotePort = udpHeader.GetDestinationPort ();
-            }
-          else
-            {
-              remotePort = udpHeader.GetSourcePort ();
-              localPort = udpHeader.GetDestinationPort ();
-            }
-        }
-      else if (protocol == TcpL4Protocol::PROT_NUMBER)
-        {
-          TcpHeader tcpHeader;
-          pCopy->RemoveHeader (tcpHeader);
-          if (direction ==  EpcTft::UPLINK)
-            {
-              localPort = tcpHeader.GetSourcePort ();
-              remotePort = tcpHeader.GetDestinationPort ();
-            }
-          else
-            {
-              remotePort = tcpHeader.GetSourcePort ();
-              localPort = tcpHeader.GetDestinationPort ();
-            }
+          NS_ABORT_MSG_IF (size < 44, "EpcTftClassifier::Classify - truncated L4 header");
+          *sourcePort = (buffer[40] << 8) | buffer[41];
+          *destinationPort = (buffer[42] << 8) | buffer[43];
         }
     }
   else
@@ -257,15 +194,37 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction, uint16_t
       NS_ABORT_MSG ("EpcTftClassifier::Classify - Unknown IP type...");
     }
 
+  std::unordered_map<FlowKey, uint32_t, FlowKeyHash, FlowKeyEqual>::const_iterator cached = m_flowCache.find (key);
+  if (cached != m_flowCache.end ())
+    {
+      NS_LOG_LOGIC ("cached classification: TFT ID = " << cached->second);
+      return cached->second;
+    }
 
-  if (protocolNumber == Ipv4L3Protocol::PROT_NUMBER)
+  uint32_t id = Match (key);
+  if (m_flowCache.size () >= MAX_CACHED_FLOWS)
     {
+      m_flowCache.clear ();
+    }
+  m_flowCache.insert (std::make_pair (key, id));
+  return id;
+}
+
+uint32_t
+EpcTftClassifier::Match (const FlowKey &key) const
+{
+  EpcTft::Direction direction = static_cast<EpcTft::Direction> (key.direction);
+
+  if (key.protocolNumber == Ipv4L3Protocol::PROT_NUMBER)
+    {
+      Ipv4Address localAddressIpv4 = Ipv4Address::Deserialize (key.localAddress);
+      Ipv4Address remoteAddressIpv4 = Ipv4Address::Deserialize (key.remoteAddress);
       NS_LOG_INFO ("Classifying packet:"
           << " localAddr="  << localAddressIpv4
           << " remoteAddr=" << remoteAddressIpv4
-          << " localPort="  << localPort
-          << " remotePort=" << remotePort
-          << " tos=0x" << (uint16_t) tos );
+          << " localPort="  << key.localPort
+          << " remotePort=" << key.remotePort
+          << " tos=0x" << (uint16_t) key.tos );
 
       // now it is possible to classify the packet!
       // we use a reverse iterator since filter priority is not implemented properly.
@@ -278,21 +237,23 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction, uint16_t
           NS_LOG_LOGIC ("TFT id: " << it->first );
           NS_LOG_LOGIC (" Ptr<EpcTft>: " << it->second);
           Ptr<EpcTft> tft = it->second;
-          if (tft->Matches (direction, remoteAddressIpv4, localAddressIpv4, remotePort, localPort, tos))
+          if (tft->Matches (direction, remoteAddressIpv4, localAddressIpv4, key.remotePort, key.localPort, key.tos))
             {
               NS_LOG_LOGIC ("matches with TFT ID = " << it->first);
               return it->first; // the id of the matching TFT
             }
         }
     }
-  else if (protocolNumber == Ipv6L3Protocol::PROT_NUMBER)
+  else if (key.protocolNumber == Ipv6L3Protocol::PROT_NUMBER)
     {
+      Ipv6Address localAddressIpv6 = Ipv6Address::Deserialize (key.localAddress);
+      Ipv6Address remoteAddressIpv6 = Ipv6Address::Deserialize (key.remoteAddress);
       NS_LOG_INFO ("Classifying packet:"
           << " localAddr="  << localAddressIpv6
           << " remoteAddr=" << remoteAddressIpv6
-          << " localPort="  << localPort
-          << " remotePort=" << remotePort
-          << " tos=0x" << (uint16_t) tos );
+          << " localPort="  << key.localPort
+          << " remotePort=" << key.remotePort
+          << " tos=0x" << (uint16_t) key.tos );
 
       // now it is possible to classify the packet!
       // we use a reverse iterator since filter priority is not implemented properly.
@@ -305,7 +266,7 @@ EpcTftClassifier::Classify (Ptr<Packet> p, EpcTft::Direction direction, uint16_t
           NS_LOG_LOGIC ("TFT id: " << it->first );
           NS_LOG_LOGIC (" Ptr<EpcTft>: " << it->second);
           Ptr<EpcTft> tft = it->second;
-          if (tft->Matches (direction, remoteAddressIpv6, localAddressIpv6, remotePort, localPort, tos))
+          if (tft->Matches (direction, remoteAddressIpv6, localAddressIpv6, key.remotePort, key.localPort, key.tos))
             {
               NS_LOG_LOGIC ("matches with TFT ID = " << it->first);
               return it->first; // the id of the matching TFT
@@ -28,6 +28,7 @@
 #include "ns3/epc-tft.h"
 
 #include <map>
+#include <unordered_map>
 
 
 namespace ns3 {
@@ -50,6 +51,13 @@ class Packet;
  *
  * When we cannot cache the port info, the TFT of the default bearer is used. This may happen
  * if there is reordering or losses of IP packets.
+ *
+ * The IP header and the port numbers are read directly from the packet
+ * buffer, without copying the packet.  The result of the classification
+ * of each flow (direction, addresses, ports and ToS) is cached, so the
+ * TFTs are evaluated only for the first packet of a flow.  The cache is
+ * flushed whenever a TFT is added or deleted; a TFT must not be modified
+ * after it has been added to the classifier.
  */
 class EpcTftClassifier : public SimpleRefCount<EpcTftClassifier>
 {
@@ -86,9 +94,56 @@ public:
   uint32_t Classify (Ptr<Packet> p, EpcTft::Direction direction, uint16_t protocolNumber);
   
 protected:
-  
+
+  /// Flow identifier used as the key of the classification cache
+  struct FlowKey
+  {
+    uint8_t localAddress[16];  ///< local IPv6 address, or IPv4 address in the first 4 bytes
+    uint8_t remoteAddress[16]; ///< remote IPv6 address, or IPv4 address in the first 4 bytes
+    uint16_t localPort;        ///< local port
+    uint16_t remotePort;       ///< remote port
+    uint16_t protocolNumber;   ///< IPv4 or IPv6 protocol number
+    uint8_t tos;               ///< type of service, or IPv6 traffic class
+    uint8_t direction;         ///< EpcTft::Direction of the packet
+  };
+
+  /// Equality of two FlowKey
+  struct FlowKeyEqual
+  {
+    /**
+     * \param a the first flow
+     * \param b the second flow
+     * \return true if the flows are the same
+     */
+    bool operator() (const FlowKey &a, const FlowKey &b) const;
+  };
+
+  /// Hash of a FlowKey
+  struct FlowKeyHash
+  {
+    /**
+     * \param k the flow
+     * \return the hash of the flow
+     */
+    std::size_t operator() (const FlowKey &k) const;
+  };
+
+  /**
+   * Find the first TFT matching a flow.
+   *
+   * \param key the flow
+   * \return the identifier (>0) of the first TFT that matches with the flow; 0 if no TFT matched.
+   */
+  uint32_t Match (const FlowKey &key) const;
+
+  /// Maximum number of flows in the classification cache
+  static const uint32_t MAX_CACHED_FLOWS = 4096;
+
   std::map <uint32_t, Ptr<EpcTft> > m_tftMap; ///< TFT map
 
+  /// Classification cache: TFT identifier (or 0) of each flow seen
+  std::unordered_map<FlowKey, uint32_t, FlowKeyHash, FlowKeyEqual> m_flowCache;
+
   std::map < std::tuple<uint32_t, uint32_t, uint8_t, uint16_t>,
              std::pair<uint32_t, uint32_t> >
       m_classifiedIpv4Fragments; ///< Map with already classified IPv4 Fragments
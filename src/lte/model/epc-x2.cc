@@ -22,6 +22,7 @@
 #include "ns3/inet-socket-address.h"
 #include "ns3/packet.h"
 #include "ns3/node.h"
+#include "ns3/simulator.h"
 #include "ns3/epc-gtpu-header.h"
 
 #include "ns3/epc-x2-header.h"
@@ -102,6 +103,7 @@ EpcX2::DoDispose (void)
 
   m_x2InterfaceSockets.clear ();
   m_x2InterfaceCellIds.clear ();
+  m_idealX2Peers.clear ();
   delete m_x2SapProvider;
 }
 
@@ -152,7 +154,8 @@ EpcX2::AddX2Interface (uint16_t localCellId, Ipv4Address localX2Address, uint16_
   localX2uSocket->SetRecvCallback (MakeCallback (&EpcX2::RecvFromX2uSocket, this));
 
 
-  NS_ASSERT_MSG (m_x2InterfaceSockets.find (remoteCellId) == m_x2InterfaceSockets.end (),
+  NS_ASSERT_MSG (m_x2InterfaceSockets.find (remoteCellId) == m_x2InterfaceSockets.end ()
+                 && m_idealX2Peers.find (remoteCellId) == m_idealX2Peers.end (),
                  "Mapping for remoteCellId = " << remoteCellId << " is already known");
   m_x2InterfaceSockets [remoteCellId] = Create<X2IfaceInfo> (remoteX2Address, localX2cSocket, localX2uSocket);
 
@@ -166,6 +169,34 @@ EpcX2::AddX2Interface (uint16_t localCellId, Ipv4Address localX2Address, uint16_
 }
 
 
+void
+EpcX2::AddIdealX2Interface (uint16_t localCellId, uint16_t remoteCellId, Ptr<EpcX2> remoteX2, Time delay)
+{
+  NS_LOG_FUNCTION (this << localCellId << remoteCellId << remoteX2 << delay);
+
+  NS_ASSERT_MSG (m_x2InterfaceSockets.find (remoteCellId) == m_x2InterfaceSockets.end ()
+                 && m_idealX2Peers.find (remoteCellId) == m_idealX2Peers.end (),
+                 "Mapping for remoteCellId = " << remoteCellId << " is already known");
+  Ptr<Node> remoteEnb = remoteX2->GetObject<Node> ();
+  NS_ASSERT_MSG (remoteEnb != 0, "EpcX2 of remoteCellId = " << remoteCellId << " is not aggregated to a node");
+
+  IdealX2Peer peer;
+  peer.localCellId = localCellId;
+  peer.remoteX2 = remoteX2;
+  peer.remoteNodeId = remoteEnb->GetId ();
+  peer.delay = delay;
+  m_idealX2Peers [remoteCellId] = peer;
+}
+
+
+const EpcX2::IdealX2Peer *
+EpcX2::GetIdealX2Peer (uint16_t remoteCellId) const
+{
+  std::map<uint16_t, IdealX2Peer>::const_iterator it = m_idealX2Peers.find (remoteCellId);
+  return (it == m_idealX2Peers.end ()) ? 0 : &(it->second);
+}
+
+
 void 
 EpcX2::RecvFromX2cSocket (Ptr<Socket> socket)
 {
@@ -410,6 +441,18 @@ EpcX2::DoSendHandoverRequest (EpcX2SapProvider::HandoverRequestParams params)
   NS_LOG_LOGIC ("targetCellId = " << params.targetCellId);
   NS_LOG_LOGIC ("mmeUeS1apId  = " << params.mmeUeS1apId);
 
+  const IdealX2Peer *peer = GetIdealX2Peer (params.targetCellId);
+  if (peer != 0)
+    {
+      NS_LOG_INFO ("Deliver X2 message: HANDOVER REQUEST");
+      params.sourceCellId = peer->localCellId;
+      params.rrcContext = (params.rrcContext != 0) ? (params.rrcContext->Copy ()) : (Create <Packet> ());
+      Simulator::ScheduleWithContext (peer->remoteNodeId, peer->delay,
+                                      &EpcX2SapUser::RecvHandoverRequest,
+                                      peer->remoteX2->m_x2SapUser, params);
+      return;
+    }
+
   NS_ASSERT_MSG (m_x2InterfaceSockets.find (params.targetCellId) != m_x2InterfaceSockets.end (),
                  "Missing infos for targetCellId = " << params.targetCellId);
   Ptr<X2IfaceInfo> socketInfo = m_x2InterfaceSockets [params.targetCellId];
@@ -461,6 +504,18 @@ EpcX2::DoSendHandoverRequestAck (EpcX2SapProvider::HandoverRequestAckParams para
   NS_LOG_LOGIC ("sourceCellId = " << params.sourceCellId);
   NS_LOG_LOGIC ("targetCellId = " << params.targetCellId);
 
+  const IdealX2Peer *peer = GetIdealX2Peer (params.sourceCellId);
+  if (peer != 0)
+    {
+      NS_LOG_INFO ("Deliver X2 message: HANDOVER REQUEST ACK");
+      params.targetCellId = peer->localCellId;
+      params.rrcContext = (params.rrcContext != 0) ? (params.rrcContext->Copy ()) : (Create <Packet> ());
+      Simulator::ScheduleWithContext (peer->remoteNodeId, peer->delay,
+                                      &EpcX2SapUser::RecvHandoverRequestAck,
+                                      peer->remoteX2->m_x2SapUser, params);
+      return;
+    }
+
   NS_ASSERT_MSG (m_x2InterfaceSockets.find (params.sourceCellId) != m_x2InterfaceSockets.end (),
                  "Socket infos not defined for sourceCellId = " << params.sourceCellId);
 
@@ -511,6 +566,17 @@ EpcX2::DoSendHandoverPreparationFailure (EpcX2SapProvider::HandoverPreparationFa
   NS_LOG_LOGIC ("cause = " << params.cause);
   NS_LOG_LOGIC ("criticalityDiagnostics = " << params.criticalityDiagnostics);
 
+  const IdealX2Peer *peer = GetIdealX2Peer (params.sourceCellId);
+  if (peer != 0)
+    {
+      NS_LOG_INFO ("Deliver X2 message: HANDOVER PREPARATION FAILURE");
+      params.targetCellId = peer->localCellId;
+      Simulator::ScheduleWithContext (peer->remoteNodeId, peer->delay,
+                                      &EpcX2SapUser::RecvHandoverPreparationFailure,
+                                      peer->remoteX2->m_x2SapUser, params);
+      return;
+    }
+
   NS_ASSERT_MSG (m_x2InterfaceSockets.find (params.sourceCellId) != m_x2InterfaceSockets.end (),
                  "Socket infos not defined for sourceCellId = " << params.sourceCellId);
 
@@ -559,6 +625,17 @@ EpcX2::DoSendSnStatusTransfer (EpcX2SapProvider::SnStatusTransferParams params)
   NS_LOG_LOGIC ("targetCellId = " << params.targetCellId);
   NS_LOG_LOGIC ("erabsList size = " << params.erabsSubjectToStatusTransferList.size ());
 
+  const IdealX2Peer *peer = GetIdealX2Peer (params.targetCellId);
+  if (peer != 0)
+    {
+      NS_LOG_INFO ("Deliver X2 message: SN STATUS TRANSFER");
+      params.sourceCellId = peer->localCellId;
+      Simulator::ScheduleWithContext (peer->remoteNodeId, peer->delay,
+                                      &EpcX2SapUser::RecvSnStatusTransfer,
+                                      peer->remoteX2->m_x2SapUser, params);
+      return;
+    }
+
   NS_ASSERT_MSG (m_x2InterfaceSockets.find (params.targetCellId) != m_x2InterfaceSockets.end (),
                  "Socket infos not defined for targetCellId = " << params.targetCellId);
 
@@ -605,6 +682,16 @@ EpcX2::DoSendUeContextRelease (EpcX2SapProvider::UeContextReleaseParams params)
   NS_LOG_LOGIC ("newEnbUeX2apId = " << params.newEnbUeX2apId);
   NS_LOG_LOGIC ("sourceCellId = " << params.sourceCellId);
 
+  const IdealX2Peer *peer = GetIdealX2Peer (params.sourceCellId);
+  if (peer != 0)
+    {
+      NS_LOG_INFO ("Deliver X2 message: UE CONTEXT RELEASE");
+      Simulator::ScheduleWithContext (peer->remoteNodeId, peer->delay,
+                                      &EpcX2SapUser::RecvUeContextRelease,
+                                      peer->remoteX2->m_x2SapUser, params);
+      return;
+    }
+
   NS_ASSERT_MSG (m_x2InterfaceSockets.find (params.sourceCellId) != m_x2InterfaceSockets.end (),
                  "Socket infos not defined for sourceCellId = " << params.sourceCellId);
 
@@ -649,6 +736,16 @@ EpcX2::DoSendLoadInformation (EpcX2SapProvider::LoadInformationParams params)
   NS_LOG_LOGIC ("targetCellId = " << params.targetCellId);
   NS_LOG_LOGIC ("cellInformationList size = " << params.cellInformationList.size ());
 
+  const IdealX2Peer *peer = GetIdealX2Peer (params.targetCellId);
+  if (peer != 0)
+    {
+      NS_LOG_INFO ("Deliver X2 message: LOAD INFORMATION");
+      Simulator::ScheduleWithContext (peer->remoteNodeId, peer->delay,
+                                      &EpcX2SapUser::RecvLoadInformation,
+                                      peer->remoteX2->m_x2SapUser, params);
+      return;
+    }
+
   NS_ASSERT_MSG (m_x2InterfaceSockets.find (params.targetCellId) != m_x2InterfaceSockets.end (),
                  "Missing infos for targetCellId = " << params.targetCellId);
   Ptr<X2IfaceInfo> socketInfo = m_x2InterfaceSockets [params.targetCellId];
@@ -695,6 +792,17 @@ EpcX2::DoSendResourceStatusUpdate (EpcX2SapProvider::ResourceStatusUpdateParams
   NS_LOG_LOGIC ("enb2MeasurementId = " << params.enb2MeasurementId);
   NS_LOG_LOGIC ("cellMeasurementResultList size = " << params.cellMeasurementResultList.size ());
 
+  const IdealX2Peer *peer = GetIdealX2Peer (params.targetCellId);
+  if (peer != 0)
+    {
+      NS_LOG_INFO ("Deliver X2 message: RESOURCE STATUS UPDATE");
+      params.targetCellId = 0;
+      Simulator::ScheduleWithContext (peer->remoteNodeId, peer->delay,
+                                      &EpcX2SapUser::RecvResourceStatusUpdate,
+                                      peer->remoteX2->m_x2SapUser, params);
+      return;
+    }
+
   NS_ASSERT_MSG (m_x2InterfaceSockets.find (params.targetCellId) != m_x2InterfaceSockets.end (),
                  "Missing infos for targetCellId = " << params.targetCellId);
   Ptr<X2IfaceInfo> socketInfo = m_x2InterfaceSockets [params.targetCellId];
@@ -742,6 +850,18 @@ EpcX2::DoSendUeData (EpcX2SapProvider::UeDataParams params)
   NS_LOG_LOGIC ("targetCellId = " << params.targetCellId);
   NS_LOG_LOGIC ("gtpTeid = " << params.gtpTeid);
 
+  const IdealX2Peer *peer = GetIdealX2Peer (params.targetCellId);
+  if (peer != 0)
+    {
+      NS_LOG_INFO ("Deliver UE DATA through ideal X2 interface");
+      params.sourceCellId = peer->localCellId;
+      params.ueData = params.ueData->Copy ();
+      Simulator::ScheduleWithContext (peer->remoteNodeId, peer->delay,
+                                      &EpcX2SapUser::RecvUeData,
+                                      peer->remoteX2->m_x2SapUser, params);
+      return;
+    }
+
   NS_ASSERT_MSG (m_x2InterfaceSockets.find (params.targetCellId) != m_x2InterfaceSockets.end (),
                  "Missing infos for targetCellId = " << params.targetCellId);
   Ptr<X2IfaceInfo> socketInfo = m_x2InterfaceSockets [params.targetCellId];
@@ -773,6 +893,13 @@ EpcX2::DoSendHandoverCancel (EpcX2SapProvider::HandoverCancelParams params)
   NS_LOG_LOGIC ("sourceCellId = " << params.sourceCellId);
   NS_LOG_LOGIC ("targetCellId = " << params.targetCellId);
 
+  if (GetIdealX2Peer (params.targetCellId) != 0)
+    {
+      // the X2 SAP User has no primitive to receive it
+      NS_LOG_INFO ("Drop X2 message: HANDOVER CANCEL");
+      return;
+    }
+
   NS_ASSERT_MSG (m_x2InterfaceSockets.find (params.targetCellId) != m_x2InterfaceSockets.end (),
                  "Socket infos not defined for targetCellId = " << params.targetCellId);
 
@@ -25,6 +25,7 @@
 #include "ns3/callback.h"
 #include "ns3/ptr.h"
 #include "ns3/object.h"
+#include "ns3/nstime.h"
 
 #include "ns3/epc-x2-sap.h"
 
@@ -141,6 +142,21 @@ public:
   void AddX2Interface (uint16_t enb1CellId, Ipv4Address enb1X2Address,
                        uint16_t enb2CellId, Ipv4Address enb2X2Address);
 
+  /**
+   * Add an ideal X2 interface to this EPC X2 entity. The messages sent
+   * to the neighbouring eNodeB are handed directly to its X2 SAP User
+   * after the given delay, without being serialized nor sent through
+   * sockets. Handover Cancel messages, which have no receive
+   * primitive, are dropped.
+   *
+   * \param localCellId the cell ID of the current eNodeB
+   * \param remoteCellId the cell ID of the neighbouring eNodeB
+   * \param remoteX2 the EPC X2 entity of the neighbouring eNodeB
+   * \param delay the delay of the messages
+   */
+  void AddIdealX2Interface (uint16_t localCellId, uint16_t remoteCellId,
+                            Ptr<EpcX2> remoteX2, Time delay);
+
 
   /** 
    * Method to be assigned to the recv callback of the X2-C (X2 Control Plane) socket.
@@ -236,6 +252,28 @@ private:
    */
   uint16_t m_x2uUdpPort;
 
+  /// Peer eNodeB of an ideal X2 interface
+  struct IdealX2Peer
+  {
+    uint16_t localCellId;  ///< the local cell ID
+    Ptr<EpcX2> remoteX2;   ///< the EPC X2 entity of the peer
+    uint32_t remoteNodeId; ///< the ID of the node of the peer
+    Time delay;            ///< the delay of the messages
+  };
+
+  /**
+   * Look up the peer of an ideal X2 interface
+   *
+   * \param remoteCellId the cell ID of the peer
+   * \return the peer, or null if the X2 interface to the cell is not ideal
+   */
+  const IdealX2Peer * GetIdealX2Peer (uint16_t remoteCellId) const;
+
+  /**
+   * Map the remote cell ID to the peer of the ideal X2 interface
+   */
+  std::map <uint16_t, IdealX2Peer> m_idealX2Peers;
+
 };
 
 } //namespace ns3
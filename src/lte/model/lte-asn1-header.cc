@@ -21,16 +21,105 @@
 #include "ns3/log.h"
 #include "ns3/lte-asn1-header.h"
 
-#include <stdio.h>
 #include <sstream>
-#include <cmath>
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("Asn1Header");
 
+Asn1BitWriter::Asn1BitWriter ()
+  : m_pendingBits (0),
+    m_numPendingBits (0)
+{
+}
+
+void
+Asn1BitWriter::WriteBits (uint32_t value, uint8_t numBits)
+{
+  NS_ASSERT (numBits <= 32);
+  if (numBits == 0)
+    {
+      return;
+    }
+  m_pendingBits = (m_pendingBits << numBits) | (value & (0xffffffffULL >> (32 - numBits)));
+  m_numPendingBits += numBits;
+  while (m_numPendingBits >= 8)
+    {
+      m_numPendingBits -= 8;
+      m_octets.push_back (static_cast<uint8_t> (m_pendingBits >> m_numPendingBits));
+    }
+  m_pendingBits &= (1ULL << m_numPendingBits) - 1;
+}
+
+void
+Asn1BitWriter::Flush ()
+{
+  if (m_numPendingBits > 0)
+    {
+      WriteBits (0, 8 - m_numPendingBits);
+    }
+}
+
+void
+Asn1BitWriter::Clear ()
+{
+  m_octets.clear ();
+  m_pendingBits = 0;
+  m_numPendingBits = 0;
+}
+
+const std::vector<uint8_t> &
+Asn1BitWriter::GetOctets () const
+{
+  return m_octets;
+}
+
+Asn1BitReader::Asn1BitReader ()
+  : m_pendingBits (0),
+    m_numPendingBits (0)
+{
+}
+
+uint32_t
+Asn1BitReader::ReadBits (uint8_t numBits, Buffer::Iterator &bIterator)
+{
+  NS_ASSERT (numBits <= 32);
+  while (m_numPendingBits < numBits)
+    {
+      m_pendingBits = (m_pendingBits << 8) | bIterator.ReadU8 ();
+      m_numPendingBits += 8;
+    }
+  m_numPendingBits -= numBits;
+  uint32_t value = static_cast<uint32_t> (m_pendingBits >> m_numPendingBits);
+  m_pendingBits &= (1ULL << m_numPendingBits) - 1;
+  return value;
+}
+
+void
+Asn1BitReader::Clear ()
+{
+  m_pendingBits = 0;
+  m_numPendingBits = 0;
+}
+
 NS_OBJECT_ENSURE_REGISTERED (Asn1Header);
 
+/**
+ * \param range the number of values of a constrained whole number
+ * \returns the number of bits of its encoding, ceil (log2 (range))
+ */
+static uint8_t
+RequiredBits (int range)
+{
+  uint8_t requiredBits = 0;
+  while ((1LL << requiredBits) < range)
+    {
+      requiredBits++;
+    }
+  NS_ASSERT_MSG (requiredBits <= 32, "range " << range << " out of 32 bits");
+  return requiredBits;
+}
+
 TypeId
 Asn1Header::GetTypeId (void)
 {
@@ -49,8 +138,6 @@ Asn1Header::GetInstanceTypeId (void) const
 
 Asn1Header::Asn1Header ()
 {
-  m_serializationPendingBits = 0x00;
-  m_numSerializationPendingBits = 0;
   m_isDataSerialized = false;
 }
 
@@ -61,6 +148,9 @@ Asn1Header::~Asn1Header ()
 uint32_t
 Asn1Header::GetSerializedSize (void) const
 {
+  // The deserialization functions of the subclasses end here:
+  // discard the padding bits of the last octet they read
+  m_deserializationReader.Clear ();
   if (!m_isDataSerialized)
     {
       PreSerialize ();
@@ -79,94 +169,22 @@ void Asn1Header::Serialize (Buffer::Iterator bIterator) const
 
 void Asn1Header::WriteOctet (uint8_t octet) const
 {
-  m_serializationResult.AddAtEnd (1);
-  Buffer::Iterator bIterator = m_serializationResult.End ();
-  bIterator.Prev ();
-  bIterator.WriteU8 (octet);
+  m_serializationWriter.WriteBits (octet, 8);
 }
 
 template <int N>
 void Asn1Header::SerializeBitset (std::bitset<N> data) const
 {
-
-  size_t dataSize = data.size ();
-  uint8_t pendingBits = dataSize;
-  uint8_t mask = 1;
-  int j;
-
   // No extension marker (Clause 16.7 ITU-T X.691),
   // as 3GPP TS 36.331 does not use it in its IE's.
 
   // Clause 16.8 ITU-T X.691
-  if (dataSize == 0)
-    {
-      return;
-    }
-
   // Clause 16.9 ITU-T X.691
   // Clause 16.10 ITU-T X.691
-  if (dataSize <= 65536)
-    {
-      // If there are bits pending to be processed,
-      // append first bits in data to complete an octet.
-      if (m_numSerializationPendingBits > 0)
-        {
-          mask = 0x80 >> m_numSerializationPendingBits;
-          while (pendingBits > 0 && m_numSerializationPendingBits < 8)
-            {
-              m_serializationPendingBits |= (data[pendingBits - 1]) ? mask : 0;
-              pendingBits--;
-              m_numSerializationPendingBits++;
-              mask = (mask >> 1) & (~mask);
-            }
-
-          if (m_numSerializationPendingBits >= 8)
-            {
-              WriteOctet (m_serializationPendingBits);
-              m_numSerializationPendingBits = 0;
-              m_serializationPendingBits = 0;
-            }
-        }
-
-      while (pendingBits > 0)
-        {
-          mask = 1;
-          j = 8;
-
-          // If there are less than 8 remaining bits,
-          // store it to m_serializationPendingBits.
-          if (pendingBits < 8)
-            {
-              mask = 0x80;
-              m_numSerializationPendingBits = pendingBits;
-              while (pendingBits > 0)
-                {
-                  m_serializationPendingBits |= (data[pendingBits - 1]) ? mask : 0;
-                  mask = (mask >> 1) & (~mask);
-                  pendingBits--;
-                }
-            }
-
-          // Write the data to buffer
-          else
-            {
-              uint8_t octetToWrite = 0;
-              for (; j > 0; j--)
-                {
-                  octetToWrite |= (data[pendingBits - j]) ? mask : 0;
-                  mask = (mask << 1) & (~mask);
-                }
-              WriteOctet (octetToWrite);
-              pendingBits -= 8;
-            }
-        }
-    }
-
-  // Clause 16.11 ITU-T X.691
-  else
-    {
-      printf ("FRAGMENTATION NEEDED!\n");
-    }
+  // The fragmentation of Clause 16.11 is never needed,
+  // as no IE is longer than a 32 bits word.
+  static_assert (N <= 32, "bit strings are limited to 32 bits");
+  m_serializationWriter.WriteBits (static_cast<uint32_t> (data.to_ulong ()), N);
 }
 
 template <int N>
@@ -343,76 +361,7 @@ void Asn1Header::SerializeInteger (int n, int nmin, int nmax) const
     }
 
   // Clause 11.5.6 ITU-T X.691
-  int requiredBits = std::ceil (std::log (range) / std::log (2.0));
-
-  switch (requiredBits)
-    {
-    case 1:
-      SerializeBitset<1> (std::bitset<1> (n));
-      break;
-    case 2:
-      SerializeBitset<2> (std::bitset<2> (n));
-      break;
-    case 3:
-      SerializeBitset<3> (std::bitset<3> (n));
-      break;
-    case 4:
-      SerializeBitset<4> (std::bitset<4> (n));
-      break;
-    case 5:
-      SerializeBitset<5> (std::bitset<5> (n));
-      break;
-    case 6:
-      SerializeBitset<6> (std::bitset<6> (n));
-      break;
-    case 7:
-      SerializeBitset<7> (std::bitset<7> (n));
-      break;
-    case 8:
-      SerializeBitset<8> (std::bitset<8> (n));
-      break;
-    case 9:
-      SerializeBitset<9> (std::bitset<9> (n));
-      break;
-    case 10:
-      SerializeBitset<10> (std::bitset<10> (n));
-      break;
-    case 11:
-      SerializeBitset<11> (std::bitset<11> (n));
-      break;
-    case 12:
-      SerializeBitset<12> (std::bitset<12> (n));
-      break;
-    case 13:
-      SerializeBitset<13> (std::bitset<13> (n));
-      break;
-    case 14:
-      SerializeBitset<14> (std::bitset<14> (n));
-      break;
-    case 15:
-      SerializeBitset<15> (std::bitset<15> (n));
-      break;
-    case 16:
-      SerializeBitset<16> (std::bitset<16> (n));
-      break;
-    case 17:
-      SerializeBitset<17> (std::bitset<17> (n));
-      break;
-    case 18:
-      SerializeBitset<18> (std::bitset<18> (n));
-      break;
-    case 19:
-      SerializeBitset<19> (std::bitset<19> (n));
-      break;
-    case 20:
-      SerializeBitset<20> (std::bitset<20> (n));
-      break;
-    default:
-      {
-        std::cout << "SerializeInteger " << requiredBits << " Out of range!!" << std::endl;
-        exit (1);
-      }
-    }
+  m_serializationWriter.WriteBits (n, RequiredBits (range));
 }
 
 void Asn1Header::SerializeNull () const
@@ -423,64 +372,24 @@ void Asn1Header::SerializeNull () const
 
 void Asn1Header::FinalizeSerialization () const
 {
-  if (m_numSerializationPendingBits > 0)
+  m_serializationWriter.Flush ();
+  const std::vector<uint8_t> &octets = m_serializationWriter.GetOctets ();
+  if (!octets.empty ())
     {
-      m_numSerializationPendingBits = 0;
-      SerializeBitset<8> (std::bitset<8> (m_serializationPendingBits));
+      m_serializationResult.AddAtEnd (octets.size ());
+      Buffer::Iterator bIterator = m_serializationResult.End ();
+      bIterator.Prev (octets.size ());
+      bIterator.Write (octets.data (), octets.size ());
     }
+  m_serializationWriter.Clear ();
   m_isDataSerialized = true;
 }
 
 template <int N>
 Buffer::Iterator Asn1Header::DeserializeBitset (std::bitset<N> *data, Buffer::Iterator bIterator)
 {
-
-  int bitsToRead = N;
-  uint8_t mask;
-
-  // Read bits from pending bits
-  if (m_numSerializationPendingBits > 0)
-    {
-      while (bitsToRead > 0 && m_numSerializationPendingBits > 0)
-        {
-          data->set (bitsToRead - 1,(m_serializationPendingBits & 0x80) ? 1 : 0);
-          bitsToRead--;
-          m_numSerializationPendingBits--;
-          m_serializationPendingBits = m_serializationPendingBits << 1;
-        }
-    }
-
-  // Read bits from buffer
-  while (bitsToRead > 0)
-    {
-      uint8_t octet = bIterator.ReadU8 ();
-      // If 8 bits can be allocated to the bitset, set the bits
-      if (bitsToRead >= 8)
-        {
-          mask = 0x80;
-          for (int j = 0; j < 8; j++)
-            {
-              data->set (bitsToRead - 1,(octet & mask) ? 1 : 0);
-              bitsToRead--;
-              mask = mask >> 1;
-            }
-        }
-
-      // Otherwise, we'll have to save the remaining bits
-      else
-        {
-          mask = 0x80;
-          m_numSerializationPendingBits = 8 - bitsToRead;
-          m_serializationPendingBits = octet << bitsToRead;
-          while (bitsToRead > 0)
-            {
-              data->set (bitsToRead - 1,(octet & mask) ? 1 : 0);
-              bitsToRead--;
-              mask = mask >> 1;
-            }
-        }
-    }
-
+  static_assert (N <= 32, "bit strings are limited to 32 bits");
+  *data = std::bitset<N> (m_deserializationReader.ReadBits (N, bIterator));
   return bIterator;
 }
 
@@ -555,118 +464,7 @@ Buffer::Iterator Asn1Header::DeserializeInteger (int *n, int nmin, int nmax, Buf
       return bIterator;
     }
 
-  int requiredBits = std::ceil (std::log (range) / std::log (2.0));
-
-  std::bitset<1> bitsRead1;
-  std::bitset<2> bitsRead2;
-  std::bitset<3> bitsRead3;
-  std::bitset<4> bitsRead4;
-  std::bitset<5> bitsRead5;
-  std::bitset<6> bitsRead6;
-  std::bitset<7> bitsRead7;
-  std::bitset<8> bitsRead8;
-  std::bitset<9> bitsRead9;
-  std::bitset<10> bitsRead10;
-  std::bitset<11> bitsRead11;
-  std::bitset<12> bitsRead12;
-  std::bitset<13> bitsRead13;
-  std::bitset<14> bitsRead14;
-  std::bitset<15> bitsRead15;
-  std::bitset<16> bitsRead16;
-  std::bitset<17> bitsRead17;
-  std::bitset<18> bitsRead18;
-  std::bitset<19> bitsRead19;
-  std::bitset<20> bitsRead20;
-
-  switch (requiredBits)
-    {
-    case 1:
-      bIterator = DeserializeBitset<1> (&bitsRead1,bIterator);
-      *n = (int)bitsRead1.to_ulong ();
-      break;
-    case 2: 
-      bIterator = DeserializeBitset<2> (&bitsRead2,bIterator);
-      *n = (int)bitsRead2.to_ulong ();
-      break;
-    case 3: 
-      bIterator = DeserializeBitset<3> (&bitsRead3,bIterator);
-      *n = (int)bitsRead3.to_ulong ();
-      break;
-    case 4: 
-      bIterator = DeserializeBitset<4> (&bitsRead4,bIterator);
-      *n = (int)bitsRead4.to_ulong ();
-      break;
-    case 5:
-      bIterator = DeserializeBitset<5> (&bitsRead5,bIterator);
-      *n = (int)bitsRead5.to_ulong ();
-      break;
-    case 6:
-      bIterator = DeserializeBitset<6> (&bitsRead6,bIterator);
-      *n = (int)bitsRead6.to_ulong ();
-      break;
-    case 7:
-      bIterator = DeserializeBitset<7> (&bitsRead7,bIterator);
-      *n = (int)bitsRead7.to_ulong ();
-      break;
-    case 8:
-      bIterator = DeserializeBitset<8> (&bitsRead8,bIterator);
-      *n = (int)bitsRead8.to_ulong ();
-      break;
-    case 9:
-      bIterator = DeserializeBitset<9> (&bitsRead9,bIterator);
-      *n = (int)bitsRead9.to_ulong ();
-      break;
-    case 10:
-      bIterator = DeserializeBitset<10> (&bitsRead10,bIterator);
-      *n = (int)bitsRead10.to_ulong ();
-      break;
-    case 11:
-      bIterator = DeserializeBitset<11> (&bitsRead11,bIterator);
-      *n = (int)bitsRead11.to_ulong ();
-      break;
-    case 12:
-      bIterator = DeserializeBitset<12> (&bitsRead12,bIterator);
-      *n = (int)bitsRead12.to_ulong ();
-      break;
-    case 13:
-      bIterator = DeserializeBitset<13> (&bitsRead13,bIterator);
-      *n = (int)bitsRead13.to_ulong ();
-      break;
-    case 14:
-      bIterator = DeserializeBitset<14> (&bitsRead14,bIterator);
-      *n = (int)bitsRead14.to_ulong ();
-      break;
-    case 15:
-      bIterator = DeserializeBitset<15> (&bitsRead15,bIterator);
-      *n = (int)bitsRead15.to_ulong ();
-      break;
-    case 16:
-      bIterator = DeserializeBitset<16> (&bitsRead16,bIterator);
-      *n = (int)bitsRead16.to_ulong ();
-      break;
-    case 17:
-      bIterator = DeserializeBitset<17> (&bitsRead17,bIterator);
-      *n = (int)bitsRead17.to_ulong ();
-      break;
-    case 18:
-      bIterator = DeserializeBitset<18> (&bitsRead18,bIterator);
-      *n = (int)bitsRead18.to_ulong ();
-      break;
-    case 19:
-      bIterator = DeserializeBitset<19> (&bitsRead19,bIterator);
-      *n = (int)bitsRead19.to_ulong ();
-      break;
-    case 20:
-      bIterator = DeserializeBitset<20> (&bitsRead20,bIterator);
-      *n = (int)bitsRead20.to_ulong ();
-      break;
-    default:
-      {
-        std::cout << "SerializeInteger Out of range!!" << std::endl;
-        exit (1);
-      }
-    }
-
+  *n = m_deserializationReader.ReadBits (RequiredBits (range), bIterator);
   *n += nmin;
 
   return bIterator;
@@ -25,9 +25,75 @@
 
 #include <bitset>
 #include <string>
+#include <vector>
 
 namespace ns3 {
 
+/**
+ * Writer of the bitstreams of the UNALIGNED variant of ITU-T X.691.
+ *
+ * Fields are written most significant bit first, and accumulated in a
+ * machine word which is flushed to the output one complete octet at a time.
+ */
+class Asn1BitWriter
+{
+public:
+  Asn1BitWriter ();
+
+  /**
+   * Write the least significant bits of a value
+   * \param value the value to write
+   * \param numBits the number of bits to write, up to 32
+   */
+  void WriteBits (uint32_t value, uint8_t numBits);
+  /**
+   * Pad the last octet of the bitstream with zero bits.
+   */
+  void Flush ();
+  /**
+   * Discard the content of the bitstream.
+   */
+  void Clear ();
+  /**
+   * \returns the complete octets of the bitstream
+   */
+  const std::vector<uint8_t> & GetOctets () const;
+
+private:
+  std::vector<uint8_t> m_octets; //!< complete octets
+  uint64_t m_pendingBits; //!< bits not yet forming a complete octet
+  uint8_t m_numPendingBits; //!< number of pending bits
+};
+
+/**
+ * Reader of the bitstreams written by Asn1BitWriter.
+ *
+ * The octets are read from a Buffer only as they are needed, so that
+ * the reader can follow the iterators passed through the deserialization
+ * functions of Asn1Header.
+ */
+class Asn1BitReader
+{
+public:
+  Asn1BitReader ();
+
+  /**
+   * Read a field
+   * \param numBits the number of bits to read, up to 32
+   * \param bIterator buffer iterator, advanced past the octets read
+   * \returns the value of the field
+   */
+  uint32_t ReadBits (uint8_t numBits, Buffer::Iterator &bIterator);
+  /**
+   * Discard the bits read but not yet consumed.
+   */
+  void Clear ();
+
+private:
+  uint64_t m_pendingBits; //!< bits read but not yet consumed
+  uint8_t m_numPendingBits; //!< number of pending bits
+};
+
 /**
  * This class has the purpose to encode Information Elements according
  * to ASN.1 syntax, as defined in ITU-T  X-691.
@@ -65,13 +131,13 @@ public:
   virtual void PreSerialize (void) const = 0;
 
 protected:
-  mutable uint8_t m_serializationPendingBits; //!< pending bits
-  mutable uint8_t m_numSerializationPendingBits; //!< number of pending bits
+  mutable Asn1BitWriter m_serializationWriter; //!< bitstream being serialized
+  mutable Asn1BitReader m_deserializationReader; //!< bitstream being deserialized
   mutable bool m_isDataSerialized; //!< true if data is serialized
   mutable Buffer m_serializationResult; //!< serialization result
 
   /**
-   * Function to write in m_serializationResult, after resizing its size
+   * Function to write an octet in the bitstream being serialized
    * \param octet bits to write
    */
   void WriteOctet (uint8_t octet) const;
@@ -117,7 +183,8 @@ protected:
    */
   void SerializeNull () const;
   /**
-   * Finalizes an in progress serialization.
+   * Finalizes an in progress serialization, appending its bitstream
+   * to m_serializationResult.
    */
   void FinalizeSerialization () const;
 
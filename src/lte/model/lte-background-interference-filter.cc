@@ -0,0 +1,94 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/log.h>
+#include <ns3/metrics-registry.h>
+
+#include "lte-background-interference-filter.h"
+#include "lte-spectrum-signal-parameters.h"
+#include "lte-spectrum-phy.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LteBackgroundInterferenceFilter");
+
+NS_OBJECT_ENSURE_REGISTERED (LteBackgroundInterferenceFilter);
+
+LteBackgroundInterferenceFilter::LteBackgroundInterferenceFilter ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TypeId
+LteBackgroundInterferenceFilter::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::LteBackgroundInterferenceFilter")
+    .SetParent<SpectrumTransmitFilter> ()
+    .SetGroupName ("Lte")
+    .AddConstructor<LteBackgroundInterferenceFilter> ()
+  ;
+  return tid;
+}
+
+void
+LteBackgroundInterferenceFilter::InstallOn (Ptr<SpectrumChannel> channel)
+{
+  if (GetFilter (channel) == 0)
+    {
+      NS_LOG_LOGIC ("install on " << channel);
+      channel->AddSpectrumTransmitFilter (CreateObject<LteBackgroundInterferenceFilter> ());
+    }
+}
+
+Ptr<const LteBackgroundInterferenceFilter>
+LteBackgroundInterferenceFilter::GetFilter (Ptr<const SpectrumChannel> channel)
+{
+  for (Ptr<const SpectrumTransmitFilter> filter = channel->GetSpectrumTransmitFilter ();
+       filter != 0; filter = filter->GetNext ())
+    {
+      Ptr<const LteBackgroundInterferenceFilter> backgroundFilter =
+        DynamicCast<const LteBackgroundInterferenceFilter> (filter);
+      if (backgroundFilter != 0)
+        {
+          return backgroundFilter;
+        }
+    }
+  return 0;
+}
+
+bool
+LteBackgroundInterferenceFilter::DoFilter (Ptr<const SpectrumSignalParameters> params,
+                                           Ptr<const SpectrumPhy> receiverPhy) const
+{
+  static MetricCounter *filtered = MetricsRegistry::Get ()->GetCounter ("LteBackgroundInterferenceFilter/Filtered");
+
+  Ptr<const LteSpectrumSignalParametersDataFrame> dataParams =
+    DynamicCast<const LteSpectrumSignalParametersDataFrame> (params);
+  if (dataParams == 0)
+    {
+      return false;
+    }
+  Ptr<const LteSpectrumPhy> ltePhy = DynamicCast<const LteSpectrumPhy> (receiverPhy);
+  if (ltePhy == 0 || !ltePhy->IsInterferenceInBackground (dataParams->cellId))
+    {
+      return false;
+    }
+  NS_LOG_LOGIC ("data frame of cell " << dataParams->cellId << " in the background of " << ltePhy);
+  filtered->Increment ();
+  return true;
+}
+
+} // namespace ns3
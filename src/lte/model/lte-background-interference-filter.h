@@ -0,0 +1,73 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LTE_BACKGROUND_INTERFERENCE_FILTER_H
+#define LTE_BACKGROUND_INTERFERENCE_FILTER_H
+
+#include <ns3/spectrum-transmit-filter.h>
+#include <ns3/spectrum-channel.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * \brief Transmit filter of the DL channel which drops the data frames
+ * of the cells whose interference a receiver approximates by a background
+ *
+ * A data frame of a cell is filtered for an LteSpectrumPhy which has
+ * the cell in its interference background (see
+ * LteSpectrumPhy::SetInterferenceBackground), as such a frame would only
+ * be added to the interference of the receiver. The control frames are
+ * never filtered.
+ *
+ * The filter is installed on the DL channel by the first LteSpectrumPhy
+ * which gets an interference background, so that the channels without
+ * such receivers, as with the default InterferenceCells of LteUePhy,
+ * evaluate no filter at all.
+ */
+class LteBackgroundInterferenceFilter : public SpectrumTransmitFilter
+{
+public:
+  LteBackgroundInterferenceFilter ();
+
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * \brief Add an LteBackgroundInterferenceFilter to the filters of a
+   *        channel, unless it already has one.
+   * \param channel the DL channel
+   */
+  static void InstallOn (Ptr<SpectrumChannel> channel);
+
+  /**
+   * \param channel a channel
+   * \return the LteBackgroundInterferenceFilter of the channel, or 0 if none
+   */
+  static Ptr<const LteBackgroundInterferenceFilter> GetFilter (Ptr<const SpectrumChannel> channel);
+
+private:
+  // inherited from SpectrumTransmitFilter
+  virtual bool DoFilter (Ptr<const SpectrumSignalParameters> params, Ptr<const SpectrumPhy> receiverPhy) const;
+};
+
+} // namespace ns3
+
+#endif /* LTE_BACKGROUND_INTERFERENCE_FILTER_H */
@@ -25,6 +25,7 @@
 #include "ns3/log.h"
 #include "lte-net-device.h"
 #include "lte-ue-net-device.h"
+#include <algorithm>
 
 namespace ns3 {
 
@@ -309,5 +310,74 @@ DlHarqFeedbackLteControlMessage::GetDlHarqFeedback (void)
 }
 
 
+// ---------------------------------------------------------------------------
+
+
+LteControlMessageFrame::LteControlMessageFrame (const std::list<Ptr<LteControlMessage> > &msgList)
+  : m_messages (msgList.begin (), msgList.end ())
+{
+  for (uint32_t i = 0; i < m_messages.size (); ++i)
+    {
+      switch (m_messages[i]->GetMessageType ())
+        {
+        case LteControlMessage::DL_DCI:
+          {
+            Ptr<DlDciLteControlMessage> dci = DynamicCast<DlDciLteControlMessage> (m_messages[i]);
+            m_dciIndexes.push_back (std::make_pair (dci->GetDci ().m_rnti, i));
+          }
+          break;
+        case LteControlMessage::UL_DCI:
+          {
+            Ptr<UlDciLteControlMessage> dci = DynamicCast<UlDciLteControlMessage> (m_messages[i]);
+            m_dciIndexes.push_back (std::make_pair (dci->GetDci ().m_rnti, i));
+          }
+          break;
+        default:
+          m_commonIndexes.push_back (i);
+          break;
+        }
+    }
+  std::sort (m_dciIndexes.begin (), m_dciIndexes.end ());
+}
+
+uint32_t
+LteControlMessageFrame::GetN (void) const
+{
+  return m_messages.size ();
+}
+
+Ptr<LteControlMessage>
+LteControlMessageFrame::Get (uint32_t index) const
+{
+  NS_ASSERT (index < m_messages.size ());
+  return m_messages[index];
+}
+
+uint32_t
+LteControlMessageFrame::GetNext (uint16_t rnti, uint32_t index) const
+{
+  uint32_t next = m_messages.size ();
+  std::vector<std::pair<uint16_t, uint32_t> >::const_iterator dciIt =
+    std::lower_bound (m_dciIndexes.begin (), m_dciIndexes.end (), std::make_pair (rnti, index));
+  if (dciIt != m_dciIndexes.end () && dciIt->first == rnti)
+    {
+      next = dciIt->second;
+    }
+  std::vector<uint32_t>::const_iterator commonIt =
+    std::lower_bound (m_commonIndexes.begin (), m_commonIndexes.end (), index);
+  if (commonIt != m_commonIndexes.end () && *commonIt < next)
+    {
+      next = *commonIt;
+    }
+  return next;
+}
+
+std::list<Ptr<LteControlMessage> >
+LteControlMessageFrame::GetList (void) const
+{
+  return std::list<Ptr<LteControlMessage> > (m_messages.begin (), m_messages.end ());
+}
+
+
 } // namespace ns3
 
@@ -27,6 +27,8 @@
 #include <ns3/ff-mac-common.h>
 #include <ns3/lte-rrc-sap.h>
 #include <list>
+#include <vector>
+#include <utility>
 
 namespace ns3 {
 
@@ -403,6 +405,64 @@ private:
 }; // end of class Sib1LteControlMessage
 
 
+// ---------------------------------------------------------------------------
+
+/**
+ * \ingroup lte
+ * \brief The control messages of a DL control frame, indexed by RNTI
+ *
+ * The eNB PHY transmits the DL control frame of a subframe once, and all
+ * the UE PHYs of the channel share it. The messages are kept in their
+ * order of transmission, with an index of the DL and UL DCIs by RNTI,
+ * so that a UE reads its own DCIs and the messages addressed to all the
+ * UEs (RAR, MIB, SIB1), without going through the DCIs of the other UEs.
+ *
+ * The frame is not modified after its creation.
+ */
+class LteControlMessageFrame : public SimpleRefCount<LteControlMessageFrame>
+{
+public:
+  /**
+   * \brief Create the frame of a list of control messages.
+   * \param msgList the control messages, in their order of transmission
+   */
+  LteControlMessageFrame (const std::list<Ptr<LteControlMessage> > &msgList);
+
+  /**
+   * \return the number of messages of the frame
+   */
+  uint32_t GetN (void) const;
+
+  /**
+   * \param index the index of the message, lower than GetN ()
+   * \return the message
+   */
+  Ptr<LteControlMessage> Get (uint32_t index) const;
+
+  /**
+   * \brief Get the index of the next message which a UE reads.
+   * \param rnti the RNTI of the UE
+   * \param index the index of the first message to consider
+   * \return the index of the first message, from \p index, which is
+   *         either a DCI of \p rnti or a message addressed to all the
+   *         UEs, or GetN () if there is none
+   */
+  uint32_t GetNext (uint16_t rnti, uint32_t index) const;
+
+  /**
+   * \return the messages, in their order of transmission
+   */
+  std::list<Ptr<LteControlMessage> > GetList (void) const;
+
+private:
+  std::vector<Ptr<LteControlMessage> > m_messages; ///< messages, in order
+  /// (RNTI, index) of the DCIs, sorted by RNTI and then index
+  std::vector<std::pair<uint16_t, uint32_t> > m_dciIndexes;
+  std::vector<uint32_t> m_commonIndexes; ///< indexes of the other messages
+
+}; // end of class LteControlMessageFrame
+
+
 } // namespace ns3
 
 #endif  // LTE_CONTROL_MESSAGES_H
@@ -27,6 +27,7 @@
 #include <ns3/pointer.h>
 #include <ns3/packet.h>
 #include <ns3/simulator.h>
+#include <ns3/metrics-registry.h>
 
 #include "lte-amc.h"
 #include "lte-control-messages.h"
@@ -406,7 +407,7 @@ LteEnbMac::DoDispose ()
   m_ulCeReceived.clear ();
   m_dlInfoListReceived.clear ();
   m_ulInfoListReceived.clear ();
-  m_miDlHarqProcessesPackets.clear ();
+  m_miDlHarqProcessesPackets.Clear ();
   delete m_macSapProvider;
   delete m_cmacSapProvider;
   delete m_schedSapUser;
@@ -501,6 +502,8 @@ void
 LteEnbMac::DoSubframeIndication (uint32_t frameNo, uint32_t subframeNo)
 {
   NS_LOG_FUNCTION (this << " EnbMac - frame " << frameNo << " subframe " << subframeNo);
+  static MetricHistogram *ttiTime = MetricsRegistry::Get ()->GetHistogram ("LteEnbMac/SubframeIndicationNs");
+  MetricTimer timer (ttiTime);
 
   // Store current frame / subframe number
   m_frameNo = frameNo;
@@ -555,7 +558,7 @@ LteEnbMac::DoSubframeIndication (uint32_t frameNo, uint32_t subframeNo)
               rachLe.m_rnti = rnti;
               rachLe.m_estimatedSize = 144; // to be confirmed
               rachInfoReqParams.m_rachList.push_back (rachLe);
-              m_rapIdRntiMap.insert (std::pair <uint16_t, uint32_t> (rnti, it->first));
+              m_rapIdRntiMap.Insert (rnti, it->first);
             }
         }
       m_schedSapProvider->SchedDlRachInfoReq (rachInfoReqParams);
@@ -765,10 +768,10 @@ LteEnbMac::DoReceivePhyPdu (Ptr<Packet> p)
   // forward the packet to the correspondent RLC
   uint16_t rnti = tag.GetRnti ();
   uint8_t lcid = tag.GetLcid ();
-  std::map <uint16_t, std::map<uint8_t, LteMacSapUser*> >::iterator rntiIt = m_rlcAttached.find (rnti);
-  NS_ASSERT_MSG (rntiIt != m_rlcAttached.end (), "could not find RNTI" << rnti);
-  std::map<uint8_t, LteMacSapUser*>::iterator lcidIt = rntiIt->second.find (lcid);
-  //NS_ASSERT_MSG (lcidIt != rntiIt->second.end (), "could not find LCID" << lcid);
+  std::map<uint8_t, LteMacSapUser*> *rlcs = m_rlcAttached.Find (rnti);
+  NS_ASSERT_MSG (rlcs != 0, "could not find RNTI" << rnti);
+  std::map<uint8_t, LteMacSapUser*>::iterator lcidIt = rlcs->find (lcid);
+  //NS_ASSERT_MSG (lcidIt != rlcs->end (), "could not find LCID" << lcid);
 
   LteMacSapUser::ReceivePduParameters rxPduParams;
   rxPduParams.p = p;
@@ -776,7 +779,7 @@ LteEnbMac::DoReceivePhyPdu (Ptr<Packet> p)
   rxPduParams.lcid = lcid;
 
   //Receive PDU only if LCID is found
-  if (lcidIt != rntiIt->second.end ())
+  if (lcidIt != rlcs->end ())
     {
       (*lcidIt).second->ReceivePdu (rxPduParams);
     }
@@ -807,10 +810,8 @@ LteEnbMac::DoAddUe (uint16_t rnti)
 {
   NS_LOG_FUNCTION (this << " rnti=" << rnti);
   std::map<uint8_t, LteMacSapUser*> empty;
-  std::pair <std::map <uint16_t, std::map<uint8_t, LteMacSapUser*> >::iterator, bool> 
-    ret = m_rlcAttached.insert (std::pair <uint16_t,  std::map<uint8_t, LteMacSapUser*> > 
-                                (rnti, empty));
-  NS_ASSERT_MSG (ret.second, "element already present, RNTI already existed");
+  bool inserted = m_rlcAttached.Insert (rnti, empty);
+  NS_ASSERT_MSG (inserted, "element already present, RNTI already existed");
 
   FfMacCschedSapProvider::CschedUeConfigReqParameters params;
   params.m_rnti = rnti;
@@ -836,7 +837,7 @@ LteEnbMac::DoAddUe (uint16_t rnti)
   DlHarqProcessesBuffer_t buf;
   buf.push_back (dlHarqLayer0pkt);
   buf.push_back (dlHarqLayer1pkt);
-  m_miDlHarqProcessesPackets.insert (std::pair <uint16_t, DlHarqProcessesBuffer_t> (rnti, buf));
+  m_miDlHarqProcessesPackets.Insert (rnti, buf);
 }
 
 void
@@ -846,8 +847,8 @@ LteEnbMac::DoRemoveUe (uint16_t rnti)
   FfMacCschedSapProvider::CschedUeReleaseReqParameters params;
   params.m_rnti = rnti;
   m_cschedSapProvider->CschedUeReleaseReq (params);
-  m_rlcAttached.erase (rnti);
-  m_miDlHarqProcessesPackets.erase (rnti);
+  m_rlcAttached.Erase (rnti);
+  m_miDlHarqProcessesPackets.Erase (rnti);
 
   NS_LOG_DEBUG ("start checking for unprocessed preamble for rnti: " << rnti);
   //remove unprocessed preamble received for RACH during handover
@@ -892,12 +893,12 @@ LteEnbMac::DoAddLc (LteEnbCmacSapProvider::LcInfo lcinfo, LteMacSapUser* msu)
   
   LteFlowId_t flow (lcinfo.rnti, lcinfo.lcId);
   
-  std::map <uint16_t, std::map<uint8_t, LteMacSapUser*> >::iterator rntiIt = m_rlcAttached.find (lcinfo.rnti);
-  NS_ASSERT_MSG (rntiIt != m_rlcAttached.end (), "RNTI not found");
-  std::map<uint8_t, LteMacSapUser*>::iterator lcidIt = rntiIt->second.find (lcinfo.lcId);
-  if (lcidIt == rntiIt->second.end ())
+  std::map<uint8_t, LteMacSapUser*> *rlcs = m_rlcAttached.Find (lcinfo.rnti);
+  NS_ASSERT_MSG (rlcs != 0, "RNTI not found");
+  std::map<uint8_t, LteMacSapUser*>::iterator lcidIt = rlcs->find (lcinfo.lcId);
+  if (lcidIt == rlcs->end ())
     {
-      rntiIt->second.insert (std::pair<uint8_t, LteMacSapUser*> (lcinfo.lcId, msu));
+      rlcs->insert (std::pair<uint8_t, LteMacSapUser*> (lcinfo.lcId, msu));
     }
   else
     {
@@ -942,8 +943,9 @@ LteEnbMac::DoReleaseLc (uint16_t rnti, uint8_t lcid)
   NS_LOG_FUNCTION (this);
 
   //Find user based on rnti and then erase lcid stored against the same
-  std::map <uint16_t, std::map<uint8_t, LteMacSapUser*> >::iterator rntiIt = m_rlcAttached.find (rnti);
-  rntiIt->second.erase (lcid);
+  std::map<uint8_t, LteMacSapUser*> *rlcs = m_rlcAttached.Find (rnti);
+  NS_ASSERT_MSG (rlcs != 0, "RNTI not found");
+  rlcs->erase (lcid);
 
   struct FfMacCschedSapProvider::CschedLcReleaseReqParameters params;
   params.m_rnti = rnti;
@@ -1048,12 +1050,12 @@ LteEnbMac::DoTransmitPdu (LteMacSapProvider::TransmitPduParameters params)
   params.pdu->AddPacketTag (tag);
   params.componentCarrierId = m_componentCarrierId;
   // Store pkt in HARQ buffer
-  std::map <uint16_t, DlHarqProcessesBuffer_t>::iterator it =  m_miDlHarqProcessesPackets.find (params.rnti);
-  NS_ASSERT (it != m_miDlHarqProcessesPackets.end ());
+  DlHarqProcessesBuffer_t *harq = m_miDlHarqProcessesPackets.Find (params.rnti);
+  NS_ASSERT (harq != 0);
   NS_LOG_DEBUG (this << " LAYER " << (uint16_t)tag.GetLayer () << " HARQ ID " << (uint16_t)params.harqProcessId);
   
-  //(*it).second.at (params.layer).at (params.harqProcessId) = params.pdu;//->Copy ();
-  (*it).second.at (params.layer).at (params.harqProcessId)->AddPacket (params.pdu);
+  //harq->at (params.layer).at (params.harqProcessId) = params.pdu;//->Copy ();
+  harq->at (params.layer).at (params.harqProcessId)->AddPacket (params.pdu);
   m_enbPhySapProvider->SendMacPdu (params.pdu);
 }
 
@@ -1096,12 +1098,12 @@ LteEnbMac::DoSchedDlConfigInd (FfMacSchedSapUser::SchedDlConfigIndParameters ind
           if (ind.m_buildDataList.at (i).m_dci.m_ndi.at (layer) == 1)
             {
               // new data -> force emptying correspondent harq pkt buffer
-              std::map <uint16_t, DlHarqProcessesBuffer_t>::iterator it = m_miDlHarqProcessesPackets.find (ind.m_buildDataList.at (i).m_rnti);
-              NS_ASSERT (it != m_miDlHarqProcessesPackets.end ());
-              for (uint16_t lcId = 0; lcId < (*it).second.size (); lcId++)
+              DlHarqProcessesBuffer_t *harq = m_miDlHarqProcessesPackets.Find (ind.m_buildDataList.at (i).m_rnti);
+              NS_ASSERT (harq != 0);
+              for (uint16_t lcId = 0; lcId < harq->size (); lcId++)
                 {
                   Ptr<PacketBurst> pb = CreateObject <PacketBurst> ();
-                  (*it).second.at (lcId).at (ind.m_buildDataList.at (i).m_dci.m_harqProcess) = pb;
+                  harq->at (lcId).at (ind.m_buildDataList.at (i).m_dci.m_harqProcess) = pb;
                 }
             }
         }
@@ -1114,10 +1116,10 @@ LteEnbMac::DoSchedDlConfigInd (FfMacSchedSapUser::SchedDlConfigIndParameters ind
                   // New Data -> retrieve it from RLC
                   uint16_t rnti = ind.m_buildDataList.at (i).m_rnti;
                   uint8_t lcid = ind.m_buildDataList.at (i).m_rlcPduList.at (j).at (k).m_logicalChannelIdentity;
-                  std::map <uint16_t, std::map<uint8_t, LteMacSapUser*> >::iterator rntiIt = m_rlcAttached.find (rnti);
-                  NS_ASSERT_MSG (rntiIt != m_rlcAttached.end (), "could not find RNTI" << rnti);
-                  std::map<uint8_t, LteMacSapUser*>::iterator lcidIt = rntiIt->second.find (lcid);
-                  NS_ASSERT_MSG (lcidIt != rntiIt->second.end (), "could not find LCID" << (uint32_t)lcid<<" carrier id:"<<(uint16_t)m_componentCarrierId);
+                  std::map<uint8_t, LteMacSapUser*> *rlcs = m_rlcAttached.Find (rnti);
+                  NS_ASSERT_MSG (rlcs != 0, "could not find RNTI" << rnti);
+                  std::map<uint8_t, LteMacSapUser*>::iterator lcidIt = rlcs->find (lcid);
+                  NS_ASSERT_MSG (lcidIt != rlcs->end (), "could not find LCID" << (uint32_t)lcid<<" carrier id:"<<(uint16_t)m_componentCarrierId);
                   NS_LOG_DEBUG (this << " rnti= " << rnti << " lcid= " << (uint32_t) lcid << " layer= " << k);
                   txOpParams.bytes = ind.m_buildDataList.at (i).m_rlcPduList.at (j).at (k).m_size;
                   txOpParams.layer = k;
@@ -1132,9 +1134,9 @@ LteEnbMac::DoSchedDlConfigInd (FfMacSchedSapUser::SchedDlConfigIndParameters ind
                   if (ind.m_buildDataList.at (i).m_dci.m_tbsSize.at (k) > 0)
                     {
                       // HARQ retransmission -> retrieve TB from HARQ buffer
-                      std::map <uint16_t, DlHarqProcessesBuffer_t>::iterator it = m_miDlHarqProcessesPackets.find (ind.m_buildDataList.at (i).m_rnti);
-                      NS_ASSERT (it != m_miDlHarqProcessesPackets.end ());
-                      Ptr<PacketBurst> pb = (*it).second.at (k).at ( ind.m_buildDataList.at (i).m_dci.m_harqProcess);
+                      DlHarqProcessesBuffer_t *harq = m_miDlHarqProcessesPackets.Find (ind.m_buildDataList.at (i).m_rnti);
+                      NS_ASSERT (harq != 0);
+                      Ptr<PacketBurst> pb = harq->at (k).at ( ind.m_buildDataList.at (i).m_dci.m_harqProcess);
                       for (std::list<Ptr<Packet> >::const_iterator j = pb->Begin (); j != pb->End (); ++j)
                         {
                           Ptr<Packet> pkt = (*j)->Copy ();
@@ -1203,22 +1205,22 @@ LteEnbMac::DoSchedDlConfigInd (FfMacSchedSapUser::SchedDlConfigIndParameters ind
   rarMsg->SetRaRnti (raRnti);
   for (unsigned int i = 0; i < ind.m_buildRarList.size (); i++)
     {
-      std::map <uint16_t, uint32_t>::iterator itRapId = m_rapIdRntiMap.find (ind.m_buildRarList.at (i).m_rnti);
-      if (itRapId == m_rapIdRntiMap.end ())
+      const uint32_t *rapId = m_rapIdRntiMap.Find (ind.m_buildRarList.at (i).m_rnti);
+      if (rapId == 0)
         {
           NS_FATAL_ERROR ("Unable to find rapId of RNTI " << ind.m_buildRarList.at (i).m_rnti);
         }
       RarLteControlMessage::Rar rar;
-      rar.rapId = itRapId->second;
+      rar.rapId = *rapId;
       rar.rarPayload = ind.m_buildRarList.at (i);
       rarMsg->AddRar (rar);
-      NS_LOG_INFO (this << " Send RAR message to RNTI " << ind.m_buildRarList.at (i).m_rnti << " rapId " << itRapId->second);
+      NS_LOG_INFO (this << " Send RAR message to RNTI " << ind.m_buildRarList.at (i).m_rnti << " rapId " << *rapId);
     }
   if (ind.m_buildRarList.size () > 0)
     {
       m_enbPhySapProvider->SendLteControlMessage (rarMsg);
     }
-  m_rapIdRntiMap.clear ();
+  m_rapIdRntiMap.Clear ();
 }
 
 
@@ -1315,15 +1317,15 @@ LteEnbMac::DoDlInfoListElementHarqFeeback (DlInfoListElement_s params)
 {
   NS_LOG_FUNCTION (this);
   // Update HARQ buffer
-  std::map <uint16_t, DlHarqProcessesBuffer_t>::iterator it =  m_miDlHarqProcessesPackets.find (params.m_rnti);
-  NS_ASSERT (it != m_miDlHarqProcessesPackets.end ());
+  DlHarqProcessesBuffer_t *harq = m_miDlHarqProcessesPackets.Find (params.m_rnti);
+  NS_ASSERT (harq != 0);
   for (uint8_t layer = 0; layer < params.m_harqStatus.size (); layer++)
     {
       if (params.m_harqStatus.at (layer) == DlInfoListElement_s::ACK)
         {
           // discard buffer
           Ptr<PacketBurst> emptyBuf = CreateObject <PacketBurst> ();
-          (*it).second.at (layer).at (params.m_harqProcessId) = emptyBuf;
+          harq->at (layer).at (params.m_harqProcessId) = emptyBuf;
           NS_LOG_DEBUG (this << " HARQ-ACK UE " << params.m_rnti << " harqId " << (uint16_t)params.m_harqProcessId << " layer " << (uint16_t)layer);
         }
       else if (params.m_harqStatus.at (layer) == DlInfoListElement_s::NACK)
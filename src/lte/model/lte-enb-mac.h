@@ -39,6 +39,7 @@
 #include <ns3/packet.h>
 #include <ns3/packet-burst.h>
 #include <ns3/lte-ccm-mac-sap.h>
+#include <ns3/rnti-table.h>
 
 namespace ns3 {
 
@@ -375,7 +376,7 @@ private:
   void DoDlInfoListElementHarqFeeback (DlInfoListElement_s params);
 
   /// RNTI, LC ID, SAP of the RLC instance
-  std::map <uint16_t, std::map<uint8_t, LteMacSapUser*> > m_rlcAttached;
+  RntiTable<std::map<uint8_t, LteMacSapUser*> > m_rlcAttached;
 
   std::vector <CqiListElement_s> m_dlCqiReceived; ///< DL-CQI received
   std::vector <FfMacSchedSapProvider::SchedUlCqiInfoReqParameters> m_ulCqiReceived; ///< UL-CQI received
@@ -436,7 +437,7 @@ private:
   uint8_t m_macChTtiDelay; ///< delay of MAC, PHY and channel in terms of TTIs
 
 
-  std::map <uint16_t, DlHarqProcessesBuffer_t> m_miDlHarqProcessesPackets; ///< Packet under transmission of the DL HARQ process
+  RntiTable<DlHarqProcessesBuffer_t> m_miDlHarqProcessesPackets; ///< Packet under transmission of the DL HARQ process, by RNTI
   
   uint8_t m_numberOfRaPreambles; ///< number of RA preambles
   uint8_t m_preambleTransMax; ///< preamble transmit maximum
@@ -462,7 +463,7 @@ private:
  
   std::map<uint8_t, uint32_t> m_receivedRachPreambleCount; ///< received RACH preamble count
 
-  std::map<uint16_t, uint32_t> m_rapIdRntiMap; ///< RAPID RNTI map
+  RntiTable<uint32_t> m_rapIdRntiMap; ///< RAPID by RNTI
 
   /// component carrier Id used to address sap
   uint8_t m_componentCarrierId;
@@ -44,6 +44,7 @@
 #include <ns3/node.h>
 #include <ns3/lte-ue-net-device.h>
 #include <ns3/pointer.h>
+#include <ns3/metrics-registry.h>
 
 namespace ns3 {
 
@@ -482,7 +483,18 @@ LteEnbPhy::CreateTxPowerSpectralDensity ()
 {
   NS_LOG_FUNCTION (this);
 
+  static MetricCounter *hits = MetricsRegistry::Get ()->GetCounter ("LteEnbPhy/TxPsdCacheHits");
+  static MetricCounter *misses = MetricsRegistry::Get ()->GetCounter ("LteEnbPhy/TxPsdCacheMisses");
+  static const std::map<int, double> noPowerTxMap;
+
+  if (m_txPsdCache.Matches (m_dlEarfcn, m_dlBandwidth, m_txPower, m_listOfDownlinkSubchannel, noPowerTxMap))
+    {
+      hits->Increment ();
+      return m_txPsdCache.psd;
+    }
+  misses->Increment ();
   Ptr<SpectrumValue> psd = LteSpectrumValueHelper::CreateTxPowerSpectralDensity (m_dlEarfcn, m_dlBandwidth, m_txPower, GetDownlinkSubChannels ());
+  m_txPsdCache.Set (m_dlEarfcn, m_dlBandwidth, m_txPower, m_listOfDownlinkSubchannel, noPowerTxMap, psd);
 
   return psd;
 }
@@ -492,7 +504,17 @@ LteEnbPhy::CreateTxPowerSpectralDensityWithPowerAllocation ()
 {
   NS_LOG_FUNCTION (this);
 
+  static MetricCounter *hits = MetricsRegistry::Get ()->GetCounter ("LteEnbPhy/TxPsdCacheHits");
+  static MetricCounter *misses = MetricsRegistry::Get ()->GetCounter ("LteEnbPhy/TxPsdCacheMisses");
+
+  if (m_txPsdWithPowerAllocationCache.Matches (m_dlEarfcn, m_dlBandwidth, m_txPower, m_listOfDownlinkSubchannel, m_dlPowerAllocationMap))
+    {
+      hits->Increment ();
+      return m_txPsdWithPowerAllocationCache.psd;
+    }
+  misses->Increment ();
   Ptr<SpectrumValue> psd = LteSpectrumValueHelper::CreateTxPowerSpectralDensity (m_dlEarfcn, m_dlBandwidth, m_txPower, m_dlPowerAllocationMap, GetDownlinkSubChannels ());
+  m_txPsdWithPowerAllocationCache.Set (m_dlEarfcn, m_dlBandwidth, m_txPower, m_listOfDownlinkSubchannel, m_dlPowerAllocationMap, psd);
 
   return psd;
 }
@@ -695,21 +717,24 @@ LteEnbPhy::StartSubFrame (void)
                   mask = (mask << 1);
                 }
               // fire trace of DL Tx PHY stats
-              for (uint8_t i = 0; i < dci->GetDci ().m_mcs.size (); i++)
+              if (!m_dlPhyTransmission.IsEmpty ())
                 {
-                  PhyTransmissionStatParameters params;
-                  params.m_cellId = m_cellId;
-                  params.m_imsi = 0; // it will be set by DlPhyTransmissionCallback in LteHelper
-                  params.m_timestamp = Simulator::Now ().GetMilliSeconds ();
-                  params.m_rnti = dci->GetDci ().m_rnti;
-                  params.m_txMode = 0; // TBD
-                  params.m_layer = i;
-                  params.m_mcs = dci->GetDci ().m_mcs.at (i);
-                  params.m_size = dci->GetDci ().m_tbsSize.at (i);
-                  params.m_rv = dci->GetDci ().m_rv.at (i);
-                  params.m_ndi = dci->GetDci ().m_ndi.at (i);
-                  params.m_ccId = m_componentCarrierId;
-                  m_dlPhyTransmission (params);
+                  for (uint8_t i = 0; i < dci->GetDci ().m_mcs.size (); i++)
+                    {
+                      PhyTransmissionStatParameters params;
+                      params.m_cellId = m_cellId;
+                      params.m_imsi = 0; // it will be set by DlPhyTransmissionCallback in LteHelper
+                      params.m_timestamp = Simulator::Now ().GetMilliSeconds ();
+                      params.m_rnti = dci->GetDci ().m_rnti;
+                      params.m_txMode = 0; // TBD
+                      params.m_layer = i;
+                      params.m_mcs = dci->GetDci ().m_mcs.at (i);
+                      params.m_size = dci->GetDci ().m_tbsSize.at (i);
+                      params.m_rv = dci->GetDci ().m_rv.at (i);
+                      params.m_ndi = dci->GetDci ().m_ndi.at (i);
+                      params.m_ccId = m_componentCarrierId;
+                      m_dlPhyTransmission (params);
+                    }
                 }
 
             }
@@ -442,6 +442,11 @@ private:
    */
   std::vector <int> m_listOfDownlinkSubchannel;
 
+  /// The PSD of the control frames, memoized
+  TxPsdCacheEntry m_txPsdCache;
+  /// The PSD of the data frames, with power allocation, memoized
+  TxPsdCacheEntry m_txPsdWithPowerAllocationCache;
+
   std::vector <int> m_dlDataRbMap; ///< DL data RB map
 
   /// For storing info on future receptions.
@@ -44,6 +44,7 @@
 #include <ns3/lte-rlc-um.h>
 #include <ns3/lte-rlc-am.h>
 #include <ns3/lte-pdcp.h>
+#include <ns3/metrics-registry.h>
 
 
 
@@ -611,13 +612,67 @@ UeManager::RecvIdealUeContextRemoveRequest (uint16_t rnti)
 
 void
 UeManager::ScheduleRrcConnectionRecursive(){
-  // std::cout<<"ScheduleRrcConnectionReconfiguration"<<std::endl;
+  NS_LOG_FUNCTION (this);
+  static MetricCounter *updatesSent = MetricsRegistry::Get ()->GetCounter ("LteEnbRrc/MeasConfigUpdatesSent");
+  static MetricCounter *updatesAvoided = MetricsRegistry::Get ()->GetCounter ("LteEnbRrc/MeasConfigUpdatesAvoided");
   if (m_state == CONNECTED_NORMALLY || m_state==CONNECTION_RECONFIGURATION){
-    LteRrcSap::RrcConnectionReconfiguration msg = BuildRrcConnectionReconfiguration ();
+    m_rrc->UpdateCellsToAddModList ();
+    // 3GPP TS 36.331 section 5.5.2.5: the UE removes the cells of the
+    // cellsToRemoveList, then adds or modifies the listed cells of the
+    // measurement object, so only the removed and changed ones are sent
+    std::set<uint8_t> listedCells;
+    std::list<LteRrcSap::CellsToAddMod> changedCells;
+    for (std::list<LteRrcSap::CellsToAddMod>::const_iterator it = m_rrc->m_cellsToAddModList.begin ();
+         it != m_rrc->m_cellsToAddModList.end (); ++it)
+      {
+        listedCells.insert (it->cellIndex);
+        std::map<uint8_t, LteRrcSap::CellsToAddMod>::const_iterator measIt = m_measCellsToAddMod.find (it->cellIndex);
+        if (measIt == m_measCellsToAddMod.end ()
+            || measIt->second.physCellId != it->physCellId
+            || measIt->second.cellIndividualOffset != it->cellIndividualOffset)
+          {
+            changedCells.push_back (*it);
+            m_measCellsToAddMod[it->cellIndex] = *it;
+          }
+      }
+    std::list<uint8_t> removedCells;
+    std::map<uint8_t, LteRrcSap::CellsToAddMod>::iterator measIt = m_measCellsToAddMod.begin ();
+    while (measIt != m_measCellsToAddMod.end ())
+      {
+        if (listedCells.find (measIt->first) == listedCells.end ())
+          {
+            removedCells.push_back (measIt->first);
+            m_measCellsToAddMod.erase (measIt++);
+          }
+        else
+          {
+            ++measIt;
+          }
+      }
+    if (changedCells.empty () && removedCells.empty ())
+      {
+        NS_LOG_LOGIC ("RNTI " << m_rnti << " cell individual offsets up to date");
+        ++m_rrc->m_measConfigUpdatesAvoided;
+        updatesAvoided->Increment ();
+        return;
+      }
+
+    LteRrcSap::RrcConnectionReconfiguration msg;
+    msg.rrcTransactionIdentifier = GetNewRrcTransactionIdentifier ();
+    msg.haveMeasConfig = true;
+    msg.haveMobilityControlInfo = false;
+    msg.haveRadioResourceConfigDedicated = false;
+    msg.haveNonCriticalExtension = false;
+    msg.measConfig.haveQuantityConfig = false;
+    msg.measConfig.haveMeasGapConfig = false;
+    msg.measConfig.haveSmeasure = false;
+    msg.measConfig.haveSpeedStatePars = false;
+    LteRrcSap::MeasObjectToAddMod measObject = BuildMeasObject ();
+    measObject.measObjectEutra.cellsToRemoveList = removedCells;
+    measObject.measObjectEutra.cellsToAddModList = changedCells;
+    msg.measConfig.measObjectToAddModList.push_back (measObject);
     m_rrc->m_rrcSapUser->SendRrcConnectionReconfiguration (m_rnti, msg);
-    
-    // //Seconds(interval) 
-    // Simulator::Schedule(Seconds(0.001), &UeManager::ScheduleRrcConnectionRecursive, this);
+    updatesSent->Increment ();
   }
 }
 
@@ -1455,6 +1510,21 @@ UeManager::RemoveDataRadioBearerInfo (uint8_t drbid)
 }
 
 
+LteRrcSap::MeasObjectToAddMod
+UeManager::BuildMeasObject ()
+{
+  NS_LOG_FUNCTION (this);
+  LteRrcSap::MeasObjectToAddMod measObject;
+  measObject.measObjectId = 1;
+  measObject.measObjectEutra.carrierFreq = m_rrc->m_dlEarfcn;
+  measObject.measObjectEutra.allowedMeasBandwidth = m_rrc->m_dlBandwidth;
+  measObject.measObjectEutra.presenceAntennaPort1 = false;
+  measObject.measObjectEutra.neighCellConfig = 0;
+  measObject.measObjectEutra.offsetFreq = 0;
+  measObject.measObjectEutra.haveCellForWhichToReportCGI = false;
+  return measObject;
+}
+
 LteRrcSap::RrcConnectionReconfiguration
 UeManager::BuildRrcConnectionReconfiguration ()
 {
@@ -1468,15 +1538,7 @@ UeManager::BuildRrcConnectionReconfiguration ()
 
 
 
-  LteRrcSap::MeasObjectToAddMod measObject;
-  measObject.measObjectId = 1;
-  measObject.measObjectEutra.carrierFreq = m_rrc->m_dlEarfcn;
-  measObject.measObjectEutra.allowedMeasBandwidth = m_rrc->m_dlBandwidth;
-  //std::cout<<"PRINT M_RRC_DL_BANDWIDTH" << m_rrc->m_dlBandwidth << std::endl;
-  measObject.measObjectEutra.presenceAntennaPort1 = false;
-  measObject.measObjectEutra.neighCellConfig = 0;
-  measObject.measObjectEutra.offsetFreq = 0;
-  measObject.measObjectEutra.haveCellForWhichToReportCGI = false;
+  LteRrcSap::MeasObjectToAddMod measObject = BuildMeasObject ();
   // for (int i =1; i <= totalEnb; i++){
   //   LteRrcSap::CellsToAddMod cellsToAddMod;
   //   cellsToAddMod.cellIndex=i;
@@ -1496,7 +1558,14 @@ UeManager::BuildRrcConnectionReconfiguration ()
 
 
   //LteRrcSap::MeasObjectEutra measObjectEutra;
+  m_rrc->UpdateCellsToAddModList ();
   measObject.measObjectEutra.cellsToAddModList = m_rrc->m_cellsToAddModList;
+  m_measCellsToAddMod.clear ();
+  for (std::list<LteRrcSap::CellsToAddMod>::const_iterator it = m_rrc->m_cellsToAddModList.begin ();
+       it != m_rrc->m_cellsToAddModList.end (); ++it)
+    {
+      m_measCellsToAddMod[it->cellIndex] = *it;
+    }
   //m_rrc->m_ueMeasConfig.measObjectToAddModList
   // std::cout<<"PRINT size of measobjecttoaddmod" << m_rrc->m_ueMeasConfig.measObjectToAddModList.size() << std::endl;
   // std::cout<<"PRINT size of measobjecttoaddmod" << msg.measConfig.measObjectToAddModList.size() << std::endl;
@@ -1750,7 +1819,8 @@ UeManager::BuildNonCriticalExtentionConfigurationCa ()
 NS_OBJECT_ENSURE_REGISTERED (LteEnbRrc);
 
 LteEnbRrc::LteEnbRrc ()
-  : m_x2SapProvider (0),
+  : m_cellIndividualOffsetVersion (0),
+    m_x2SapProvider (0),
     m_cmacSapProvider (0),
     m_handoverManagementSapProvider (0),
     m_ccmRrcSapProvider (0),
@@ -1764,6 +1834,7 @@ LteEnbRrc::LteEnbRrc ()
     m_lastAllocatedRnti (0),
     m_srsCurrentPeriodicityId (0),
     m_lastAllocatedConfigurationIndex (0),
+    m_measConfigUpdatesAvoided (0),
     m_reconfigureUes (false),
     m_numberOfComponentCarriers (0),
     m_carriersConfigured (false)
@@ -1824,6 +1895,8 @@ LteEnbRrc::DoDispose ()
   m_ffrRrcSapUser.erase (m_ffrRrcSapUser.begin (),m_ffrRrcSapUser.end ());
   m_ffrRrcSapUser.clear ();
   m_ueMap.clear ();  
+  m_ueManagerByRnti.Clear ();
+  m_cellIndividualOffset = 0;
   delete m_handoverManagementSapUser;
   delete m_ccmRrcSapUser;
   delete m_anrSapUser;
@@ -2228,8 +2301,7 @@ bool
 LteEnbRrc::HasUeManager (uint16_t rnti) const
 {
   NS_LOG_FUNCTION (this << (uint32_t) rnti);
-  std::map<uint16_t, Ptr<UeManager> >::const_iterator it = m_ueMap.find (rnti);
-  return (it != m_ueMap.end ());
+  return m_ueManagerByRnti.Contains (rnti);
 }
 
 Ptr<UeManager>
@@ -2237,10 +2309,10 @@ LteEnbRrc::GetUeManager (uint16_t rnti)
 {
   NS_LOG_FUNCTION (this << (uint32_t) rnti);
   NS_ASSERT (0 != rnti);
-  std::map<uint16_t, Ptr<UeManager> >::iterator it = m_ueMap.find (rnti);
+  UeManager * const *ueManager = m_ueManagerByRnti.Find (rnti);
 
   // New
-  if(!HasUeManager(rnti)){
+  if(ueManager == 0){
     std::cout<<"No rnti: "<<rnti<<"  in Cell: "<<temp_cellId<<std::endl;
   }
 
@@ -2252,12 +2324,12 @@ LteEnbRrc::GetUeManager (uint16_t rnti)
 
 
 //   std::cout<<" IMSI: "<<temp_imsi<<std::endl;
-  NS_ASSERT_MSG (it != m_ueMap.end (), "UE manager for RNTI " << rnti << " not found");
+  NS_ASSERT_MSG (ueManager != 0, "UE manager for RNTI " << rnti << " not found");
   
 
  
   // }
-  return it->second;
+  return *ueManager;
 }
 
 uint8_t
@@ -3153,7 +3225,7 @@ LteEnbRrc::AddUe (UeManager::State state, uint8_t componentCarrierId)
        (rnti != m_lastAllocatedRnti - 1) && (!found);
        ++rnti)
     {
-      if ((rnti != 0) && (m_ueMap.find (rnti) == m_ueMap.end ()))
+      if ((rnti != 0) && !m_ueManagerByRnti.Contains (rnti))
         {
           found = true;
           break;
@@ -3165,6 +3237,7 @@ LteEnbRrc::AddUe (UeManager::State state, uint8_t componentCarrierId)
   Ptr<UeManager> ueManager = CreateObject<UeManager> (this, rnti, state, componentCarrierId);
   m_ccmRrcSapProvider-> AddUe (rnti, (uint8_t)state);
   m_ueMap.insert (std::pair<uint16_t, Ptr<UeManager> > (rnti, ueManager));
+  m_ueManagerByRnti.Insert (rnti, PeekPointer (ueManager));
   ueManager->Initialize ();
   const uint16_t cellId = ComponentCarrierToCellId (componentCarrierId);
   NS_LOG_DEBUG (this << " New UE RNTI " << rnti << " cellId " << cellId << " srs CI " << ueManager->GetSrsConfigurationIndex ());
@@ -3239,6 +3312,7 @@ LteEnbRrc::RemoveUe (uint16_t rnti)
   // fire trace upon connection release
   m_connectionReleaseTrace (imsi, ComponentCarrierToCellId (it->second->GetComponentCarrierId ()), rnti);
   m_ueMap.erase (it);
+  m_ueManagerByRnti.Erase (rnti);
 
   ///////////////////////
   //New Part
@@ -3291,6 +3365,7 @@ LteEnbRrc::RemoveUe (uint16_t rnti)
       m_s1SapProvider->UeContextRelease (rnti);
     }
   m_ccmRrcSapProvider-> RemoveUe (rnti);
+  m_handoverManagementSapProvider->RemoveUe (rnti);
   // need to do this after UeManager has been deleted
   if (srsCi != 0)
     {
@@ -3345,6 +3420,50 @@ void LteEnbRrc::setCellstoAddModList(std::list<LteRrcSap::CellsToAddMod> list_te
   m_cellsToAddModList = list_temp;
 }
 
+uint64_t
+LteEnbRrc::GetNMeasConfigUpdatesAvoided (void) const
+{
+  return m_measConfigUpdatesAvoided;
+}
+
+void
+LteEnbRrc::SetCellIndividualOffsetTable (Ptr<CellIndividualOffset> cellIndividualOffset)
+{
+  NS_LOG_FUNCTION (this << cellIndividualOffset);
+  m_cellIndividualOffset = cellIndividualOffset;
+  // the offsets are copied at the next update, even if unchanged
+  m_cellIndividualOffsetVersion = cellIndividualOffset == 0 ? 0 : cellIndividualOffset->GetVersion () - 1;
+}
+
+Ptr<CellIndividualOffset>
+LteEnbRrc::GetCellIndividualOffsetTable (void) const
+{
+  return m_cellIndividualOffset;
+}
+
+void
+LteEnbRrc::UpdateCellsToAddModList (void)
+{
+  if (m_cellIndividualOffset == 0)
+    {
+      return;
+    }
+  uint64_t version = m_cellIndividualOffset->GetVersion ();
+  if (version == m_cellIndividualOffsetVersion)
+    {
+      return;
+    }
+  NS_LOG_FUNCTION (this << version);
+  CellIndividualOffset::ConstSpan offsets = m_cellIndividualOffset->GetOffsetList ();
+  for (std::list<LteRrcSap::CellsToAddMod>::iterator it = m_cellsToAddModList.begin ();
+       it != m_cellsToAddModList.end (); ++it)
+    {
+      // the cell index of the list of a SLC2 eNB is the cell ID
+      it->cellIndividualOffset = it->cellIndex >= 1 && it->cellIndex <= offsets.size () ? (int8_t) offsets[it->cellIndex - 1] : 0;
+    }
+  m_cellIndividualOffsetVersion = version;
+}
+
 void
 LteEnbRrc::AddX2Neighbour (uint16_t cellId)
 {
@@ -51,6 +51,8 @@
 #include <map>
 #include <set>
 #include <ns3/component-carrier-enb.h>
+#include <ns3/rnti-table.h>
+#include <ns3/cell-individual-offset.h>
 #include <vector>
 
 #define MIN_NO_CC 1
@@ -194,6 +196,13 @@ public:
    */
   void ScheduleRrcConnectionReconfiguration ();
 
+  /**
+   * Update the cell individual offsets configured at the UE, if it is
+   * connected, to the CellsToAddMod list of the eNB RRC. Only the cells
+   * whose offsets changed since the last measurement configuration of the
+   * UE are sent, in an RRC Connection Reconfiguration which carries no
+   * other configuration; nothing is sent if no offset changed.
+   */
   void ScheduleRrcConnectionRecursive();
 
   /** 
@@ -457,6 +466,12 @@ private:
    */
   LteRrcSap::RrcConnectionReconfiguration BuildRrcConnectionReconfiguration ();
 
+  /**
+   * \return the E-UTRA measurement object of the serving frequency, without
+   * its cells
+   */
+  LteRrcSap::MeasObjectToAddMod BuildMeasObject ();
+
   /** 
    * 
    * \return an NonCriticalExtensionConfiguration struct built based on the
@@ -638,6 +653,9 @@ private:
   /// Define if the Carrier Aggregation was already configure for the current UE on not
   bool m_caSupportConfigured;
 
+  /// The CellsToAddMod list of the last measurement configuration of the UE, by cell index
+  std::map<uint8_t, LteRrcSap::CellsToAddMod> m_measCellsToAddMod;
+
   /// Pending start data radio bearers
   bool m_pendingStartDataRadioBearers;
 
@@ -1441,6 +1459,31 @@ public:
 
   std::list<LteRrcSap::CellsToAddMod> m_cellsToAddModList; //NS-3 SON:
   void setCellstoAddModList (std::list<LteRrcSap::CellsToAddMod> list_temp); //NS-3 SON
+  /**
+   * \return the number of RRC Connection Reconfigurations of the cell
+   * individual offsets which were not sent because the offsets of the UE
+   * were already up to date
+   */
+  uint64_t GetNMeasConfigUpdatesAvoided (void) const;
+
+  /**
+   * \brief Take the cell individual offsets of the cellsToAddModList sent
+   *        to the UEs from the given offsets, when they change.
+   * \param cellIndividualOffset the offsets of the cells, usually shared
+   *        by all the eNodeBs installed by an LteHelper
+   */
+  void SetCellIndividualOffsetTable (Ptr<CellIndividualOffset> cellIndividualOffset);
+  /**
+   * \return the offsets of the cells, or 0 if not set
+   */
+  Ptr<CellIndividualOffset> GetCellIndividualOffsetTable (void) const;
+  /**
+   * \brief Copy the offsets of the cells into the cellsToAddModList, if
+   *        they changed since the last update.
+   */
+  void UpdateCellsToAddModList (void);
+  Ptr<CellIndividualOffset> m_cellIndividualOffset; ///< the offsets of the cells
+  uint64_t m_cellIndividualOffsetVersion; ///< the version of the offsets in the cellsToAddModList
   /** 
    * Add a neighbour with an X2 interface
    *
@@ -1487,6 +1530,10 @@ public:
    * The `UeMap` attribute. List of UeManager by C-RNTI.
    */
   std::map<uint16_t, Ptr<UeManager> > m_ueMap;
+  /**
+   * The UE managers of m_ueMap, for the constant time lookups by C-RNTI.
+   */
+  RntiTable<UeManager *> m_ueManagerByRnti;
 
   // NS3-SON
   // int RrcConnectionReEstablishmentAttemps = 0;
@@ -1658,6 +1705,7 @@ private:
   uint16_t m_srsCurrentPeriodicityId; ///< SRS current periodicity ID
   std::set<uint16_t> m_ueSrsConfigurationIndexSet; ///< UE SRS configuration index set
   uint16_t m_lastAllocatedConfigurationIndex; ///< last allocated configuration index
+  uint64_t m_measConfigUpdatesAvoided; ///< reconfigurations of the cell individual offsets not sent
   bool m_reconfigureUes; ///< reconfigure UEs?
 
   /**
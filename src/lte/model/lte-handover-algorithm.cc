@@ -56,5 +56,11 @@ LteHandoverAlgorithm::DoDispose ()
 }
 
 
+void
+LteHandoverAlgorithm::DoRemoveUe (uint16_t rnti)
+{
+}
+
+
 
 } // end of namespace ns3
@@ -105,6 +105,17 @@ protected:
    */
   virtual void DoReportUeMeas (uint16_t rnti, LteRrcSap::MeasResults measResults) = 0;
 
+  /**
+   * \brief Implementation of LteHandoverManagementSapProvider::RemoveUe.
+   *
+   * The default implementation does nothing, for the algorithms without
+   * per-UE state.
+   *
+   * \param rnti Radio Network Temporary Identity, an integer identifying the UE
+   *             whose context is removed
+   */
+  virtual void DoRemoveUe (uint16_t rnti);
+
 }; // end of class LteHandoverAlgorithm
 
 
@@ -54,6 +54,16 @@ public:
   virtual void ReportUeMeas (uint16_t rnti,
                              LteRrcSap::MeasResults measResults) = 0;
 
+  /**
+   * \brief Remove the context of a UE from the handover algorithm.
+   * \param rnti Radio Network Temporary Identity, an integer identifying the UE
+   *             whose context is removed from the eNodeB
+   *
+   * The RNTI may later be assigned to another UE, which shall not inherit
+   * any state of the removed UE.
+   */
+  virtual void RemoveUe (uint16_t rnti) = 0;
+
 }; // end of class LteHandoverManagementSapProvider
 
 
@@ -124,6 +134,7 @@ public:
 
   // inherited from LteHandoverManagemenrSapProvider
   virtual void ReportUeMeas (uint16_t rnti, LteRrcSap::MeasResults measResults);
+  virtual void RemoveUe (uint16_t rnti);
 
 private:
   MemberLteHandoverManagementSapProvider ();
@@ -147,6 +158,14 @@ MemberLteHandoverManagementSapProvider<C>::ReportUeMeas (uint16_t rnti, LteRrcSa
 }
 
 
+template <class C>
+void
+MemberLteHandoverManagementSapProvider<C>::RemoveUe (uint16_t rnti)
+{
+  m_owner->DoRemoveUe (rnti);
+}
+
+
 
 /**
  * \brief Template for the implementation of the LteHandoverManagementSapUser
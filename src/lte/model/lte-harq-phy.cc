@@ -31,22 +31,25 @@ NS_LOG_COMPONENT_DEFINE ("LteHarqPhy");
 //  ;
 
 
+const uint8_t LteHarqPhy::HARQ_PROCESSES;
+const uint8_t LteHarqPhy::HARQ_LAYERS;
+
+
+LteHarqPhy::UlHarqBuffers::UlHarqBuffers ()
+  : m_subframe (0)
+{
+}
+
+
 LteHarqPhy::LteHarqPhy ()
+  : m_nSubframes (0)
 {
-  // Create DL Decodification HARQ buffers
-  std::vector <HarqProcessInfoList_t> dlHarqLayer0;
-  dlHarqLayer0.resize (8);
-  std::vector <HarqProcessInfoList_t> dlHarqLayer1;
-  dlHarqLayer1.resize (8);
-  m_miDlHarqProcessesInfoMap.push_back (dlHarqLayer0);
-  m_miDlHarqProcessesInfoMap.push_back (dlHarqLayer1);
 }
 
 
 LteHarqPhy::~LteHarqPhy ()
 {
-  m_miDlHarqProcessesInfoMap.clear ();
-  m_miUlHarqProcessesInfoMap.clear ();
+  m_miUlHarqProcessesInfo.Clear ();
 }
 
 
@@ -55,15 +58,41 @@ LteHarqPhy::SubframeIndication (uint32_t frameNo, uint32_t subframeNo)
 {
   NS_LOG_FUNCTION (this);
 
-  // left shift UL HARQ buffers
-  std::map <uint16_t, std::vector <HarqProcessInfoList_t> >::iterator it;
-  for (it = m_miUlHarqProcessesInfoMap.begin (); it != m_miUlHarqProcessesInfoMap.end (); it++)
+  // left shift UL HARQ buffers, done by GetUlHarqBuffers when they are accessed
+  ++m_nSubframes;
+}
+
+
+LteHarqPhy::UlHarqBuffers&
+LteHarqPhy::GetUlHarqBuffers (uint16_t rnti)
+{
+  UlHarqBuffers *buffers = m_miUlHarqProcessesInfo.Find (rnti);
+  if (buffers == 0)
     {
-      (*it).second.erase ((*it).second.begin ());
-      HarqProcessInfoList_t h;
-      (*it).second.push_back (h);      
+      // new entry
+      m_miUlHarqProcessesInfo.Insert (rnti, UlHarqBuffers ());
+      buffers = m_miUlHarqProcessesInfo.Find (rnti);
+      buffers->m_subframe = m_nSubframes;
+      return *buffers;
     }
+  // each shift drops the first process and appends an empty one, which
+  // takes its place in the ring
+  for (uint64_t subframe = buffers->m_subframe;
+       subframe < m_nSubframes && subframe < buffers->m_subframe + HARQ_PROCESSES;
+       ++subframe)
+    {
+      buffers->m_processes[subframe % HARQ_PROCESSES].clear ();
+    }
+  buffers->m_subframe = m_nSubframes;
+  return *buffers;
+}
+
 
+HarqProcessInfoList_t&
+LteHarqPhy::GetUlProcess (UlHarqBuffers &buffers, uint8_t harqProcId)
+{
+  NS_ASSERT (harqProcId < HARQ_PROCESSES);
+  return buffers.m_processes[(buffers.m_subframe + harqProcId) % HARQ_PROCESSES];
 }
 
 
@@ -71,7 +100,7 @@ double
 LteHarqPhy::GetAccumulatedMiDl (uint8_t harqProcId, uint8_t layer)
 {
   NS_LOG_FUNCTION (this << (uint32_t)harqProcId << (uint16_t)layer);
-  HarqProcessInfoList_t list = m_miDlHarqProcessesInfoMap.at (layer).at (harqProcId);
+  const HarqProcessInfoList_t& list = GetHarqProcessInfoDl (harqProcId, layer);
   double mi = 0.0;
   for (uint8_t i = 0; i < list.size (); i++)
     {
@@ -80,11 +109,12 @@ LteHarqPhy::GetAccumulatedMiDl (uint8_t harqProcId, uint8_t layer)
   return (mi);
 }
 
-HarqProcessInfoList_t
+const HarqProcessInfoList_t&
 LteHarqPhy::GetHarqProcessInfoDl (uint8_t harqProcId, uint8_t layer)
 {
   NS_LOG_FUNCTION (this << (uint32_t)harqProcId << (uint16_t)layer);
-  return (m_miDlHarqProcessesInfoMap.at (layer).at (harqProcId));   
+  NS_ASSERT (layer < HARQ_LAYERS && harqProcId < HARQ_PROCESSES);
+  return (m_miDlHarqProcessesInfo[layer][harqProcId]);
 }
 
 
@@ -93,10 +123,8 @@ LteHarqPhy::GetAccumulatedMiUl (uint16_t rnti)
 {
   NS_LOG_FUNCTION (this << rnti);
 
-  std::map <uint16_t, std::vector <HarqProcessInfoList_t> >::iterator it;
-  it = m_miUlHarqProcessesInfoMap.find (rnti);
-  NS_ASSERT_MSG (it!=m_miUlHarqProcessesInfoMap.end (), " Does not find MI for RNTI");
-  HarqProcessInfoList_t list = (*it).second.at (0);
+  NS_ASSERT_MSG (m_miUlHarqProcessesInfo.Contains (rnti), " Does not find MI for RNTI");
+  const HarqProcessInfoList_t& list = GetUlProcess (GetUlHarqBuffers (rnti), 0);
   double mi = 0.0;
   for (uint8_t i = 0; i < list.size (); i++)
     {
@@ -105,24 +133,11 @@ LteHarqPhy::GetAccumulatedMiUl (uint16_t rnti)
   return (mi);
 }
 
-HarqProcessInfoList_t
+const HarqProcessInfoList_t&
 LteHarqPhy::GetHarqProcessInfoUl (uint16_t rnti, uint8_t harqProcId)
 {
   NS_LOG_FUNCTION (this << rnti << (uint16_t)harqProcId);
-  std::map <uint16_t, std::vector <HarqProcessInfoList_t> >::iterator it;
-  it = m_miUlHarqProcessesInfoMap.find (rnti);
-  if (it==m_miUlHarqProcessesInfoMap.end ())
-    {
-      // new entry
-      std::vector <HarqProcessInfoList_t> harqList;
-      harqList.resize (8);
-      m_miUlHarqProcessesInfoMap.insert (std::pair <uint16_t, std::vector <HarqProcessInfoList_t> > (rnti, harqList));
-      return (harqList.at (harqProcId));
-    }
-  else
-    {
-      return ((*it).second.at (harqProcId));
-    }
+  return GetUlProcess (GetUlHarqBuffers (rnti), harqProcId);
 }
 
 
@@ -131,7 +146,9 @@ void
 LteHarqPhy::UpdateDlHarqProcessStatus (uint8_t id, uint8_t layer, double mi, uint16_t infoBytes, uint16_t codeBytes)
 {
   NS_LOG_FUNCTION (this << (uint16_t) id << mi);
-  if (m_miDlHarqProcessesInfoMap.at (layer).at (id).size () == 3)  // MAX HARQ RETX
+  NS_ASSERT (layer < HARQ_LAYERS && id < HARQ_PROCESSES);
+  HarqProcessInfoList_t& list = m_miDlHarqProcessesInfo[layer][id];
+  if (list.size () == 3)  // MAX HARQ RETX
     {
       // HARQ should be disabled -> discard info
       return;
@@ -140,7 +157,7 @@ LteHarqPhy::UpdateDlHarqProcessStatus (uint8_t id, uint8_t layer, double mi, uin
   el.m_mi = mi;
   el.m_infoBits = infoBytes * 8;
   el.m_codeBits = codeBytes * 8;
-  m_miDlHarqProcessesInfoMap.at (layer).at (id).push_back (el);
+  list.push_back (el);
 }
 
 
@@ -148,9 +165,10 @@ void
 LteHarqPhy::ResetDlHarqProcessStatus (uint8_t id)
 {
   NS_LOG_FUNCTION (this << (uint16_t) id);
-  for (uint8_t i = 0; i < m_miDlHarqProcessesInfoMap.size (); i++)
+  NS_ASSERT (id < HARQ_PROCESSES);
+  for (uint8_t i = 0; i < HARQ_LAYERS; i++)
     {
-      m_miDlHarqProcessesInfoMap.at (i).at (id).clear ();
+      m_miDlHarqProcessesInfo[i][id].clear ();
     }
   
 }
@@ -160,60 +178,30 @@ void
 LteHarqPhy::UpdateUlHarqProcessStatus (uint16_t rnti, double mi, uint16_t infoBytes, uint16_t codeBytes)
 {
   NS_LOG_FUNCTION (this << rnti << mi);
-  std::map <uint16_t, std::vector <HarqProcessInfoList_t> >::iterator it;
-  it = m_miUlHarqProcessesInfoMap.find (rnti);
-  if (it==m_miUlHarqProcessesInfoMap.end ())
+  UlHarqBuffers& buffers = GetUlHarqBuffers (rnti);
+  const HarqProcessInfoList_t& current = GetUlProcess (buffers, 0);
+  HarqProcessInfoList_t& last = GetUlProcess (buffers, HARQ_PROCESSES - 1);
+  if (current.size () == 3) // MAX HARQ RETX
     {
-      // new entry
-      std::vector <HarqProcessInfoList_t> harqList;
-      harqList.resize (8);
-      HarqProcessInfoElement_t el;
-      el.m_mi = mi;
-      el.m_infoBits = infoBytes * 8;
-      el.m_codeBits = codeBytes * 8;
-      harqList.at (7).push_back (el);
-      m_miUlHarqProcessesInfoMap.insert (std::pair <uint16_t, std::vector <HarqProcessInfoList_t> > (rnti, harqList));
-    }
-  else
-    {
-      if ((*it).second.at (0).size () == 3) // MAX HARQ RETX
-        {
-          // HARQ should be disabled -> discard info
-          return;
-        }
-      
-//       move current status back at the end to maintain full history
-      HarqProcessInfoList_t list = (*it).second.at (0);
-      for (uint8_t i = 0; i < list.size (); i++)
-        {
-          (*it).second.at (7).push_back (list.at (i));
-        }
-      
-      HarqProcessInfoElement_t el;
-      el.m_mi = mi;
-      el.m_infoBits = infoBytes * 8;
-      el.m_codeBits = codeBytes * 8;
-      (*it).second.at (7).push_back (el);
+      // HARQ should be disabled -> discard info
+      return;
     }
+
+  // move current status back at the end to maintain full history
+  last.insert (last.end (), current.begin (), current.end ());
+
+  HarqProcessInfoElement_t el;
+  el.m_mi = mi;
+  el.m_infoBits = infoBytes * 8;
+  el.m_codeBits = codeBytes * 8;
+  last.push_back (el);
 }
 
 void
 LteHarqPhy::ResetUlHarqProcessStatus (uint16_t rnti, uint8_t id)
 {
   NS_LOG_FUNCTION (this << rnti << (uint16_t)id);
-  std::map <uint16_t, std::vector <HarqProcessInfoList_t> >::iterator it;
-  it = m_miUlHarqProcessesInfoMap.find (rnti);
-  if (it==m_miUlHarqProcessesInfoMap.end ())
-    {
-      // new entry
-      std::vector <HarqProcessInfoList_t> harqList;
-      harqList.resize (8);
-      m_miUlHarqProcessesInfoMap.insert (std::pair <uint16_t, std::vector <HarqProcessInfoList_t> > (rnti, harqList));
-    }
-  else
-    {
-      (*it).second.at (id).clear ();
-    }
+  GetUlProcess (GetUlHarqBuffers (rnti), id).clear ();
 }
 
 void
@@ -221,14 +209,13 @@ LteHarqPhy::ClearDlHarqBuffer (uint16_t rnti)
 {
   NS_LOG_FUNCTION (this << rnti);
   // flush the DL harq buffers
-  m_miDlHarqProcessesInfoMap.clear ();
-  // Recreate DL Decodification HARQ buffers
-  std::vector<HarqProcessInfoList_t> dlHarqLayer0;
-  dlHarqLayer0.resize (8);
-  std::vector<HarqProcessInfoList_t> dlHarqLayer1;
-  dlHarqLayer1.resize (8);
-  m_miDlHarqProcessesInfoMap.push_back (dlHarqLayer0);
-  m_miDlHarqProcessesInfoMap.push_back (dlHarqLayer1);
+  for (uint8_t i = 0; i < HARQ_LAYERS; i++)
+    {
+      for (uint8_t j = 0; j < HARQ_PROCESSES; j++)
+        {
+          m_miDlHarqProcessesInfo[i][j].clear ();
+        }
+    }
 }
 
 
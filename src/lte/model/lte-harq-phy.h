@@ -28,8 +28,8 @@
 #include <ns3/assert.h>
 #include <math.h>
 #include <vector>
-#include <map>
 #include <ns3/simple-ref-count.h>
+#include <ns3/rnti-table.h>
 
 
 namespace ns3 {
@@ -52,6 +52,14 @@ typedef std::vector <HarqProcessInfoElement_t> HarqProcessInfoList_t; ///< HarqP
  * \brief The LteHarqPhy class implements the HARQ functionalities related to PHY layer
  *(i.e., decodification buffers for incremental redundancy management)
  *
+ * The buffers of the 8 processes of each layer (DL) or RNTI (UL) have a
+ * fixed layout, and the lists of their transmissions keep their capacity
+ * when they are reset, so that no memory is allocated once the buffers
+ * are warm. The UL buffers of an RNTI are a ring, which is shifted by one
+ * process per subframe when the buffers of the RNTI are next accessed.
+ *
+ * The lists returned by the getters are references to the buffers, valid
+ * until the next update of the buffers.
 */
 class LteHarqPhy : public SimpleRefCount<LteHarqPhy>
 {
@@ -82,7 +90,7 @@ public:
   * \param layer layer no. (for MIMO spatial multiplexing)
   * \return the vector of the info related to HARQ proc Id
   */
-  HarqProcessInfoList_t GetHarqProcessInfoDl (uint8_t harqProcId, uint8_t layer);
+  const HarqProcessInfoList_t& GetHarqProcessInfoDl (uint8_t harqProcId, uint8_t layer);
 
   /**
   * \brief Return the cumulated MI of the HARQ procId in case of retransmissions
@@ -99,7 +107,7 @@ public:
   * \param harqProcId the HARQ proc id
   * \return the vector of the info related to HARQ proc Id
   */
-  HarqProcessInfoList_t GetHarqProcessInfoUl (uint16_t rnti, uint8_t harqProcId);
+  const HarqProcessInfoList_t& GetHarqProcessInfoUl (uint16_t rnti, uint8_t harqProcId);
 
   /**
   * \brief Update the Info associated to the decodification of an HARQ process
@@ -150,9 +158,38 @@ public:
 
 private:
 
-  std::vector <std::vector <HarqProcessInfoList_t> > m_miDlHarqProcessesInfoMap; ///< MI DL HARQ processes info map
-  std::map <uint16_t, std::vector <HarqProcessInfoList_t> > m_miUlHarqProcessesInfoMap; ///< MI UL HARQ processes info map
-  
+  /// Number of HARQ processes
+  static const uint8_t HARQ_PROCESSES = 8;
+  /// Number of layers of the DL HARQ buffers
+  static const uint8_t HARQ_LAYERS = 2;
+
+  /// UL HARQ buffers of an RNTI
+  struct UlHarqBuffers
+  {
+    UlHarqBuffers ();
+    HarqProcessInfoList_t m_processes[HARQ_PROCESSES]; ///< process i is at (m_subframe + i) % HARQ_PROCESSES
+    uint64_t m_subframe; ///< subframe up to which the ring was shifted
+  };
+
+  /**
+   * \brief Get the UL HARQ buffers of an RNTI, shifted up to the current
+   * subframe, creating empty buffers for a new RNTI
+   * \param rnti the RNTI of the transmitter
+   * \return the buffers of the RNTI
+   */
+  UlHarqBuffers& GetUlHarqBuffers (uint16_t rnti);
+
+  /**
+   * \param buffers the UL HARQ buffers of an RNTI
+   * \param harqProcId the HARQ proc id, in the order of the shifts
+   * \return the info of the HARQ process
+   */
+  HarqProcessInfoList_t& GetUlProcess (UlHarqBuffers &buffers, uint8_t harqProcId);
+
+  HarqProcessInfoList_t m_miDlHarqProcessesInfo[HARQ_LAYERS][HARQ_PROCESSES]; ///< MI DL HARQ processes info, by layer and process
+  RntiTable<UlHarqBuffers> m_miUlHarqProcessesInfo; ///< MI UL HARQ processes info, by RNTI
+  uint64_t m_nSubframes; ///< number of subframe indications
+
 
 };
 
@@ -53,6 +53,7 @@ LteInterference::DoDispose ()
   m_rxSignal = 0;
   m_allSignals = 0;
   m_noise = 0;
+  m_background = 0;
   Object::DoDispose ();
 } 
 
@@ -218,6 +219,7 @@ LteInterference::SetNoisePowerSpectralDensity (Ptr<const SpectrumValue> noisePsd
   // reset m_allSignals (will reset if already set previously)
   // this is needed since this method can potentially change the SpectrumModel
   m_allSignals = Create<SpectrumValue> (noisePsd->GetSpectrumModel ());
+  m_background = 0;
   if (m_receiving == true)
     {
       // abort rx
@@ -228,6 +230,24 @@ LteInterference::SetNoisePowerSpectralDensity (Ptr<const SpectrumValue> noisePsd
   m_lastSignalIdBeforeReset = m_lastSignalId;
 }
 
+void
+LteInterference::SetBackgroundPowerSpectralDensity (Ptr<const SpectrumValue> backgroundPsd)
+{
+  NS_LOG_FUNCTION (this << backgroundPsd);
+  NS_ASSERT_MSG (m_allSignals, "the noise must be set before the background");
+  ConditionallyEvaluateChunk ();
+  if (m_background)
+    {
+      (*m_allSignals) -= (*m_background);
+    }
+  m_background = backgroundPsd;
+  if (m_background)
+    {
+      NS_ASSERT (m_background->GetSpectrumModel () == m_allSignals->GetSpectrumModel ());
+      (*m_allSignals) += (*m_background);
+    }
+}
+
 void
 LteInterference::AddRsPowerChunkProcessor (Ptr<LteChunkProcessor> p)
 {
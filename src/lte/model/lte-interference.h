@@ -110,6 +110,17 @@ public:
    */
   virtual void SetNoisePowerSpectralDensity (Ptr<const SpectrumValue> noisePsd);
 
+  /**
+   * Set a background interference, which is present in addition to the
+   * signals added by AddSignal until the next call of this method or of
+   * SetNoisePowerSpectralDensity. The background is used to approximate
+   * the interference of the transmitters whose signals are not simulated.
+   *
+   * @param backgroundPsd the Power Spectral Density of the background, on
+   * the SpectrumModel of the noise, or 0 for no background
+   */
+  virtual void SetBackgroundPowerSpectralDensity (Ptr<const SpectrumValue> backgroundPsd);
+
 protected:
   /**
    * Conditionally evaluate chunk
@@ -143,6 +154,8 @@ protected:
 
   Ptr<const SpectrumValue> m_noise {nullptr}; ///< the noise value
 
+  Ptr<const SpectrumValue> m_background {nullptr}; ///< the background included in m_allSignals
+
   Time m_lastChangeTime {Seconds(0)}; /**< the time of the last change in
                                        * m_TotalPower
                                        */
@@ -266,4 +266,34 @@ LtePhy::GetComponentCarrierId ()
   return m_componentCarrierId;
 }
 
+LtePhy::TxPsdCacheEntry::TxPsdCacheEntry ()
+  : earfcn (0),
+    bandwidth (0),
+    txPower (0)
+{
+}
+
+bool
+LtePhy::TxPsdCacheEntry::Matches (uint32_t earfcn, uint16_t bandwidth, double txPower,
+                                  const std::vector<int> &activeRbs,
+                                  const std::map<int, double> &powerTxMap) const
+{
+  return psd != 0 && this->earfcn == earfcn && this->bandwidth == bandwidth
+         && this->txPower == txPower && this->activeRbs == activeRbs
+         && this->powerTxMap == powerTxMap;
+}
+
+void
+LtePhy::TxPsdCacheEntry::Set (uint32_t earfcn, uint16_t bandwidth, double txPower,
+                              const std::vector<int> &activeRbs,
+                              const std::map<int, double> &powerTxMap, Ptr<SpectrumValue> txPsd)
+{
+  this->earfcn = earfcn;
+  this->bandwidth = bandwidth;
+  this->txPower = txPower;
+  this->activeRbs = activeRbs;
+  this->powerTxMap = powerTxMap;
+  psd = txPsd;
+}
+
 } // namespace ns3
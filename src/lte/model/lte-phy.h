@@ -35,6 +35,9 @@
 #include <ns3/generic-phy.h>
 #include <ns3/lte-spectrum-phy.h>
 
+#include <map>
+#include <vector>
+
 namespace ns3 {
 
 class PacketBurst;
@@ -228,6 +231,50 @@ public:
   uint8_t GetComponentCarrierId ();
 
 protected:
+  /**
+   * A transmission PSD, memoized with the parameters it was created from,
+   * which change rarely from a subframe to the next one. The PSD is shared
+   * by the transmissions, whose channel works on copies of it, so that it
+   * must not be modified.
+   */
+  struct TxPsdCacheEntry
+  {
+    TxPsdCacheEntry ();
+
+    /**
+     * \param earfcn the carrier frequency
+     * \param bandwidth the bandwidth in number of PRBs
+     * \param txPower the transmission power in dBm
+     * \param activeRbs the active RBs
+     * \param powerTxMap the transmission power per RB in dBm, empty if not used
+     * \return true if the cached PSD was created from these parameters
+     */
+    bool Matches (uint32_t earfcn, uint16_t bandwidth, double txPower,
+                  const std::vector<int> &activeRbs,
+                  const std::map<int, double> &powerTxMap) const;
+
+    /**
+     * Cache a PSD.
+     *
+     * \param earfcn the carrier frequency
+     * \param bandwidth the bandwidth in number of PRBs
+     * \param txPower the transmission power in dBm
+     * \param activeRbs the active RBs
+     * \param powerTxMap the transmission power per RB in dBm, empty if not used
+     * \param txPsd the PSD created from these parameters
+     */
+    void Set (uint32_t earfcn, uint16_t bandwidth, double txPower,
+              const std::vector<int> &activeRbs,
+              const std::map<int, double> &powerTxMap, Ptr<SpectrumValue> txPsd);
+
+    uint32_t earfcn;                  ///< the carrier frequency
+    uint16_t bandwidth;               ///< the bandwidth in number of PRBs
+    double txPower;                   ///< the transmission power in dBm
+    std::vector<int> activeRbs;       ///< the active RBs
+    std::map<int, double> powerTxMap; ///< the transmission power per RB in dBm
+    Ptr<SpectrumValue> psd;           ///< the PSD, null if none is cached
+  };
+
   /// Pointer to the NetDevice where this PHY layer is attached.
   Ptr<LteNetDevice> m_netDevice;
 
@@ -40,7 +40,6 @@ LteRlcAm::LteRlcAm ()
   NS_LOG_FUNCTION (this);
 
   // Buffers
-  m_txonBufferSize = 0;
   m_retxBuffer.resize (1024);
   m_retxBufferSize = 0;
   m_txedBuffer.resize (1024);
@@ -133,8 +132,7 @@ LteRlcAm::DoDispose ()
   m_statusProhibitTimer.Cancel ();
   m_rbsTimer.Cancel ();
 
-  m_txonBuffer.clear ();
-  m_txonBufferSize = 0;
+  m_txonBuffer.Clear ();
   m_txedBuffer.clear ();
   m_txedBufferSize = 0;
   m_retxBuffer.clear ();
@@ -148,6 +146,12 @@ LteRlcAm::DoDispose ()
 }
 
 
+uint32_t
+LteRlcAm::GetTxBufferSize (void) const
+{
+  return m_txonBuffer.GetBytes ();
+}
+
 /**
  * RLC SAP
  */
@@ -164,10 +168,9 @@ LteRlcAm::DoTransmitPdcpPdu (Ptr<Packet> p)
   p->AddPacketTag (tag);
 
   NS_LOG_LOGIC ("Txon Buffer: New packet added");
-  m_txonBuffer.push_back (TxPdu (p, Simulator::Now ()));
-  m_txonBufferSize += p->GetSize ();
-  NS_LOG_LOGIC ("NumOfBuffers = " << m_txonBuffer.size() );
-  NS_LOG_LOGIC ("txonBufferSize = " << m_txonBufferSize);
+  m_txonBuffer.PushBack (p, Simulator::Now ());
+  NS_LOG_LOGIC ("NumOfBuffers = " << m_txonBuffer.GetNPdus () );
+  NS_LOG_LOGIC ("txonBufferSize = " << m_txonBuffer.GetBytes ());
 
   /** Report Buffer Status */
   DoReportBufferStatus ();
@@ -300,10 +303,10 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
                   // Calculate the Polling Bit (5.2.2.1)
                   rlcAmHeader.SetPollingBit (LteRlcAmHeader::STATUS_REPORT_NOT_REQUESTED);
 
-                  NS_LOG_LOGIC ("polling conditions: m_txonBuffer.empty=" << m_txonBuffer.empty () 
+                  NS_LOG_LOGIC ("polling conditions: m_txonBuffer.empty=" << m_txonBuffer.IsEmpty () 
                                 << " retxBufferSize="  << m_retxBufferSize
                                 << " packet->GetSize ()=" << packet->GetSize ());
-                  if (((m_txonBuffer.empty ()) && (m_retxBufferSize == packet->GetSize () + rlcAmHeader.GetSerializedSize ())) 
+                  if (((m_txonBuffer.IsEmpty ()) && (m_retxBufferSize == packet->GetSize () + rlcAmHeader.GetSerializedSize ())) 
                       || (m_vtS >= m_vtMs)
                       || m_pollRetransmitTimerJustExpired)
                     {
@@ -387,7 +390,7 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
         }
       NS_ASSERT_MSG (false, "m_retxBufferSize > 0, but no PDU considered for retx found");
     }
-  else if ( m_txonBufferSize > 0 )
+  else if ( m_txonBuffer.GetBytes () > 0 )
     {
       if (txOpParams.bytes < 7)
       {
@@ -432,22 +435,21 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
 
   // Remove the first packet from the transmission buffer.
   // If only a segment of the packet is taken, then the remaining is given back later
-  if ( m_txonBuffer.size () == 0 )
+  if ( m_txonBuffer.IsEmpty () )
     {
       NS_LOG_LOGIC ("No data pending");
       return;
     }
 
-  NS_LOG_LOGIC ("SDUs in TxonBuffer  = " << m_txonBuffer.size ());
-  NS_LOG_LOGIC ("First SDU buffer  = " << m_txonBuffer.begin ()->m_pdu);
-  NS_LOG_LOGIC ("First SDU size    = " << m_txonBuffer.begin ()->m_pdu->GetSize ());
+  NS_LOG_LOGIC ("SDUs in TxonBuffer  = " << m_txonBuffer.GetNPdus ());
+  NS_LOG_LOGIC ("First SDU buffer  = " << m_txonBuffer.Front ().m_pdu);
+  NS_LOG_LOGIC ("First SDU size    = " << m_txonBuffer.Front ().m_pdu->GetSize ());
   NS_LOG_LOGIC ("Next segment size = " << nextSegmentSize);
   NS_LOG_LOGIC ("Remove SDU from TxBuffer");
-  Time firstSegmentTime = m_txonBuffer.begin ()->m_waitingSince;
-  Ptr<Packet> firstSegment = m_txonBuffer.begin ()->m_pdu->Copy ();
-  m_txonBufferSize -= m_txonBuffer.begin ()->m_pdu->GetSize ();
-  NS_LOG_LOGIC ("txBufferSize      = " << m_txonBufferSize );
-  m_txonBuffer.erase (m_txonBuffer.begin ());
+  Time firstSegmentTime = m_txonBuffer.Front ().m_waitingSince;
+  Ptr<Packet> firstSegment = m_txonBuffer.Front ().m_pdu->Copy ();
+  m_txonBuffer.PopFront ();
+  NS_LOG_LOGIC ("txBufferSize      = " << m_txonBuffer.GetBytes () );
 
   while ( firstSegment && (firstSegment->GetSize () > 0) && (nextSegmentSize > 0) )
     {
@@ -495,13 +497,12 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
             {
               firstSegment->AddPacketTag (oldTag);
 
-              m_txonBuffer.insert (m_txonBuffer.begin (), TxPdu (firstSegment, firstSegmentTime));
-              m_txonBufferSize += m_txonBuffer.begin ()->m_pdu->GetSize ();
+              m_txonBuffer.PushFront (firstSegment, firstSegmentTime);
 
               NS_LOG_LOGIC ("    Txon buffer: Give back the remaining segment");
-              NS_LOG_LOGIC ("    Txon buffers = " << m_txonBuffer.size ());
-              NS_LOG_LOGIC ("    Front buffer size = " << m_txonBuffer.begin ()->m_pdu->GetSize ());
-              NS_LOG_LOGIC ("    txonBufferSize = " << m_txonBufferSize );
+              NS_LOG_LOGIC ("    Txon buffers = " << m_txonBuffer.GetNPdus ());
+              NS_LOG_LOGIC ("    Front buffer size = " << m_txonBuffer.Front ().m_pdu->GetSize ());
+              NS_LOG_LOGIC ("    txonBufferSize = " << m_txonBuffer.GetBytes () );
             }
           else
             {
@@ -541,7 +542,7 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
           // (NO more segments) ? exit
           // break;
         }
-      else if ( (nextSegmentSize - firstSegment->GetSize () <= 2) || (m_txonBuffer.size () == 0) )
+      else if ( (nextSegmentSize - firstSegment->GetSize () <= 2) || (m_txonBuffer.IsEmpty ()) )
         {
           NS_LOG_LOGIC ("    IF nextSegmentSize - firstSegment->GetSize () <= 2 || txonBuffer.size == 0");
 
@@ -559,11 +560,11 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
           nextSegmentSize -= dataFieldAddedSize;
           nextSegmentId++;
 
-          NS_LOG_LOGIC ("        SDUs in TxBuffer  = " << m_txonBuffer.size ());
-          if (m_txonBuffer.size () > 0)
+          NS_LOG_LOGIC ("        SDUs in TxBuffer  = " << m_txonBuffer.GetNPdus ());
+          if (! m_txonBuffer.IsEmpty ())
             {
-              NS_LOG_LOGIC ("        First SDU buffer  = " << m_txonBuffer.begin ()->m_pdu);
-              NS_LOG_LOGIC ("        First SDU size    = " << m_txonBuffer.begin ()->m_pdu->GetSize ());
+              NS_LOG_LOGIC ("        First SDU buffer  = " << m_txonBuffer.Front ().m_pdu);
+              NS_LOG_LOGIC ("        First SDU size    = " << m_txonBuffer.Front ().m_pdu->GetSize ());
             }
           NS_LOG_LOGIC ("        Next segment size = " << nextSegmentSize);
 
@@ -589,21 +590,20 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
           nextSegmentSize -= ((nextSegmentId % 2) ? (2) : (1)) + dataFieldAddedSize;
           nextSegmentId++;
 
-          NS_LOG_LOGIC ("        SDUs in TxBuffer  = " << m_txonBuffer.size ());
-          if (m_txonBuffer.size () > 0)
+          NS_LOG_LOGIC ("        SDUs in TxBuffer  = " << m_txonBuffer.GetNPdus ());
+          if (! m_txonBuffer.IsEmpty ())
             {
-              NS_LOG_LOGIC ("        First SDU buffer  = " << m_txonBuffer.begin ()->m_pdu);
-              NS_LOG_LOGIC ("        First SDU size    = " << m_txonBuffer.begin ()->m_pdu->GetSize ());
+              NS_LOG_LOGIC ("        First SDU buffer  = " << m_txonBuffer.Front ().m_pdu);
+              NS_LOG_LOGIC ("        First SDU size    = " << m_txonBuffer.Front ().m_pdu->GetSize ());
             }
           NS_LOG_LOGIC ("        Next segment size = " << nextSegmentSize);
           NS_LOG_LOGIC ("        Remove SDU from TxBuffer");
 
           // (more segments)
-          firstSegment = m_txonBuffer.begin ()->m_pdu->Copy ();
-          firstSegmentTime = m_txonBuffer.begin ()->m_waitingSince;
-          m_txonBufferSize -= m_txonBuffer.begin ()->m_pdu->GetSize ();
-          m_txonBuffer.erase (m_txonBuffer.begin ());
-          NS_LOG_LOGIC ("        txBufferSize = " << m_txonBufferSize );
+          firstSegment = m_txonBuffer.Front ().m_pdu->Copy ();
+          firstSegmentTime = m_txonBuffer.Front ().m_waitingSince;
+          m_txonBuffer.PopFront ();
+          NS_LOG_LOGIC ("        txBufferSize = " << m_txonBuffer.GetBytes () );
         }
 
     }
@@ -683,7 +683,7 @@ LteRlcAm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
   NS_LOG_LOGIC ("BYTE_WITHOUT_POLL = " << m_byteWithoutPoll);
 
   if ( (m_pduWithoutPoll >= m_pollPdu) || (m_byteWithoutPoll >= m_pollByte) ||
-       ( (m_txonBuffer.empty ()) && (m_retxBufferSize == 0) ) ||
+       ( (m_txonBuffer.IsEmpty ()) && (m_retxBufferSize == 0) ) ||
        (m_vtS >= m_vtMs)
        || m_pollRetransmitTimerJustExpired
      )
@@ -1206,7 +1206,7 @@ LteRlcAm::ReassembleAndDeliver (Ptr<Packet> packet)
     }
   while ( extensionBit == 1 );
 
-  std::list < Ptr<Packet> >::iterator it;
+  std::deque < Ptr<Packet> >::iterator it;
 
   // Current reassembling state
   if (m_reassemblingState == WAITING_S0_FULL)       NS_LOG_LOGIC ("Reassembling State = 'WAITING_S0_FULL'");
@@ -1577,7 +1577,7 @@ LteRlcAm::DoReportBufferStatus (void)
 
   Time now = Simulator::Now ();
 
-  NS_LOG_LOGIC ("txonBufferSize = " << m_txonBufferSize);
+  NS_LOG_LOGIC ("txonBufferSize = " << m_txonBuffer.GetBytes ());
   NS_LOG_LOGIC ("retxBufferSize = " << m_retxBufferSize);
   NS_LOG_LOGIC ("txedBufferSize = " << m_txedBufferSize);
   NS_LOG_LOGIC ("VT(A) = " << m_vtA);
@@ -1585,9 +1585,9 @@ LteRlcAm::DoReportBufferStatus (void)
 
   // Transmission Queue HOL time
   Time txonQueueHolDelay (0);
-  if ( m_txonBufferSize > 0 )
+  if ( m_txonBuffer.GetBytes () > 0 )
     {
-      txonQueueHolDelay = now - m_txonBuffer.front ().m_waitingSince;
+      txonQueueHolDelay = now - m_txonBuffer.Front ().m_waitingSince;
     }
 
   // Retransmission Queue HOL time
@@ -1613,7 +1613,7 @@ LteRlcAm::DoReportBufferStatus (void)
   LteMacSapProvider::ReportBufferStatusParameters r;
   r.rnti = m_rnti;
   r.lcid = m_lcid;
-  r.txQueueSize = m_txonBufferSize;
+  r.txQueueSize = m_txonBuffer.GetBytes ();
   r.txQueueHolDelay = txonQueueHolDelay.GetMilliSeconds ();
   r.retxQueueSize = m_retxBufferSize + m_txedBufferSize;
   r.retxQueueHolDelay = retxQueueHolDelay.GetMilliSeconds ();
@@ -1689,7 +1689,7 @@ LteRlcAm::ExpirePollRetransmitTimer (void)
   NS_LOG_FUNCTION (this);
   NS_LOG_LOGIC ("PollRetransmit Timer has expired");
 
-  NS_LOG_LOGIC ("txonBufferSize = " << m_txonBufferSize);
+  NS_LOG_LOGIC ("txonBufferSize = " << m_txonBuffer.GetBytes ());
   NS_LOG_LOGIC ("retxBufferSize = " << m_retxBufferSize);
   NS_LOG_LOGIC ("txedBufferSize = " << m_txedBufferSize);
   NS_LOG_LOGIC ("statusPduRequested = " << m_statusPduRequested);
@@ -1699,7 +1699,7 @@ LteRlcAm::ExpirePollRetransmitTimer (void)
   // see section 5.2.2.3
   // note the difference between Rel 8 and Rel 11 specs; we follow Rel 11 here
   NS_ASSERT (m_vtS <= m_vtMs);
-  if ((m_txonBufferSize == 0 && m_retxBufferSize == 0)
+  if ((m_txonBuffer.GetBytes () == 0 && m_retxBufferSize == 0)
       || (m_vtS == m_vtMs))
     {
       NS_LOG_INFO ("txonBuffer and retxBuffer empty. Move PDUs up to = " << m_vtS.GetValue () - 1 << " to retxBuffer");
@@ -1739,7 +1739,7 @@ LteRlcAm::ExpireRbsTimer (void)
 {
   NS_LOG_LOGIC ("RBS Timer expires");
 
-  if (m_txonBufferSize + m_txedBufferSize + m_retxBufferSize > 0)
+  if (m_txonBuffer.GetBytes () + m_txedBufferSize + m_retxBufferSize > 0)
     {
       DoReportBufferStatus ();
       m_rbsTimer = Simulator::Schedule (m_rbsTimerValue, &LteRlcAm::ExpireRbsTimer, this);
@@ -24,7 +24,9 @@
 #include <ns3/event-id.h>
 #include <ns3/lte-rlc-sequence-number.h>
 #include <ns3/lte-rlc.h>
+#include <ns3/lte-rlc-tx-queue.h>
 
+#include <deque>
 #include <vector>
 #include <map>
 
@@ -64,6 +66,9 @@ public:
   virtual void DoNotifyHarqDeliveryFailure ();
   virtual void DoReceivePdu (LteMacSapUser::ReceivePduParameters rxPduParams);
 
+  // inherited from LteRlc
+  virtual uint32_t GetTxBufferSize (void) const;
+
 private:
   /**
    * This method will schedule a timeout at WaitReplyTimeout interval
@@ -107,28 +112,7 @@ private:
   void DoReportBufferStatus ();
 
 private:
-  /**
-   * \brief Store an incoming (from layer above us) PDU, waiting to transmit it
-   */
-  struct TxPdu
-  {
-    /**
-     * \brief TxPdu default constructor
-     * \param pdu the PDU
-     * \param time the arrival time
-     */
-    TxPdu (const Ptr<Packet> &pdu, const Time &time) :
-      m_pdu (pdu),
-      m_waitingSince (time)
-    { }
-
-    TxPdu () = delete;
-
-    Ptr<Packet> m_pdu;           ///< PDU
-    Time        m_waitingSince;  ///< Layer arrival time
-  };
-
-  std::vector < TxPdu > m_txonBuffer; ///< Transmission buffer
+  LteRlcTxQueue m_txonBuffer; ///< Transmission buffer
 
   /// RetxPdu structure
   struct RetxPdu
@@ -143,7 +127,6 @@ private:
                                        ///< for retransmission 
   std::vector <RetxPdu> m_retxBuffer;  ///< Buffer for PDUs considered for retransmission
 
-    uint32_t m_txonBufferSize; ///< transmit on buffer size
     uint32_t m_retxBufferSize; ///< retransmit buffer size
     uint32_t m_txedBufferSize; ///< transmit ed buffer size
 
@@ -166,7 +149,7 @@ private:
     // SDU reassembly
 //   std::vector < Ptr<Packet> > m_reasBuffer;     // Reassembling buffer
 // 
-    std::list < Ptr<Packet> > m_sdusBuffer;       ///< List of SDUs in a packet (PDU)
+    std::deque < Ptr<Packet> > m_sdusBuffer;      ///< List of SDUs in a packet (PDU)
 
   /**
    * State variables. See section 7.1 in TS 36.322
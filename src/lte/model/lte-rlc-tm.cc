@@ -31,8 +31,7 @@ NS_LOG_COMPONENT_DEFINE ("LteRlcTm");
 NS_OBJECT_ENSURE_REGISTERED (LteRlcTm);
 
 LteRlcTm::LteRlcTm ()
-  : m_maxTxBufferSize (0),
-    m_txBufferSize (0)
+  : m_maxTxBufferSize (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -63,12 +62,18 @@ LteRlcTm::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
   m_rbsTimer.Cancel ();
-  m_txBuffer.clear ();
+  m_txBuffer.Clear ();
 
   LteRlc::DoDispose ();
 }
 
 
+uint32_t
+LteRlcTm::GetTxBufferSize (void) const
+{
+  return m_txBuffer.GetBytes ();
+}
+
 /**
  * RLC SAP
  */
@@ -78,20 +83,19 @@ LteRlcTm::DoTransmitPdcpPdu (Ptr<Packet> p)
 {
   NS_LOG_FUNCTION (this << m_rnti << (uint32_t) m_lcid << p->GetSize ());
 
-  if (m_txBufferSize + p->GetSize () <= m_maxTxBufferSize)
+  if (m_txBuffer.GetBytes () + p->GetSize () <= m_maxTxBufferSize)
     {
       NS_LOG_LOGIC ("Tx Buffer: New packet added");
-      m_txBuffer.push_back (TxPdu (p, Simulator::Now ()));
-      m_txBufferSize += p->GetSize ();
-      NS_LOG_LOGIC ("NumOfBuffers = " << m_txBuffer.size() );
-      NS_LOG_LOGIC ("txBufferSize = " << m_txBufferSize);
+      m_txBuffer.PushBack (p, Simulator::Now ());
+      NS_LOG_LOGIC ("NumOfBuffers = " << m_txBuffer.GetNPdus () );
+      NS_LOG_LOGIC ("txBufferSize = " << m_txBuffer.GetBytes ());
     }
   else
     {
       // Discard full RLC SDU
       NS_LOG_LOGIC ("TxBuffer is full. RLC SDU discarded");
       NS_LOG_LOGIC ("MaxTxBufferSize = " << m_maxTxBufferSize);
-      NS_LOG_LOGIC ("txBufferSize    = " << m_txBufferSize);
+      NS_LOG_LOGIC ("txBufferSize    = " << m_txBuffer.GetBytes ());
       NS_LOG_LOGIC ("packet size     = " << p->GetSize ());
     }
 
@@ -116,13 +120,13 @@ LteRlcTm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
   // - submit a RLC SDU without any modification to lower layer.
 
 
-  if ( m_txBuffer.size () == 0 )
+  if ( m_txBuffer.IsEmpty () )
     {
       NS_LOG_LOGIC ("No data pending");
       return;
     }
 
-  Ptr<Packet> packet = m_txBuffer.begin ()->m_pdu->Copy ();
+  Ptr<Packet> packet = m_txBuffer.Front ().m_pdu->Copy ();
 
   if (txOpParams.bytes < packet->GetSize ())
     {
@@ -131,8 +135,7 @@ LteRlcTm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
       return;
     }
 
-  m_txBufferSize -= packet->GetSize ();
-  m_txBuffer.erase (m_txBuffer.begin ());
+  m_txBuffer.PopFront ();
 
   m_txPdu (m_rnti, m_lcid, packet->GetSize ());
 
@@ -147,7 +150,7 @@ LteRlcTm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
 
   m_macSapProvider->TransmitPdu (params);
 
-  if (! m_txBuffer.empty ())
+  if (! m_txBuffer.IsEmpty ())
     {
       m_rbsTimer.Cancel ();
       m_rbsTimer = Simulator::Schedule (MilliSeconds (10), &LteRlcTm::ExpireRbsTimer, this);
@@ -182,11 +185,11 @@ LteRlcTm::DoReportBufferStatus (void)
   Time holDelay (0);
   uint32_t queueSize = 0;
 
-  if (! m_txBuffer.empty ())
+  if (! m_txBuffer.IsEmpty ())
     {
-      holDelay = Simulator::Now () - m_txBuffer.front ().m_waitingSince;
+      holDelay = Simulator::Now () - m_txBuffer.Front ().m_waitingSince;
 
-      queueSize = m_txBufferSize; // just data in tx queue (no header overhead for RLC TM)
+      queueSize = m_txBuffer.GetBytes (); // just data in tx queue (no header overhead for RLC TM)
     }
 
   LteMacSapProvider::ReportBufferStatusParameters r;
@@ -207,7 +210,7 @@ LteRlcTm::ExpireRbsTimer (void)
 {
   NS_LOG_LOGIC ("RBS Timer expires");
 
-  if (! m_txBuffer.empty ())
+  if (! m_txBuffer.IsEmpty ())
     {
       DoReportBufferStatus ();
       m_rbsTimer = Simulator::Schedule (MilliSeconds (10), &LteRlcTm::ExpireRbsTimer, this);
@@ -23,6 +23,7 @@
 #define LTE_RLC_TM_H
 
 #include "ns3/lte-rlc.h"
+#include "ns3/lte-rlc-tx-queue.h"
 
 #include <ns3/event-id.h>
 #include <map>
@@ -67,6 +68,9 @@ public:
   virtual void DoNotifyHarqDeliveryFailure ();
   virtual void DoReceivePdu (LteMacSapUser::ReceivePduParameters rxPduParams);
 
+  // inherited from LteRlc
+  virtual uint32_t GetTxBufferSize (void) const;
+
 private:
   /// Expire RBS timer function
   void ExpireRbsTimer (void);
@@ -74,31 +78,9 @@ private:
   void DoReportBufferStatus ();
 
 private:
-  /**
-   * \brief Store an incoming (from layer above us) PDU, waiting to transmit it
-   */
-  struct TxPdu
-  {
-    /**
-     * \brief TxPdu default constructor
-     * \param pdu the PDU
-     * \param time the arrival time
-     */
-    TxPdu (const Ptr<Packet> &pdu, const Time &time) :
-      m_pdu (pdu),
-      m_waitingSince (time)
-    { }
-
-    TxPdu () = delete;
-
-    Ptr<Packet> m_pdu;           ///< PDU
-    Time        m_waitingSince;  ///< Layer arrival time
-  };
-
-  std::vector < TxPdu > m_txBuffer; ///< Transmission buffer
+  LteRlcTxQueue m_txBuffer; ///< Transmission buffer
 
   uint32_t m_maxTxBufferSize; ///< maximum transmit buffer size
-  uint32_t m_txBufferSize; ///< transmit buffer size
 
   EventId m_rbsTimer; ///< RBS timer
 };
@@ -0,0 +1,105 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/lte-rlc-tx-queue.h"
+
+#include <ns3/assert.h>
+
+namespace ns3 {
+
+LteRlcTxQueue::LteRlcTxQueue (uint32_t capacity)
+  : m_head (0),
+    m_count (0),
+    m_bytes (0)
+{
+  uint32_t size = 1;
+  while (size < capacity)
+    {
+      size <<= 1;
+    }
+  m_ring.resize (size);
+}
+
+void
+LteRlcTxQueue::PushBack (Ptr<Packet> pdu, Time waitingSince)
+{
+  if (m_count == m_ring.size ())
+    {
+      Grow ();
+    }
+  TxPdu &slot = m_ring[(m_head + m_count) & (m_ring.size () - 1)];
+  slot.m_pdu = pdu;
+  slot.m_waitingSince = waitingSince;
+  m_count++;
+  m_bytes += pdu->GetSize ();
+}
+
+void
+LteRlcTxQueue::PushFront (Ptr<Packet> pdu, Time waitingSince)
+{
+  if (m_count == m_ring.size ())
+    {
+      Grow ();
+    }
+  m_head = (m_head - 1) & (m_ring.size () - 1);
+  TxPdu &slot = m_ring[m_head];
+  slot.m_pdu = pdu;
+  slot.m_waitingSince = waitingSince;
+  m_count++;
+  m_bytes += pdu->GetSize ();
+}
+
+void
+LteRlcTxQueue::PopFront ()
+{
+  NS_ASSERT_MSG (m_count > 0, "empty RLC transmission queue");
+  TxPdu &slot = m_ring[m_head];
+  m_bytes -= slot.m_pdu->GetSize ();
+  slot.m_pdu = 0;
+  m_head = (m_head + 1) & (m_ring.size () - 1);
+  m_count--;
+}
+
+const LteRlcTxQueue::TxPdu &
+LteRlcTxQueue::Front () const
+{
+  NS_ASSERT_MSG (m_count > 0, "empty RLC transmission queue");
+  return m_ring[m_head];
+}
+
+void
+LteRlcTxQueue::Clear ()
+{
+  while (m_count > 0)
+    {
+      PopFront ();
+    }
+  m_head = 0;
+}
+
+void
+LteRlcTxQueue::Grow ()
+{
+  std::vector<TxPdu> ring (m_ring.size () * 2);
+  for (uint32_t i = 0; i < m_count; ++i)
+    {
+      ring[i] = m_ring[(m_head + i) & (m_ring.size () - 1)];
+    }
+  m_ring.swap (ring);
+  m_head = 0;
+}
+
+} // namespace ns3
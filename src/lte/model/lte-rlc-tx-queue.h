@@ -0,0 +1,113 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LTE_RLC_TX_QUEUE_H
+#define LTE_RLC_TX_QUEUE_H
+
+#include <ns3/packet.h>
+#include <ns3/nstime.h>
+
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * FIFO of the SDUs waiting for transmission in an RLC entity.
+ *
+ * The SDUs are kept in a ring buffer, so that taking the head of line
+ * SDU, and putting back its remaining segment, take constant time
+ * whatever the length of the queue.  The capacity doubles when the
+ * ring is full, and is kept afterwards, so a saturated queue does not
+ * allocate.  The queue also accounts the bytes of the SDUs it holds.
+ */
+class LteRlcTxQueue
+{
+public:
+  /// An SDU waiting for transmission
+  struct TxPdu
+  {
+    Ptr<Packet> m_pdu;           ///< PDU
+    Time        m_waitingSince;  ///< Layer arrival time
+  };
+
+  /**
+   * Constructor
+   *
+   * \param capacity the initial capacity, rounded up to a power of two
+   */
+  LteRlcTxQueue (uint32_t capacity = 16);
+
+  /**
+   * Append an SDU at the tail of the queue
+   *
+   * \param pdu the SDU
+   * \param waitingSince the arrival time of the SDU
+   */
+  void PushBack (Ptr<Packet> pdu, Time waitingSince);
+  /**
+   * Put an SDU back at the head of the queue, e.g., the remaining
+   * segment of the head of line SDU
+   *
+   * \param pdu the SDU
+   * \param waitingSince the arrival time of the SDU
+   */
+  void PushFront (Ptr<Packet> pdu, Time waitingSince);
+  /// Remove the head of line SDU
+  void PopFront ();
+  /**
+   * \return the head of line SDU; the queue must not be empty
+   */
+  const TxPdu & Front () const;
+
+  /**
+   * \return true if the queue holds no SDU
+   */
+  bool IsEmpty () const
+  {
+    return m_count == 0;
+  }
+  /**
+   * \return the number of SDUs in the queue
+   */
+  uint32_t GetNPdus () const
+  {
+    return m_count;
+  }
+  /**
+   * \return the total size of the SDUs in the queue, in bytes
+   */
+  uint32_t GetBytes () const
+  {
+    return m_bytes;
+  }
+  /// Remove all the SDUs
+  void Clear ();
+
+private:
+  /// Double the capacity of the ring, keeping the SDUs in order
+  void Grow ();
+
+  std::vector<TxPdu> m_ring; ///< the ring, whose size is a power of two
+  uint32_t m_head;           ///< index of the head of line SDU
+  uint32_t m_count;          ///< number of SDUs in the queue
+  uint32_t m_bytes;          ///< total size of the SDUs in the queue
+};
+
+} // namespace ns3
+
+#endif // LTE_RLC_TX_QUEUE_H
@@ -34,7 +34,6 @@ NS_OBJECT_ENSURE_REGISTERED (LteRlcUm);
 
 LteRlcUm::LteRlcUm ()
   : m_maxTxBufferSize (10 * 1024),
-    m_txBufferSize (0),
     m_sequenceNumber (0),
     m_vrUr (0),
     m_vrUx (0),
@@ -82,6 +81,12 @@ LteRlcUm::DoDispose ()
   LteRlc::DoDispose ();
 }
 
+uint32_t
+LteRlcUm::GetTxBufferSize (void) const
+{
+  return m_txBuffer.GetBytes ();
+}
+
 /**
  * RLC SAP
  */
@@ -91,7 +96,7 @@ LteRlcUm::DoTransmitPdcpPdu (Ptr<Packet> p)
 {
   NS_LOG_FUNCTION (this << m_rnti << (uint32_t) m_lcid << p->GetSize ());
 
-  if (m_txBufferSize + p->GetSize () <= m_maxTxBufferSize)
+  if (m_txBuffer.GetBytes () + p->GetSize () <= m_maxTxBufferSize)
     {
       /** Store PDCP PDU */
       LteRlcSduStatusTag tag;
@@ -99,17 +104,16 @@ LteRlcUm::DoTransmitPdcpPdu (Ptr<Packet> p)
       p->AddPacketTag (tag);
 
       NS_LOG_LOGIC ("Tx Buffer: New packet added");
-      m_txBuffer.push_back (TxPdu (p, Simulator::Now ()));
-      m_txBufferSize += p->GetSize ();
-      NS_LOG_LOGIC ("NumOfBuffers = " << m_txBuffer.size() );
-      NS_LOG_LOGIC ("txBufferSize = " << m_txBufferSize);
+      m_txBuffer.PushBack (p, Simulator::Now ());
+      NS_LOG_LOGIC ("NumOfBuffers = " << m_txBuffer.GetNPdus () );
+      NS_LOG_LOGIC ("txBufferSize = " << m_txBuffer.GetBytes ());
     }
   else
     {
       // Discard full RLC SDU
       NS_LOG_LOGIC ("TxBuffer is full. RLC SDU discarded");
       NS_LOG_LOGIC ("MaxTxBufferSize = " << m_maxTxBufferSize);
-      NS_LOG_LOGIC ("txBufferSize    = " << m_txBufferSize);
+      NS_LOG_LOGIC ("txBufferSize    = " << m_txBuffer.GetBytes ());
       NS_LOG_LOGIC ("packet size     = " << p->GetSize ());
     }
 
@@ -147,23 +151,22 @@ LteRlcUm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
 
   // Remove the first packet from the transmission buffer.
   // If only a segment of the packet is taken, then the remaining is given back later
-  if ( m_txBuffer.size () == 0 )
+  if ( m_txBuffer.IsEmpty () )
     {
       NS_LOG_LOGIC ("No data pending");
       return;
     }
 
-  Ptr<Packet> firstSegment = m_txBuffer.begin ()->m_pdu->Copy ();
-  Time firstSegmentTime = m_txBuffer.begin ()->m_waitingSince;
+  Ptr<Packet> firstSegment = m_txBuffer.Front ().m_pdu->Copy ();
+  Time firstSegmentTime = m_txBuffer.Front ().m_waitingSince;
 
-  NS_LOG_LOGIC ("SDUs in TxBuffer  = " << m_txBuffer.size ());
+  NS_LOG_LOGIC ("SDUs in TxBuffer  = " << m_txBuffer.GetNPdus ());
   NS_LOG_LOGIC ("First SDU buffer  = " << firstSegment);
   NS_LOG_LOGIC ("First SDU size    = " << firstSegment->GetSize ());
   NS_LOG_LOGIC ("Next segment size = " << nextSegmentSize);
   NS_LOG_LOGIC ("Remove SDU from TxBuffer");
-  m_txBufferSize -= firstSegment->GetSize ();
-  NS_LOG_LOGIC ("txBufferSize      = " << m_txBufferSize );
-  m_txBuffer.erase (m_txBuffer.begin ());
+  m_txBuffer.PopFront ();
+  NS_LOG_LOGIC ("txBufferSize      = " << m_txBuffer.GetBytes () );
 
   while ( firstSegment && (firstSegment->GetSize () > 0) && (nextSegmentSize > 0) )
     {
@@ -211,13 +214,12 @@ LteRlcUm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
             {
               firstSegment->AddPacketTag (oldTag);
 
-              m_txBuffer.insert (m_txBuffer.begin (), TxPdu (firstSegment, firstSegmentTime));
-              m_txBufferSize += m_txBuffer.begin()->m_pdu->GetSize ();
+              m_txBuffer.PushFront (firstSegment, firstSegmentTime);
 
               NS_LOG_LOGIC ("    TX buffer: Give back the remaining segment");
-              NS_LOG_LOGIC ("    TX buffers = " << m_txBuffer.size ());
-              NS_LOG_LOGIC ("    Front buffer size = " << m_txBuffer.begin()->m_pdu->GetSize ());
-              NS_LOG_LOGIC ("    txBufferSize = " << m_txBufferSize );
+              NS_LOG_LOGIC ("    TX buffers = " << m_txBuffer.GetNPdus ());
+              NS_LOG_LOGIC ("    Front buffer size = " << m_txBuffer.Front ().m_pdu->GetSize ());
+              NS_LOG_LOGIC ("    txBufferSize = " << m_txBuffer.GetBytes () );
             }
           else
             {
@@ -257,7 +259,7 @@ LteRlcUm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
           // (NO more segments) → exit
           // break;
         }
-      else if ( (nextSegmentSize - firstSegment->GetSize () <= 2) || (m_txBuffer.size () == 0) )
+      else if ( (nextSegmentSize - firstSegment->GetSize () <= 2) || (m_txBuffer.IsEmpty ()) )
         {
           NS_LOG_LOGIC ("    IF nextSegmentSize - firstSegment->GetSize () <= 2 || txBuffer.size == 0");
           // Add txBuffer.FirstBuffer to DataField
@@ -274,11 +276,11 @@ LteRlcUm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
           nextSegmentSize -= dataFieldAddedSize;
           nextSegmentId++;
 
-          NS_LOG_LOGIC ("        SDUs in TxBuffer  = " << m_txBuffer.size ());
-          if (m_txBuffer.size () > 0)
+          NS_LOG_LOGIC ("        SDUs in TxBuffer  = " << m_txBuffer.GetNPdus ());
+          if (! m_txBuffer.IsEmpty ())
             {
-              NS_LOG_LOGIC ("        First SDU buffer  = " << m_txBuffer.begin()->m_pdu);
-              NS_LOG_LOGIC ("        First SDU size    = " << m_txBuffer.begin()->m_pdu->GetSize ());
+              NS_LOG_LOGIC ("        First SDU buffer  = " << m_txBuffer.Front ().m_pdu);
+              NS_LOG_LOGIC ("        First SDU size    = " << m_txBuffer.Front ().m_pdu->GetSize ());
             }
           NS_LOG_LOGIC ("        Next segment size = " << nextSegmentSize);
 
@@ -304,21 +306,20 @@ LteRlcUm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
           nextSegmentSize -= ((nextSegmentId % 2) ? (2) : (1)) + dataFieldAddedSize;
           nextSegmentId++;
 
-          NS_LOG_LOGIC ("        SDUs in TxBuffer  = " << m_txBuffer.size ());
-          if (m_txBuffer.size () > 0)
+          NS_LOG_LOGIC ("        SDUs in TxBuffer  = " << m_txBuffer.GetNPdus ());
+          if (! m_txBuffer.IsEmpty ())
             {
-              NS_LOG_LOGIC ("        First SDU buffer  = " << m_txBuffer.begin()->m_pdu);
-              NS_LOG_LOGIC ("        First SDU size    = " << m_txBuffer.begin()->m_pdu->GetSize ());
+              NS_LOG_LOGIC ("        First SDU buffer  = " << m_txBuffer.Front ().m_pdu);
+              NS_LOG_LOGIC ("        First SDU size    = " << m_txBuffer.Front ().m_pdu->GetSize ());
             }
           NS_LOG_LOGIC ("        Next segment size = " << nextSegmentSize);
           NS_LOG_LOGIC ("        Remove SDU from TxBuffer");
 
           // (more segments)
-          firstSegment = m_txBuffer.begin ()->m_pdu->Copy ();
-          firstSegmentTime = m_txBuffer.begin ()->m_waitingSince;
-          m_txBufferSize -= firstSegment->GetSize ();
-          m_txBuffer.erase (m_txBuffer.begin ());
-          NS_LOG_LOGIC ("        txBufferSize = " << m_txBufferSize );
+          firstSegment = m_txBuffer.Front ().m_pdu->Copy ();
+          firstSegmentTime = m_txBuffer.Front ().m_waitingSince;
+          m_txBuffer.PopFront ();
+          NS_LOG_LOGIC ("        txBufferSize = " << m_txBuffer.GetBytes () );
         }
 
     }
@@ -396,7 +397,7 @@ LteRlcUm::DoNotifyTxOpportunity (LteMacSapUser::TxOpportunityParameters txOpPara
 
   m_macSapProvider->TransmitPdu (params);
 
-  if (! m_txBuffer.empty ())
+  if (! m_txBuffer.IsEmpty ())
     {
       m_rbsTimer.Cancel ();
       m_rbsTimer = Simulator::Schedule (MilliSeconds (10), &LteRlcUm::ExpireRbsTimer, this);
@@ -650,7 +651,7 @@ LteRlcUm::ReassembleAndDeliver (Ptr<Packet> packet)
     }
   while ( extensionBit == 1 );
 
-  std::list < Ptr<Packet> >::iterator it;
+  std::deque < Ptr<Packet> >::iterator it;
 
   // Current reassembling state
   if (m_reassemblingState == WAITING_S0_FULL)       NS_LOG_LOGIC ("Reassembling State = 'WAITING_S0_FULL'");
@@ -1126,11 +1127,11 @@ LteRlcUm::DoReportBufferStatus (void)
   Time holDelay (0);
   uint32_t queueSize = 0;
 
-  if (! m_txBuffer.empty ())
+  if (! m_txBuffer.IsEmpty ())
     {
-      holDelay = Simulator::Now () - m_txBuffer.front().m_waitingSince;
+      holDelay = Simulator::Now () - m_txBuffer.Front ().m_waitingSince;
 
-      queueSize = m_txBufferSize + 2 * m_txBuffer.size (); // Data in tx queue + estimated headers size
+      queueSize = m_txBuffer.GetBytes () + 2 * m_txBuffer.GetNPdus (); // Data in tx queue + estimated headers size
     }
 
   LteMacSapProvider::ReportBufferStatusParameters r;
@@ -1191,7 +1192,7 @@ LteRlcUm::ExpireRbsTimer (void)
 {
   NS_LOG_LOGIC ("RBS Timer expires");
 
-  if (! m_txBuffer.empty ())
+  if (! m_txBuffer.IsEmpty ())
     {
       DoReportBufferStatus ();
       m_rbsTimer = Simulator::Schedule (MilliSeconds (10), &LteRlcUm::ExpireRbsTimer, this);
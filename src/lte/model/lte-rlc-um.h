@@ -23,8 +23,10 @@
 
 #include "ns3/lte-rlc-sequence-number.h"
 #include "ns3/lte-rlc.h"
+#include "ns3/lte-rlc-tx-queue.h"
 
 #include <ns3/event-id.h>
+#include <deque>
 #include <map>
 
 namespace ns3 {
@@ -60,6 +62,9 @@ public:
   virtual void DoNotifyHarqDeliveryFailure ();
   virtual void DoReceivePdu (LteMacSapUser::ReceivePduParameters rxPduParams);
 
+  // inherited from LteRlc
+  virtual uint32_t GetTxBufferSize (void) const;
+
 private:
   /// Expire reordering timer
   void ExpireReorderingTimer (void);
@@ -96,33 +101,11 @@ private:
 
 private:
   uint32_t m_maxTxBufferSize; ///< maximum transmit buffer status
-  uint32_t m_txBufferSize; ///< transmit buffer size
-  /**
-   * \brief Store an incoming (from layer above us) PDU, waiting to transmit it
-   */
-  struct TxPdu
-  {
-    /**
-     * \brief TxPdu default constructor
-     * \param pdu the PDU
-     * \param time the arrival time
-     */
-    TxPdu (const Ptr<Packet> &pdu, const Time &time) :
-      m_pdu (pdu),
-      m_waitingSince (time)
-    { }
-
-    TxPdu () = delete;
-
-    Ptr<Packet> m_pdu;           ///< PDU
-    Time        m_waitingSince;  ///< Layer arrival time
-  };
-
-  std::vector < TxPdu > m_txBuffer; ///< Transmission buffer
+  LteRlcTxQueue m_txBuffer; ///< Transmission buffer
   std::map <uint16_t, Ptr<Packet> > m_rxBuffer; ///< Reception buffer
   std::vector < Ptr<Packet> > m_reasBuffer;     ///< Reassembling buffer
 
-  std::list < Ptr<Packet> > m_sdusBuffer;       ///< List of SDUs in a packet
+  std::deque < Ptr<Packet> > m_sdusBuffer;      ///< List of SDUs in a packet
 
   /**
    * State variables. See section 7.1 in TS 36.322
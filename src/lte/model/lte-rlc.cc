@@ -166,6 +166,12 @@ LteRlc::GetLteMacSapUser ()
   return m_macSapUser;
 }
 
+uint32_t
+LteRlc::GetTxBufferSize (void) const
+{
+  return 0;
+}
+
 
 
 ////////////////////////////////////////
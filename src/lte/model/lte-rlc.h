@@ -108,6 +108,12 @@ public:
    */
   LteMacSapUser* GetLteMacSapUser ();
 
+  /**
+   * \return the size, in bytes, of the SDUs waiting for their first
+   * transmission in this RLC entity
+   */
+  virtual uint32_t GetTxBufferSize (void) const;
+
 
   /**
    * TracedCallback signature for NotifyTxOpportunity events.
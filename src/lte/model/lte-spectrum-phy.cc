@@ -24,6 +24,7 @@
 #include <ns3/object-factory.h>
 #include <ns3/log.h>
 #include <cmath>
+#include <algorithm>
 #include <ns3/simulator.h>
 #include <ns3/trace-source-accessor.h>
 #include <ns3/antenna-model.h>
@@ -33,11 +34,13 @@
 #include "lte-radio-bearer-tag.h"
 #include "lte-chunk-processor.h"
 #include "lte-phy-tag.h"
+#include "lte-background-interference-filter.h"
 #include <ns3/lte-mi-error-model.h>
 #include <ns3/lte-radio-bearer-tag.h>
 #include <ns3/boolean.h>
 #include <ns3/double.h>
 #include <ns3/config.h>
+#include <ns3/metrics-registry.h>
 
 namespace ns3 {
 
@@ -165,6 +168,7 @@ void LteSpectrumPhy::DoDispose ()
   m_ltePhyRxDataEndErrorCallback = MakeNullCallback< void > ();
   m_ltePhyRxDataEndOkCallback    = MakeNullCallback< void, Ptr<Packet> >  ();
   m_ltePhyRxCtrlEndOkCallback = MakeNullCallback< void, std::list<Ptr<LteControlMessage> > > ();
+  m_ltePhyRxDlCtrlEndOkCallback = MakeNullCallback< void, Ptr<const LteControlMessageFrame> > ();
   m_ltePhyRxCtrlEndErrorCallback = MakeNullCallback< void > ();
   m_ltePhyDlHarqFeedbackCallback = MakeNullCallback< void, DlInfoListElement_s > ();
   m_ltePhyUlHarqFeedbackCallback = MakeNullCallback< void, UlInfoListElement_s > ();
@@ -327,6 +331,31 @@ LteSpectrumPhy::SetNoisePowerSpectralDensity (Ptr<const SpectrumValue> noisePsd)
   m_rxSpectrumModel = noisePsd->GetSpectrumModel ();
   m_interferenceData->SetNoisePowerSpectralDensity (noisePsd);
   m_interferenceCtrl->SetNoisePowerSpectralDensity (noisePsd);
+  m_backgroundCellIds.clear ();
+}
+
+
+void
+LteSpectrumPhy::SetInterferenceBackground (Ptr<const SpectrumValue> backgroundPsd,
+                                           const std::vector<uint16_t> &cellIds)
+{
+  NS_LOG_FUNCTION (this << backgroundPsd << cellIds.size ());
+  m_interferenceData->SetBackgroundPowerSpectralDensity (backgroundPsd);
+  m_backgroundCellIds = cellIds;
+  std::sort (m_backgroundCellIds.begin (), m_backgroundCellIds.end ());
+  if (!m_backgroundCellIds.empty () && m_channel != 0)
+    {
+      // the data frames of the background cells are dropped by the channel
+      LteBackgroundInterferenceFilter::InstallOn (m_channel);
+    }
+}
+
+
+bool
+LteSpectrumPhy::IsInterferenceInBackground (uint16_t cellId) const
+{
+  return cellId != m_cellId
+         && std::binary_search (m_backgroundCellIds.begin (), m_backgroundCellIds.end (), cellId);
 }
 
 
@@ -343,6 +372,11 @@ LteSpectrumPhy::Reset ()
   m_endRxDlCtrlEvent.Cancel ();
   m_endRxUlSrsEvent.Cancel ();
   m_rxControlMessageList.clear ();
+  m_rxDlCtrlFrame = 0;
+  if (!m_backgroundCellIds.empty ())
+    {
+      SetInterferenceBackground (0, std::vector<uint16_t> ());
+    }
   m_expectedTbs.clear ();
   m_txControlMessageList.clear ();
   m_rxPacketBurstList.clear ();
@@ -373,6 +407,13 @@ LteSpectrumPhy::SetLtePhyRxCtrlEndOkCallback (LtePhyRxCtrlEndOkCallback c)
   m_ltePhyRxCtrlEndOkCallback = c;
 }
 
+void
+LteSpectrumPhy::SetLtePhyRxDlCtrlEndOkCallback (LtePhyRxDlCtrlEndOkCallback c)
+{
+  NS_LOG_FUNCTION (this);
+  m_ltePhyRxDlCtrlEndOkCallback = c;
+}
+
 void
 LteSpectrumPhy::SetLtePhyRxCtrlEndErrorCallback (LtePhyRxCtrlEndErrorCallback c)
 {
@@ -542,7 +583,8 @@ LteSpectrumPhy::StartTxDlCtrlFrame (std::list<Ptr<LteControlMessage> > ctrlMsgLi
           txParams->psd = m_txPsd;
           txParams->cellId = m_cellId;
           txParams->pss = pss;
-          txParams->ctrlMsgList = ctrlMsgList;
+          // the copies of the parameters for the receivers share the frame
+          txParams->ctrlMsgFrame = Create<LteControlMessageFrame> (ctrlMsgList);
           m_channel->StartTx (txParams);
           m_endTxEvent = Simulator::Schedule (DL_CTRL_DURATION, &LteSpectrumPhy::EndTxDlCtrl, this);
         }
@@ -815,13 +857,17 @@ LteSpectrumPhy::StartRxDlCtrl (Ptr<LteSpectrumSignalParametersDlCtrlFrame> lteDl
                 {
                   NS_LOG_LOGIC (this << " synchronized with this signal (cellId=" << cellId << ")");
 
-                  NS_ASSERT (m_rxControlMessageList.empty ());
+                  NS_ASSERT (m_rxDlCtrlFrame == 0);
                   m_firstRxStart = Simulator::Now ();
                   m_firstRxDuration = lteDlCtrlRxParams->duration;
                   NS_LOG_LOGIC (this << " scheduling EndRx with delay " << lteDlCtrlRxParams->duration);
 
                   // store the DCIs
-                  m_rxControlMessageList = lteDlCtrlRxParams->ctrlMsgList;
+                  m_rxDlCtrlFrame = lteDlCtrlRxParams->ctrlMsgFrame;
+                  if (m_rxDlCtrlFrame == 0)
+                    {
+                      m_rxDlCtrlFrame = Create<LteControlMessageFrame> (std::list<Ptr<LteControlMessage> > ());
+                    }
                   m_endRxDlCtrlEvent = Simulator::Schedule (lteDlCtrlRxParams->duration, &LteSpectrumPhy::EndRxDlCtrl, this);
                   ChangeState (RX_DL_CTRL);
                   m_interferenceCtrl->StartRx (lteDlCtrlRxParams->psd);
@@ -975,6 +1021,10 @@ LteSpectrumPhy::EndRxData ()
 {
   NS_LOG_FUNCTION (this);
   NS_LOG_LOGIC (this << " state: " << m_state);
+  static MetricHistogram *decodeTime = MetricsRegistry::Get ()->GetHistogram ("LteSpectrumPhy/EndRxDataNs");
+  static MetricCounter *tbDecoded = MetricsRegistry::Get ()->GetCounter ("LteSpectrumPhy/TbDecoded");
+  static MetricCounter *tbCorrupted = MetricsRegistry::Get ()->GetCounter ("LteSpectrumPhy/TbCorrupted");
+  MetricTimer timer (decodeTime);
 
   NS_ASSERT (m_state == RX_DATA);
 
@@ -994,24 +1044,30 @@ LteSpectrumPhy::EndRxData ()
     {
       if ((m_dataErrorModelEnabled)&&(m_rxPacketBurstList.size () > 0)) // avoid to check for errors when there is no actual data transmitted
         {
-          // retrieve HARQ info
-          HarqProcessInfoList_t harqInfoList;
+          // retrieve HARQ info, without copying the history
+          static const HarqProcessInfoList_t noHarqHistory;
+          const HarqProcessInfoList_t *harqInfoList = &noHarqHistory;
           if ((*itTb).second.ndi == 0)
             {
               // TB retxed: retrieve HARQ history
               uint16_t ulHarqId = 0;
               if ((*itTb).second.downlink)
                 {
-                  harqInfoList = m_harqPhyModule->GetHarqProcessInfoDl ((*itTb).second.harqProcessId, (*itTb).first.m_layer);
+                  harqInfoList = &m_harqPhyModule->GetHarqProcessInfoDl ((*itTb).second.harqProcessId, (*itTb).first.m_layer);
                 }
               else
                 {
-                  harqInfoList = m_harqPhyModule->GetHarqProcessInfoUl ((*itTb).first.m_rnti, ulHarqId);
+                  harqInfoList = &m_harqPhyModule->GetHarqProcessInfoUl ((*itTb).first.m_rnti, ulHarqId);
                 }
             }
-          TbStats_t tbStats = LteMiErrorModel::GetTbDecodificationStats (m_sinrPerceived, (*itTb).second.rbBitmap, (*itTb).second.size, (*itTb).second.mcs, harqInfoList);
+          TbStats_t tbStats = LteMiErrorModel::GetTbDecodificationStats (m_sinrPerceived, (*itTb).second.rbBitmap, (*itTb).second.size, (*itTb).second.mcs, *harqInfoList);
           (*itTb).second.mi = tbStats.mi;
           (*itTb).second.corrupt = m_random->GetValue () > tbStats.tbler ? false : true;
+          tbDecoded->Increment ();
+          if ((*itTb).second.corrupt)
+            {
+              tbCorrupted->Increment ();
+            }
           NS_LOG_DEBUG (this << "RNTI " << (*itTb).first.m_rnti << " size " << (*itTb).second.size << " mcs " << (uint32_t)(*itTb).second.mcs << " bitmap " << (*itTb).second.rbBitmap.size () << " layer " << (uint16_t)(*itTb).first.m_layer << " TBLER " << tbStats.tbler << " corrupted " << (*itTb).second.corrupt);
           // fire traces on DL/UL reception PHY stats
           PhyReceptionStatParameters params;
@@ -1035,7 +1091,7 @@ LteSpectrumPhy::EndRxData ()
           else
             {
               // UL
-              params.m_rv = harqInfoList.size ();
+              params.m_rv = harqInfoList->size ();
               m_ulPhyReception (params);
             }
         }
@@ -1199,10 +1255,15 @@ LteSpectrumPhy::EndRxDlCtrl ()
 
   if (!error)
     {
-      if (!m_ltePhyRxCtrlEndOkCallback.IsNull ())
+      if (!m_ltePhyRxDlCtrlEndOkCallback.IsNull ())
         {
           NS_LOG_DEBUG (this << " PCFICH-PDCCH Rxed OK");
-          m_ltePhyRxCtrlEndOkCallback (m_rxControlMessageList);
+          m_ltePhyRxDlCtrlEndOkCallback (m_rxDlCtrlFrame);
+        }
+      else if (!m_ltePhyRxCtrlEndOkCallback.IsNull ())
+        {
+          NS_LOG_DEBUG (this << " PCFICH-PDCCH Rxed OK");
+          m_ltePhyRxCtrlEndOkCallback (m_rxDlCtrlFrame->GetList ());
         }
     }
   else
@@ -1214,7 +1275,7 @@ LteSpectrumPhy::EndRxDlCtrl ()
         }
     }
   ChangeState (IDLE);
-  m_rxControlMessageList.clear ();
+  m_rxDlCtrlFrame = 0;
 }
 
 void
@@ -38,6 +38,7 @@
 #include <ns3/lte-interference.h>
 #include "ns3/random-variable-stream.h"
 #include <map>
+#include <vector>
 #include <ns3/ff-mac-common.h>
 #include <ns3/lte-harq-phy.h>
 #include <ns3/lte-common.h>
@@ -86,6 +87,7 @@ typedef std::map<TbId_t, tbInfo_t> expectedTbs_t; ///< expectedTbs_t typedef
 class LteNetDevice;
 class AntennaModel;
 class LteControlMessage;
+class LteControlMessageFrame;
 struct LteSpectrumSignalParametersDataFrame;
 struct LteSpectrumSignalParametersDlCtrlFrame;
 struct LteSpectrumSignalParametersUlSrsFrame;
@@ -113,6 +115,15 @@ typedef Callback< void, Ptr<Packet> > LtePhyRxDataEndOkCallback;
 */
 typedef Callback< void, std::list<Ptr<LteControlMessage> > > LtePhyRxCtrlEndOkCallback;
 
+/**
+* This method is used by the LteSpectrumPhy to notify the UE PHY that a
+* previously started RX of a DL control frame attempt has been
+* successfully completed.
+*
+* @param frame the control messages of the frame
+*/
+typedef Callback< void, Ptr<const LteControlMessageFrame> > LtePhyRxDlCtrlEndOkCallback;
+
 /**
 * This method is used by the LteSpectrumPhy to notify the PHY that a
 * previously started RX of a control frame attempt has terminated 
@@ -217,6 +228,29 @@ public:
    */
   void SetNoisePowerSpectralDensity (Ptr<const SpectrumValue> noisePsd);
 
+  /**
+   * \brief approximate the interference of some cells by a background
+   *
+   * The data frames of the given cells are no longer simulated at this
+   * receiver (see LteBackgroundInterferenceFilter), and their interference
+   * on the data is replaced by the given background, until the next call
+   * of this method or of SetNoisePowerSpectralDensity. The control frames
+   * of these cells are still received, e.g. for the RSRP measurements.
+   *
+   * \param backgroundPsd the Power Spectral Density of the background, on
+   * the SpectrumModel of the noise, or 0 for no background
+   * \param cellIds the cells whose interference is in the background
+   */
+  void SetInterferenceBackground (Ptr<const SpectrumValue> backgroundPsd,
+                                  const std::vector<uint16_t> &cellIds);
+
+  /**
+   * \param cellId the cell ID
+   * \return true if the interference of the cell is in the background, i.e.,
+   * if its data frames need not be delivered to this receiver
+   */
+  bool IsInterferenceInBackground (uint16_t cellId) const;
+
   /** 
    * reset the internal state
    * 
@@ -288,6 +322,16 @@ public:
   */
   void SetLtePhyRxCtrlEndOkCallback (LtePhyRxCtrlEndOkCallback c);
   
+  /**
+  * set the callback for the successful end of a RX DL ctrl frame, as part
+  * of the interconnections between the LteSpectrumPhy and the UE PHY. When
+  * set, it is called instead of the LtePhyRxCtrlEndOkCallback at the end
+  * of the DL ctrl frames.
+  *
+  * @param c the callback
+  */
+  void SetLtePhyRxDlCtrlEndOkCallback (LtePhyRxDlCtrlEndOkCallback c);
+
   /**
   * set the callback for the erroneous end of a RX ctrl frame, as part 
   * of the interconnections between the LteSpectrumPhy and the PHY
@@ -489,6 +533,7 @@ private:
   
   std::list<Ptr<LteControlMessage> > m_txControlMessageList; ///< the transmit control message list
   std::list<Ptr<LteControlMessage> > m_rxControlMessageList; ///< the receive control message list
+  Ptr<const LteControlMessageFrame> m_rxDlCtrlFrame; ///< the DL ctrl frame being received
   
   
   State m_state; ///< the state
@@ -505,6 +550,7 @@ private:
   LtePhyRxDataEndOkCallback      m_ltePhyRxDataEndOkCallback; ///< the LTE phy receive data end ok callback
   
   LtePhyRxCtrlEndOkCallback     m_ltePhyRxCtrlEndOkCallback; ///< the LTE phy receive control end ok callback
+  LtePhyRxDlCtrlEndOkCallback   m_ltePhyRxDlCtrlEndOkCallback; ///< the LTE phy receive DL control end ok callback
   LtePhyRxCtrlEndErrorCallback  m_ltePhyRxCtrlEndErrorCallback; ///< the LTE phy receive control end error callback
   LtePhyRxPssCallback  m_ltePhyRxPssCallback; ///< the LTE phy receive PSS callback
 
@@ -512,6 +558,7 @@ private:
   Ptr<LteInterference> m_interferenceCtrl; ///< the control interference
 
   uint16_t m_cellId; ///< the cell ID
+  std::vector<uint16_t> m_backgroundCellIds; ///< the cells in the interference background, sorted
   
   uint8_t m_componentCarrierId; ///< the component carrier ID
   expectedTbs_t m_expectedTbs; ///< the expected TBS
@@ -88,7 +88,7 @@ LteSpectrumSignalParametersDlCtrlFrame::LteSpectrumSignalParametersDlCtrlFrame (
   NS_LOG_FUNCTION (this << &p);
   cellId = p.cellId;
   pss = p.pss;
-  ctrlMsgList = p.ctrlMsgList;
+  ctrlMsgFrame = p.ctrlMsgFrame;
 }
 
 Ptr<SpectrumSignalParameters>
@@ -29,6 +29,7 @@ namespace ns3 {
 
 class PacketBurst;
 class LteControlMessage;
+class LteControlMessageFrame;
 
 
 /**
@@ -118,7 +119,7 @@ struct LteSpectrumSignalParametersDlCtrlFrame : public SpectrumSignalParameters
   LteSpectrumSignalParametersDlCtrlFrame (const LteSpectrumSignalParametersDlCtrlFrame& p);
 
 
-  std::list<Ptr<LteControlMessage> > ctrlMsgList; ///< control message list
+  Ptr<const LteControlMessageFrame> ctrlMsgFrame; ///< control messages, shared by the copies
   
   uint16_t cellId; ///< cell ID
   bool pss; ///< primary synchronization signal
@@ -0,0 +1,320 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "lte-traffic-generator.h"
+
+#include <ns3/log.h>
+#include <ns3/abort.h>
+#include <ns3/simulator.h>
+#include <ns3/string.h>
+#include <ns3/enum.h>
+#include <ns3/uinteger.h>
+#include <ns3/pointer.h>
+#include <ns3/object-map.h>
+#include <ns3/node-list.h>
+#include <ns3/ipv4-header.h>
+#include <ns3/lte-ue-net-device.h>
+#include <ns3/lte-enb-net-device.h>
+#include <ns3/lte-ue-rrc.h>
+#include <ns3/lte-enb-rrc.h>
+#include <ns3/lte-pdcp.h>
+#include <ns3/lte-rlc.h>
+#include <ns3/lte-radio-bearer-info.h>
+#include <ns3/component-carrier.h>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LteTrafficGenerator");
+
+NS_OBJECT_ENSURE_REGISTERED (LteTrafficGenerator);
+
+/// Size of the IPv4 header of the SDUs
+static const uint32_t IPV4_HEADER_SIZE = 20;
+/// IP protocol number of the SDUs, reserved for experimentation (RFC 3692)
+static const uint8_t EXPERIMENTAL_PROTOCOL = 253;
+/// Size of the PDCP header of the data radio bearers
+static const uint32_t PDCP_HEADER_SIZE = 2;
+
+TypeId
+LteTrafficGenerator::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::LteTrafficGenerator")
+    .SetParent<Application> ()
+    .SetGroupName ("Lte")
+    .AddConstructor<LteTrafficGenerator> ()
+    .AddAttribute ("Model",
+                   "The traffic model",
+                   EnumValue (LteTrafficGenerator::FULL_BUFFER),
+                   MakeEnumAccessor (&LteTrafficGenerator::m_model),
+                   MakeEnumChecker (LteTrafficGenerator::FULL_BUFFER, "FullBuffer",
+                                    LteTrafficGenerator::CBR, "Cbr",
+                                    LteTrafficGenerator::FTP_MODEL_3, "FtpModel3"))
+    .AddAttribute ("DrbId",
+                   "The DRB identity of the data radio bearer to be loaded",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&LteTrafficGenerator::m_drbId),
+                   MakeUintegerChecker<uint8_t> (1, 32))
+    .AddAttribute ("PacketSize",
+                   "The size of the SDUs, IPv4 header included",
+                   UintegerValue (1024),
+                   MakeUintegerAccessor (&LteTrafficGenerator::m_packetSize),
+                   MakeUintegerChecker<uint32_t> (IPV4_HEADER_SIZE))
+    .AddAttribute ("Interval",
+                   "The time between two SDUs in the Cbr model",
+                   TimeValue (MilliSeconds (10)),
+                   MakeTimeAccessor (&LteTrafficGenerator::m_interval),
+                   MakeTimeChecker ())
+    .AddAttribute ("FullBufferBacklog",
+                   "The size of the RLC transmission buffer kept by the FullBuffer "
+                   "and FtpModel3 models. It should not exceed the MaxTxBufferSize "
+                   "of the RLC, which would discard the excess SDUs.",
+                   UintegerValue (10 * 1024),
+                   MakeUintegerAccessor (&LteTrafficGenerator::m_backlog),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("FileSize",
+                   "The size of the files, in bytes, in the FtpModel3 model",
+                   StringValue ("ns3::ConstantRandomVariable[Constant=512000]"),
+                   MakePointerAccessor (&LteTrafficGenerator::m_fileSize),
+                   MakePointerChecker<RandomVariableStream> ())
+    .AddAttribute ("FileInterArrival",
+                   "The time between two files, in seconds, in the FtpModel3 model",
+                   StringValue ("ns3::ExponentialRandomVariable[Mean=1.0]"),
+                   MakePointerAccessor (&LteTrafficGenerator::m_fileInterArrival),
+                   MakePointerChecker<RandomVariableStream> ())
+    .AddTraceSource ("Tx",
+                     "An SDU handed to the PDCP",
+                     MakeTraceSourceAccessor (&LteTrafficGenerator::m_txTrace),
+                     "ns3::Packet::TracedCallback")
+  ;
+  return tid;
+}
+
+LteTrafficGenerator::LteTrafficGenerator ()
+  : m_pendingBytes (0),
+    m_txBytes (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+LteTrafficGenerator::~LteTrafficGenerator ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+LteTrafficGenerator::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_ueRrc = 0;
+  m_enbRrcs.clear ();
+  m_ueManager = 0;
+  m_bearer = 0;
+  Application::DoDispose ();
+}
+
+int64_t
+LteTrafficGenerator::AssignStreams (int64_t stream)
+{
+  NS_LOG_FUNCTION (this << stream);
+  m_fileSize->SetStream (stream);
+  m_fileInterArrival->SetStream (stream + 1);
+  return 2;
+}
+
+uint64_t
+LteTrafficGenerator::GetTxBytes (void) const
+{
+  return m_txBytes;
+}
+
+void
+LteTrafficGenerator::StartApplication (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  for (uint32_t i = 0; i < GetNode ()->GetNDevices () && m_ueRrc == 0; ++i)
+    {
+      Ptr<LteUeNetDevice> ueDev = GetNode ()->GetDevice (i)->GetObject<LteUeNetDevice> ();
+      if (ueDev != 0)
+        {
+          m_ueRrc = ueDev->GetRrc ();
+        }
+    }
+  NS_ABORT_MSG_IF (m_ueRrc == 0, "LteTrafficGenerator must be installed on a node with an LteUeNetDevice");
+
+  for (NodeList::Iterator it = NodeList::Begin (); it != NodeList::End (); ++it)
+    {
+      for (uint32_t i = 0; i < (*it)->GetNDevices (); ++i)
+        {
+          Ptr<LteEnbNetDevice> enbDev = (*it)->GetDevice (i)->GetObject<LteEnbNetDevice> ();
+          if (enbDev == 0)
+            {
+              continue;
+            }
+          std::map<uint8_t, Ptr<ComponentCarrierBaseStation> > ccMap = enbDev->GetCcMap ();
+          for (std::map<uint8_t, Ptr<ComponentCarrierBaseStation> >::iterator ccIt = ccMap.begin ();
+               ccIt != ccMap.end (); ++ccIt)
+            {
+              m_enbRrcs[ccIt->second->GetCellId ()] = enbDev->GetRrc ();
+            }
+        }
+    }
+
+  switch (m_model)
+    {
+    case FULL_BUFFER:
+      Fill ();
+      break;
+
+    case CBR:
+      SendCbr ();
+      break;
+
+    case FTP_MODEL_3:
+      NewFile ();
+      break;
+
+    default:
+      NS_FATAL_ERROR ("unknown traffic model");
+      break;
+    }
+}
+
+void
+LteTrafficGenerator::StopApplication (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_sendEvent.Cancel ();
+  m_fileEvent.Cancel ();
+  m_fillEvent.Cancel ();
+}
+
+Ptr<LteDataRadioBearerInfo>
+LteTrafficGenerator::GetBearer (void)
+{
+  if (m_ueRrc->GetState () != LteUeRrc::CONNECTED_NORMALLY)
+    {
+      return 0;
+    }
+  std::map<uint16_t, Ptr<LteEnbRrc> >::const_iterator enbIt = m_enbRrcs.find (m_ueRrc->GetCellId ());
+  uint16_t rnti = m_ueRrc->GetRnti ();
+  if (enbIt == m_enbRrcs.end () || !enbIt->second->HasUeManager (rnti))
+    {
+      return 0;
+    }
+  Ptr<UeManager> ueManager = enbIt->second->GetUeManager (rnti);
+  if (ueManager->GetState () != UeManager::CONNECTED_NORMALLY
+      && ueManager->GetState () != UeManager::CONNECTION_RECONFIGURATION)
+    {
+      return 0;
+    }
+  if (ueManager != m_ueManager || m_bearer == 0)
+    {
+      ObjectMapValue drbs;
+      ueManager->GetAttribute ("DataRadioBearerMap", drbs);
+      m_ueManager = ueManager;
+      m_bearer = DynamicCast<LteDataRadioBearerInfo> (drbs.Get (m_drbId));
+      NS_LOG_LOGIC ("cell " << enbIt->first << " RNTI " << rnti << " bearer " << m_bearer);
+    }
+  if (m_bearer != 0 && m_bearer->m_pdcp == 0)
+    {
+      NS_LOG_WARN ("DRB " << (uint16_t) m_drbId << " has no PDCP, e.g., it uses the RLC SM");
+      return 0;
+    }
+  return m_bearer;
+}
+
+void
+LteTrafficGenerator::Send (Ptr<LteDataRadioBearerInfo> bearer, uint32_t size)
+{
+  Ptr<Packet> p = Create<Packet> (size - IPV4_HEADER_SIZE);
+  Ipv4Header ipv4Header;
+  ipv4Header.SetPayloadSize (size - IPV4_HEADER_SIZE);
+  ipv4Header.SetProtocol (EXPERIMENTAL_PROTOCOL);
+  p->AddHeader (ipv4Header);
+  m_txTrace (p);
+  m_txBytes += size;
+
+  LtePdcpSapProvider::TransmitPdcpSduParameters params;
+  params.pdcpSdu = p;
+  params.rnti = m_ueRrc->GetRnti ();
+  params.lcid = bearer->m_logicalChannelIdentity;
+  bearer->m_pdcp->GetLtePdcpSapProvider ()->TransmitPdcpSdu (params);
+}
+
+void
+LteTrafficGenerator::SendCbr (void)
+{
+  Ptr<LteDataRadioBearerInfo> bearer = GetBearer ();
+  if (bearer != 0)
+    {
+      Send (bearer, m_packetSize);
+    }
+  else
+    {
+      NS_LOG_LOGIC ("UE not connected, SDU not generated");
+    }
+  m_sendEvent = Simulator::Schedule (m_interval, &LteTrafficGenerator::SendCbr, this);
+}
+
+void
+LteTrafficGenerator::NewFile (void)
+{
+  uint32_t fileSize = m_fileSize->GetInteger ();
+  NS_LOG_FUNCTION (this << fileSize);
+  bool idle = (m_pendingBytes == 0);
+  m_pendingBytes += fileSize;
+  if (idle && m_pendingBytes > 0)
+    {
+      Fill ();
+    }
+  m_fileEvent = Simulator::Schedule (Seconds (m_fileInterArrival->GetValue ()),
+                                     &LteTrafficGenerator::NewFile, this);
+}
+
+void
+LteTrafficGenerator::Fill (void)
+{
+  Ptr<LteDataRadioBearerInfo> bearer = GetBearer ();
+  if (bearer != 0)
+    {
+      uint32_t buffered = bearer->m_rlc->GetTxBufferSize ();
+      while (m_model == FULL_BUFFER || m_pendingBytes > 0)
+        {
+          uint32_t size = m_packetSize;
+          if (m_model == FTP_MODEL_3 && m_pendingBytes < size)
+            {
+              size = std::max<uint32_t> (m_pendingBytes, IPV4_HEADER_SIZE);
+            }
+          if (buffered + size + PDCP_HEADER_SIZE > m_backlog)
+            {
+              break;
+            }
+          Send (bearer, size);
+          buffered += size + PDCP_HEADER_SIZE;
+          if (m_model == FTP_MODEL_3)
+            {
+              m_pendingBytes -= std::min<uint64_t> (size, m_pendingBytes);
+            }
+        }
+    }
+  if (m_model == FULL_BUFFER || m_pendingBytes > 0)
+    {
+      m_fillEvent = Simulator::Schedule (MilliSeconds (1), &LteTrafficGenerator::Fill, this);
+    }
+}
+
+} // namespace ns3
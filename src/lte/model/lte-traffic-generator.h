@@ -0,0 +1,155 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LTE_TRAFFIC_GENERATOR_H
+#define LTE_TRAFFIC_GENERATOR_H
+
+#include <ns3/application.h>
+#include <ns3/event-id.h>
+#include <ns3/nstime.h>
+#include <ns3/packet.h>
+#include <ns3/random-variable-stream.h>
+#include <ns3/traced-callback.h>
+
+#include <map>
+
+namespace ns3 {
+
+class LteUeRrc;
+class LteEnbRrc;
+class UeManager;
+class LteDataRadioBearerInfo;
+
+/**
+ * \ingroup lte
+ *
+ * Downlink traffic source which hands synthetic SDUs directly to the
+ * PDCP entity of a data radio bearer at the serving eNB, so that the
+ * RAN can be loaded without remote hosts, sockets, IP routing nor EPC.
+ *
+ * The application is installed on the node of the UE it serves. At
+ * every SDU, it looks up the cell and the RNTI of the UE, and the data
+ * radio bearer with the configured DRB identity at the eNB serving
+ * that cell; it stays silent while the UE is not connected, e.g.,
+ * during a handover. Three traffic models are available:
+ *
+ *  - FullBuffer: the RLC transmission buffer of the bearer is topped
+ *    up every millisecond to the FullBufferBacklog size;
+ *  - Cbr: an SDU of PacketSize bytes every Interval;
+ *  - FtpModel3: files of FileSize bytes arrive according to the
+ *    FileInterArrival times (3GPP TR 36.872 FTP model 3), and each file
+ *    is fed to the RLC buffer as in the full buffer model until it has
+ *    been completely handed over.
+ *
+ * The bearer must have a PDCP entity, i.e., it must not use the RLC
+ * saturation mode (LteRlcSm), which is the default of
+ * LteEnbRrc::EpsBearerToRlcMapping.
+ *
+ * The SDUs carry an IPv4 header with an experimental protocol number,
+ * so that the UE can deliver them to its (possibly missing) IP stack,
+ * which discards them. The PDCP and RLC statistics account them as
+ * any other data.
+ */
+class LteTrafficGenerator : public Application
+{
+public:
+  /// Traffic model
+  enum Model
+  {
+    FULL_BUFFER,
+    CBR,
+    FTP_MODEL_3
+  };
+
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  LteTrafficGenerator ();
+  virtual ~LteTrafficGenerator ();
+
+  /**
+   * Assign a fixed random variable stream number to the random variables
+   * used by this model.
+   *
+   * \param stream first stream index to use
+   * \return the number of stream indices assigned by this model
+   */
+  int64_t AssignStreams (int64_t stream);
+
+  /**
+   * \return the total size of the SDUs handed to the PDCP so far
+   */
+  uint64_t GetTxBytes (void) const;
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  virtual void StartApplication (void);
+  virtual void StopApplication (void);
+
+  /// Send an SDU and schedule the next one, in the CBR model
+  void SendCbr (void);
+  /// Add a new file to the pending bytes, in the FTP model 3
+  void NewFile (void);
+  /// Top up the RLC buffer from the pending bytes
+  void Fill (void);
+
+  /**
+   * Look up the data radio bearer of the UE at its serving eNB.
+   *
+   * \return the bearer, or null if the UE is not connected or the
+   * bearer is not set up
+   */
+  Ptr<LteDataRadioBearerInfo> GetBearer (void);
+
+  /**
+   * Hand an SDU to the PDCP of the bearer.
+   *
+   * \param bearer the data radio bearer
+   * \param size the size of the SDU, IPv4 header included
+   */
+  void Send (Ptr<LteDataRadioBearerInfo> bearer, uint32_t size);
+
+  Model m_model;                       ///< the traffic model
+  uint32_t m_packetSize;               ///< the size of the SDUs
+  Time m_interval;                     ///< the CBR inter-SDU time
+  uint32_t m_backlog;                  ///< the RLC buffer size kept by Fill
+  uint8_t m_drbId;                     ///< the DRB identity of the bearer
+  Ptr<RandomVariableStream> m_fileSize;         ///< the FTP file size
+  Ptr<RandomVariableStream> m_fileInterArrival; ///< the FTP file inter-arrival time
+
+  Ptr<LteUeRrc> m_ueRrc;                           ///< the RRC of the UE
+  std::map<uint16_t, Ptr<LteEnbRrc> > m_enbRrcs;   ///< the eNB RRCs by cell ID
+  Ptr<UeManager> m_ueManager;                      ///< the UE context of the cached bearer
+  Ptr<LteDataRadioBearerInfo> m_bearer;            ///< the cached bearer
+
+  uint64_t m_pendingBytes;             ///< bytes of the current FTP files not yet sent
+  uint64_t m_txBytes;                  ///< bytes handed to the PDCP
+  EventId m_sendEvent;                 ///< the next CBR SDU
+  EventId m_fileEvent;                 ///< the next FTP file
+  EventId m_fillEvent;                 ///< the next top up of the RLC buffer
+
+  /// The `Tx` trace source, fired for each SDU handed to the PDCP
+  TracedCallback<Ptr<const Packet> > m_txTrace;
+};
+
+} // namespace ns3
+
+#endif // LTE_TRAFFIC_GENERATOR_H
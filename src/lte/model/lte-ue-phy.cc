@@ -28,6 +28,7 @@
 #include <ns3/node.h>
 #include <cfloat>
 #include <cmath>
+#include <algorithm>
 #include <ns3/simulator.h>
 #include <ns3/double.h>
 #include "lte-ue-phy.h"
@@ -44,6 +45,7 @@
 #include <ns3/pointer.h>
 #include <ns3/boolean.h>
 #include <ns3/lte-ue-power-control.h>
+#include <ns3/metrics-registry.h>
 
 namespace ns3 {
 
@@ -163,6 +165,7 @@ LteUePhy::LteUePhy (Ptr<LteSpectrumPhy> dlPhy, Ptr<LteSpectrumPhy> ulPhy)
     m_dataInterferencePowerUpdated (false),
     m_pssReceived (false),
     m_ueMeasurementsFilterPeriod (MilliSeconds (200)),
+    m_interferenceCells (0),
     m_ueMeasurementsFilterLast (MilliSeconds (0)),
     m_rsrpSinrSampleCounter (0),
     m_imsi (0)
@@ -301,6 +304,16 @@ LteUePhy::GetTypeId (void)
                    TimeValue (MilliSeconds (200)),
                    MakeTimeAccessor (&LteUePhy::m_ueMeasurementsFilterPeriod),
                    MakeTimeChecker ())
+    .AddAttribute ("InterferenceCells",
+                   "Number of strongest neighbour cells, by the RSRP of the "
+                   "last UeMeasurementsFilterPeriod, whose DL data frames are "
+                   "simulated exactly. The interference of the other "
+                   "neighbours is approximated by a background of their "
+                   "RSRP at full load, and their DL data frames are not "
+                   "delivered to the UE. 0 simulates all the neighbours.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&LteUePhy::m_interferenceCells),
+                   MakeUintegerChecker<uint16_t> ())
     .AddAttribute ("DownlinkCqiPeriodicity",
                    "Periodicity in milliseconds for reporting the"
                    "wideband and subband downlink CQIs to the eNB",
@@ -546,8 +559,23 @@ Ptr<SpectrumValue>
 LteUePhy::CreateTxPowerSpectralDensity ()
 {
   NS_LOG_FUNCTION (this);
-  LteSpectrumValueHelper psdHelper;
-  Ptr<SpectrumValue> psd = psdHelper.CreateUlTxPowerSpectralDensity (m_ulEarfcn, m_ulBandwidth, m_txPower, GetSubChannelsForTransmission ());
+  static MetricCounter *hits = MetricsRegistry::Get ()->GetCounter ("LteUePhy/TxPsdCacheHits");
+  static MetricCounter *misses = MetricsRegistry::Get ()->GetCounter ("LteUePhy/TxPsdCacheMisses");
+  static const std::map<int, double> noPowerTxMap;
+
+  Ptr<SpectrumValue> psd;
+  if (m_txPsdCache.Matches (m_ulEarfcn, m_ulBandwidth, m_txPower, m_subChannelsForTransmission, noPowerTxMap))
+    {
+      hits->Increment ();
+      psd = m_txPsdCache.psd;
+    }
+  else
+    {
+      misses->Increment ();
+      LteSpectrumValueHelper psdHelper;
+      psd = psdHelper.CreateUlTxPowerSpectralDensity (m_ulEarfcn, m_ulBandwidth, m_txPower, GetSubChannelsForTransmission ());
+      m_txPsdCache.Set (m_ulEarfcn, m_ulBandwidth, m_txPower, m_subChannelsForTransmission, noPowerTxMap, psd);
+    }
   m_reportPowerSpectralDensity (m_rnti, psd);
 
   return psd;
@@ -618,19 +646,10 @@ LteUePhy::GenerateCqiRsrpRsrq (const SpectrumValue& sinr)
     {
       NS_ASSERT_MSG (m_rsReceivedPowerUpdated, " RS received power info obsolete");
       // RSRP evaluated as averaged received power among RBs
-      double sum = 0.0;
-      uint8_t rbNum = 0;
-      Values::const_iterator it;
-      for (it = m_rsReceivedPower.ConstValuesBegin (); it != m_rsReceivedPower.ConstValuesEnd (); it++)
-        {
-          // convert PSD [W/Hz] to linear power [W] for the single RE
-          // we consider only one RE for the RS since the channel is
-          // flat within the same RB
-          double powerTxW = ((*it) * 180000.0) / 12.0;
-          sum += powerTxW;
-          rbNum++;
-        }
-      double rsrp = (rbNum > 0) ? (sum / rbNum) : DBL_MAX;
+      // we consider only one RE for the RS since the channel is
+      // flat within the same RB
+      size_t rbNum = m_rsReceivedPower.GetValuesN ();
+      double rsrp = (rbNum > 0) ? (SumRePower (m_rsReceivedPower) / rbNum) : DBL_MAX;
       // averaged SINR among RBs
       double avSinr = ComputeAvgSinr (sinr);
 
@@ -652,25 +671,13 @@ LteUePhy::GenerateCqiRsrpRsrq (const SpectrumValue& sinr)
       // measure instantaneous RSRQ now
       NS_ASSERT_MSG (m_rsInterferencePowerUpdated, " RS interference power info obsolete");
 
-      std::list <PssElement>::iterator itPss = m_pssList.begin ();
-      while (itPss != m_pssList.end ())
-        {
-          uint16_t rbNum = 0;
-          double rssiSum = 0.0;
-
-          Values::const_iterator itIntN = m_rsInterferencePower.ConstValuesBegin ();
-          Values::const_iterator itPj = m_rsReceivedPower.ConstValuesBegin ();
-          for (itPj = m_rsReceivedPower.ConstValuesBegin ();
-               itPj != m_rsReceivedPower.ConstValuesEnd ();
-               itIntN++, itPj++)
-            {
-              rbNum++;
-              // convert PSD [W/Hz] to linear power [W] for the single RE
-              double interfPlusNoisePowerTxW = ((*itIntN) * 180000.0) / 12.0;
-              double signalPowerTxW = ((*itPj) * 180000.0) / 12.0;
-              rssiSum += (2 * (interfPlusNoisePowerTxW + signalPowerTxW));
-            }
+      // the RSSI is the same for all the measured cells
+      uint16_t rbNum = m_rsReceivedPower.GetValuesN ();
+      double rssiSum = ComputeRsRssi (m_rsInterferencePower, m_rsReceivedPower);
 
+      for (std::vector <PssElement>::const_iterator itPss = m_pssList.begin ();
+           itPss != m_pssList.end (); ++itPss)
+        {
           NS_ASSERT (rbNum == (*itPss).nRB);
           double rsrq_dB = 10 * log10 ((*itPss).pssPsdSum / rssiSum);
 
@@ -679,12 +686,11 @@ LteUePhy::GenerateCqiRsrpRsrq (const SpectrumValue& sinr)
               NS_LOG_INFO (this << " PSS RNTI " << m_rnti << " cellId " << m_cellId
                                 << " has RSRQ " << rsrq_dB << " and RBnum " << rbNum);
               // store measurements
-              std::map <uint16_t, UeMeasurementsElement>::iterator itMeasMap;
-              itMeasMap = m_ueMeasurementsMap.find ((*itPss).cellId);
-              if (itMeasMap != m_ueMeasurementsMap.end ())
+              if ((*itPss).cellId < m_ueMeasurements.size ()
+                  && m_ueMeasurements[(*itPss).cellId].rsrpNum > 0)
                 {
-                  (*itMeasMap).second.rsrqSum += rsrq_dB;
-                  (*itMeasMap).second.rsrqNum++;
+                  m_ueMeasurements[(*itPss).cellId].rsrqSum += rsrq_dB;
+                  m_ueMeasurements[(*itPss).cellId].rsrqNum++;
                 }
               else
                 {
@@ -692,9 +698,7 @@ LteUePhy::GenerateCqiRsrpRsrq (const SpectrumValue& sinr)
                 }
             }
 
-          itPss++;
-
-        } // end of while (itPss != m_pssList.end ())
+        } // end of for (itPss = m_pssList.begin (); ...)
 
       m_pssList.clear ();
 
@@ -946,6 +950,41 @@ LteUePhy::CreateDlCqiFeedbackMessage (const SpectrumValue& sinr)
 }
 
 
+double
+LteUePhy::SumRePower (const SpectrumValue& psd)
+{
+  // the sum is computed over 4 independent partial sums, which the
+  // compiler maps to SIMD lanes, and scaled once
+  size_t n = psd.GetValuesN ();
+  if (n == 0)
+    {
+      return 0.0;
+    }
+  const double *v = &(*psd.ConstValuesBegin ());
+  size_t nBlocked = n - n % 4;
+  double acc[4] = { 0.0, 0.0, 0.0, 0.0 };
+  for (size_t i = 0; i < nBlocked; i += 4)
+    {
+      acc[0] += v[i];
+      acc[1] += v[i + 1];
+      acc[2] += v[i + 2];
+      acc[3] += v[i + 3];
+    }
+  double sum = (acc[0] + acc[1]) + (acc[2] + acc[3]);
+  for (size_t i = nBlocked; i < n; ++i)
+    {
+      sum += v[i];
+    }
+  return sum * 180000.0 / 12.0;
+}
+
+double
+LteUePhy::ComputeRsRssi (const SpectrumValue& interference, const SpectrumValue& signal)
+{
+  NS_ASSERT (interference.GetValuesN () == signal.GetValuesN ());
+  return 2 * (SumRePower (interference) + SumRePower (signal));
+}
+
 void
 LteUePhy::ReportUeMeasurements ()
 {
@@ -953,42 +992,87 @@ LteUePhy::ReportUeMeasurements ()
   NS_LOG_DEBUG (this << " Report UE Measurements ");
 
   LteUeCphySapUser::UeMeasurementsParameters ret;
+  std::vector<std::pair<double, uint16_t> > neighbours;
 
-  std::map <uint16_t, UeMeasurementsElement>::iterator it;
-  for (it = m_ueMeasurementsMap.begin (); it != m_ueMeasurementsMap.end (); it++)
+  for (uint16_t cellId = 0; cellId < m_ueMeasurements.size (); cellId++)
     {
-      double avg_rsrp = (*it).second.rsrpSum / (double)(*it).second.rsrpNum;
-      double avg_rsrq = (*it).second.rsrqSum / (double)(*it).second.rsrqNum;
+      UeMeasurementsElement &el = m_ueMeasurements[cellId];
+      if (el.rsrpNum == 0)
+        {
+          continue;
+        }
+      double avg_rsrp = el.rsrpSum / (double)el.rsrpNum;
+      double avg_rsrq = el.rsrqSum / (double)el.rsrqNum;
       /*
        * In CELL_SEARCH state, this may result in avg_rsrq = 0/0 = -nan.
        * UE RRC must take this into account when receiving measurement reports.
        * TODO remove this shortcoming by calculating RSRQ during CELL_SEARCH
        */
-      NS_LOG_DEBUG (this << " CellId " << (*it).first
+      NS_LOG_DEBUG (this << " CellId " << cellId
                          << " RSRP " << avg_rsrp
-                         << " (nSamples " << (uint16_t)(*it).second.rsrpNum << ")"
+                         << " (nSamples " << (uint16_t)el.rsrpNum << ")"
                          << " RSRQ " << avg_rsrq
-                         << " (nSamples " << (uint16_t)(*it).second.rsrqNum << ")"
+                         << " (nSamples " << (uint16_t)el.rsrqNum << ")"
                          << " ComponentCarrierID " << (uint16_t)m_componentCarrierId);
 
       LteUeCphySapUser::UeMeasurementsElement newEl;
-      newEl.m_cellId = (*it).first;
+      newEl.m_cellId = cellId;
       newEl.m_rsrp = avg_rsrp;
       newEl.m_rsrq = avg_rsrq;
       ret.m_ueMeasurementsList.push_back (newEl);
       ret.m_componentCarrierId = m_componentCarrierId;
 
       // report to UE measurements trace
-      m_reportUeMeasurements (m_rnti, (*it).first, avg_rsrp, avg_rsrq, ((*it).first == m_cellId ? 1 : 0), m_componentCarrierId);
+      m_reportUeMeasurements (m_rnti, cellId, avg_rsrp, avg_rsrq, (cellId == m_cellId ? 1 : 0), m_componentCarrierId);
+
+      if (cellId != m_cellId)
+        {
+          neighbours.push_back (std::make_pair (avg_rsrp, cellId));
+        }
+
+      el.rsrpSum = 0;
+      el.rsrpNum = 0;
+      el.rsrqSum = 0;
+      el.rsrqNum = 0;
+    }
+
+  if (m_interferenceCells > 0 && m_dlConfigured)
+    {
+      UpdateInterferenceBackground (neighbours);
     }
 
   // report to RRC
   m_ueCphySapUser->ReportUeMeasurements (ret);
 
-  m_ueMeasurementsMap.clear ();
   Simulator::Schedule (m_ueMeasurementsFilterPeriod, &LteUePhy::ReportUeMeasurements, this);
 }
 
+void
+LteUePhy::UpdateInterferenceBackground (std::vector<std::pair<double, uint16_t> > &neighbours)
+{
+  NS_LOG_FUNCTION (this << neighbours.size ());
+
+  std::vector<uint16_t> cellIds;
+  Ptr<SpectrumValue> background;
+  if (neighbours.size () > m_interferenceCells)
+    {
+      std::sort (neighbours.begin (), neighbours.end ());
+      uint32_t nBackground = neighbours.size () - m_interferenceCells;
+      double rsrpW = 0.0;
+      for (uint32_t i = 0; i < nBackground; ++i)
+        {
+          rsrpW += std::pow (10.0, (neighbours[i].first - 30) / 10.0);
+          cellIds.push_back (neighbours[i].second);
+        }
+      // the RSRP is the power per RE, i.e., per 15 kHz subcarrier (see SumRePower)
+      background = Create<SpectrumValue> (m_noisePsd->GetSpectrumModel ());
+      (*background) = rsrpW / 15000.0;
+      NS_LOG_INFO (this << " cellId " << m_cellId << " rnti " << m_rnti << " background of "
+                        << nBackground << " cells, RSRP " << 10 * std::log10 (1000 * rsrpW) << " dBm");
+    }
+  m_downlinkSpectrumPhy->SetInterferenceBackground (background, cellIds);
+}
+
 void
 LteUePhy::SetDownlinkCqiPeriodicity (Time cqiPeriodicity)
 {
@@ -1052,90 +1136,109 @@ LteUePhy::ReceiveLteControlMessageList (std::list<Ptr<LteControlMessage> > msgLi
   NS_LOG_DEBUG (this << " I am rnti = " << m_rnti << " and I received msgs " << (uint16_t) msgList.size ());
   for (it = msgList.begin (); it != msgList.end (); it++)
     {
-      Ptr<LteControlMessage> msg = (*it);
+      ProcessLteControlMessage (*it);
+    }
+}
 
-      if (msg->GetMessageType () == LteControlMessage::DL_DCI)
-        {
-          Ptr<DlDciLteControlMessage> msg2 = DynamicCast<DlDciLteControlMessage> (msg);
+void
+LteUePhy::ReceiveLteControlMessageFrame (Ptr<const LteControlMessageFrame> frame)
+{
+  NS_LOG_FUNCTION (this);
+  NS_LOG_DEBUG (this << " I am rnti = " << m_rnti << " and I received msgs " << (uint16_t) frame->GetN ());
+  // m_rnti is read again for every message, since a RAR sets it
+  for (uint32_t i = frame->GetNext (m_rnti, 0); i < frame->GetN (); i = frame->GetNext (m_rnti, i + 1))
+    {
+      ProcessLteControlMessage (frame->Get (i));
+    }
+}
 
-          DlDciListElement_s dci = msg2->GetDci ();
-          if (dci.m_rnti != m_rnti)
-            {
-              // DCI not for me
-              continue;
-            }
+void
+LteUePhy::ProcessLteControlMessage (Ptr<LteControlMessage> msg)
+{
+  if (msg->GetMessageType () == LteControlMessage::DL_DCI)
+    {
+      Ptr<DlDciLteControlMessage> msg2 = DynamicCast<DlDciLteControlMessage> (msg);
 
-          if (dci.m_resAlloc != 0)
-            {
-              NS_FATAL_ERROR ("Resource Allocation type not implemented");
-            }
+      DlDciListElement_s dci = msg2->GetDci ();
+      if (dci.m_rnti != m_rnti)
+        {
+          // DCI not for me
+          return;
+        }
 
-          std::vector <int> dlRb;
+      if (dci.m_resAlloc != 0)
+        {
+          NS_FATAL_ERROR ("Resource Allocation type not implemented");
+        }
 
+      std::vector <int> dlRb;
 
-          // New part for User Throughput
-          ////////////////////////////////
-          
-          m_dlSize = dci.m_tbsSize;
 
-          for (uint8_t i = 0; i < dci.m_tbsSize.size (); i++){
-            m_dlThroughput += (float(dci.m_tbsSize.at (i)) * 8.0 / 1000000 / 0.004);
-          }
+      // New part for User Throughput
+      ////////////////////////////////
+      
+      m_dlSize = dci.m_tbsSize;
 
-          ////////////////////////////////
+      for (uint8_t i = 0; i < dci.m_tbsSize.size (); i++){
+        m_dlThroughput += (float(dci.m_tbsSize.at (i)) * 8.0 / 1000000 / 0.004);
+      }
+
+      ////////////////////////////////
 
-          // translate the DCI to Spectrum framework
-          uint32_t mask = 0x1;
-          for (int i = 0; i < 32; i++)
+      // translate the DCI to Spectrum framework
+      uint32_t mask = 0x1;
+      for (int i = 0; i < 32; i++)
+        {
+          if (((dci.m_rbBitmap & mask) >> i) == 1)
             {
-              if (((dci.m_rbBitmap & mask) >> i) == 1)
+              for (int k = 0; k < GetRbgSize (); k++)
                 {
-                  for (int k = 0; k < GetRbgSize (); k++)
-                    {
-                      dlRb.push_back ((i * GetRbgSize ()) + k);
+                  dlRb.push_back ((i * GetRbgSize ()) + k);
 //             NS_LOG_DEBUG(this << " RNTI " << m_rnti << " RBG " << i << " DL-DCI allocated PRB " << (i*GetRbgSize()) + k);
-                    }
                 }
-              mask = (mask << 1);
-            }
-          if (m_enableUplinkPowerControl)
-            {
-              m_powerControl->ReportTpc (dci.m_tpc);
             }
+          mask = (mask << 1);
+        }
+      if (m_enableUplinkPowerControl)
+        {
+          m_powerControl->ReportTpc (dci.m_tpc);
+        }
 
 
-          // send TB info to LteSpectrumPhy
-          NS_LOG_DEBUG (this << " UE " << m_rnti << " DL-DCI " << dci.m_rnti << " bitmap "  << dci.m_rbBitmap);
-          for (uint8_t i = 0; i < dci.m_tbsSize.size (); i++)
-            {
-              m_downlinkSpectrumPhy->AddExpectedTb (dci.m_rnti, dci.m_ndi.at (i), dci.m_tbsSize.at (i), dci.m_mcs.at (i), dlRb, i, dci.m_harqProcess, dci.m_rv.at (i), true /* DL */);
-            }
+      // send TB info to LteSpectrumPhy
+      NS_LOG_DEBUG (this << " UE " << m_rnti << " DL-DCI " << dci.m_rnti << " bitmap "  << dci.m_rbBitmap);
+      for (uint8_t i = 0; i < dci.m_tbsSize.size (); i++)
+        {
+          m_downlinkSpectrumPhy->AddExpectedTb (dci.m_rnti, dci.m_ndi.at (i), dci.m_tbsSize.at (i), dci.m_mcs.at (i), dlRb, i, dci.m_harqProcess, dci.m_rv.at (i), true /* DL */);
+        }
 
-          SetSubChannelsForReception (dlRb);
+      SetSubChannelsForReception (dlRb);
 
 
+    }
+  else if (msg->GetMessageType () == LteControlMessage::UL_DCI)
+    {
+      // set the uplink bandwidth according to the UL-CQI
+      Ptr<UlDciLteControlMessage> msg2 = DynamicCast<UlDciLteControlMessage> (msg);
+      UlDciListElement_s dci = msg2->GetDci ();
+      if (dci.m_rnti != m_rnti)
+        {
+          // DCI not for me
+          return;
         }
-      else if (msg->GetMessageType () == LteControlMessage::UL_DCI)
+      NS_LOG_INFO (this << " UL DCI");
+      std::vector <int> ulRb;
+      for (int i = 0; i < dci.m_rbLen; i++)
         {
-          // set the uplink bandwidth according to the UL-CQI
-          Ptr<UlDciLteControlMessage> msg2 = DynamicCast<UlDciLteControlMessage> (msg);
-          UlDciListElement_s dci = msg2->GetDci ();
-          if (dci.m_rnti != m_rnti)
-            {
-              // DCI not for me
-              continue;
-            }
-          NS_LOG_INFO (this << " UL DCI");
-          std::vector <int> ulRb;
-          for (int i = 0; i < dci.m_rbLen; i++)
-            {
-              ulRb.push_back (i + dci.m_rbStart);
-              //NS_LOG_DEBUG (this << " UE RB " << i + dci.m_rbStart);
-            }
-          m_reportUlPhyResourceBlocks (m_rnti, ulRb);
-          QueueSubChannelsForTransmission (ulRb);
-          // fire trace of UL Tx PHY stats
-          HarqProcessInfoList_t harqInfoList = m_harqPhyModule->GetHarqProcessInfoUl (m_rnti, 0);
+          ulRb.push_back (i + dci.m_rbStart);
+          //NS_LOG_DEBUG (this << " UE RB " << i + dci.m_rbStart);
+        }
+      m_reportUlPhyResourceBlocks (m_rnti, ulRb);
+      QueueSubChannelsForTransmission (ulRb);
+      // fire trace of UL Tx PHY stats
+      if (!m_ulPhyTransmission.IsEmpty ())
+        {
+          const HarqProcessInfoList_t& harqInfoList = m_harqPhyModule->GetHarqProcessInfoUl (m_rnti, 0);
           PhyTransmissionStatParameters params;
           params.m_cellId = m_cellId;
           params.m_imsi = 0; // it will be set by DlPhyTransmissionCallback in LteHelper
@@ -1149,63 +1252,61 @@ LteUePhy::ReceiveLteControlMessageList (std::list<Ptr<LteControlMessage> > msgLi
           params.m_ndi = dci.m_ndi;
           params.m_ccId = m_componentCarrierId;
           m_ulPhyTransmission (params);
-          // pass the info to the MAC
-          m_uePhySapUser->ReceiveLteControlMessage (msg);
         }
-      else if (msg->GetMessageType () == LteControlMessage::RAR)
+      // pass the info to the MAC
+      m_uePhySapUser->ReceiveLteControlMessage (msg);
+    }
+  else if (msg->GetMessageType () == LteControlMessage::RAR)
+    {
+      Ptr<RarLteControlMessage> rarMsg = DynamicCast<RarLteControlMessage> (msg);
+      if (rarMsg->GetRaRnti () == m_raRnti)
         {
-          Ptr<RarLteControlMessage> rarMsg = DynamicCast<RarLteControlMessage> (msg);
-          if (rarMsg->GetRaRnti () == m_raRnti)
+          for (std::list<RarLteControlMessage::Rar>::const_iterator it = rarMsg->RarListBegin (); it != rarMsg->RarListEnd (); ++it)
             {
-              for (std::list<RarLteControlMessage::Rar>::const_iterator it = rarMsg->RarListBegin (); it != rarMsg->RarListEnd (); ++it)
+              if (it->rapId != m_raPreambleId)
                 {
-                  if (it->rapId != m_raPreambleId)
-                    {
-                      // UL grant not for me
-                      continue;
-                    }
-                  else
+                  // UL grant not for me
+                  continue;
+                }
+              else
+                {
+                  NS_LOG_INFO ("received RAR RNTI " << m_raRnti);
+                  // set the uplink bandwidth according to the UL grant
+                  std::vector <int> ulRb;
+                  for (int i = 0; i < it->rarPayload.m_grant.m_rbLen; i++)
                     {
-                      NS_LOG_INFO ("received RAR RNTI " << m_raRnti);
-                      // set the uplink bandwidth according to the UL grant
-                      std::vector <int> ulRb;
-                      for (int i = 0; i < it->rarPayload.m_grant.m_rbLen; i++)
-                        {
-                          ulRb.push_back (i + it->rarPayload.m_grant.m_rbStart);
-                        }
-
-                      QueueSubChannelsForTransmission (ulRb);
-                      // pass the info to the MAC
-                      m_uePhySapUser->ReceiveLteControlMessage (msg);
-                      // reset RACH variables with out of range values
-                      m_raPreambleId = 255;
-                      m_raRnti = 11;
+                      ulRb.push_back (i + it->rarPayload.m_grant.m_rbStart);
                     }
+
+                  QueueSubChannelsForTransmission (ulRb);
+                  // pass the info to the MAC
+                  m_uePhySapUser->ReceiveLteControlMessage (msg);
+                  // reset RACH variables with out of range values
+                  m_raPreambleId = 255;
+                  m_raRnti = 11;
                 }
             }
         }
-      else if (msg->GetMessageType () == LteControlMessage::MIB)
-        {
-          NS_LOG_INFO ("received MIB");
-          NS_ASSERT (m_cellId > 0);
-          Ptr<MibLteControlMessage> msg2 = DynamicCast<MibLteControlMessage> (msg);
-          m_ueCphySapUser->RecvMasterInformationBlock (m_cellId, msg2->GetMib ());
-        }
-      else if (msg->GetMessageType () == LteControlMessage::SIB1)
-        {
-          NS_LOG_INFO ("received SIB1");
-          NS_ASSERT (m_cellId > 0);
-          Ptr<Sib1LteControlMessage> msg2 = DynamicCast<Sib1LteControlMessage> (msg);
-          m_ueCphySapUser->RecvSystemInformationBlockType1 (m_cellId, msg2->GetSib1 ());
-        }
-      else
-        {
-          // pass the message to UE-MAC
-          m_uePhySapUser->ReceiveLteControlMessage (msg);
-        }
-
     }
-
+  else if (msg->GetMessageType () == LteControlMessage::MIB)
+    {
+      NS_LOG_INFO ("received MIB");
+      NS_ASSERT (m_cellId > 0);
+      Ptr<MibLteControlMessage> msg2 = DynamicCast<MibLteControlMessage> (msg);
+      m_ueCphySapUser->RecvMasterInformationBlock (m_cellId, msg2->GetMib ());
+    }
+  else if (msg->GetMessageType () == LteControlMessage::SIB1)
+    {
+      NS_LOG_INFO ("received SIB1");
+      NS_ASSERT (m_cellId > 0);
+      Ptr<Sib1LteControlMessage> msg2 = DynamicCast<Sib1LteControlMessage> (msg);
+      m_ueCphySapUser->RecvSystemInformationBlockType1 (m_cellId, msg2->GetSib1 ());
+    }
+  else
+    {
+      // pass the message to UE-MAC
+      m_uePhySapUser->ReceiveLteControlMessage (msg);
+    }
 
 }
 
@@ -1215,16 +1316,8 @@ LteUePhy::ReceivePss (uint16_t cellId, Ptr<SpectrumValue> p)
 {
   NS_LOG_FUNCTION (this << cellId << (*p));
 
-  double sum = 0.0;
-  uint16_t nRB = 0;
-  Values::const_iterator itPi;
-  for (itPi = p->ConstValuesBegin (); itPi != p->ConstValuesEnd (); itPi++)
-    {
-      // convert PSD [W/Hz] to linear power [W] for the single RE
-      double powerTxW = ((*itPi) * 180000.0) / 12.0;
-      sum += powerTxW;
-      nRB++;
-    }
+  double sum = SumRePower (*p);
+  uint16_t nRB = p->GetValuesN ();
 
   // measure instantaneous RSRP now
   double rsrp_dBm = 10 * log10 (1000 * (sum / (double)nRB));
@@ -1233,22 +1326,17 @@ LteUePhy::ReceivePss (uint16_t cellId, Ptr<SpectrumValue> p)
   // note that m_pssReceptionThreshold does not apply here
 
   // store measurements
-  std::map <uint16_t, UeMeasurementsElement>::iterator itMeasMap = m_ueMeasurementsMap.find (cellId);
-  if (itMeasMap == m_ueMeasurementsMap.end ())
+  if (cellId >= m_ueMeasurements.size ())
     {
-      // insert new entry
       UeMeasurementsElement newEl;
-      newEl.rsrpSum = rsrp_dBm;
-      newEl.rsrpNum = 1;
+      newEl.rsrpSum = 0;
+      newEl.rsrpNum = 0;
       newEl.rsrqSum = 0;
       newEl.rsrqNum = 0;
-      m_ueMeasurementsMap.insert (std::pair <uint16_t, UeMeasurementsElement> (cellId, newEl));
-    }
-  else
-    {
-      (*itMeasMap).second.rsrpSum += rsrp_dBm;
-      (*itMeasMap).second.rsrpNum++;
+      m_ueMeasurements.resize (cellId + 1, newEl);
     }
+  m_ueMeasurements[cellId].rsrpSum += rsrp_dBm;
+  m_ueMeasurements[cellId].rsrpNum++;
 
   /*
    * Collect the PSS for later processing in GenerateCtrlCqiReport()
@@ -1878,15 +1966,17 @@ LteUePhy::RlfDetection (double sinrDb)
 
     // For MRO state
     /////
-    std::map <uint16_t, UeMeasurementsElement>::iterator it;
-    for (it = m_ueMeasurementsMap.begin (); it != m_ueMeasurementsMap.end(); it++){
-      double avg_rsrp = (*it).second.rsrpSum / (double)(*it).second.rsrpNum;
-      if((*it).first == m_cellId){
+    for (uint16_t measCellId = 0; measCellId < m_ueMeasurements.size (); measCellId++){
+      if (m_ueMeasurements[measCellId].rsrpNum == 0){
+        continue;
+      }
+      double avg_rsrp = m_ueMeasurements[measCellId].rsrpSum / (double)m_ueMeasurements[measCellId].rsrpNum;
+      if(measCellId == m_cellId){
         current_rsrp = avg_rsrp;
       }
       if(avg_rsrp > max_rsrp){
           max_rsrp = avg_rsrp;
-          max_cellId = (*it).first;
+          max_cellId = measCellId;
         }
       }
     
@@ -1898,12 +1988,14 @@ LteUePhy::RlfDetection (double sinrDb)
     // /////
 
     if (HandoverOccured == true){
-      std::map <uint16_t, UeMeasurementsElement>::iterator it;
-      for (it = m_ueMeasurementsMap.begin (); it != m_ueMeasurementsMap.end(); it++){
-        double avg_rsrp = (*it).second.rsrpSum / (double)(*it).second.rsrpNum;
+      for (uint16_t measCellId = 0; measCellId < m_ueMeasurements.size (); measCellId++){
+        if (m_ueMeasurements[measCellId].rsrpNum == 0){
+          continue;
+        }
+        double avg_rsrp = m_ueMeasurements[measCellId].rsrpSum / (double)m_ueMeasurements[measCellId].rsrpNum;
         if(avg_rsrp > max_rsrp){
           max_rsrp = avg_rsrp;
-          max_cellId = (*it).first;
+          max_cellId = measCellId;
         }
       }
 
@@ -36,8 +36,10 @@
 #include <ns3/ptr.h>
 #include <ns3/lte-amc.h>
 #include <set>
+#include <utility>
 #include <ns3/lte-ue-power-control.h>
 
+class LteUePhyRePowerTestCase;
 
 namespace ns3 {
 
@@ -58,6 +60,8 @@ class LteUePhy : public LtePhy
   friend class UeMemberLteUePhySapProvider;
   /// allow MemberLteUeCphySapProvider<LteUePhy> class friend access
   friend class MemberLteUeCphySapProvider<LteUePhy>;
+  /// allow LteUePhyRePowerTestCase class friend access
+  friend class ::LteUePhyRePowerTestCase;
 
 public:
   /**
@@ -247,6 +251,13 @@ public:
    * \param msgList LTE control message list
    */
   virtual void ReceiveLteControlMessageList (std::list<Ptr<LteControlMessage> > msgList);
+  /**
+   * \brief Receive the control messages of a DL control frame, reading
+   * only the DCIs of this UE and the messages addressed to all the UEs
+   *
+   * \param frame the control messages of the frame
+   */
+  virtual void ReceiveLteControlMessageFrame (Ptr<const LteControlMessageFrame> frame);
   /**
    * \brief Receive PSS function
    *
@@ -505,6 +516,13 @@ private:
    * \param [in] rbMap
    */
   void QueueSubChannelsForTransmission (std::vector <int> rbMap);
+  /**
+   * \brief Process a received control message, ignoring the DCIs of the
+   * other UEs
+   *
+   * \param [in] msg the control message
+   */
+  void ProcessLteControlMessage (Ptr<LteControlMessage> msg);
   /** 
    * \brief Get CQI, RSRP, and RSRQ
    *
@@ -514,6 +532,29 @@ private:
    * \param sinr 
    */
   void GenerateCqiRsrpRsrq (const SpectrumValue& sinr);
+  /**
+   * \brief Sum, over the RBs of a PSD, the linear power of one of their
+   *        resource elements
+   *
+   * The channel is flat within a RB, so that the power of a RE is the PSD
+   * times the RB bandwidth over its 12 subcarriers.
+   *
+   * \param psd the PSD [W/Hz]
+   * \return the sum of the RE powers [W]
+   */
+  static double SumRePower (const SpectrumValue& psd);
+  /**
+   * \brief Compute the RSSI of the RS, summed over the RBs
+   *
+   * The RSSI of a RB is the power of its 2 RS REs, of the serving cell
+   * plus the interference and noise; it does not depend on the measured
+   * cell.
+   *
+   * \param interference the interference plus noise PSD of the RS [W/Hz]
+   * \param signal the received PSD of the RS of the serving cell [W/Hz]
+   * \return the sum of the RSSI of the RBs [W]
+   */
+  static double ComputeRsRssi (const SpectrumValue& interference, const SpectrumValue& signal);
   /**
    * \brief Layer-1 filtering of RSRP and RSRQ measurements and reporting to
    *        the RRC entity.
@@ -522,6 +563,17 @@ private:
    * periodicity as indicated by the *UeMeasurementsFilterPeriod* attribute.
    */
   void ReportUeMeasurements ();
+  /**
+   * \brief Approximate the interference of the weakest neighbour cells by
+   *        a background, as configured by the *InterferenceCells* attribute.
+   *
+   * The *InterferenceCells* strongest neighbours remain simulated exactly;
+   * the interference of the others is replaced by a flat background of
+   * their total RSRP, i.e., assuming that they transmit on all the RBs.
+   *
+   * \param neighbours the RSRP (dBm) and cell ID of the measured neighbours
+   */
+  void UpdateInterferenceBackground (std::vector<std::pair<double, uint16_t> > &neighbours);
   /**
    * \brief Set the periodicty for the downlink periodic
    * wideband and aperiodic subband CQI reporting.
@@ -747,6 +799,8 @@ private:
   std::vector <int> m_subChannelsForTransmission;
   /// A list of sub channels to use in RX.
   std::vector <int> m_subChannelsForReception;
+  /// The TX PSD, memoized
+  TxPsdCacheEntry m_txPsdCache;
 
   std::vector< std::vector <int> > m_subChannelsForTransmissionQueue; ///< subchannels for transmission queue
 
@@ -822,7 +876,7 @@ private:
     double pssPsdSum; ///< PSS PSD sum
     uint16_t nRB; ///< number of RB
   };
-  std::list <PssElement> m_pssList; ///< PSS list
+  std::vector <PssElement> m_pssList; ///< PSS received in the current subframe
 
   /**
    * The `RsrqUeMeasThreshold` attribute. Receive threshold for PSS on RSRQ
@@ -841,14 +895,20 @@ private:
 
   /**
    * Store measurement results during the last layer-1 filtering period.
-   * Indexed by the cell ID where the measurements come from.
+   * Indexed by the cell ID where the measurements come from; the cells
+   * without RSRP sample in the period have not been measured.
    */
-  std::map <uint16_t, UeMeasurementsElement> m_ueMeasurementsMap;
+  std::vector <UeMeasurementsElement> m_ueMeasurements;
   /**
    * The `UeMeasurementsFilterPeriod` attribute. Time period for reporting UE
    * measurements, i.e., the length of layer-1 filtering (default 200 ms).
    */
   Time m_ueMeasurementsFilterPeriod;
+  /**
+   * The `InterferenceCells` attribute. Number of strongest neighbour cells
+   * whose DL data is simulated exactly, 0 for all of them.
+   */
+  uint16_t m_interferenceCells;
   /// \todo Can be removed.
   Time m_ueMeasurementsFilterLast;
 
@@ -40,6 +40,7 @@
 #include <ns3/lte-radio-bearer-info.h>
 
 #include <cmath>
+#include <algorithm>
 
 namespace ns3 {
 
@@ -554,6 +555,25 @@ LteUeRrc::GetPreviousCellId () const
   return m_previousCellId;
 }
 
+int8_t
+LteUeRrc::GetCellIndividualOffset (uint8_t cellIndex) const
+{
+  NS_LOG_FUNCTION (this << (uint16_t) cellIndex);
+  std::map<uint8_t, LteRrcSap::MeasObjectToAddMod>::const_iterator measObjectIt = m_varMeasConfig.measObjectList.find (1);
+  if (measObjectIt != m_varMeasConfig.measObjectList.end ())
+    {
+      const std::list<LteRrcSap::CellsToAddMod> &cells = measObjectIt->second.measObjectEutra.cellsToAddModList;
+      for (std::list<LteRrcSap::CellsToAddMod>::const_iterator it = cells.begin (); it != cells.end (); ++it)
+        {
+          if (it->cellIndex == cellIndex)
+            {
+              return it->cellIndividualOffset;
+            }
+        }
+    }
+  return 0;
+}
+
 void
 LteUeRrc::SetUseRlcSm (bool val)
 {
@@ -1684,9 +1704,8 @@ LteUeRrc::ApplyMeasConfig (LteRrcSap::MeasConfig mc)
        ++it)
     {
       // simplifying assumptions
-      NS_ASSERT_MSG (it->measObjectEutra.cellsToRemoveList.empty (), "cellsToRemoveList not supported");
       // NS_ASSERT_MSG (it->measObjectEutra.cellsToAddModList.empty (), "cellsToAddModList not supported");
-      NS_ASSERT_MSG (it->measObjectEutra.cellsToRemoveList.empty (), "blackCellsToRemoveList not supported");
+      NS_ASSERT_MSG (it->measObjectEutra.blackCellsToRemoveList.empty (), "blackCellsToRemoveList not supported");
       NS_ASSERT_MSG (it->measObjectEutra.blackCellsToAddModList.empty (), "blackCellsToAddModList not supported");
       NS_ASSERT_MSG (it->measObjectEutra.haveCellForWhichToReportCGI == false, "cellForWhichToReportCGI is not supported");
       // std::cout<<"Print MeasObjectEutra: " << it->measObjectEutra.cellsToAddModList.size()<<std::endl;
@@ -1702,7 +1721,45 @@ LteUeRrc::ApplyMeasConfig (LteRrcSap::MeasConfig mc)
       if (measObjectIt != m_varMeasConfig.measObjectList.end ())
         {
           NS_LOG_LOGIC ("measObjectId " << (uint32_t) measObjectId << " exists, updating entry");
+          // the cells of the cellsToRemoveList are removed, then the
+          // listed cells are added or modified, the others are kept
+          std::list<LteRrcSap::CellsToAddMod> cells = measObjectIt->second.measObjectEutra.cellsToAddModList;
+          for (std::list<uint8_t>::const_iterator removedIt = it->measObjectEutra.cellsToRemoveList.begin ();
+               removedIt != it->measObjectEutra.cellsToRemoveList.end (); ++removedIt)
+            {
+              std::list<LteRrcSap::CellsToAddMod>::iterator oldCellIt = cells.begin ();
+              while (oldCellIt != cells.end ())
+                {
+                  if (oldCellIt->cellIndex == *removedIt)
+                    {
+                      oldCellIt = cells.erase (oldCellIt);
+                    }
+                  else
+                    {
+                      ++oldCellIt;
+                    }
+                }
+            }
+          for (std::list<LteRrcSap::CellsToAddMod>::const_iterator cellIt = it->measObjectEutra.cellsToAddModList.begin ();
+               cellIt != it->measObjectEutra.cellsToAddModList.end (); ++cellIt)
+            {
+              std::list<LteRrcSap::CellsToAddMod>::iterator oldCellIt = cells.begin ();
+              while (oldCellIt != cells.end () && oldCellIt->cellIndex != cellIt->cellIndex)
+                {
+                  ++oldCellIt;
+                }
+              if (oldCellIt != cells.end ())
+                {
+                  *oldCellIt = *cellIt;
+                }
+              else
+                {
+                  cells.push_back (*cellIt);
+                }
+            }
           measObjectIt->second = *it;
+          measObjectIt->second.measObjectEutra.cellsToRemoveList.clear ();
+          measObjectIt->second.measObjectEutra.cellsToAddModList = cells;
           for (std::map<uint8_t, LteRrcSap::MeasIdToAddMod>::iterator measIdIt
                  = m_varMeasConfig.measIdList.begin ();
                measIdIt != m_varMeasConfig.measIdList.end ();
@@ -1969,6 +2026,10 @@ LteUeRrc::MeasurementReportTriggering (uint8_t measId)
   bool eventLeavingCondApplicable = false;
   ConcernedCells_t concernedCellsEntry;
   ConcernedCells_t concernedCellsLeaving;
+  // cells removed from the pending time-to-trigger events, in one pass
+  // over the events once all the cells have been evaluated
+  ConcernedCells_t cancelledCellsEntry;
+  ConcernedCells_t cancelledCellsLeaving;
 
   switch (reportConfigEutra.eventId)
     {
@@ -2185,6 +2246,34 @@ LteUeRrc::MeasurementReportTriggering (uint8_t measId)
                 break;
             }
 
+          // cell individual offsets of the SON measurement object, indexed
+          // by cell index, looked up once for all the neighbours; the last
+          // entry of a cell index wins and a neighbour without entry keeps
+          // the offset of the previous one, as in the per-neighbour lookup
+          std::vector<int8_t> cellCio;
+          std::vector<bool> hasCellCio;
+          std::map<uint8_t, LteRrcSap::MeasObjectToAddMod>::const_iterator cioObjectIt =
+            m_varMeasConfig.measObjectList.find (1);
+          if (cioObjectIt != m_varMeasConfig.measObjectList.end ())
+            {
+              const std::list<LteRrcSap::CellsToAddMod> &cells = cioObjectIt->second.measObjectEutra.cellsToAddModList;
+              for (std::list<LteRrcSap::CellsToAddMod>::const_iterator cellIt = cells.begin ();
+                   cellIt != cells.end (); ++cellIt)
+                {
+                  if (cellIt->cellIndex >= cellCio.size ())
+                    {
+                      cellCio.resize (cellIt->cellIndex + 1, 0);
+                      hasCellCio.resize (cellIt->cellIndex + 1, false);
+                    }
+                  cellCio[cellIt->cellIndex] = cellIt->cellIndividualOffset;
+                  hasCellCio[cellIt->cellIndex] = true;
+                }
+            }
+          if (m_cellId < hasCellCio.size () && hasCellCio[m_cellId])
+            {
+              ocp = cellCio[m_cellId];
+            }
+
           for (std::map<uint16_t, MeasValues>::iterator storedMeasIt = m_storedMeasValues.begin ();
                storedMeasIt != m_storedMeasValues.end ();
                ++storedMeasIt)
@@ -2194,19 +2283,10 @@ LteUeRrc::MeasurementReportTriggering (uint8_t measId)
                 {
                   continue;
                 }
-            std::list<LteRrcSap::CellsToAddMod> m_var_temp = m_varMeasConfig.measObjectList[1].measObjectEutra.cellsToAddModList;
-    
-            for (std::list<LteRrcSap::CellsToAddMod>::iterator iter_temp = m_var_temp.begin(); 
-            iter_temp != m_var_temp.end(); ++iter_temp){
-              // std::cout <<"CellsToAddModUE "<<"["<<int(iter_temp->cellIndex)<<" "<<int(iter_temp->cellIndividualOffset) <<"]"<<std::endl;
-              if (iter_temp->cellIndex == m_cellId){
-                ocp = iter_temp->cellIndividualOffset;
-              }
-              else if (iter_temp->cellIndex == cellId){
-                ocn = iter_temp->cellIndividualOffset;
-              }
-
-            }
+              if (cellId < hasCellCio.size () && hasCellCio[cellId])
+                {
+                  ocn = cellCio[cellId];
+                }
               switch (reportConfigEutra.triggerQuantity)
                 {
                   case LteRrcSap::ReportConfigEutra::RSRP:
@@ -2238,7 +2318,7 @@ LteUeRrc::MeasurementReportTriggering (uint8_t measId)
               // else if (reportConfigEutra.timeToTrigger > 0)
               else if (Ttt > 0) // New, TTT
                 {
-                  CancelEnteringTrigger (measId, cellId);
+                  cancelledCellsEntry.push_back (cellId);
                 }
 
               // Inequality A3-2 (Leaving condition): Mn + Ofn + Ocn + Hys < Mp + Ofp + Ocp + Off
@@ -2255,7 +2335,7 @@ LteUeRrc::MeasurementReportTriggering (uint8_t measId)
               // else if (reportConfigEutra.timeToTrigger > 0)
               else if (Ttt > 0) // New, TTT
                 {
-                  CancelLeavingTrigger (measId, cellId);
+                  cancelledCellsLeaving.push_back (cellId);
                 }
 
               NS_LOG_LOGIC (this << " event A3: neighbor cell " << cellId
@@ -2340,7 +2420,7 @@ LteUeRrc::MeasurementReportTriggering (uint8_t measId)
                 }
               else if (reportConfigEutra.timeToTrigger > 0)
                 {
-                  CancelEnteringTrigger (measId, cellId);
+                  cancelledCellsEntry.push_back (cellId);
                 }
 
               // Inequality A4-2 (Leaving condition): Mn + Ofn + Ocn + Hys < Thresh
@@ -2356,7 +2436,7 @@ LteUeRrc::MeasurementReportTriggering (uint8_t measId)
                 }
               else if (reportConfigEutra.timeToTrigger > 0)
                 {
-                  CancelLeavingTrigger (measId, cellId);
+                  cancelledCellsLeaving.push_back (cellId);
                 }
 
               NS_LOG_LOGIC (this << " event A4: neighbor cell " << cellId
@@ -2458,7 +2538,7 @@ LteUeRrc::MeasurementReportTriggering (uint8_t measId)
                     }
                   else if (reportConfigEutra.timeToTrigger > 0)
                     {
-                      CancelEnteringTrigger (measId, cellId);
+                      cancelledCellsEntry.push_back (cellId);
                     }
 
                   NS_LOG_LOGIC (this << " event A5: neighbor cell " << cellId
@@ -2547,7 +2627,7 @@ LteUeRrc::MeasurementReportTriggering (uint8_t measId)
 
                               if (!leavingCond)
                                 {
-                                  CancelLeavingTrigger (measId, cellId);
+                                  cancelledCellsLeaving.push_back (cellId);
                                 }
 
                               /*
@@ -2645,6 +2725,15 @@ LteUeRrc::MeasurementReportTriggering (uint8_t measId)
 
     } // switch (event type)
 
+  if (!cancelledCellsEntry.empty ())
+    {
+      CancelEnteringTrigger (measId, cancelledCellsEntry);
+    }
+  if (!cancelledCellsLeaving.empty ())
+    {
+      CancelLeavingTrigger (measId, cancelledCellsLeaving);
+    }
+
   NS_LOG_LOGIC (this << " eventEntryCondApplicable=" << eventEntryCondApplicable
                      << " eventLeavingCondApplicable=" << eventLeavingCondApplicable);
 
@@ -2738,38 +2827,18 @@ void
 LteUeRrc::CancelEnteringTrigger (uint8_t measId, uint16_t cellId)
 {
   NS_LOG_FUNCTION (this << (uint16_t) measId << cellId);
+  CancelEnteringTrigger (measId, ConcernedCells_t (1, cellId));
+}
+
+void
+LteUeRrc::CancelEnteringTrigger (uint8_t measId, const ConcernedCells_t &cellIds)
+{
+  NS_LOG_FUNCTION (this << (uint16_t) measId << cellIds.size ());
 
   std::map<uint8_t, std::list<PendingTrigger_t> >::iterator
     it1 = m_enteringTriggerQueue.find (measId);
   NS_ASSERT (it1 != m_enteringTriggerQueue.end ());
-
-  std::list<PendingTrigger_t>::iterator it2 = it1->second.begin ();
-  while (it2 != it1->second.end ())
-    {
-      NS_ASSERT (it2->measId == measId);
-
-      ConcernedCells_t::iterator it3;
-      for (it3 = it2->concernedCells.begin ();
-           it3 != it2->concernedCells.end (); ++it3)
-        {
-          if (*it3 == cellId)
-            {
-              it3 = it2->concernedCells.erase (it3);
-            }
-        }
-
-      if (it2->concernedCells.empty ())
-        {
-          NS_LOG_LOGIC (this << " canceling entering time-to-trigger event at "
-                             << Simulator::GetDelayLeft (it2->timer).GetSeconds ());
-          Simulator::Cancel (it2->timer);
-          it2 = it1->second.erase (it2);
-        }
-      else
-        {
-          it2++;
-        }
-    }
+  CancelTriggers (it1->second, cellIds, "entering");
 }
 
 void
@@ -2800,32 +2869,57 @@ void
 LteUeRrc::CancelLeavingTrigger (uint8_t measId, uint16_t cellId)
 {
   NS_LOG_FUNCTION (this << (uint16_t) measId << cellId);
+  CancelLeavingTrigger (measId, ConcernedCells_t (1, cellId));
+}
+
+void
+LteUeRrc::CancelLeavingTrigger (uint8_t measId, const ConcernedCells_t &cellIds)
+{
+  NS_LOG_FUNCTION (this << (uint16_t) measId << cellIds.size ());
 
   std::map<uint8_t, std::list<PendingTrigger_t> >::iterator
     it1 = m_leavingTriggerQueue.find (measId);
   NS_ASSERT (it1 != m_leavingTriggerQueue.end ());
+  CancelTriggers (it1->second, cellIds, "leaving");
+}
 
-  std::list<PendingTrigger_t>::iterator it2 = it1->second.begin ();
-  while (it2 != it1->second.end ())
+void
+LteUeRrc::CancelTriggers (std::list<PendingTrigger_t> &triggers,
+                          const ConcernedCells_t &cellIds, const char *kind)
+{
+  NS_LOG_FUNCTION (this << cellIds.size () << kind);
+  if (triggers.empty ())
     {
-      NS_ASSERT (it2->measId == measId);
+      return;
+    }
+
+  // sorted once, so that each cell of the triggers is looked up in
+  // logarithmic time instead of by a scan of the removed cells
+  std::vector<uint16_t> removed (cellIds.begin (), cellIds.end ());
+  std::sort (removed.begin (), removed.end ());
 
-      ConcernedCells_t::iterator it3;
-      for (it3 = it2->concernedCells.begin ();
-           it3 != it2->concernedCells.end (); ++it3)
+  std::list<PendingTrigger_t>::iterator it2 = triggers.begin ();
+  while (it2 != triggers.end ())
+    {
+      ConcernedCells_t::iterator it3 = it2->concernedCells.begin ();
+      while (it3 != it2->concernedCells.end ())
         {
-          if (*it3 == cellId)
+          if (std::binary_search (removed.begin (), removed.end (), *it3))
             {
               it3 = it2->concernedCells.erase (it3);
             }
+          else
+            {
+              ++it3;
+            }
         }
 
       if (it2->concernedCells.empty ())
         {
-          NS_LOG_LOGIC (this << " canceling leaving time-to-trigger event at "
+          NS_LOG_LOGIC (this << " canceling " << kind << " time-to-trigger event at "
                              << Simulator::GetDelayLeft (it2->timer).GetSeconds ());
           Simulator::Cancel (it2->timer);
-          it2 = it1->second.erase (it2);
+          it2 = triggers.erase (it2);
         }
       else
         {
@@ -45,6 +45,8 @@
 #define MIN_NO_CC 1
 #define MAX_NO_CC 5 // this is the maximum number of carrier components allowed by 3GPP up to R13
 
+class LteUeRrcCancelTriggerTestCase;
+
 namespace ns3 {
 
 
@@ -91,6 +93,8 @@ class LteUeRrc : public Object
   friend class MemberLteAsSapProvider<LteUeRrc>;
   /// allow MemberLteUeCphySapUser<LteUeRrc> class friend access
   friend class MemberLteUeCphySapUser<LteUeRrc>;
+  /// allow LteUeRrcCancelTriggerTestCase class friend access
+  friend class ::LteUeRrcCancelTriggerTestCase;
   /// allow MemberLteUeRrcSapProvider<LteUeRrc> class friend access
   friend class MemberLteUeRrcSapProvider<LteUeRrc>;
   /// allow MemberLteUeCcmRrcSapUser<LteUeRrc> class friend access
@@ -337,6 +341,15 @@ public:
    */
   uint16_t GetPreviousCellId () const;
 
+  /**
+   * \brief Get the cell individual offset of a cell
+   *
+   * \param cellIndex the index of the cell in the measurement object
+   * \return the cell individual offset configured for the cell, 0 if the
+   * cell is not configured
+   */
+  int8_t GetCellIndividualOffset (uint8_t cellIndex) const;
+
   /** 
    * 
    * 
@@ -1203,6 +1216,19 @@ private:
    */
   void CancelEnteringTrigger (uint8_t measId, uint16_t cellId);
 
+  /**
+   * \brief Remove several cells from the waiting triggers in
+   *        #m_enteringTriggerQueue which belong to the given measurement
+   *        identity, in one pass over the triggers.
+   * \param measId the measurement identity to be processed, must already exists
+   *               in #m_enteringTriggerQueue, otherwise an error would be
+   *               raised
+   * \param cellIds the cell IDs to be removed from the waiting triggers
+   *
+   * \sa LteUeRrc::CancelEnteringTrigger (uint8_t measId, uint16_t cellId)
+   */
+  void CancelEnteringTrigger (uint8_t measId, const ConcernedCells_t &cellIds);
+
   /**
    * \brief Clear all the waiting triggers in #m_leavingTriggerQueue which are
    *        associated with the given measurement identity.
@@ -1243,6 +1269,30 @@ private:
    */
   void CancelLeavingTrigger (uint8_t measId, uint16_t cellId);
 
+  /**
+   * \brief Remove several cells from the waiting triggers in
+   *        #m_leavingTriggerQueue which belong to the given measurement
+   *        identity, in one pass over the triggers.
+   * \param measId the measurement identity to be processed, must already exists
+   *               in #m_leavingTriggerQueue, otherwise an error would be
+   *               raised
+   * \param cellIds the cell IDs to be removed from the waiting triggers
+   *
+   * \sa LteUeRrc::CancelLeavingTrigger (uint8_t measId, uint16_t cellId)
+   */
+  void CancelLeavingTrigger (uint8_t measId, const ConcernedCells_t &cellIds);
+
+  /**
+   * \brief Remove several cells from waiting triggers, and cancel the
+   *        triggers left without cell, in time linear in the number of
+   *        cells of the triggers once the removed cells are sorted.
+   * \param triggers the waiting triggers of a measurement identity
+   * \param cellIds the cell IDs to be removed from the waiting triggers
+   * \param kind the kind of the triggers, "entering" or "leaving", for the log
+   */
+  void CancelTriggers (std::list<PendingTrigger_t> &triggers,
+                       const ConcernedCells_t &cellIds, const char *kind);
+
   /**
    * The `T300` attribute. Timer for RRC connection establishment procedure
    * (i.e., the procedure is deemed as failed if it takes longer than this).
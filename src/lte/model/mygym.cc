@@ -36,8 +36,12 @@
 #include <ns3/lte-common.h>
 #include "ns3/lte-enb-rrc.h"
 
+#include <ns3/a3-rsrp-table-handover-algorithm.h>
+
 #include <ns3/cell-individual-offset.h>
 
+#include "ns3/metrics-registry.h"
+
 #include <stdlib.h>
 
 #include <typeinfo>
@@ -85,8 +89,64 @@ namespace ns3 {
     MyGymEnv::ScheduleNextStateRead() {
         NS_LOG_FUNCTION(this);
         Simulator::Schedule(Seconds(m_interval), & MyGymEnv::ScheduleNextStateRead, this);
-        Notify();
+        if (m_qTablePolicy) {
+            ApplyQTablePolicy();
+        } else {
+            Notify();
+        }
+    }
+
+    /**
+     * \param obs the observation
+     * \param key the key of a box of the observation
+     * \return the values of the box, whatever its data type
+     */
+    static std::vector < float >
+    GetBoxValues(Ptr < OpenGymDictContainer > obs, std::string key) {
+        Ptr < OpenGymDataContainer > data = obs -> Get(key);
+        std::vector < float > values;
+        Ptr < OpenGymBoxContainer < float > > floatBox = DynamicCast < OpenGymBoxContainer < float > > (data);
+        Ptr < OpenGymBoxContainer < double > > doubleBox = DynamicCast < OpenGymBoxContainer < double > > (data);
+        if (floatBox) {
+            values = floatBox -> GetData();
+        } else if (doubleBox) {
+            std::vector < double > doubles = doubleBox -> GetData();
+            values.assign(doubles.begin(), doubles.end());
+        } else {
+            NS_FATAL_ERROR("no float or double box " << key << " in the observation");
+        }
+        return values;
     }
+
+    void
+    MyGymEnv::ApplyQTablePolicy() {
+        NS_LOG_FUNCTION(this);
+        NS_ABORT_MSG_IF(m_qTablePolicy -> GetNCells() != m_enbs.size(),
+            "the Q-table policy has " << m_qTablePolicy -> GetNCells() << " cells, the scenario " << m_enbs.size());
+        if (!m_agentPolicy) {
+            m_agentPolicy = Create < Slc2AgentPolicy > (m_qTablePolicy, m_dqnCoordinator);
+        }
+        // same sequence as OpenGymInterface::Notify, GetReward resets the step counters
+        Ptr < OpenGymDictContainer > obs = DynamicCast < OpenGymDictContainer > (GetObservation());
+        GetReward();
+        uint32_t nCells = m_qTablePolicy -> GetNCells();
+        std::vector < float > observations;
+        if (m_dqnCoordinator) {
+            const char * keys[3] = { "AvgCqi", "dlPrbusage", "enbBestCell" };
+            for (uint32_t k = 0; k < 3; k++) {
+                std::vector < float > values = GetBoxValues(obs, keys[k]);
+                NS_ABORT_MSG_IF(values.size() < nCells, "too few values in the " << keys[k] << " observation");
+                observations.insert(observations.end(), values.begin(), values.begin() + nCells);
+            }
+        }
+        const std::vector < float > & chosenAction = m_agentPolicy -> Step(GetBoxValues(obs, "enbMLBstate"),
+            GetBoxValues(obs, "AverageVelocity"), observations);
+        std::vector < uint32_t > shape = { 3 * nCells, };
+        Ptr < OpenGymBoxContainer < float > > action = CreateObject < OpenGymBoxContainer < float > > (shape);
+        action -> SetData(chosenAction);
+        ExecuteActions(action);
+    }
+
     void
     MyGymEnv::Start_Collecting() {
         NS_LOG_FUNCTION(this);
@@ -103,13 +163,87 @@ namespace ns3 {
         static TypeId tid = TypeId("MyGymEnv")
             .SetParent < OpenGymEnv > ()
             .SetGroupName("OpenGym")
-            .AddConstructor < MyGymEnv > ();
+            .AddConstructor < MyGymEnv > ()
+            .AddAttribute("ReportMetrics",
+                "If true, time the simulator hot paths and report a snapshot of "
+                "the MetricsRegistry counters and histograms as extra info at every step, "
+                "with the increments since the previous step of this environment.",
+                BooleanValue(false),
+                MakeBooleanAccessor(& MyGymEnv::SetReportMetrics, & MyGymEnv::GetReportMetrics),
+                MakeBooleanChecker())
+            .AddAttribute("QTablePolicy",
+                "The binary Q-table policy file (see QTablePolicy). If not empty, the "
+                "greedy MLB and MRO actions of the tables are applied at every step, "
+                "with the step logic of the agents (see Slc2AgentPolicy), in place of "
+                "the actions of the agent, which is not notified.",
+                StringValue(""),
+                MakeStringAccessor(& MyGymEnv::SetQTablePolicy, & MyGymEnv::GetQTablePolicy),
+                MakeStringChecker())
+            .AddAttribute("DqnCoordinator",
+                "The binary DQN file (see DqnPolicy) of the coordinator, which chooses, "
+                "cell by cell, between the new actions of the QTablePolicy and the "
+                "previous ones. If empty, the new actions are always applied.",
+                StringValue(""),
+                MakeStringAccessor(& MyGymEnv::SetDqnCoordinator, & MyGymEnv::GetDqnCoordinator),
+                MakeStringChecker());
         return tid;
     }
 
+    void
+    MyGymEnv::SetReportMetrics(bool reportMetrics) {
+        NS_LOG_FUNCTION(this << reportMetrics);
+        // the reader of this environment does not reset the metrics of the others
+        if (reportMetrics != (m_metricsReader != 0)) {
+            m_metricsReader = reportMetrics ? Create < MetricsReader > () : 0;
+        }
+    }
+
+    bool
+    MyGymEnv::GetReportMetrics() const {
+        return m_metricsReader != 0;
+    }
+
+    void
+    MyGymEnv::SetQTablePolicy(std::string filename) {
+        NS_LOG_FUNCTION(this << filename);
+        m_qTablePolicyFile = filename;
+        m_qTablePolicy = 0;
+        m_agentPolicy = 0;
+        if (!filename.empty()) {
+            m_qTablePolicy = Create < QTablePolicy > ();
+            NS_ABORT_MSG_IF(!m_qTablePolicy -> Load(filename), "cannot load the Q-table policy " << filename);
+        }
+    }
+
+    std::string
+    MyGymEnv::GetQTablePolicy() const {
+        return m_qTablePolicyFile;
+    }
+
+    void
+    MyGymEnv::SetDqnCoordinator(std::string filename) {
+        NS_LOG_FUNCTION(this << filename);
+        m_dqnCoordinatorFile = filename;
+        m_dqnCoordinator = 0;
+        m_agentPolicy = 0;
+        if (!filename.empty()) {
+            m_dqnCoordinator = Create < DqnPolicy > ();
+            NS_ABORT_MSG_IF(!m_dqnCoordinator -> Load(filename), "cannot load the DQN coordinator " << filename);
+        }
+    }
+
+    std::string
+    MyGymEnv::GetDqnCoordinator() const {
+        return m_dqnCoordinatorFile;
+    }
+
     void
     MyGymEnv::DoDispose() {
         NS_LOG_FUNCTION(this);
+        m_qTablePolicy = 0;
+        m_dqnCoordinator = 0;
+        m_agentPolicy = 0;
+        m_metricsReader = 0;
     }
     
     void 
@@ -1248,7 +1382,11 @@ namespace ns3 {
     std::string
     MyGymEnv::GetExtraInfo() {
         NS_LOG_FUNCTION(this);
-        return "";
+        if (!m_metricsReader) {
+            return "";
+        }
+        // metrics of the interval since the previous step
+        return m_metricsReader -> Snapshot();
     }
 
     bool
@@ -1267,6 +1405,7 @@ namespace ns3 {
             // QLB Action
             /////////////////
             std::list<LteRrcSap::CellsToAddMod> celllist_temp;
+            std::vector<double> cios;
 
             for(uint32_t i = 0; i < nodeNum; i++){
                 LteRrcSap::CellsToAddMod cell_temp;
@@ -1280,10 +1419,34 @@ namespace ns3 {
                 std::cout<<"Cell "<<i+1<<"  new CIO: "<<int(cio)<<std::endl;
 
                 celllist_temp.push_back(cell_temp);
+                cios.push_back(cio);
                 
             }
+            // the eNBs evaluating Event A3 themselves take the CIOs and the
+            // HOM and TTT of their UEs without any RRC reconfiguration
+            std::map<uint32_t, Ptr<A3RsrpTableHandoverAlgorithm>> a3TableAlgorithms;
+            // the eNBs installed by the same LteHelper share their table of
+            // offsets with their handover algorithms, so it is only updated once
+            Ptr<CellIndividualOffset> cioTable;
+            if (!m_enbs.empty()) {
+                cioTable = m_enbs.begin()->second->GetRrc()->GetCellIndividualOffsetTable();
+            }
+            if (cioTable != 0) {
+                cioTable->SetOffsetList(cios);
+            }
             for (std::map<uint32_t, Ptr<LteEnbNetDevice>>::iterator iter = m_enbs.begin(); iter != m_enbs.end(); ++iter){
-                iter->second->m_rrc->setCellstoAddModList(celllist_temp);
+                NS_ASSERT_MSG(iter->second->GetRrc()->GetCellIndividualOffsetTable() == cioTable,
+                    "the eNBs do not share their table of cell individual offsets");
+                if (cioTable == 0) {
+                    iter->second->m_rrc->setCellstoAddModList(celllist_temp);
+                }
+                PointerValue handoverAlgorithm;
+                iter->second->GetAttribute("LteHandoverAlgorithm", handoverAlgorithm);
+                Ptr<A3RsrpTableHandoverAlgorithm> a3TableAlgorithm = handoverAlgorithm.Get<A3RsrpTableHandoverAlgorithm>();
+                if (a3TableAlgorithm != 0) {
+                    a3TableAlgorithms[iter->first] = a3TableAlgorithm;
+                    continue;
+                }
                 std::map<uint16_t, Ptr<UeManager>> m_UeMap = iter->second->GetRrc()->m_ueMap;
                 for(auto iter2 = m_UeMap.begin(); iter2 != m_UeMap.end(); iter2++)
                 {
@@ -1353,10 +1516,16 @@ namespace ns3 {
                     
                     UeActions[2*Imsi_actions] = HOM;
                     UeActions[2*Imsi_actions+1] = TTT*mappedVelocity;
+
+                    std::map<uint32_t, Ptr<A3RsrpTableHandoverAlgorithm>>::iterator a3TableIt = a3TableAlgorithms.find(iter->first);
+                    if (a3TableIt != a3TableAlgorithms.end()) {
+                        uint16_t ueTtt = UeActions[2*Imsi_actions+1];
+                        a3TableIt->second->SetUeParameters(iter2->first, HOM, MilliSeconds(ueTtt));
+                    }
                 }
             }
 
-            for (std::map<uint64_t, Ptr<LteUeNetDevice>>::iterator iter = m_ues.begin(); iter != m_ues.end(); ++iter)
+            for (std::map<uint64_t, Ptr<LteUeNetDevice>>::iterator iter = m_ues.begin(); iter != m_ues.end() && a3TableAlgorithms.size() < m_enbs.size(); ++iter)
             {
                 uint64_t imsi = (iter->first)-1;
                 double HOM = UeActions[2*imsi];
@@ -38,9 +38,13 @@
 #include "ns3/lte-ue-net-device.h"
 #include "ns3/lte-ue-rrc.h"
 #include "ns3/radio-bearer-stats-calculator.h"
+#include "ns3/metrics-registry.h"
 
 #include "ns3/nstime.h"
 #include "ns3/ff-mac-scheduler.h"
+#include "ns3/q-table-policy.h"
+#include "ns3/dqn-policy.h"
+#include "ns3/slc2-agent-policy.h"
 namespace ns3 {
 
     class MyGymEnv: public OpenGymEnv {
@@ -66,8 +70,15 @@ namespace ns3 {
             void AddNewUe(uint64_t imsi, Ptr<LteUeNetDevice> dev);
             
             void GetRlcStats(Ptr<RadioBearerStatsCalculator> m_rlcStats); // NS-3 SON
+            void SetReportMetrics(bool reportMetrics);
+            bool GetReportMetrics() const;
+            void SetQTablePolicy(std::string filename);
+            std::string GetQTablePolicy() const;
+            void SetDqnCoordinator(std::string filename);
+            std::string GetDqnCoordinator() const;
 
             private: void ScheduleNextStateRead();
+            void ApplyQTablePolicy();
             void Start_Collecting();
             static uint8_t Convert2ITB(uint8_t MCSidx);
             static uint8_t GetnRB(uint8_t iTB, uint16_t tbSize);
@@ -81,6 +92,12 @@ namespace ns3 {
             uint32_t m_port;
             uint32_t m_nRBTotal;
             uint8_t m_chooseReward;
+            Ptr<MetricsReader> m_metricsReader; // reader of the MetricsRegistry snapshots reported as extra info, if any
+            std::string m_qTablePolicyFile; // binary Q-table policy file, empty if the agent acts
+            Ptr<QTablePolicy> m_qTablePolicy; // Q-table policy acting in place of the agent
+            std::string m_dqnCoordinatorFile; // binary DQN file of the coordinator, empty if none
+            Ptr<DqnPolicy> m_dqnCoordinator; // coordinator of the Q-table policy actions
+            Ptr<Slc2AgentPolicy> m_agentPolicy; // step logic of the agents with the Q-table policy and coordinator
             int RLF_Counter = 0 ; //kihoon 0523
             int Pingpong_Counter = 0; //kihoon 0523
             int Step_Counter = 0; //kihoon 0523
@@ -0,0 +1,355 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "q-table-policy.h"
+
+#include <ns3/log.h>
+#include <ns3/abort.h>
+#include <ns3/little-endian.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("QTablePolicy");
+
+/// Magic number of the binary files
+static const char Q_TABLE_MAGIC[4] = { 'S', 'L', 'C', 'Q' };
+/// Version of the binary format
+static const uint32_t Q_TABLE_VERSION = 1;
+
+const double QTablePolicy::HOM_VALUES[QTablePolicy::N_HOM] = { 0, 1, 2, 3, 4, 5, 6 };
+const uint16_t QTablePolicy::TTT_VALUES[QTablePolicy::N_TTT] = { 100, 128, 256, 320, 480, 512, 640 };
+
+/**
+ * Write a double as a 64-bit IEEE 754 value in little endian order.
+ *
+ * \param os the output stream
+ * \param d the value
+ */
+static void
+WriteDouble (std::ostream &os, double d)
+{
+  uint64_t v;
+  std::memcpy (&v, &d, sizeof (v));
+  unsigned char b[8];
+  for (uint32_t i = 0; i < 8; ++i)
+    {
+      b[i] = (v >> (8 * i)) & 0xff;
+    }
+  os.write (reinterpret_cast<const char *> (b), 8);
+}
+
+/**
+ * Read a 64-bit IEEE 754 value in little endian order.
+ *
+ * \param is the input stream
+ * \param [out] d the value
+ * \return false on a read error
+ */
+static bool
+ReadDouble (std::istream &is, double &d)
+{
+  unsigned char b[8];
+  if (!is.read (reinterpret_cast<char *> (b), 8))
+    {
+      return false;
+    }
+  uint64_t v = 0;
+  for (uint32_t i = 0; i < 8; ++i)
+    {
+      v |= static_cast<uint64_t> (b[i]) << (8 * i);
+    }
+  std::memcpy (&d, &v, sizeof (d));
+  return true;
+}
+
+QTablePolicy::QTablePolicy ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+bool
+QTablePolicy::ReadCsv (std::string filename, Table &table)
+{
+  NS_LOG_FUNCTION (filename);
+  std::ifstream ifs (filename.c_str ());
+  if (!ifs.is_open ())
+    {
+      NS_LOG_ERROR ("cannot open " << filename);
+      return false;
+    }
+  table.nStates = 0;
+  table.nActions = 0;
+  table.q.clear ();
+  std::string line;
+  while (std::getline (ifs, line))
+    {
+      if (line.find_first_not_of (" \t\r") == std::string::npos)
+        {
+          continue;
+        }
+      uint32_t nValues = 0;
+      const char *p = line.c_str ();
+      while (true)
+        {
+          char *end;
+          double v = std::strtod (p, &end);
+          if (end == p)
+            {
+              NS_LOG_ERROR (filename << ": invalid value in row " << table.nStates);
+              return false;
+            }
+          table.q.push_back (v);
+          ++nValues;
+          p = end + std::strspn (end, " \t\r");
+          if (*p == '\0')
+            {
+              break;
+            }
+          if (*p != ',')
+            {
+              NS_LOG_ERROR (filename << ": invalid separator in row " << table.nStates);
+              return false;
+            }
+          ++p;
+        }
+      if (table.nStates > 0 && nValues != table.nActions)
+        {
+          NS_LOG_ERROR (filename << ": row " << table.nStates << " has " << nValues
+                                 << " values instead of " << table.nActions);
+          return false;
+        }
+      table.nActions = nValues;
+      ++table.nStates;
+    }
+  if (table.nStates == 0)
+    {
+      NS_LOG_ERROR (filename << ": empty table");
+      return false;
+    }
+  return true;
+}
+
+void
+QTablePolicy::ComputeGreedyActions (Table &table)
+{
+  table.best.resize (table.nStates);
+  for (uint32_t s = 0; s < table.nStates; ++s)
+    {
+      const double *row = &table.q[s * table.nActions];
+      uint32_t best = 0;
+      for (uint32_t a = 0; a < table.nActions; ++a)
+        {
+          // as numpy.argmax, the first NaN, if any, is the maximum
+          if (row[a] != row[a])
+            {
+              best = a;
+              break;
+            }
+          if (row[a] > row[best])
+            {
+              best = a;
+            }
+        }
+      table.best[s] = best;
+    }
+}
+
+bool
+QTablePolicy::SetTables (std::vector<Table> &mlb, std::vector<Table> &mro)
+{
+  NS_LOG_FUNCTION (this);
+  if (mlb.size () != mro.size () || mlb.empty ())
+    {
+      NS_LOG_ERROR ("the numbers of MLB and MRO tables differ or are zero");
+      return false;
+    }
+  for (uint32_t c = 0; c < mlb.size (); ++c)
+    {
+      if (mlb[c].nActions % 2 == 0 || mlb[c].nActions > 255)
+        {
+          NS_LOG_ERROR ("MLB table of cell " << c << " has " << mlb[c].nActions
+                                             << " actions, which are not centered CIOs");
+          return false;
+        }
+      if (mro[c].nActions != N_HOM * N_TTT)
+        {
+          NS_LOG_ERROR ("MRO table of cell " << c << " has " << mro[c].nActions
+                                             << " actions instead of " << N_HOM * N_TTT);
+          return false;
+        }
+      ComputeGreedyActions (mlb[c]);
+      ComputeGreedyActions (mro[c]);
+    }
+  m_mlb.swap (mlb);
+  m_mro.swap (mro);
+  return true;
+}
+
+bool
+QTablePolicy::ImportCsv (const std::vector<std::string> &mlbFiles,
+                         const std::vector<std::string> &mroFiles)
+{
+  NS_LOG_FUNCTION (this);
+  std::vector<Table> mlb (mlbFiles.size ());
+  std::vector<Table> mro (mroFiles.size ());
+  for (uint32_t c = 0; c < mlbFiles.size (); ++c)
+    {
+      if (!ReadCsv (mlbFiles[c], mlb[c]))
+        {
+          return false;
+        }
+    }
+  for (uint32_t c = 0; c < mroFiles.size (); ++c)
+    {
+      if (!ReadCsv (mroFiles[c], mro[c]))
+        {
+          return false;
+        }
+    }
+  return SetTables (mlb, mro);
+}
+
+bool
+QTablePolicy::Load (std::string filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  std::ifstream ifs (filename.c_str (), std::ios::binary);
+  if (!ifs.is_open ())
+    {
+      NS_LOG_ERROR ("cannot open " << filename);
+      return false;
+    }
+  char magic[4];
+  uint32_t version;
+  uint32_t nCells;
+  if (!ifs.read (magic, 4) || std::memcmp (magic, Q_TABLE_MAGIC, 4) != 0
+      || !LittleEndian::ReadU32 (ifs, version) || version != Q_TABLE_VERSION
+      || !LittleEndian::ReadU32 (ifs, nCells))
+    {
+      NS_LOG_ERROR (filename << ": not a Q-table policy file of version " << Q_TABLE_VERSION);
+      return false;
+    }
+  std::vector<Table> mlb (nCells);
+  std::vector<Table> mro (nCells);
+  for (uint32_t c = 0; c < nCells; ++c)
+    {
+      Table *tables[2] = { &mlb[c], &mro[c] };
+      for (uint32_t t = 0; t < 2; ++t)
+        {
+          Table &table = *tables[t];
+          if (!LittleEndian::ReadU32 (ifs, table.nStates)
+              || !LittleEndian::ReadU32 (ifs, table.nActions)
+              || table.nStates == 0 || table.nActions == 0)
+            {
+              NS_LOG_ERROR (filename << ": invalid table of cell " << c);
+              return false;
+            }
+          table.q.resize (static_cast<size_t> (table.nStates) * table.nActions);
+          for (size_t i = 0; i < table.q.size (); ++i)
+            {
+              if (!ReadDouble (ifs, table.q[i]))
+                {
+                  NS_LOG_ERROR (filename << ": truncated table of cell " << c);
+                  return false;
+                }
+            }
+        }
+    }
+  return SetTables (mlb, mro);
+}
+
+bool
+QTablePolicy::Save (std::string filename) const
+{
+  NS_LOG_FUNCTION (this << filename);
+  std::ofstream ofs (filename.c_str (), std::ios::binary | std::ios::trunc);
+  if (!ofs.is_open ())
+    {
+      NS_LOG_ERROR ("cannot open " << filename);
+      return false;
+    }
+  ofs.write (Q_TABLE_MAGIC, 4);
+  LittleEndian::WriteU32 (ofs, Q_TABLE_VERSION);
+  LittleEndian::WriteU32 (ofs, m_mlb.size ());
+  for (uint32_t c = 0; c < m_mlb.size (); ++c)
+    {
+      const Table *tables[2] = { &m_mlb[c], &m_mro[c] };
+      for (uint32_t t = 0; t < 2; ++t)
+        {
+          LittleEndian::WriteU32 (ofs, tables[t]->nStates);
+          LittleEndian::WriteU32 (ofs, tables[t]->nActions);
+          for (size_t i = 0; i < tables[t]->q.size (); ++i)
+            {
+              WriteDouble (ofs, tables[t]->q[i]);
+            }
+        }
+    }
+  ofs.close ();
+  return !ofs.fail ();
+}
+
+uint32_t
+QTablePolicy::GetNCells (void) const
+{
+  return m_mlb.size ();
+}
+
+uint32_t
+QTablePolicy::GetGreedyAction (const Table &table, uint32_t state)
+{
+  NS_ABORT_MSG_IF (state >= table.nStates,
+                   "state " << state << " out of the " << table.nStates << " states of the Q-table");
+  return table.best[state];
+}
+
+uint32_t
+QTablePolicy::GetMlbAction (uint32_t cell, uint32_t state) const
+{
+  NS_ASSERT_MSG (cell < m_mlb.size (), "invalid cell index " << cell);
+  return GetGreedyAction (m_mlb[cell], state);
+}
+
+uint32_t
+QTablePolicy::GetMroAction (uint32_t cell, uint32_t state) const
+{
+  NS_ASSERT_MSG (cell < m_mro.size (), "invalid cell index " << cell);
+  return GetGreedyAction (m_mro[cell], state);
+}
+
+int8_t
+QTablePolicy::GetCio (uint32_t cell, uint32_t state) const
+{
+  int32_t action = GetMlbAction (cell, state);
+  return action - static_cast<int32_t> (m_mlb[cell].nActions - 1) / 2;
+}
+
+double
+QTablePolicy::GetHom (uint32_t cell, uint32_t state) const
+{
+  return HOM_VALUES[GetMroAction (cell, state) / N_TTT];
+}
+
+uint16_t
+QTablePolicy::GetTtt (uint32_t cell, uint32_t state) const
+{
+  return TTT_VALUES[GetMroAction (cell, state) % N_TTT];
+}
+
+} // namespace ns3
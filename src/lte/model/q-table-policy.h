@@ -0,0 +1,179 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef Q_TABLE_POLICY_H
+#define Q_TABLE_POLICY_H
+
+#include <ns3/simple-ref-count.h>
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * Greedy policy of the per-cell mobility load balancing (MLB) and
+ * mobility robustness optimization (MRO) Q-tables of the SLC2 agents.
+ *
+ * Each cell has an MLB table, indexed by the enbMLBstate observation,
+ * whose actions are the cell individual offsets (CIO) centered on 0 dB,
+ * i.e., -4..4 dB for 9 actions; and an MRO table, indexed by the
+ * AverageVelocity observation, whose action a is the hysteresis
+ * HOM_VALUES[a / 7] and the time-to-trigger TTT_VALUES[a % 7]. The
+ * greedy action of a state is the first one with the largest Q-value,
+ * as numpy.argmax, and is computed once when the tables are loaded.
+ *
+ * The tables can be imported from the CSV files written by the agents,
+ * one row per state, and saved in a compact binary file: the "SLCQ"
+ * magic, the format version and the number of cells, followed by the
+ * MLB then the MRO table of each cell, each of them its number of
+ * states, its number of actions and its Q-values, row by row. All the
+ * fields are little endian 32-bit unsigned integers or IEEE 754
+ * doubles.
+ */
+class QTablePolicy : public SimpleRefCount<QTablePolicy>
+{
+public:
+  QTablePolicy ();
+
+  /**
+   * Import the Q-tables from CSV files, one MLB and one MRO table per
+   * cell, in the order of the cell IDs.
+   *
+   * \param mlbFiles the CSV files of the MLB tables
+   * \param mroFiles the CSV files of the MRO tables
+   * \return false if a file cannot be read or is not a valid table
+   */
+  bool ImportCsv (const std::vector<std::string> &mlbFiles,
+                  const std::vector<std::string> &mroFiles);
+
+  /**
+   * Load the Q-tables from a binary file.
+   *
+   * \param filename the name of the file
+   * \return false if the file cannot be read or is not a valid policy
+   */
+  bool Load (std::string filename);
+
+  /**
+   * Save the Q-tables to a binary file.
+   *
+   * \param filename the name of the file
+   * \return false if the file cannot be written
+   */
+  bool Save (std::string filename) const;
+
+  /// \return the number of cells of the policy
+  uint32_t GetNCells (void) const;
+
+  /**
+   * \param cell the index of the cell, from 0
+   * \param state the MLB state of the cell
+   * \return the greedy MLB action
+   */
+  uint32_t GetMlbAction (uint32_t cell, uint32_t state) const;
+
+  /**
+   * \param cell the index of the cell, from 0
+   * \param state the MRO state of the cell
+   * \return the greedy MRO action
+   */
+  uint32_t GetMroAction (uint32_t cell, uint32_t state) const;
+
+  /**
+   * \param cell the index of the cell, from 0
+   * \param state the MLB state of the cell
+   * \return the CIO of the greedy MLB action, in dB
+   */
+  int8_t GetCio (uint32_t cell, uint32_t state) const;
+
+  /**
+   * \param cell the index of the cell, from 0
+   * \param state the MRO state of the cell
+   * \return the hysteresis of the greedy MRO action, in dB
+   */
+  double GetHom (uint32_t cell, uint32_t state) const;
+
+  /**
+   * \param cell the index of the cell, from 0
+   * \param state the MRO state of the cell
+   * \return the time-to-trigger of the greedy MRO action, in ms
+   */
+  uint16_t GetTtt (uint32_t cell, uint32_t state) const;
+
+  /// Number of hysteresis values of the MRO actions
+  static const uint32_t N_HOM = 7;
+  /// Number of time-to-trigger values of the MRO actions
+  static const uint32_t N_TTT = 7;
+  /// Hysteresis values of the MRO actions, in dB
+  static const double HOM_VALUES[N_HOM];
+  /// Time-to-trigger values of the MRO actions, in ms
+  static const uint16_t TTT_VALUES[N_TTT];
+
+private:
+  /// Q-table of a cell
+  struct Table
+  {
+    uint32_t nStates;            ///< the number of states
+    uint32_t nActions;           ///< the number of actions
+    std::vector<double> q;       ///< the Q-values, row by row
+    std::vector<uint32_t> best;  ///< the greedy action of each state
+  };
+
+  /**
+   * Read a Q-table from a CSV file.
+   *
+   * \param filename the name of the file
+   * \param [out] table the table
+   * \return false if the file cannot be read or the rows are not all
+   * of the same length
+   */
+  static bool ReadCsv (std::string filename, Table &table);
+
+  /**
+   * Compute the greedy action of each state of a table.
+   *
+   * \param table the table
+   */
+  static void ComputeGreedyActions (Table &table);
+
+  /**
+   * Check that the actions of the tables can be mapped to CIO, HOM and
+   * TTT values, and compute their greedy actions.
+   *
+   * \param mlb the MLB tables
+   * \param mro the MRO tables
+   * \return false if a table is not valid
+   */
+  bool SetTables (std::vector<Table> &mlb, std::vector<Table> &mro);
+
+  /**
+   * \param table the table
+   * \param state the state
+   * \return the greedy action of the state
+   */
+  static uint32_t GetGreedyAction (const Table &table, uint32_t state);
+
+  std::vector<Table> m_mlb; ///< the MLB table of each cell
+  std::vector<Table> m_mro; ///< the MRO table of each cell
+};
+
+} // namespace ns3
+
+#endif // Q_TABLE_POLICY_H
@@ -0,0 +1,179 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef RNTI_TABLE_H
+#define RNTI_TABLE_H
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * \brief Table of per-UE values indexed by RNTI
+ *
+ * The values are stored in dense slots, which are allocated to the RNTIs
+ * when they are inserted and reused after they are erased; an index from
+ * RNTI to slot gives the value of an RNTI in constant time. The index
+ * grows up to the largest RNTI inserted, i.e., at most 64 Ki entries.
+ *
+ * The pointers returned by Find are invalidated by the next Insert.
+ *
+ * \tparam T the type of the values
+ */
+template <typename T>
+class RntiTable
+{
+public:
+  RntiTable ()
+    : m_nValues (0)
+  {
+  }
+
+  /**
+   * \param rnti the RNTI
+   * \return the value of the RNTI, or 0 if the RNTI is not in the table
+   */
+  T *Find (uint16_t rnti)
+  {
+    uint32_t slot = GetSlot (rnti);
+    return slot == NO_SLOT ? 0 : &m_values[slot];
+  }
+
+  /**
+   * \param rnti the RNTI
+   * \return the value of the RNTI, or 0 if the RNTI is not in the table
+   */
+  const T *Find (uint16_t rnti) const
+  {
+    uint32_t slot = GetSlot (rnti);
+    return slot == NO_SLOT ? 0 : &m_values[slot];
+  }
+
+  /**
+   * \param rnti the RNTI
+   * \return true if the RNTI is in the table
+   */
+  bool Contains (uint16_t rnti) const
+  {
+    return GetSlot (rnti) != NO_SLOT;
+  }
+
+  /**
+   * Insert the value of an RNTI, as std::map::insert: the value of an
+   * RNTI already in the table is not changed.
+   *
+   * \param rnti the RNTI
+   * \param value the value
+   * \return false if the RNTI was already in the table
+   */
+  bool Insert (uint16_t rnti, const T &value)
+  {
+    if (Contains (rnti))
+      {
+        return false;
+      }
+    uint32_t slot;
+    if (m_freeSlots.empty ())
+      {
+        slot = m_values.size ();
+        m_values.push_back (value);
+        m_rntiBySlot.push_back (rnti);
+      }
+    else
+      {
+        slot = m_freeSlots.back ();
+        m_freeSlots.pop_back ();
+        m_values[slot] = value;
+        m_rntiBySlot[slot] = rnti;
+      }
+    if (rnti >= m_slotByRnti.size ())
+      {
+        m_slotByRnti.resize (rnti + 1, NO_SLOT);
+      }
+    m_slotByRnti[rnti] = slot;
+    ++m_nValues;
+    return true;
+  }
+
+  /**
+   * Erase the value of an RNTI. The slot of the RNTI is reset to a
+   * default value, which releases the resources of the erased value.
+   *
+   * \param rnti the RNTI
+   * \return false if the RNTI was not in the table
+   */
+  bool Erase (uint16_t rnti)
+  {
+    uint32_t slot = GetSlot (rnti);
+    if (slot == NO_SLOT)
+      {
+        return false;
+      }
+    m_values[slot] = T ();
+    m_slotByRnti[rnti] = NO_SLOT;
+    m_freeSlots.push_back (slot);
+    --m_nValues;
+    return true;
+  }
+
+  /// Erase all the values, in a time proportional to the number of slots
+  void Clear (void)
+  {
+    for (uint32_t slot = 0; slot < m_rntiBySlot.size (); ++slot)
+      {
+        m_slotByRnti[m_rntiBySlot[slot]] = NO_SLOT;
+      }
+    m_values.clear ();
+    m_rntiBySlot.clear ();
+    m_freeSlots.clear ();
+    m_nValues = 0;
+  }
+
+  /// \return the number of RNTIs in the table
+  uint32_t GetN (void) const
+  {
+    return m_nValues;
+  }
+
+private:
+  /// Slot of the RNTIs not in the table
+  static const uint32_t NO_SLOT = 0xffffffff;
+
+  /**
+   * \param rnti the RNTI
+   * \return the slot of the RNTI, or NO_SLOT
+   */
+  uint32_t GetSlot (uint16_t rnti) const
+  {
+    return rnti < m_slotByRnti.size () ? m_slotByRnti[rnti] : NO_SLOT;
+  }
+
+  std::vector<uint32_t> m_slotByRnti; ///< slot of each RNTI, NO_SLOT if none
+  std::vector<T> m_values;            ///< values, by slot
+  std::vector<uint16_t> m_rntiBySlot; ///< RNTI of each slot, last one for the free slots
+  std::vector<uint32_t> m_freeSlots;  ///< slots of the erased values
+  uint32_t m_nValues;                 ///< number of RNTIs in the table
+};
+
+template <typename T>
+const uint32_t RntiTable<T>::NO_SLOT;
+
+} // namespace ns3
+
+#endif /* RNTI_TABLE_H */
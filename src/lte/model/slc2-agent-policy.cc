@@ -0,0 +1,140 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "slc2-agent-policy.h"
+
+#include <ns3/log.h>
+#include <ns3/abort.h>
+
+#include <algorithm>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("Slc2AgentPolicy");
+
+Slc2AgentPolicy::Slc2AgentPolicy (Ptr<const QTablePolicy> tables, Ptr<const DqnPolicy> coordinator)
+  : m_tables (tables),
+    m_coordinator (coordinator)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ABORT_MSG_IF (!tables || tables->GetNCells () == 0, "no Q-tables");
+  uint32_t nCells = tables->GetNCells ();
+  if (coordinator)
+    {
+      NS_ABORT_MSG_IF (coordinator->GetNInputs () != 6 * nCells,
+                       "the coordinator has " << coordinator->GetNInputs ()
+                                              << " inputs instead of " << 6 * nCells);
+      NS_ABORT_MSG_IF (nCells > 15 || coordinator->GetNOutputs () != 1u << (2 * nCells),
+                       "the coordinator has " << coordinator->GetNOutputs ()
+                                              << " outputs instead of 4^" << nCells);
+    }
+  Reset ();
+}
+
+uint32_t
+Slc2AgentPolicy::GetNCells (void) const
+{
+  return m_tables->GetNCells ();
+}
+
+void
+Slc2AgentPolicy::Reset (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_nSteps = 0;
+  m_coordinatorAction = 0;
+  m_actions.assign (3 * GetNCells (), 0);
+  m_coordinatorState.assign (6 * GetNCells (), 0);
+}
+
+const std::vector<float> &
+Slc2AgentPolicy::Step (const std::vector<float> &mlbState,
+                       const std::vector<float> &mroState,
+                       const std::vector<float> &observations)
+{
+  NS_LOG_FUNCTION (this << m_nSteps);
+  uint32_t nCells = GetNCells ();
+  NS_ABORT_MSG_IF (mlbState.size () < nCells || mroState.size () < nCells,
+                   "too few MLB or MRO states");
+
+  // the CIOs, then the (TTT, HOM) of each cell
+  m_tableActions.resize (3 * nCells);
+  for (uint32_t i = 0; i < nCells; ++i)
+    {
+      m_tableActions[i] = m_tables->GetCio (i, static_cast<uint32_t> (mlbState[i]));
+      uint32_t state = static_cast<uint32_t> (mroState[i]);
+      uint32_t mroTable = m_nSteps == 0 ? i : 0;
+      m_tableActions[nCells + 2 * i] = m_tables->GetTtt (mroTable, state);
+      m_tableActions[nCells + 2 * i + 1] = m_tables->GetHom (mroTable, state);
+    }
+
+  if (!m_coordinator)
+    {
+      m_actions = m_tableActions;
+      ++m_nSteps;
+      return m_actions;
+    }
+
+  NS_ABORT_MSG_IF (observations.size () != 3 * nCells,
+                   "the coordinator needs " << 3 * nCells << " observations, not "
+                                            << observations.size ());
+  if (m_nSteps == 0)
+    {
+      for (uint32_t i = 0; i < nCells; ++i)
+        {
+          uint32_t index[3] = { i, nCells + 2 * i, nCells + 2 * i + 1 };
+          for (uint32_t k = 0; k < 3; ++k)
+            {
+              float diff = m_tableActions[index[k]] - m_actions[index[k]];
+              m_coordinatorState[k * nCells + i] = (diff > 0) - (diff < 0);
+            }
+        }
+    }
+  std::copy (observations.begin (), observations.end (), m_coordinatorState.begin () + 3 * nCells);
+
+  m_coordinatorAction = m_coordinator->GetGreedyAction (m_coordinatorState);
+  uint32_t choices = m_coordinatorAction;
+  for (uint32_t i = 0; i < nCells; ++i, choices /= 4)
+    {
+      uint32_t choice = choices % 4;
+      NS_LOG_LOGIC ("cell " << i + 1 << " coordinator choice " << choice);
+      if (choice == 0 || choice == 1)
+        {
+          m_actions[i] = m_tableActions[i];
+        }
+      if (choice == 0 || choice == 2)
+        {
+          m_actions[nCells + 2 * i] = m_tableActions[nCells + 2 * i];
+          m_actions[nCells + 2 * i + 1] = m_tableActions[nCells + 2 * i + 1];
+        }
+    }
+  ++m_nSteps;
+  return m_actions;
+}
+
+uint32_t
+Slc2AgentPolicy::GetNSteps (void) const
+{
+  return m_nSteps;
+}
+
+uint32_t
+Slc2AgentPolicy::GetCoordinatorAction (void) const
+{
+  return m_coordinatorAction;
+}
+
+} // namespace ns3
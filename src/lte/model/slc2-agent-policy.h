@@ -0,0 +1,107 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SLC2_AGENT_POLICY_H
+#define SLC2_AGENT_POLICY_H
+
+#include <ns3/simple-ref-count.h>
+#include <ns3/ptr.h>
+#include <ns3/q-table-policy.h>
+#include <ns3/dqn-policy.h>
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup lte
+ *
+ * Step logic of the greedy SLC2 agents (scratch/SLC2_Agent_*.py), in one
+ * episode, with the Q-tables of a QTablePolicy and, optionally, the
+ * coordinator of a DqnPolicy.
+ *
+ * At each step, the MLB table of each cell maps its enbMLBstate to its
+ * CIO. At the first step, the MRO table of each cell maps its
+ * AverageVelocity to its TTT and HOM; at the next steps, as in the
+ * agents, the MRO table of the first cell is used for all the cells.
+ *
+ * The coordinator chooses, cell by cell, between these new actions and
+ * the previous ones. Its state is the direction (-1, 0 or 1) of the
+ * change of the CIO, of the TTT and of the HOM of each cell, then the
+ * AvgCqi, dlPrbusage and enbBestCell observations. As in the agents, the
+ * directions are those of the first step, from null previous actions,
+ * for the whole episode. Its greedy action is, in base 4, the choice of
+ * each cell, from the first one: 0 for both new actions, 1 for the new
+ * CIO only, 2 for the new MRO actions only and 3 for both previous
+ * actions. Without a coordinator, the new actions are always applied, as
+ * with a coordinator always choosing 0; the agents have no such mode.
+ *
+ * The agents explore with an epsilon-greedy coordinator and keep the
+ * previous actions of an episode for the next one; this class is greedy
+ * and starts every episode, as the first one of the agents, from null
+ * previous actions.
+ */
+class Slc2AgentPolicy : public SimpleRefCount<Slc2AgentPolicy>
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param tables the MLB and MRO Q-tables of the cells
+   * \param coordinator the coordinator, or 0 to always apply the new actions
+   */
+  Slc2AgentPolicy (Ptr<const QTablePolicy> tables, Ptr<const DqnPolicy> coordinator);
+
+  /// \return the number of cells
+  uint32_t GetNCells (void) const;
+
+  /// Start a new episode.
+  void Reset (void);
+
+  /**
+   * Compute the actions of a step.
+   *
+   * \param mlbState the enbMLBstate observation of each cell
+   * \param mroState the AverageVelocity observation of each cell
+   * \param observations the AvgCqi, then the dlPrbusage, then the
+   * enbBestCell observations of the cells, only used by the coordinator
+   * \return the actions of the agents: the CIO of each cell, in dB, then
+   * the TTT, in ms, and the HOM, in dB, of each cell
+   */
+  const std::vector<float> & Step (const std::vector<float> &mlbState,
+                                   const std::vector<float> &mroState,
+                                   const std::vector<float> &observations);
+
+  /// \return the number of steps of the episode
+  uint32_t GetNSteps (void) const;
+
+  /// \return the action of the coordinator at the last step, 0 without coordinator
+  uint32_t GetCoordinatorAction (void) const;
+
+private:
+  Ptr<const QTablePolicy> m_tables;      ///< the Q-tables
+  Ptr<const DqnPolicy> m_coordinator;    ///< the coordinator, if any
+  uint32_t m_nSteps;                     ///< the number of steps of the episode
+  uint32_t m_coordinatorAction;          ///< the action of the coordinator at the last step
+  std::vector<float> m_tableActions;     ///< the new actions of the Q-tables
+  std::vector<float> m_actions;          ///< the actions of the last step
+  std::vector<float> m_coordinatorState; ///< the state of the coordinator
+};
+
+} // namespace ns3
+
+#endif // SLC2_AGENT_POLICY_H
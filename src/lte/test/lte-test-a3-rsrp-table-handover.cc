@@ -0,0 +1,354 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/test.h>
+#include <ns3/log.h>
+#include <ns3/nstime.h>
+#include <ns3/callback.h>
+#include <ns3/config.h>
+#include <ns3/pointer.h>
+#include <ns3/simulator.h>
+#include <ns3/node-container.h>
+#include <ns3/net-device-container.h>
+#include <ns3/lte-helper.h>
+#include <ns3/point-to-point-epc-helper.h>
+#include <ns3/internet-stack-helper.h>
+#include <ns3/mobility-helper.h>
+#include <ns3/position-allocator.h>
+#include <ns3/lte-common.h>
+#include <ns3/lte-ue-net-device.h>
+#include <ns3/lte-ue-rrc.h>
+#include <ns3/a3-rsrp-table-handover-algorithm.h>
+
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteA3RsrpTableHandoverTest");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Handover Management SAP user recording the requests of a handover
+ *        algorithm, in place of an eNodeB RRC.
+ */
+class A3RsrpTableTestSapUser : public LteHandoverManagementSapUser
+{
+public:
+  /// Handover triggered by the algorithm
+  struct Handover
+  {
+    Time time; ///< the time of the handover
+    uint16_t rnti; ///< the RNTI of the UE
+    uint16_t targetCellId; ///< the target cell
+  };
+
+  virtual uint8_t AddUeMeasReportConfigForHandover (LteRrcSap::ReportConfigEutra reportConfig)
+  {
+    m_reportConfigs.push_back (reportConfig);
+    return 1;
+  }
+
+  virtual void TriggerHandover (uint16_t rnti, uint16_t targetCellId)
+  {
+    Handover handover;
+    handover.time = Simulator::Now ();
+    handover.rnti = rnti;
+    handover.targetCellId = targetCellId;
+    m_handovers.push_back (handover);
+  }
+
+  std::vector<LteRrcSap::ReportConfigEutra> m_reportConfigs; ///< report configurations requested
+  std::vector<Handover> m_handovers; ///< handovers triggered
+};
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test the evaluation of Event A3 by A3RsrpTableHandoverAlgorithm on
+ *        synthetic measurement reports, with per-UE parameters and per-cell
+ *        individual offsets.
+ */
+class LteA3RsrpTableHandoverTestCase : public TestCase
+{
+public:
+  LteA3RsrpTableHandoverTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Report the RSRP of the serving cell and of two neighbours to the algorithm
+   * \param rnti the RNTI of the UE
+   * \param servingRsrp the RSRP of the serving cell 1 in dBm
+   * \param rsrp2 the RSRP of the cell 2 in dBm
+   * \param rsrp3 the RSRP of the cell 3 in dBm
+   */
+  void Report (uint16_t rnti, double servingRsrp, double rsrp2, double rsrp3);
+
+  Ptr<A3RsrpTableHandoverAlgorithm> m_algorithm; ///< the algorithm
+};
+
+LteA3RsrpTableHandoverTestCase::LteA3RsrpTableHandoverTestCase ()
+  : TestCase ("A3 conditions evaluated on measurement reports")
+{
+}
+
+void
+LteA3RsrpTableHandoverTestCase::Report (uint16_t rnti, double servingRsrp, double rsrp2, double rsrp3)
+{
+  LteRrcSap::MeasResults measResults;
+  measResults.measId = 1;
+  measResults.rsrpResult = EutranMeasurementMapping::Dbm2RsrpRange (servingRsrp);
+  measResults.rsrqResult = 0;
+  measResults.haveMeasResultNeighCells = true;
+  measResults.haveScellsMeas = false;
+  for (uint16_t cellId = 2; cellId <= 3; ++cellId)
+    {
+      LteRrcSap::MeasResultEutra measResultEutra;
+      measResultEutra.physCellId = cellId;
+      measResultEutra.haveCgiInfo = false;
+      measResultEutra.haveRsrpResult = true;
+      measResultEutra.rsrpResult = EutranMeasurementMapping::Dbm2RsrpRange (cellId == 2 ? rsrp2 : rsrp3);
+      measResultEutra.haveRsrqResult = false;
+      measResults.measResultListEutra.push_back (measResultEutra);
+    }
+  m_algorithm->GetLteHandoverManagementSapProvider ()->ReportUeMeas (rnti, measResults);
+}
+
+void
+LteA3RsrpTableHandoverTestCase::DoRun ()
+{
+  A3RsrpTableTestSapUser sapUser;
+  m_algorithm = CreateObject<A3RsrpTableHandoverAlgorithm> ();
+  m_algorithm->SetLteHandoverManagementSapUser (&sapUser);
+  m_algorithm->SetCellId (1);
+  m_algorithm->Initialize ();
+
+  NS_TEST_ASSERT_MSG_EQ (sapUser.m_reportConfigs.size (), 1, "one report configuration expected");
+  NS_TEST_ASSERT_MSG_EQ (sapUser.m_reportConfigs[0].eventId, LteRrcSap::ReportConfigEutra::EVENT_A4,
+                         "Event A4 reports expected");
+  NS_TEST_ASSERT_MSG_EQ ((uint16_t) sapUser.m_reportConfigs[0].threshold1.range, 0, "lowest threshold expected");
+  NS_TEST_ASSERT_MSG_EQ (sapUser.m_reportConfigs[0].reportInterval, LteRrcSap::ReportConfigEutra::MS120,
+                         "120 ms reports expected");
+
+  // RNTI 2 has no handover margin nor time-to-trigger: the first report
+  // triggers a handover to the best neighbour
+  m_algorithm->SetUeParameters (2, 0.0, Seconds (0));
+  Simulator::Schedule (MilliSeconds (0), &LteA3RsrpTableHandoverTestCase::Report, this, 2, -90.0, -89.5, -89.0);
+
+  // RNTI 1 has the default 3 dB and 320 ms: a neighbour 2 dB better
+  // triggers a handover 360 ms after the offset of 2 dB of the cell 2
+  Simulator::Schedule (MilliSeconds (60), &A3RsrpTableHandoverAlgorithm::SetCellIndividualOffset, m_algorithm, 2, 2.0);
+  for (uint32_t i = 0; i <= 4; ++i)
+    {
+      Simulator::Schedule (MilliSeconds (120 * i), &LteA3RsrpTableHandoverTestCase::Report, this, 1, -90.0, -88.0, -100.0);
+    }
+
+  // RNTI 3: a report not meeting the condition restarts the time-to-trigger
+  double rsrp3[] = {-85.0, -89.0, -85.0, -85.0, -85.0, -85.0};
+  for (uint32_t i = 0; i < 6; ++i)
+    {
+      Simulator::Schedule (MilliSeconds (120 * i), &LteA3RsrpTableHandoverTestCase::Report, this, 3, -90.0, rsrp3[i], -100.0);
+    }
+
+  // RNTI 4: the offset of the serving cell delays the handover to the cell 3
+  // until the cell 3 has an offset too
+  Simulator::Schedule (MilliSeconds (700), &A3RsrpTableHandoverAlgorithm::SetUeParameters, m_algorithm, 4, 0.0, Seconds (0));
+  Simulator::Schedule (MilliSeconds (700), &A3RsrpTableHandoverAlgorithm::SetCellIndividualOffset, m_algorithm, 1, 6.0);
+  Simulator::Schedule (MilliSeconds (720), &LteA3RsrpTableHandoverTestCase::Report, this, 4, -90.0, -100.0, -85.0);
+  Simulator::Schedule (MilliSeconds (800), &A3RsrpTableHandoverAlgorithm::SetCellIndividualOffset, m_algorithm, 3, 2.0);
+  Simulator::Schedule (MilliSeconds (840), &LteA3RsrpTableHandoverTestCase::Report, this, 4, -90.0, -100.0, -85.0);
+
+  // RNTIs 5 and 6 are released and reassigned to new UEs, which inherit
+  // neither the entering time of the cell 2 nor the parameters of the
+  // released UEs: the handovers are triggered 360 ms after the first report
+  // of the new UEs
+  Simulator::Schedule (MilliSeconds (1000), &A3RsrpTableHandoverAlgorithm::SetUeParameters, m_algorithm, 6, 10.0, Seconds (0));
+  for (uint32_t i = 0; i < 3; ++i)
+    {
+      Simulator::Schedule (MilliSeconds (1000 + 120 * i), &LteA3RsrpTableHandoverTestCase::Report, this, 5, -90.0, -80.0, -100.0);
+      Simulator::Schedule (MilliSeconds (1000 + 120 * i), &LteA3RsrpTableHandoverTestCase::Report, this, 6, -90.0, -80.0, -100.0);
+    }
+  Simulator::Schedule (MilliSeconds (1300), &LteHandoverManagementSapProvider::RemoveUe,
+                       m_algorithm->GetLteHandoverManagementSapProvider (), 5);
+  Simulator::Schedule (MilliSeconds (1300), &LteHandoverManagementSapProvider::RemoveUe,
+                       m_algorithm->GetLteHandoverManagementSapProvider (), 6);
+  for (uint32_t i = 0; i < 4; ++i)
+    {
+      Simulator::Schedule (MilliSeconds (1360 + 120 * i), &LteA3RsrpTableHandoverTestCase::Report, this, 5, -90.0, -80.0, -100.0);
+      Simulator::Schedule (MilliSeconds (1360 + 120 * i), &LteA3RsrpTableHandoverTestCase::Report, this, 6, -90.0, -80.0, -100.0);
+    }
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  uint16_t expectedRnti[] = {2, 1, 3, 4, 5, 6};
+  uint16_t expectedTarget[] = {3, 2, 2, 3, 2, 2};
+  uint32_t expectedTimeMs[] = {0, 480, 600, 840, 1720, 1720};
+  NS_TEST_ASSERT_MSG_EQ (sapUser.m_handovers.size (), 6, "wrong number of handovers");
+  for (uint32_t i = 0; i < 6; ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (sapUser.m_handovers[i].rnti, expectedRnti[i], "wrong UE of the handover " << i);
+      NS_TEST_ASSERT_MSG_EQ (sapUser.m_handovers[i].targetCellId, expectedTarget[i], "wrong target of the handover " << i);
+      NS_TEST_ASSERT_MSG_EQ (sapUser.m_handovers[i].time, MilliSeconds (expectedTimeMs[i]), "wrong time of the handover " << i);
+    }
+
+  m_algorithm->Dispose ();
+  m_algorithm = 0;
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test that a cell individual offset set on the algorithm of the
+ *        serving eNodeB hands a UE over, without reconfiguring the UE.
+ *
+ *     eNodeB 1          UE                          eNodeB 2
+ *        x ------------- x ------------------------- x
+ *              300 m                700 m
+ */
+class LteA3RsrpTableHandoverOffsetTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   * \param offsetDb the offset of the cell 2 set at 1 s, 0 for none
+   */
+  LteA3RsrpTableHandoverOffsetTestCase (double offsetDb);
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * UE handover end OK callback function
+   * \param context the context string
+   * \param imsi the IMSI
+   * \param cellId the cell ID
+   * \param rnti the RNTI
+   */
+  void UeHandoverEndOk (std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti);
+
+  double m_offsetDb; ///< the offset of the cell 2
+  uint32_t m_nHandovers; ///< the number of handovers completed
+  Time m_handoverTime; ///< the time of the last handover completed
+};
+
+LteA3RsrpTableHandoverOffsetTestCase::LteA3RsrpTableHandoverOffsetTestCase (double offsetDb)
+  : TestCase ("offset of " + std::to_string (offsetDb) + " dB of the cell 2"),
+    m_offsetDb (offsetDb),
+    m_nHandovers (0)
+{
+}
+
+void
+LteA3RsrpTableHandoverOffsetTestCase::UeHandoverEndOk (std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti)
+{
+  ++m_nHandovers;
+  m_handoverTime = Simulator::Now ();
+}
+
+void
+LteA3RsrpTableHandoverOffsetTestCase::DoRun ()
+{
+  Ptr<PointToPointEpcHelper> epcHelper = CreateObject<PointToPointEpcHelper> ();
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  lteHelper->SetEpcHelper (epcHelper);
+  lteHelper->SetHandoverAlgorithmType ("ns3::A3RsrpTableHandoverAlgorithm");
+
+  NodeContainer enbNodes;
+  enbNodes.Create (2);
+  Ptr<Node> ueNode = CreateObject<Node> ();
+
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0, 0, 0));
+  positionAlloc->Add (Vector (1000, 0, 0));
+  positionAlloc->Add (Vector (300, 0, 0));
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (enbNodes);
+  mobility.Install (ueNode);
+
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  Ptr<NetDevice> ueDev = lteHelper->InstallUeDevice (ueNode).Get (0);
+
+  InternetStackHelper internet;
+  internet.Install (ueNode);
+  epcHelper->AssignUeIpv4Address (ueDev);
+
+  lteHelper->AddX2Interface (enbNodes);
+  lteHelper->Attach (ueDev, enbDevs.Get (0));
+
+  Config::Connect ("/NodeList/*/DeviceList/*/LteUeRrc/HandoverEndOk",
+                   MakeCallback (&LteA3RsrpTableHandoverOffsetTestCase::UeHandoverEndOk, this));
+
+  // the cells of the helper share their offsets: the UE is not handed back
+  // to the cell 1 by the algorithm of the cell 2
+  PointerValue algorithm;
+  enbDevs.Get (0)->GetAttribute ("LteHandoverAlgorithm", algorithm);
+  Ptr<A3RsrpTableHandoverAlgorithm> a3TableAlgorithm = algorithm.Get<A3RsrpTableHandoverAlgorithm> ();
+  NS_TEST_ASSERT_MSG_NE (a3TableAlgorithm, 0, "A3RsrpTableHandoverAlgorithm expected");
+  if (m_offsetDb != 0)
+    {
+      Simulator::Schedule (Seconds (1), &A3RsrpTableHandoverAlgorithm::SetCellIndividualOffset,
+                           a3TableAlgorithm, 2, m_offsetDb);
+    }
+
+  Simulator::Stop (Seconds (2.5));
+  Simulator::Run ();
+
+  Ptr<LteUeRrc> ueRrc = ueDev->GetObject<LteUeNetDevice> ()->GetRrc ();
+  if (m_offsetDb != 0)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_nHandovers, 1, "one handover expected");
+      NS_TEST_EXPECT_MSG_GT (m_handoverTime, Seconds (1), "handover before the offset");
+      NS_TEST_EXPECT_MSG_EQ (ueRrc->GetCellId (), 2, "UE not in the cell 2");
+    }
+  else
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_nHandovers, 0, "no handover expected");
+      NS_TEST_EXPECT_MSG_EQ (ueRrc->GetCellId (), 1, "UE not in the cell 1");
+    }
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief A3RsrpTableHandoverAlgorithm test suite
+ */
+class LteA3RsrpTableHandoverTestSuite : public TestSuite
+{
+public:
+  LteA3RsrpTableHandoverTestSuite ();
+};
+
+LteA3RsrpTableHandoverTestSuite::LteA3RsrpTableHandoverTestSuite ()
+  : TestSuite ("lte-a3-rsrp-table-handover", SYSTEM)
+{
+  AddTestCase (new LteA3RsrpTableHandoverTestCase (), TestCase::QUICK);
+  AddTestCase (new LteA3RsrpTableHandoverOffsetTestCase (0.0), TestCase::QUICK);
+  AddTestCase (new LteA3RsrpTableHandoverOffsetTestCase (15.0), TestCase::QUICK);
+}
+
+/// the test suite
+static LteA3RsrpTableHandoverTestSuite g_lteA3RsrpTableHandoverTestSuite;
@@ -0,0 +1,199 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/test.h>
+#include <ns3/log.h>
+#include <ns3/pointer.h>
+#include <ns3/simulator.h>
+#include <ns3/node-container.h>
+#include <ns3/net-device-container.h>
+#include <ns3/mobility-helper.h>
+#include <ns3/lte-helper.h>
+#include <ns3/lte-enb-net-device.h>
+#include <ns3/lte-enb-rrc.h>
+#include <ns3/cell-individual-offset.h>
+#include <ns3/a3-rsrp-table-handover-algorithm.h>
+
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteCellIndividualOffsetTest");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test the offsets and the version of CellIndividualOffset.
+ */
+class LteCellIndividualOffsetTableTestCase : public TestCase
+{
+public:
+  LteCellIndividualOffsetTableTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteCellIndividualOffsetTableTestCase::LteCellIndividualOffsetTableTestCase ()
+  : TestCase ("offsets and version of a table")
+{
+}
+
+void
+LteCellIndividualOffsetTableTestCase::DoRun ()
+{
+  Ptr<CellIndividualOffset> table = CreateObject<CellIndividualOffset> ();
+  Ptr<CellIndividualOffset> otherTable = CreateObject<CellIndividualOffset> ();
+  NS_TEST_ASSERT_MSG_EQ (table->GetVersion (), 0, "new table not at version 0");
+  NS_TEST_ASSERT_MSG_EQ (table->GetOffsetList ().size (), 0, "new table not empty");
+  NS_TEST_ASSERT_MSG_EQ (table->GetOffset (1), 0.0, "offset of a cell not set");
+
+  table->SetOffset (3, 2.0);
+  NS_TEST_ASSERT_MSG_EQ (table->GetVersion (), 1, "version not incremented");
+  CellIndividualOffset::ConstSpan offsets = table->GetOffsetList ();
+  NS_TEST_ASSERT_MSG_EQ (offsets.size (), 3, "the table does not cover the cells 1 to 3");
+  NS_TEST_ASSERT_MSG_EQ (offsets[0], 0.0, "wrong offset of the cell 1");
+  NS_TEST_ASSERT_MSG_EQ (offsets[2], 2.0, "wrong offset of the cell 3");
+  NS_TEST_ASSERT_MSG_EQ (table->GetOffset (3), 2.0, "wrong offset of the cell 3");
+  NS_TEST_ASSERT_MSG_EQ (table->GetOffset (4), 0.0, "offset of a cell beyond the table");
+
+  table->SetOffset (3, 2.0);
+  NS_TEST_ASSERT_MSG_EQ (table->GetVersion (), 1, "version incremented without change");
+
+  std::vector<double> list;
+  list.push_back (-1.0);
+  list.push_back (0.0);
+  list.push_back (2.0);
+  table->SetOffsetList (list);
+  NS_TEST_ASSERT_MSG_EQ (table->GetVersion (), 2, "version not incremented");
+  NS_TEST_ASSERT_MSG_EQ (table->GetOffset (1), -1.0, "wrong offset of the cell 1");
+  table->SetOffsetList (list);
+  NS_TEST_ASSERT_MSG_EQ (table->GetVersion (), 2, "version incremented without change");
+
+  // the views do not copy the offsets
+  offsets = table->GetOffsetList ();
+  table->SetOffset (2, 5.0);
+  NS_TEST_ASSERT_MSG_EQ (offsets[1], 5.0, "view not updated");
+
+  NS_TEST_ASSERT_MSG_EQ (otherTable->GetVersion (), 0, "tables not independent");
+  NS_TEST_ASSERT_MSG_EQ (otherTable->GetOffset (2), 0.0, "tables not independent");
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test that the eNodeBs installed by an LteHelper share its table of
+ *        offsets, and that their RRCs copy its changes into the
+ *        cellsToAddModList sent to the UEs.
+ */
+class LteCellIndividualOffsetHelperTestCase : public TestCase
+{
+public:
+  LteCellIndividualOffsetHelperTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteCellIndividualOffsetHelperTestCase::LteCellIndividualOffsetHelperTestCase ()
+  : TestCase ("table shared by the eNodeBs of a helper")
+{
+}
+
+void
+LteCellIndividualOffsetHelperTestCase::DoRun ()
+{
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  Ptr<LteHelper> otherLteHelper = CreateObject<LteHelper> ();
+  lteHelper->SetHandoverAlgorithmType ("ns3::A3RsrpTableHandoverAlgorithm");
+  NS_TEST_ASSERT_MSG_NE (lteHelper->GetCellIndividualOffsetTable (), otherLteHelper->GetCellIndividualOffsetTable (),
+                         "helpers sharing their table");
+
+  NodeContainer enbNodes;
+  enbNodes.Create (2);
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (enbNodes);
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+
+  Ptr<CellIndividualOffset> table = lteHelper->GetCellIndividualOffsetTable ();
+  std::vector<Ptr<LteEnbRrc> > rrcs;
+  for (uint32_t i = 0; i < enbDevs.GetN (); ++i)
+    {
+      Ptr<LteEnbNetDevice> enbDev = enbDevs.Get (i)->GetObject<LteEnbNetDevice> ();
+      rrcs.push_back (enbDev->GetRrc ());
+      NS_TEST_ASSERT_MSG_EQ (enbDev->GetRrc ()->GetCellIndividualOffsetTable (), table, "eNB RRC without the table of the helper");
+
+      PointerValue algorithm;
+      enbDev->GetAttribute ("LteHandoverAlgorithm", algorithm);
+      Ptr<A3RsrpTableHandoverAlgorithm> a3TableAlgorithm = algorithm.Get<A3RsrpTableHandoverAlgorithm> ();
+      NS_TEST_ASSERT_MSG_EQ (a3TableAlgorithm->GetCellIndividualOffsetTable (), table, "handover algorithm without the table of the helper");
+    }
+
+  // the cellsToAddModList of the SLC2 eNBs lists the cells 1 to 2
+  std::list<LteRrcSap::CellsToAddMod> cells;
+  for (uint8_t cellIndex = 1; cellIndex <= 2; ++cellIndex)
+    {
+      LteRrcSap::CellsToAddMod cell;
+      cell.cellIndex = cellIndex;
+      cell.physCellId = 0;
+      cell.cellIndividualOffset = 0;
+      cells.push_back (cell);
+    }
+  rrcs[0]->setCellstoAddModList (cells);
+  rrcs[1]->setCellstoAddModList (cells);
+
+  table->SetOffset (2, 6.0);
+  for (uint32_t i = 0; i < rrcs.size (); ++i)
+    {
+      rrcs[i]->UpdateCellsToAddModList ();
+      NS_TEST_ASSERT_MSG_EQ ((int) rrcs[i]->m_cellsToAddModList.front ().cellIndividualOffset, 0, "wrong offset of the cell 1");
+      NS_TEST_ASSERT_MSG_EQ ((int) rrcs[i]->m_cellsToAddModList.back ().cellIndividualOffset, 6, "wrong offset of the cell 2");
+    }
+
+  // unchanged offsets are not copied again
+  rrcs[0]->m_cellsToAddModList.back ().cellIndividualOffset = 1;
+  rrcs[0]->UpdateCellsToAddModList ();
+  NS_TEST_ASSERT_MSG_EQ ((int) rrcs[0]->m_cellsToAddModList.back ().cellIndividualOffset, 1, "offsets copied without change");
+
+  lteHelper = 0;
+  otherLteHelper = 0;
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief CellIndividualOffset test suite
+ */
+class LteCellIndividualOffsetTestSuite : public TestSuite
+{
+public:
+  LteCellIndividualOffsetTestSuite ();
+};
+
+LteCellIndividualOffsetTestSuite::LteCellIndividualOffsetTestSuite ()
+  : TestSuite ("lte-cell-individual-offset", UNIT)
+{
+  AddTestCase (new LteCellIndividualOffsetTableTestCase (), TestCase::QUICK);
+  AddTestCase (new LteCellIndividualOffsetHelperTestCase (), TestCase::QUICK);
+}
+
+/// the test suite
+static LteCellIndividualOffsetTestSuite g_lteCellIndividualOffsetTestSuite;
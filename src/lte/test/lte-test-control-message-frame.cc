@@ -0,0 +1,134 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/lte-control-messages.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestControlMessageFrame");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test that a UE reads, in a control message frame, its own DCIs
+ * and the messages addressed to all the UEs, in their order of
+ * transmission.
+ */
+class LteControlMessageFrameTestCase : public TestCase
+{
+public:
+  LteControlMessageFrameTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Check the messages read by a UE.
+   *
+   * \param frame the frame
+   * \param rnti the RNTI of the UE
+   * \param expected the indexes of the messages which the UE reads
+   */
+  void Check (Ptr<const LteControlMessageFrame> frame, uint16_t rnti,
+              std::vector<uint32_t> expected);
+};
+
+LteControlMessageFrameTestCase::LteControlMessageFrameTestCase ()
+  : TestCase ("Control messages of a frame read by each UE")
+{
+}
+
+void
+LteControlMessageFrameTestCase::Check (Ptr<const LteControlMessageFrame> frame, uint16_t rnti,
+                                       std::vector<uint32_t> expected)
+{
+  std::vector<uint32_t> read;
+  for (uint32_t i = frame->GetNext (rnti, 0); i < frame->GetN (); i = frame->GetNext (rnti, i + 1))
+    {
+      read.push_back (i);
+    }
+  NS_TEST_ASSERT_MSG_EQ (read.size (), expected.size (), "wrong number of messages of RNTI " << rnti);
+  for (uint32_t i = 0; i < read.size () && i < expected.size (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (read[i], expected[i], "wrong message " << i << " of RNTI " << rnti);
+    }
+}
+
+void
+LteControlMessageFrameTestCase::DoRun (void)
+{
+  std::list<Ptr<LteControlMessage> > msgList;
+  uint16_t dlRntis[] = {2, 1};
+  for (uint32_t i = 0; i < 2; ++i)
+    {
+      Ptr<DlDciLteControlMessage> msg = Create<DlDciLteControlMessage> ();
+      DlDciListElement_s dci;
+      dci.m_rnti = dlRntis[i];
+      msg->SetDci (dci);
+      msgList.push_back (msg);
+    }
+  msgList.push_back (Create<MibLteControlMessage> ());
+  Ptr<UlDciLteControlMessage> ulMsg = Create<UlDciLteControlMessage> ();
+  UlDciListElement_s ulDci;
+  ulDci.m_rnti = 2;
+  ulMsg->SetDci (ulDci);
+  msgList.push_back (ulMsg);
+  msgList.push_back (Create<RarLteControlMessage> ());
+
+  Ptr<const LteControlMessageFrame> frame = Create<LteControlMessageFrame> (msgList);
+  NS_TEST_ASSERT_MSG_EQ (frame->GetN (), 5, "wrong number of messages");
+  std::list<Ptr<LteControlMessage> > frameList = frame->GetList ();
+  NS_TEST_ASSERT_MSG_EQ ((frameList == msgList), true, "wrong order of the messages");
+
+  std::vector<uint32_t> expected;
+  expected.push_back (0);
+  expected.push_back (2);
+  expected.push_back (3);
+  expected.push_back (4);
+  Check (frame, 2, expected);
+  expected[0] = 1;
+  expected.erase (expected.begin () + 2);
+  Check (frame, 1, expected);
+  expected.erase (expected.begin ());
+  Check (frame, 3, expected);
+
+  Check (Create<LteControlMessageFrame> (std::list<Ptr<LteControlMessage> > ()), 1,
+         std::vector<uint32_t> ());
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Control message frame test suite
+ */
+class LteControlMessageFrameTestSuite : public TestSuite
+{
+public:
+  LteControlMessageFrameTestSuite ();
+};
+
+LteControlMessageFrameTestSuite::LteControlMessageFrameTestSuite ()
+  : TestSuite ("lte-control-message-frame", UNIT)
+{
+  AddTestCase (new LteControlMessageFrameTestCase (), TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static LteControlMessageFrameTestSuite lteControlMessageFrameTestSuite;
@@ -386,7 +386,7 @@ LteDownlinkCtrlSinrTestCase::DoRun (void)
   sp1->psd = m_sv;
   sp1->txPhy = 0;
   sp1->duration = ds;
-  sp1->ctrlMsgList = ctrlMsgList[0];
+  sp1->ctrlMsgFrame = Create<LteControlMessageFrame> (ctrlMsgList[0]);
   sp1->cellId = pbCellId[0];
   sp1->pss = false;
   Simulator::Schedule (ts, &LteSpectrumPhy::StartRx, dlPhy, sp1);
@@ -396,7 +396,7 @@ LteDownlinkCtrlSinrTestCase::DoRun (void)
   ip1->psd = i1;
   ip1->txPhy = 0;
   ip1->duration = di1;
-  ip1->ctrlMsgList = ctrlMsgList[1];
+  ip1->ctrlMsgFrame = Create<LteControlMessageFrame> (ctrlMsgList[1]);
   ip1->cellId = pbCellId[1];
   ip1->pss = false;
   Simulator::Schedule (ti1, &LteSpectrumPhy::StartRx, dlPhy, ip1);
@@ -405,7 +405,7 @@ LteDownlinkCtrlSinrTestCase::DoRun (void)
   ip2->psd = i2;
   ip2->txPhy = 0;
   ip2->duration = di2;
-  ip2->ctrlMsgList = ctrlMsgList[2];
+  ip2->ctrlMsgFrame = Create<LteControlMessageFrame> (ctrlMsgList[2]);
   ip2->cellId = pbCellId[2];
   ip2->pss = false;
   Simulator::Schedule (ti2, &LteSpectrumPhy::StartRx, dlPhy, ip2);
@@ -414,7 +414,7 @@ LteDownlinkCtrlSinrTestCase::DoRun (void)
   ip3->psd = i3;
   ip3->txPhy = 0;
   ip3->duration = di3;
-  ip3->ctrlMsgList = ctrlMsgList[3];
+  ip3->ctrlMsgFrame = Create<LteControlMessageFrame> (ctrlMsgList[3]);
   ip3->cellId = pbCellId[3];
   ip3->pss = false;
   Simulator::Schedule (ti3, &LteSpectrumPhy::StartRx, dlPhy, ip3);
@@ -423,7 +423,7 @@ LteDownlinkCtrlSinrTestCase::DoRun (void)
   ip4->psd = i4;
   ip4->txPhy = 0;
   ip4->duration = di4;
-  ip4->ctrlMsgList = ctrlMsgList[4];
+  ip4->ctrlMsgFrame = Create<LteControlMessageFrame> (ctrlMsgList[4]);
   ip4->cellId = pbCellId[4];
   ip4->pss = false;
   Simulator::Schedule (ti4, &LteSpectrumPhy::StartRx, dlPhy, ip4);
@@ -0,0 +1,467 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/dqn-policy.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestDqnPolicy");
+
+/**
+ * \ingroup lte-test
+ *
+ * Deterministic generator of the weights and inputs of the tests,
+ * uniform in [-1, 1).
+ */
+class TestValueGenerator
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param seed the seed
+   */
+  TestValueGenerator (uint32_t seed)
+    : m_state (seed)
+  {
+  }
+
+  /// \return the next value
+  float Next (void)
+  {
+    m_state = m_state * 1664525 + 1013904223;
+    return (m_state >> 8) / 8388608.0f - 1.0f;
+  }
+
+  /**
+   * \param n the number of values
+   * \return the next n values
+   */
+  std::vector<float> Next (uint32_t n)
+  {
+    std::vector<float> values (n);
+    for (uint32_t i = 0; i < n; ++i)
+      {
+        values[i] = Next ();
+      }
+    return values;
+  }
+
+private:
+  uint32_t m_state; ///< the state of the linear congruential generator
+};
+
+/// Weights and biases of a fully connected layer, for the reference forward pass
+struct TestLayer
+{
+  uint32_t nInputs;            ///< the number of inputs
+  uint32_t nOutputs;           ///< the number of outputs
+  std::vector<float> weights;  ///< the weights, output by output
+  std::vector<float> bias;     ///< the biases
+};
+
+/**
+ * Forward pass in double precision, without any reordering of the sums.
+ *
+ * \param layers the layers
+ * \param input the inputs
+ * \return the outputs
+ */
+static std::vector<double>
+ReferenceForward (const std::vector<TestLayer> &layers, const std::vector<float> &input)
+{
+  std::vector<double> x (input.begin (), input.end ());
+  for (uint32_t l = 0; l < layers.size (); ++l)
+    {
+      std::vector<double> y (layers[l].nOutputs);
+      for (uint32_t o = 0; o < layers[l].nOutputs; ++o)
+        {
+          double sum = layers[l].bias[o];
+          for (uint32_t i = 0; i < layers[l].nInputs; ++i)
+            {
+              sum += (double) layers[l].weights[o * layers[l].nInputs + i] * x[i];
+            }
+          y[o] = (l + 1 < layers.size () && sum < 0) ? 0 : sum;
+        }
+      x.swap (y);
+    }
+  return x;
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test the GEMV kernel of DqnPolicy against a double precision
+ * reference, for sizes around the number of partial sums of the kernel.
+ */
+class DqnPolicyGemvTestCase : public TestCase
+{
+public:
+  DqnPolicyGemvTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+DqnPolicyGemvTestCase::DqnPolicyGemvTestCase ()
+  : TestCase ("DQN policy GEMV kernel")
+{
+}
+
+void
+DqnPolicyGemvTestCase::DoRun (void)
+{
+  const uint32_t sizes[][2] = { { 1, 1 }, { 7, 3 }, { 8, 5 }, { 9, 4 }, { 30, 32 }, { 33, 17 }, { 54, 32 } };
+  TestValueGenerator generator (1);
+  for (uint32_t s = 0; s < sizeof (sizes) / sizeof (sizes[0]); ++s)
+    {
+      uint32_t nInputs = sizes[s][0];
+      uint32_t nOutputs = sizes[s][1];
+      std::vector<float> w = generator.Next (nInputs * nOutputs);
+      std::vector<float> b = generator.Next (nOutputs);
+      std::vector<float> x = generator.Next (nInputs);
+      std::vector<float> y (nOutputs);
+      DqnPolicy::Gemv (&w[0], &b[0], &x[0], &y[0], nInputs, nOutputs);
+      for (uint32_t o = 0; o < nOutputs; ++o)
+        {
+          double expected = b[o];
+          double magnitude = std::fabs (b[o]);
+          for (uint32_t i = 0; i < nInputs; ++i)
+            {
+              expected += (double) w[o * nInputs + i] * x[i];
+              magnitude += std::fabs ((double) w[o * nInputs + i] * x[i]);
+            }
+          NS_TEST_ASSERT_MSG_EQ_TOL (y[o], expected, 1e-6 * (1 + magnitude),
+                                     "wrong output " << o << " of the " << nInputs << "x"
+                                                     << nOutputs << " GEMV");
+        }
+    }
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test the forward pass, the greedy action and the ReLU of the
+ * hidden layers on a small network whose outputs are exact.
+ */
+class DqnPolicyForwardTestCase : public TestCase
+{
+public:
+  DqnPolicyForwardTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+DqnPolicyForwardTestCase::DqnPolicyForwardTestCase ()
+  : TestCase ("DQN policy forward pass")
+{
+}
+
+void
+DqnPolicyForwardTestCase::DoRun (void)
+{
+  DqnPolicy policy;
+  // hidden layer: h = ReLU ([x0 + x1, x0 - x1, -x0] + [0, 1, 0.5])
+  const float w1[] = { 1, 1, 1, -1, -1, 0 };
+  const float b1[] = { 0, 1, 0.5 };
+  // output layer: q = [h0, h1 + h2, 2 h2, h0] + [0, 0, 0, 0]
+  const float w2[] = { 1, 0, 0, 0, 1, 1, 0, 0, 2, 1, 0, 0 };
+  const float b2[] = { 0, 0, 0, 0 };
+  policy.AddLayer (2, 3, std::vector<float> (w1, w1 + 6), std::vector<float> (b1, b1 + 3));
+  policy.AddLayer (3, 4, std::vector<float> (w2, w2 + 12), std::vector<float> (b2, b2 + 4));
+  NS_TEST_ASSERT_MSG_EQ (policy.GetNLayers (), 2, "wrong number of layers");
+  NS_TEST_ASSERT_MSG_EQ (policy.GetNInputs (), 2, "wrong number of inputs");
+  NS_TEST_ASSERT_MSG_EQ (policy.GetNOutputs (), 4, "wrong number of outputs");
+
+  std::vector<float> input (2);
+  std::vector<float> output;
+  // h = [3, 0, 0], the second hidden output is clipped
+  input[0] = 1;
+  input[1] = 2;
+  policy.Evaluate (input, output);
+  NS_TEST_ASSERT_MSG_EQ (output.size (), 4, "wrong number of outputs");
+  NS_TEST_ASSERT_MSG_EQ (output[0], 3, "wrong output");
+  NS_TEST_ASSERT_MSG_EQ (output[1], 0, "wrong output");
+  NS_TEST_ASSERT_MSG_EQ (output[2], 0, "wrong output");
+  NS_TEST_ASSERT_MSG_EQ (output[3], 3, "wrong output");
+  // tie between the first and last outputs
+  NS_TEST_ASSERT_MSG_EQ (policy.GetGreedyAction (input), 0, "wrong greedy action on a tie");
+
+  // h = [0, 0, 2.5], the first two hidden outputs are clipped
+  input[0] = -2;
+  input[1] = 1;
+  policy.Evaluate (input, output);
+  NS_TEST_ASSERT_MSG_EQ (output[0], 0, "wrong output");
+  NS_TEST_ASSERT_MSG_EQ (output[1], 2.5, "wrong output");
+  NS_TEST_ASSERT_MSG_EQ (output[2], 5, "wrong output");
+  NS_TEST_ASSERT_MSG_EQ (output[3], 0, "wrong output");
+  NS_TEST_ASSERT_MSG_EQ (policy.GetGreedyAction (input), 2, "wrong greedy action");
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test that a network of the size of the SLC2 coordinator, saved
+ * to and loaded from a binary file, computes the Q-values of a double
+ * precision reference and its greedy actions, and that invalid files are
+ * rejected.
+ */
+class DqnPolicyFileTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param nCells the number of cells of the coordinator
+   */
+  DqnPolicyFileTestCase (uint32_t nCells);
+
+private:
+  virtual void DoRun (void);
+
+  uint32_t m_nCells; ///< the number of cells of the coordinator
+};
+
+DqnPolicyFileTestCase::DqnPolicyFileTestCase (uint32_t nCells)
+  : TestCase ("DQN policy file of a coordinator of " + std::to_string (nCells) + " cells"),
+    m_nCells (nCells)
+{
+}
+
+/**
+ * \param filename the name of the file
+ * \return the content of the file
+ */
+static std::string
+ReadFile (std::string filename)
+{
+  std::ifstream ifs (filename.c_str (), std::ios::binary);
+  return std::string (std::istreambuf_iterator<char> (ifs), std::istreambuf_iterator<char> ());
+}
+
+/**
+ * Write a file.
+ *
+ * \param filename the name of the file
+ * \param content the content of the file
+ */
+static void
+WriteFile (std::string filename, std::string content)
+{
+  std::ofstream ofs (filename.c_str (), std::ios::binary | std::ios::trunc);
+  ofs << content;
+}
+
+void
+DqnPolicyFileTestCase::DoRun (void)
+{
+  // state_size -> 32 -> ReLU -> 32 -> ReLU -> action_size, as the agents
+  uint32_t sizes[4] = { 6 * m_nCells, 32, 32, 1u << (2 * m_nCells) };
+  TestValueGenerator generator (m_nCells);
+  std::vector<TestLayer> layers (3);
+  DqnPolicy policy;
+  uint32_t expectedSize = 12;
+  for (uint32_t l = 0; l < 3; ++l)
+    {
+      layers[l].nInputs = sizes[l];
+      layers[l].nOutputs = sizes[l + 1];
+      layers[l].weights = generator.Next (sizes[l] * sizes[l + 1]);
+      layers[l].bias = generator.Next (sizes[l + 1]);
+      policy.AddLayer (sizes[l], sizes[l + 1], layers[l].weights, layers[l].bias);
+      expectedSize += 8 + 4 * (sizes[l] + 1) * sizes[l + 1];
+    }
+
+  std::string file1 = CreateTempDirFilename ("coordinator1.bin");
+  NS_TEST_ASSERT_MSG_EQ (policy.Save (file1), true, "save failed");
+  std::string content = ReadFile (file1);
+  NS_TEST_ASSERT_MSG_EQ (content.size (), expectedSize, "wrong file size");
+  NS_TEST_ASSERT_MSG_EQ (content.substr (0, 4), "SLCD", "wrong magic");
+
+  DqnPolicy loaded;
+  NS_TEST_ASSERT_MSG_EQ (loaded.Load (file1), true, "load failed");
+  NS_TEST_ASSERT_MSG_EQ (loaded.GetNLayers (), 3, "wrong number of layers");
+  NS_TEST_ASSERT_MSG_EQ (loaded.GetNInputs (), sizes[0], "wrong number of inputs");
+  NS_TEST_ASSERT_MSG_EQ (loaded.GetNOutputs (), sizes[3], "wrong number of outputs");
+  std::string file2 = CreateTempDirFilename ("coordinator2.bin");
+  NS_TEST_ASSERT_MSG_EQ (loaded.Save (file2), true, "save failed");
+  NS_TEST_ASSERT_MSG_EQ ((ReadFile (file2) == content), true, "saved networks differ");
+
+  for (uint32_t t = 0; t < 20; ++t)
+    {
+      // coordinator states: directions of the changes, then observations
+      std::vector<float> input = generator.Next (sizes[0]);
+      for (uint32_t i = 0; i < 3 * m_nCells; ++i)
+        {
+          input[i] = std::floor (input[i] * 1.5f + 0.5f);
+        }
+      for (uint32_t i = 3 * m_nCells; i < sizes[0]; ++i)
+        {
+          input[i] = std::floor ((input[i] + 1) * 8);
+        }
+
+      std::vector<float> output;
+      std::vector<float> loadedOutput;
+      policy.Evaluate (input, output);
+      loaded.Evaluate (input, loadedOutput);
+      NS_TEST_ASSERT_MSG_EQ ((output == loadedOutput), true, "the loaded network differs");
+
+      std::vector<double> expected = ReferenceForward (layers, input);
+      uint32_t best = 0;
+      uint32_t second = 1;
+      for (uint32_t a = 0; a < sizes[3]; ++a)
+        {
+          NS_TEST_ASSERT_MSG_EQ_TOL (output[a], expected[a], 1e-4 * (1 + std::fabs (expected[a])),
+                                     "wrong Q-value of action " << a << " of state " << t);
+          if (expected[a] > expected[best])
+            {
+              second = best;
+              best = a;
+            }
+          else if (a != best && expected[a] > expected[second])
+            {
+              second = a;
+            }
+        }
+      if (expected[best] - expected[second] > 1e-3)
+        {
+          NS_TEST_ASSERT_MSG_EQ (loaded.GetGreedyAction (input), best,
+                                 "wrong greedy action of state " << t);
+        }
+    }
+
+  // truncated file, wrong magic, inconsistent layers, missing file
+  std::string invalidFile = CreateTempDirFilename ("invalid.bin");
+  DqnPolicy invalid;
+  WriteFile (invalidFile, content.substr (0, content.size () - 1));
+  NS_TEST_ASSERT_MSG_EQ (invalid.Load (invalidFile), false, "truncated file loaded");
+  WriteFile (invalidFile, "SLCQ" + content.substr (4));
+  NS_TEST_ASSERT_MSG_EQ (invalid.Load (invalidFile), false, "file with a wrong magic loaded");
+  std::string inconsistent = content;
+  // number of inputs of the second layer
+  inconsistent[12 + 8 + 4 * (sizes[0] + 1) * sizes[1]] = 31;
+  WriteFile (invalidFile, inconsistent);
+  NS_TEST_ASSERT_MSG_EQ (invalid.Load (invalidFile), false, "inconsistent layers loaded");
+  NS_TEST_ASSERT_MSG_EQ (invalid.Load (CreateTempDirFilename ("missing.bin")), false,
+                         "missing file loaded");
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test that the coordinator of the small SLC2 agent, written by its
+ * export_dqn, computes the Q-values of the agent, within the rounding
+ * errors of the single precision sums, and its greedy actions. The fixture
+ * is generated by reference/generate-slc2-dqn-fixture.py.
+ */
+class DqnPolicyExportTestCase : public TestCase
+{
+public:
+  DqnPolicyExportTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+DqnPolicyExportTestCase::DqnPolicyExportTestCase ()
+  : TestCase ("DQN policy exported by the SLC2 agent")
+{
+}
+
+void
+DqnPolicyExportTestCase::DoRun (void)
+{
+  SetDataDir (NS_TEST_SOURCEDIR);
+  DqnPolicy policy;
+  NS_TEST_ASSERT_MSG_EQ (policy.Load (CreateDataDirFilename ("reference/slc2-coordinator-small.bin")),
+                         true, "load failed");
+  NS_TEST_ASSERT_MSG_EQ (policy.GetNLayers (), 3, "wrong number of layers");
+  NS_TEST_ASSERT_MSG_EQ (policy.GetNInputs (), 30, "wrong number of inputs");
+  NS_TEST_ASSERT_MSG_EQ (policy.GetNOutputs (), 1024, "wrong number of outputs");
+
+  // one row per state: the inputs, then the Q-values of the agent
+  std::ifstream ifs (CreateDataDirFilename ("reference/slc2-coordinator-small-q.csv").c_str ());
+  NS_TEST_ASSERT_MSG_EQ (ifs.is_open (), true, "cannot open the Q-values of the agent");
+  std::string line;
+  uint32_t nStates = 0;
+  while (std::getline (ifs, line))
+    {
+      std::vector<double> values;
+      const char *p = line.c_str ();
+      char *end;
+      for (double v = std::strtod (p, &end); end != p; v = std::strtod (p, &end))
+        {
+          values.push_back (v);
+          p = *end == ',' ? end + 1 : end;
+        }
+      NS_TEST_ASSERT_MSG_EQ (values.size (), 30 + 1024, "wrong row " << nStates);
+      std::vector<float> input (values.begin (), values.begin () + 30);
+      std::vector<float> output;
+      policy.Evaluate (input, output);
+      uint32_t best = 0;
+      for (uint32_t a = 0; a < 1024; ++a)
+        {
+          double expected = values[30 + a];
+          NS_TEST_ASSERT_MSG_EQ_TOL (output[a], expected, 1e-5 * (1 + std::fabs (expected)),
+                                     "wrong Q-value of action " << a << " of state " << nStates);
+          if (expected > values[30 + best])
+            {
+              best = a;
+            }
+        }
+      NS_TEST_ASSERT_MSG_EQ (policy.GetGreedyAction (input), best,
+                             "wrong greedy action of state " << nStates);
+      ++nStates;
+    }
+  NS_TEST_ASSERT_MSG_EQ (nStates, 4, "wrong number of states");
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief DqnPolicy test suite
+ */
+class DqnPolicyTestSuite : public TestSuite
+{
+public:
+  DqnPolicyTestSuite ();
+};
+
+DqnPolicyTestSuite::DqnPolicyTestSuite ()
+  : TestSuite ("lte-dqn-policy", UNIT)
+{
+  AddTestCase (new DqnPolicyGemvTestCase (), TestCase::QUICK);
+  AddTestCase (new DqnPolicyForwardTestCase (), TestCase::QUICK);
+  // the small and large SLC2 scenarios
+  AddTestCase (new DqnPolicyFileTestCase (5), TestCase::QUICK);
+  AddTestCase (new DqnPolicyFileTestCase (9), TestCase::EXTENSIVE);
+  AddTestCase (new DqnPolicyExportTestCase (), TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static DqnPolicyTestSuite dqnPolicyTestSuite;
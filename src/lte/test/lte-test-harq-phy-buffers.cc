@@ -0,0 +1,121 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/ptr.h"
+#include "ns3/lte-harq-phy.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestHarqPhyBuffers");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test that the UL HARQ buffers of the RNTIs are shifted by one
+ * process per subframe, whether or not they are accessed in between,
+ * and that the DL HARQ buffers keep the transmissions of each process.
+ */
+class LteHarqPhyBuffersTestCase : public TestCase
+{
+public:
+  LteHarqPhyBuffersTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteHarqPhyBuffersTestCase::LteHarqPhyBuffersTestCase ()
+  : TestCase ("UL and DL HARQ buffers of the PHY")
+{
+}
+
+void
+LteHarqPhyBuffersTestCase::DoRun (void)
+{
+  Ptr<LteHarqPhy> harq = Create<LteHarqPhy> ();
+
+  // a NACKed TB is retransmitted 8 subframes later, at the first process
+  harq->UpdateUlHarqProcessStatus (1, 0.5, 100, 200);
+  harq->UpdateUlHarqProcessStatus (2, 0.25, 100, 200);
+  NS_TEST_ASSERT_MSG_EQ (harq->GetHarqProcessInfoUl (1, 7).size (), 1, "TB not stored at the last process");
+  for (uint32_t i = 0; i < 7; ++i)
+    {
+      harq->SubframeIndication (1, i + 1);
+      NS_TEST_ASSERT_MSG_EQ (harq->GetHarqProcessInfoUl (1, 6 - i).size (), 1,
+                             "TB not shifted at the subframe " << i + 1);
+    }
+  NS_TEST_ASSERT_MSG_EQ (harq->GetAccumulatedMiUl (1), 0.5, "wrong MI of the first process");
+  // RNTI 2 was not accessed during the shifts
+  NS_TEST_ASSERT_MSG_EQ (harq->GetAccumulatedMiUl (2), 0.25, "wrong MI of RNTI 2");
+
+  // the history of the retransmission is kept
+  harq->UpdateUlHarqProcessStatus (1, 0.75, 100, 200);
+  const HarqProcessInfoList_t& history = harq->GetHarqProcessInfoUl (1, 7);
+  NS_TEST_ASSERT_MSG_EQ (history.size (), 2, "wrong history of the retransmission");
+  NS_TEST_ASSERT_MSG_EQ (history.at (0).m_mi, 0.5, "wrong first transmission");
+  NS_TEST_ASSERT_MSG_EQ (history.at (1).m_mi, 0.75, "wrong retransmission");
+  NS_TEST_ASSERT_MSG_EQ (history.at (1).m_infoBits, 800, "wrong info bits");
+  NS_TEST_ASSERT_MSG_EQ (history.at (1).m_codeBits, 1600, "wrong code bits");
+
+  // the first process is dropped at the next shift, and all of them after
+  // 8 shifts made at once
+  harq->SubframeIndication (1, 8);
+  NS_TEST_ASSERT_MSG_EQ (harq->GetHarqProcessInfoUl (2, 7).size (), 0, "first process not dropped");
+  NS_TEST_ASSERT_MSG_EQ (harq->GetHarqProcessInfoUl (1, 6).size (), 2, "history not shifted");
+  for (uint32_t i = 0; i < 20; ++i)
+    {
+      harq->SubframeIndication (2, i);
+    }
+  for (uint8_t id = 0; id < 8; ++id)
+    {
+      NS_TEST_ASSERT_MSG_EQ (harq->GetHarqProcessInfoUl (1, id).size (), 0, "process " << (uint16_t) id << " not dropped");
+    }
+
+  // the DL processes keep up to 3 transmissions, per layer
+  for (uint32_t i = 0; i < 4; ++i)
+    {
+      harq->UpdateDlHarqProcessStatus (3, 1, 0.125, 10, 20);
+    }
+  NS_TEST_ASSERT_MSG_EQ (harq->GetHarqProcessInfoDl (3, 1).size (), 3, "wrong number of DL transmissions");
+  NS_TEST_ASSERT_MSG_EQ (harq->GetAccumulatedMiDl (3, 1), 0.375, "wrong DL MI");
+  NS_TEST_ASSERT_MSG_EQ (harq->GetHarqProcessInfoDl (3, 0).size (), 0, "wrong layer updated");
+  harq->ResetDlHarqProcessStatus (3);
+  NS_TEST_ASSERT_MSG_EQ (harq->GetHarqProcessInfoDl (3, 1).size (), 0, "DL process not reset");
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief HARQ buffers of the PHY test suite
+ */
+class LteHarqPhyBuffersTestSuite : public TestSuite
+{
+public:
+  LteHarqPhyBuffersTestSuite ();
+};
+
+LteHarqPhyBuffersTestSuite::LteHarqPhyBuffersTestSuite ()
+  : TestSuite ("lte-harq-phy-buffers", UNIT)
+{
+  AddTestCase (new LteHarqPhyBuffersTestCase (), TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static LteHarqPhyBuffersTestSuite lteHarqPhyBuffersTestSuite;
@@ -0,0 +1,308 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/config.h"
+#include "ns3/boolean.h"
+#include "ns3/enum.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/metrics-registry.h"
+#include "ns3/node-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/lte-helper.h"
+#include "ns3/lte-enb-rrc.h"
+#include "ns3/lte-ue-net-device.h"
+#include "ns3/lte-ue-phy.h"
+#include "ns3/lte-spectrum-phy.h"
+#include "ns3/lte-background-interference-filter.h"
+#include "ns3/lte-interference.h"
+#include "ns3/lte-chunk-processor.h"
+#include "ns3/lte-spectrum-value-helper.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestInterferenceBackground");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test that the background of LteInterference adds to the
+ * interference of the signals until it is replaced or the noise is set.
+ */
+class LteInterferenceBackgroundTestCase : public TestCase
+{
+public:
+  LteInterferenceBackgroundTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Receive a signal of 1 ms, with an interferer, and check its SINR.
+   *
+   * \param interferer the power spectral density of the interferer, 0 for none
+   * \param expectedSinr the expected SINR
+   */
+  void Receive (double interferer, double expectedSinr);
+
+  /**
+   * End the reception and check the SINR.
+   *
+   * \param expectedSinr the expected SINR
+   */
+  void EndReceive (double expectedSinr);
+
+  Ptr<LteInterference> m_interference; ///< the interference under test
+  Ptr<SpectrumValue> m_signal;         ///< the received signal
+  LteSpectrumValueCatcher m_sinr;      ///< the SINR of the last reception
+};
+
+LteInterferenceBackgroundTestCase::LteInterferenceBackgroundTestCase ()
+  : TestCase ("Background of LteInterference")
+{
+}
+
+void
+LteInterferenceBackgroundTestCase::Receive (double interferer, double expectedSinr)
+{
+  if (interferer > 0)
+    {
+      Ptr<SpectrumValue> psd = Create<SpectrumValue> (m_signal->GetSpectrumModel ());
+      (*psd) = interferer;
+      m_interference->AddSignal (psd, MilliSeconds (1));
+    }
+  m_interference->AddSignal (m_signal, MilliSeconds (1));
+  m_interference->StartRx (m_signal);
+  Simulator::Schedule (MilliSeconds (1), &LteInterferenceBackgroundTestCase::EndReceive, this, expectedSinr);
+}
+
+void
+LteInterferenceBackgroundTestCase::EndReceive (double expectedSinr)
+{
+  m_interference->EndRx ();
+  Ptr<SpectrumValue> sinr = m_sinr.GetValue ();
+  for (uint32_t i = 0; i < sinr->GetValuesN (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ_TOL ((*sinr)[i], expectedSinr, expectedSinr * 1e-9,
+                                 "wrong SINR at " << Simulator::Now ().GetMilliSeconds () << " ms, RB " << i);
+    }
+}
+
+void
+LteInterferenceBackgroundTestCase::DoRun (void)
+{
+  Ptr<SpectrumModel> model = LteSpectrumValueHelper::GetSpectrumModel (100, 6);
+  Ptr<SpectrumValue> noise = Create<SpectrumValue> (model);
+  (*noise) = 1e-18;
+  m_signal = Create<SpectrumValue> (model);
+  (*m_signal) = 1e-16;
+
+  m_interference = CreateObject<LteInterference> ();
+  Ptr<LteChunkProcessor> p = Create<LteChunkProcessor> ();
+  p->AddCallback (MakeCallback (&LteSpectrumValueCatcher::ReportValue, &m_sinr));
+  m_interference->AddSinrChunkProcessor (p);
+  m_interference->SetNoisePowerSpectralDensity (noise);
+
+  Ptr<SpectrumValue> background = Create<SpectrumValue> (model);
+  (*background) = 3e-18;
+  Ptr<SpectrumValue> background2 = Create<SpectrumValue> (model);
+  (*background2) = 9e-18;
+
+  Simulator::Schedule (MilliSeconds (1), &LteInterferenceBackgroundTestCase::Receive, this, 0, 100);
+  Simulator::Schedule (MicroSeconds (2500), &LteInterference::SetBackgroundPowerSpectralDensity,
+                       m_interference, background);
+  Simulator::Schedule (MilliSeconds (3), &LteInterferenceBackgroundTestCase::Receive, this, 0, 25);
+  Simulator::Schedule (MilliSeconds (5), &LteInterferenceBackgroundTestCase::Receive, this, 6e-18, 10);
+  // a new background replaces the previous one
+  Simulator::Schedule (MicroSeconds (6500), &LteInterference::SetBackgroundPowerSpectralDensity,
+                       m_interference, background2);
+  Simulator::Schedule (MilliSeconds (7), &LteInterferenceBackgroundTestCase::Receive, this, 0, 10);
+  // a new noise drops the background
+  Simulator::Schedule (MicroSeconds (8500), &LteInterference::SetNoisePowerSpectralDensity,
+                       m_interference, noise);
+  Simulator::Schedule (MilliSeconds (9), &LteInterferenceBackgroundTestCase::Receive, this, 0, 100);
+  Simulator::Schedule (MicroSeconds (10500), &LteInterference::SetBackgroundPowerSpectralDensity,
+                       m_interference, background2);
+  Simulator::Schedule (MicroSeconds (10500), &LteInterference::SetBackgroundPowerSpectralDensity,
+                       m_interference, Ptr<SpectrumValue> ());
+  Simulator::Schedule (MilliSeconds (11), &LteInterferenceBackgroundTestCase::Receive, this, 0, 100);
+  Simulator::Run ();
+
+  m_interference->Dispose ();
+  m_interference = 0;
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test that a UE with the InterferenceCells attribute simulates the
+ * DL data of its strongest neighbours only, and that the background of
+ * the other neighbours gives the SINR of the exact simulation at full load.
+ *
+ * The eNBs are on a line, 500 m apart, and each serves a UE with
+ * saturated traffic; the UE under test is served by the first eNB.
+ */
+class LteInterferenceCellsTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param nEnbs the number of eNBs
+   */
+  LteInterferenceCellsTestCase (uint16_t nEnbs);
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Simulate the layout.
+   *
+   * \param interferenceCells the InterferenceCells of the UEs
+   * \return the DL data SINR of the UE under test, in dB
+   */
+  double Run (uint16_t interferenceCells);
+
+  uint16_t m_nEnbs; ///< the number of eNBs
+};
+
+LteInterferenceCellsTestCase::LteInterferenceCellsTestCase (uint16_t nEnbs)
+  : TestCase ("Interference of the " + std::to_string (nEnbs - 2) + " weakest of "
+              + std::to_string (nEnbs) + " cells in the background"),
+    m_nEnbs (nEnbs)
+{
+}
+
+double
+LteInterferenceCellsTestCase::Run (uint16_t interferenceCells)
+{
+  Config::Reset ();
+  Config::SetDefault ("ns3::LteSpectrumPhy::CtrlErrorModelEnabled", BooleanValue (false));
+  Config::SetDefault ("ns3::LteSpectrumPhy::DataErrorModelEnabled", BooleanValue (false));
+  Config::SetDefault ("ns3::LteEnbRrc::EpsBearerToRlcMapping", EnumValue (LteEnbRrc::RLC_SM_ALWAYS));
+  Config::SetDefault ("ns3::LteUePhy::InterferenceCells", UintegerValue (interferenceCells));
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  lteHelper->SetAttribute ("PathlossModel", StringValue ("ns3::FriisSpectrumPropagationLossModel"));
+  lteHelper->SetAttribute ("UseIdealRrc", BooleanValue (true));
+  lteHelper->SetSchedulerType ("ns3::RrFfMacScheduler");
+
+  NodeContainer enbNodes;
+  NodeContainer ueNodes;
+  enbNodes.Create (m_nEnbs);
+  ueNodes.Create (m_nEnbs);
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  for (uint16_t i = 0; i < m_nEnbs; ++i)
+    {
+      positionAlloc->Add (Vector (500.0 * i, 0.0, 0.0));
+    }
+  for (uint16_t i = 0; i < m_nEnbs; ++i)
+    {
+      positionAlloc->Add (Vector (500.0 * i + 100.0, 50.0, 0.0));
+    }
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (enbNodes);
+  mobility.Install (ueNodes);
+
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+  for (uint16_t i = 0; i < m_nEnbs; ++i)
+    {
+      lteHelper->Attach (ueDevs.Get (i), enbDevs.Get (i));
+    }
+  lteHelper->ActivateDataRadioBearer (ueDevs, EpsBearer (EpsBearer::NGBR_VIDEO_TCP_DEFAULT));
+
+  Ptr<LteUePhy> uePhy = ueDevs.Get (0)->GetObject<LteUeNetDevice> ()->GetPhy ();
+  Ptr<LteChunkProcessor> p = Create<LteChunkProcessor> ();
+  LteSpectrumValueCatcher sinr;
+  p->AddCallback (MakeCallback (&LteSpectrumValueCatcher::ReportValue, &sinr));
+  uePhy->GetDlSpectrumPhy ()->AddDataSinrChunkProcessor (p);
+
+  MetricCounter *filtered = MetricsRegistry::Get ()->GetCounter ("LteBackgroundInterferenceFilter/Filtered");
+  filtered->Reset ();
+
+  // after the second measurement report of the UEs
+  Simulator::Stop (Seconds (0.45));
+  Simulator::Run ();
+
+  Ptr<LteSpectrumPhy> dlPhy = uePhy->GetDlSpectrumPhy ();
+  for (uint16_t cellId = 1; cellId <= m_nEnbs; ++cellId)
+    {
+      bool expected = interferenceCells > 0 && cellId > interferenceCells + 1;
+      NS_TEST_EXPECT_MSG_EQ (dlPhy->IsInterferenceInBackground (cellId), expected,
+                             "wrong background of the cell " << cellId);
+    }
+  // the channel evaluates the filter only if some UE has a background
+  Ptr<const LteBackgroundInterferenceFilter> filter =
+    LteBackgroundInterferenceFilter::GetFilter (lteHelper->GetDownlinkSpectrumChannel ());
+  if (interferenceCells > 0)
+    {
+      NS_TEST_EXPECT_MSG_NE (filter, 0, "no filter on the DL channel");
+      NS_TEST_EXPECT_MSG_GT (filtered->GetValue (), 0, "no data frame filtered");
+    }
+  else
+    {
+      NS_TEST_EXPECT_MSG_EQ (filter, 0, "filter on the DL channel");
+      NS_TEST_EXPECT_MSG_EQ (filtered->GetValue (), 0, "data frames filtered");
+    }
+
+  Ptr<SpectrumValue> value = sinr.GetValue ();
+  NS_TEST_EXPECT_MSG_NE (value, 0, "no DL data received");
+  double sinrDb = value ? 10 * std::log10 (Sum (*value) / value->GetValuesN ()) : 0;
+  NS_LOG_INFO (m_nEnbs << " eNBs, InterferenceCells " << interferenceCells << ": SINR " << sinrDb << " dB");
+
+  Simulator::Destroy ();
+  return sinrDb;
+}
+
+void
+LteInterferenceCellsTestCase::DoRun (void)
+{
+  double exact = Run (0);
+  double approximated = Run (1);
+  // at full load, the background is the interference of the cells it replaces
+  NS_TEST_ASSERT_MSG_EQ_TOL (approximated, exact, 0.05, "wrong SINR with the background");
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Interference background test suite
+ */
+class LteInterferenceBackgroundTestSuite : public TestSuite
+{
+public:
+  LteInterferenceBackgroundTestSuite ();
+};
+
+LteInterferenceBackgroundTestSuite::LteInterferenceBackgroundTestSuite ()
+  : TestSuite ("lte-interference-background", SYSTEM)
+{
+  AddTestCase (new LteInterferenceBackgroundTestCase (), TestCase::QUICK);
+  AddTestCase (new LteInterferenceCellsTestCase (3), TestCase::QUICK);
+  AddTestCase (new LteInterferenceCellsTestCase (5), TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static LteInterferenceBackgroundTestSuite lteInterferenceBackgroundTestSuite;
@@ -0,0 +1,226 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/config.h"
+#include "ns3/boolean.h"
+#include "ns3/node-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/lte-helper.h"
+#include "ns3/lte-enb-net-device.h"
+#include "ns3/lte-ue-net-device.h"
+#include "ns3/lte-enb-rrc.h"
+#include "ns3/lte-ue-rrc.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestMeasConfigDelta");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test that the updates of the cell individual offsets of a UE
+ * carry only the changed and removed cells, which the UE merges in its
+ * measurement object, and that no update is sent when no offset changed.
+ * With the real RRC protocol, the updates go through the ASN.1 encoding of
+ * the RRC connection reconfiguration without radioResourceConfigDedicated.
+ */
+class LteMeasConfigDeltaTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param useIdealRrc true to use the ideal RRC protocol
+   */
+  LteMeasConfigDeltaTestCase (bool useIdealRrc);
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Set the cell individual offsets of the cells at the eNB and update
+   * them at its UEs.
+   *
+   * \param cio1 the offset of the cell 1
+   * \param cio2 the offset of the cell 2
+   * \param listCell2 false to remove the cell 2 from the list of the eNB
+   */
+  void SetCio (int8_t cio1, int8_t cio2, bool listCell2);
+
+  /**
+   * Check the measurement configuration of the UE.
+   *
+   * \param nReconfigurations the expected number of reconfigurations
+   * \param nAvoided the expected number of updates not sent
+   * \param cio1 the expected offset of the cell 1
+   * \param cio2 the expected offset of the cell 2
+   */
+  void Check (uint32_t nReconfigurations, uint64_t nAvoided, int8_t cio1, int8_t cio2);
+
+  /**
+   * RRC connection reconfiguration completed at the UE.
+   *
+   * \param context the context
+   * \param imsi the IMSI
+   * \param cellId the cell ID
+   * \param rnti the RNTI
+   */
+  void ConnectionReconfiguration (std::string context, uint64_t imsi, uint16_t cellId, uint16_t rnti);
+
+  bool m_useIdealRrc;           ///< whether the ideal RRC protocol is used
+  Ptr<LteEnbRrc> m_enbRrc;      ///< the RRC of the serving eNB
+  Ptr<LteUeRrc> m_ueRrc;        ///< the RRC of the UE
+  uint32_t m_nReconfigurations; ///< reconfigurations completed at the UE
+};
+
+LteMeasConfigDeltaTestCase::LteMeasConfigDeltaTestCase (bool useIdealRrc)
+  : TestCase (useIdealRrc ? "Delta updates of the cell individual offsets, ideal RRC"
+              : "Delta updates of the cell individual offsets, real RRC"),
+    m_useIdealRrc (useIdealRrc),
+    m_nReconfigurations (0)
+{
+}
+
+void
+LteMeasConfigDeltaTestCase::SetCio (int8_t cio1, int8_t cio2, bool listCell2)
+{
+  std::list<LteRrcSap::CellsToAddMod> cells;
+  LteRrcSap::CellsToAddMod cell;
+  cell.physCellId = 0;
+  cell.cellIndex = 1;
+  cell.cellIndividualOffset = cio1;
+  cells.push_back (cell);
+  if (listCell2)
+    {
+      cell.cellIndex = 2;
+      cell.cellIndividualOffset = cio2;
+      cells.push_back (cell);
+    }
+  m_enbRrc->setCellstoAddModList (cells);
+  m_enbRrc->GetUeManager (m_ueRrc->GetRnti ())->ScheduleRrcConnectionRecursive ();
+}
+
+void
+LteMeasConfigDeltaTestCase::Check (uint32_t nReconfigurations, uint64_t nAvoided,
+                                   int8_t cio1, int8_t cio2)
+{
+  NS_TEST_ASSERT_MSG_EQ (m_nReconfigurations, nReconfigurations, "wrong number of reconfigurations");
+  NS_TEST_ASSERT_MSG_EQ (m_enbRrc->GetNMeasConfigUpdatesAvoided (), nAvoided,
+                         "wrong number of updates not sent");
+  NS_TEST_ASSERT_MSG_EQ ((int) m_ueRrc->GetCellIndividualOffset (1), (int) cio1, "wrong CIO of the cell 1");
+  NS_TEST_ASSERT_MSG_EQ ((int) m_ueRrc->GetCellIndividualOffset (2), (int) cio2, "wrong CIO of the cell 2");
+}
+
+void
+LteMeasConfigDeltaTestCase::ConnectionReconfiguration (std::string context, uint64_t imsi,
+                                                       uint16_t cellId, uint16_t rnti)
+{
+  ++m_nReconfigurations;
+}
+
+void
+LteMeasConfigDeltaTestCase::DoRun (void)
+{
+  Config::Reset ();
+  Config::SetDefault ("ns3::LteSpectrumPhy::CtrlErrorModelEnabled", BooleanValue (false));
+  Config::SetDefault ("ns3::LteSpectrumPhy::DataErrorModelEnabled", BooleanValue (false));
+  Config::SetDefault ("ns3::LteHelper::UseIdealRrc", BooleanValue (m_useIdealRrc));
+
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+
+  NodeContainer enbNodes;
+  NodeContainer ueNodes;
+  enbNodes.Create (2);
+  ueNodes.Create (1);
+
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, 0.0, 0.0));
+  positionAlloc->Add (Vector (1000.0, 0.0, 0.0));
+  positionAlloc->Add (Vector (50.0, 0.0, 0.0));
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (enbNodes);
+  mobility.Install (ueNodes);
+
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+  lteHelper->Attach (ueDevs, enbDevs.Get (0));
+
+  m_enbRrc = enbDevs.Get (0)->GetObject<LteEnbNetDevice> ()->GetRrc ();
+  m_ueRrc = ueDevs.Get (0)->GetObject<LteUeNetDevice> ()->GetRrc ();
+  Config::Connect ("/NodeList/*/DeviceList/*/LteUeRrc/ConnectionReconfiguration",
+                   MakeCallback (&LteMeasConfigDeltaTestCase::ConnectionReconfiguration, this));
+
+  // without bearers, the UE is not reconfigured at the connection setup
+  Simulator::Schedule (Seconds (0.2), &LteMeasConfigDeltaTestCase::Check, this, 0, 0, 0, 0);
+  // the first update configures both cells
+  Simulator::Schedule (Seconds (0.3), &LteMeasConfigDeltaTestCase::SetCio, this, 0, 0, true);
+  Simulator::Schedule (Seconds (0.35), &LteMeasConfigDeltaTestCase::Check, this, 1, 0, 0, 0);
+  // unchanged offsets, nothing is sent
+  Simulator::Schedule (Seconds (0.4), &LteMeasConfigDeltaTestCase::SetCio, this, 0, 0, true);
+  Simulator::Schedule (Seconds (0.45), &LteMeasConfigDeltaTestCase::Check, this, 1, 1, 0, 0);
+  // only the cell 1 is sent, then only the cell 2, the UE keeps the cell 1
+  Simulator::Schedule (Seconds (0.5), &LteMeasConfigDeltaTestCase::SetCio, this, -2, 0, true);
+  Simulator::Schedule (Seconds (0.55), &LteMeasConfigDeltaTestCase::Check, this, 2, 1, -2, 0);
+  Simulator::Schedule (Seconds (0.6), &LteMeasConfigDeltaTestCase::SetCio, this, -2, 3, true);
+  Simulator::Schedule (Seconds (0.65), &LteMeasConfigDeltaTestCase::Check, this, 3, 1, -2, 3);
+  Simulator::Schedule (Seconds (0.7), &LteMeasConfigDeltaTestCase::SetCio, this, -2, 3, true);
+  Simulator::Schedule (Seconds (0.75), &LteMeasConfigDeltaTestCase::Check, this, 3, 2, -2, 3);
+  // the cell 2 is no longer listed, the UE removes it
+  Simulator::Schedule (Seconds (0.8), &LteMeasConfigDeltaTestCase::SetCio, this, -2, 0, false);
+  Simulator::Schedule (Seconds (0.85), &LteMeasConfigDeltaTestCase::Check, this, 4, 2, -2, 0);
+  Simulator::Schedule (Seconds (0.9), &LteMeasConfigDeltaTestCase::SetCio, this, -2, 0, false);
+  Simulator::Schedule (Seconds (0.95), &LteMeasConfigDeltaTestCase::Check, this, 4, 3, -2, 0);
+  // listed again, the cell 2 is sent again with its previous offset
+  Simulator::Schedule (Seconds (1.0), &LteMeasConfigDeltaTestCase::SetCio, this, -2, 3, true);
+  Simulator::Schedule (Seconds (1.05), &LteMeasConfigDeltaTestCase::Check, this, 5, 3, -2, 3);
+
+  Simulator::Stop (Seconds (1.1));
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ ((int) m_ueRrc->GetState (), (int) LteUeRrc::CONNECTED_NORMALLY,
+                         "the UE lost its connection");
+
+  m_enbRrc = 0;
+  m_ueRrc = 0;
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Delta measurement configuration test suite
+ */
+class LteMeasConfigDeltaTestSuite : public TestSuite
+{
+public:
+  LteMeasConfigDeltaTestSuite ();
+};
+
+LteMeasConfigDeltaTestSuite::LteMeasConfigDeltaTestSuite ()
+  : TestSuite ("lte-meas-config-delta", SYSTEM)
+{
+  AddTestCase (new LteMeasConfigDeltaTestCase (true), TestCase::QUICK);
+  AddTestCase (new LteMeasConfigDeltaTestCase (false), TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static LteMeasConfigDeltaTestSuite lteMeasConfigDeltaTestSuite;
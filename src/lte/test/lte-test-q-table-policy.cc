@@ -0,0 +1,286 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/q-table-policy.h"
+
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestQTablePolicy");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test the import of the Q-tables from CSV files, their greedy
+ * actions, as numpy.argmax, and the mapping of the actions to CIO, HOM
+ * and TTT values.
+ */
+class QTablePolicyCsvTestCase : public TestCase
+{
+public:
+  QTablePolicyCsvTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+QTablePolicyCsvTestCase::QTablePolicyCsvTestCase ()
+  : TestCase ("Q-table policy CSV import and greedy actions")
+{
+}
+
+/**
+ * Write the MRO Q-table of a test cell, whose greedy action of state s
+ * is best[s].
+ *
+ * \param filename the name of the file
+ * \param best the greedy action of each state
+ */
+static void
+WriteMroCsv (std::string filename, const std::vector<uint32_t> &best)
+{
+  std::ofstream ofs (filename.c_str ());
+  for (uint32_t s = 0; s < best.size (); ++s)
+    {
+      for (uint32_t a = 0; a < QTablePolicy::N_HOM * QTablePolicy::N_TTT; ++a)
+        {
+          ofs << (a > 0 ? "," : "") << (a == best[s] ? 1.5 : -0.25 * a);
+        }
+      ofs << "\n";
+    }
+}
+
+void
+QTablePolicyCsvTestCase::DoRun (void)
+{
+  std::string mlb1 = CreateTempDirFilename ("mlb1.csv");
+  std::string mlb2 = CreateTempDirFilename ("mlb2.csv");
+  std::string mro1 = CreateTempDirFilename ("mro1.csv");
+  std::string mro2 = CreateTempDirFilename ("mro2.csv");
+  {
+    std::ofstream ofs (mlb1.c_str ());
+    // ties go to the first action, a NaN wins, blank lines are skipped
+    ofs << "0.0,0.0,0.0,0.0,0.0\n"
+        << "1.0e-3, 2.5e-3 ,2.5e-3,-1,0\n"
+        << "\n"
+        << "1,2,nan,3,nan\r\n"
+        << "-5,-4,-3,-2,-1\n";
+  }
+  {
+    std::ofstream ofs (mlb2.c_str ());
+    ofs << "3,2,1\n";
+  }
+  std::vector<uint32_t> best1;
+  best1.push_back (0);
+  best1.push_back (48);
+  best1.push_back (23);
+  WriteMroCsv (mro1, best1);
+  std::vector<uint32_t> best2 (1, 9);
+  WriteMroCsv (mro2, best2);
+
+  std::vector<std::string> mlbFiles;
+  mlbFiles.push_back (mlb1);
+  mlbFiles.push_back (mlb2);
+  std::vector<std::string> mroFiles;
+  mroFiles.push_back (mro1);
+  mroFiles.push_back (mro2);
+
+  QTablePolicy policy;
+  NS_TEST_ASSERT_MSG_EQ (policy.ImportCsv (mlbFiles, mroFiles), true, "import failed");
+  NS_TEST_ASSERT_MSG_EQ (policy.GetNCells (), 2, "wrong number of cells");
+
+  NS_TEST_ASSERT_MSG_EQ (policy.GetMlbAction (0, 0), 0, "wrong greedy action on ties");
+  NS_TEST_ASSERT_MSG_EQ (policy.GetMlbAction (0, 1), 1, "wrong greedy action on ties");
+  NS_TEST_ASSERT_MSG_EQ (policy.GetMlbAction (0, 2), 2, "wrong greedy action with NaN");
+  NS_TEST_ASSERT_MSG_EQ (policy.GetMlbAction (0, 3), 4, "wrong greedy action");
+  NS_TEST_ASSERT_MSG_EQ (policy.GetMlbAction (1, 0), 0, "wrong greedy action");
+
+  // 5 actions are the CIOs -2..2 dB, 3 actions -1..1 dB
+  NS_TEST_ASSERT_MSG_EQ ((int) policy.GetCio (0, 0), -2, "wrong CIO");
+  NS_TEST_ASSERT_MSG_EQ ((int) policy.GetCio (0, 3), 2, "wrong CIO");
+  NS_TEST_ASSERT_MSG_EQ ((int) policy.GetCio (1, 0), -1, "wrong CIO");
+
+  for (uint32_t s = 0; s < best1.size (); ++s)
+    {
+      NS_TEST_ASSERT_MSG_EQ (policy.GetMroAction (0, s), best1[s], "wrong MRO action");
+    }
+  NS_TEST_ASSERT_MSG_EQ (policy.GetHom (0, 0), 0, "wrong HOM");
+  NS_TEST_ASSERT_MSG_EQ (policy.GetTtt (0, 0), 100, "wrong TTT");
+  NS_TEST_ASSERT_MSG_EQ (policy.GetHom (0, 1), 6, "wrong HOM");
+  NS_TEST_ASSERT_MSG_EQ (policy.GetTtt (0, 1), 640, "wrong TTT");
+  // 23 = 3 * 7 + 2
+  NS_TEST_ASSERT_MSG_EQ (policy.GetHom (0, 2), 3, "wrong HOM");
+  NS_TEST_ASSERT_MSG_EQ (policy.GetTtt (0, 2), 256, "wrong TTT");
+  // 9 = 1 * 7 + 2
+  NS_TEST_ASSERT_MSG_EQ (policy.GetHom (1, 0), 1, "wrong HOM");
+  NS_TEST_ASSERT_MSG_EQ (policy.GetTtt (1, 0), 256, "wrong TTT");
+
+  // invalid tables: ragged rows, MRO tables without 49 actions
+  {
+    std::ofstream ofs (mlb2.c_str ());
+    ofs << "3,2,1\n4,5\n";
+  }
+  QTablePolicy invalid;
+  NS_TEST_ASSERT_MSG_EQ (invalid.ImportCsv (mlbFiles, mroFiles), false, "ragged table imported");
+  mlbFiles.pop_back ();
+  mroFiles.pop_back ();
+  NS_TEST_ASSERT_MSG_EQ (invalid.ImportCsv (mlbFiles, mlbFiles), false, "MRO table of 5 actions imported");
+  NS_TEST_ASSERT_MSG_EQ (invalid.ImportCsv (mlbFiles, std::vector<std::string> ()), false,
+                         "unmatched MLB table imported");
+  NS_TEST_ASSERT_MSG_EQ (invalid.ImportCsv (mlbFiles, mroFiles), true, "import failed");
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test that the Q-tables saved in a binary file are loaded back
+ * unchanged, and that invalid files are rejected.
+ */
+class QTablePolicyBinaryTestCase : public TestCase
+{
+public:
+  QTablePolicyBinaryTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+QTablePolicyBinaryTestCase::QTablePolicyBinaryTestCase ()
+  : TestCase ("Q-table policy binary round trip")
+{
+}
+
+/**
+ * \param filename the name of the file
+ * \return the content of the file
+ */
+static std::string
+ReadFile (std::string filename)
+{
+  std::ifstream ifs (filename.c_str (), std::ios::binary);
+  return std::string (std::istreambuf_iterator<char> (ifs), std::istreambuf_iterator<char> ());
+}
+
+void
+QTablePolicyBinaryTestCase::DoRun (void)
+{
+  const uint32_t nCells = 3;
+  const uint32_t nMlbStates = 36;
+  const uint32_t nMroStates = 11;
+  std::vector<std::string> mlbFiles;
+  std::vector<std::string> mroFiles;
+  for (uint32_t c = 0; c < nCells; ++c)
+    {
+      std::ostringstream mlb;
+      mlb << "mlb" << c << ".csv";
+      mlbFiles.push_back (CreateTempDirFilename (mlb.str ()));
+      std::ofstream mlbOfs (mlbFiles.back ().c_str ());
+      mlbOfs.precision (17);
+      for (uint32_t s = 0; s < nMlbStates; ++s)
+        {
+          for (uint32_t a = 0; a < 9; ++a)
+            {
+              mlbOfs << (a > 0 ? "," : "") << 1.0 / (1 + (s * 7 + a * 5 + c) % 13);
+            }
+          mlbOfs << "\n";
+        }
+      std::ostringstream mro;
+      mro << "mro" << c << ".csv";
+      mroFiles.push_back (CreateTempDirFilename (mro.str ()));
+      std::vector<uint32_t> best;
+      for (uint32_t s = 0; s < nMroStates; ++s)
+        {
+          best.push_back ((s * 11 + c) % 49);
+        }
+      WriteMroCsv (mroFiles.back (), best);
+    }
+
+  QTablePolicy policy;
+  NS_TEST_ASSERT_MSG_EQ (policy.ImportCsv (mlbFiles, mroFiles), true, "import failed");
+  std::string file1 = CreateTempDirFilename ("policy1.bin");
+  NS_TEST_ASSERT_MSG_EQ (policy.Save (file1), true, "save failed");
+
+  QTablePolicy loaded;
+  NS_TEST_ASSERT_MSG_EQ (loaded.Load (file1), true, "load failed");
+  NS_TEST_ASSERT_MSG_EQ (loaded.GetNCells (), nCells, "wrong number of cells");
+  for (uint32_t c = 0; c < nCells; ++c)
+    {
+      for (uint32_t s = 0; s < nMlbStates; ++s)
+        {
+          NS_TEST_ASSERT_MSG_EQ (loaded.GetMlbAction (c, s), policy.GetMlbAction (c, s),
+                                 "MLB action of cell " << c << " state " << s << " changed");
+        }
+      for (uint32_t s = 0; s < nMroStates; ++s)
+        {
+          NS_TEST_ASSERT_MSG_EQ (loaded.GetMroAction (c, s), policy.GetMroAction (c, s),
+                                 "MRO action of cell " << c << " state " << s << " changed");
+        }
+    }
+
+  // the Q-values are stored exactly
+  std::string file2 = CreateTempDirFilename ("policy2.bin");
+  NS_TEST_ASSERT_MSG_EQ (loaded.Save (file2), true, "save failed");
+  std::string content = ReadFile (file1);
+  NS_TEST_ASSERT_MSG_EQ ((content == ReadFile (file2)), true, "saved tables differ");
+  uint32_t expectedSize = 12 + nCells * (16 + 8 * (nMlbStates * 9 + nMroStates * 49));
+  NS_TEST_ASSERT_MSG_EQ (content.size (), expectedSize, "wrong file size");
+  NS_TEST_ASSERT_MSG_EQ (content.substr (0, 4), "SLCQ", "wrong magic");
+
+  // truncated file, wrong magic, missing file
+  std::string invalidFile = CreateTempDirFilename ("invalid.bin");
+  {
+    std::ofstream ofs (invalidFile.c_str (), std::ios::binary);
+    ofs << content.substr (0, content.size () - 1);
+  }
+  QTablePolicy invalid;
+  NS_TEST_ASSERT_MSG_EQ (invalid.Load (invalidFile), false, "truncated file loaded");
+  {
+    std::ofstream ofs (invalidFile.c_str (), std::ios::binary);
+    ofs << "SLCX" << content.substr (4);
+  }
+  NS_TEST_ASSERT_MSG_EQ (invalid.Load (invalidFile), false, "file with a wrong magic loaded");
+  NS_TEST_ASSERT_MSG_EQ (invalid.Load (CreateTempDirFilename ("missing.bin")), false,
+                         "missing file loaded");
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief QTablePolicy test suite
+ */
+class QTablePolicyTestSuite : public TestSuite
+{
+public:
+  QTablePolicyTestSuite ();
+};
+
+QTablePolicyTestSuite::QTablePolicyTestSuite ()
+  : TestSuite ("lte-q-table-policy", UNIT)
+{
+  AddTestCase (new QTablePolicyCsvTestCase (), TestCase::QUICK);
+  AddTestCase (new QTablePolicyBinaryTestCase (), TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static QTablePolicyTestSuite qTablePolicyTestSuite;
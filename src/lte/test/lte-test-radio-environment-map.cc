@@ -0,0 +1,271 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include "ns3/string.h"
+#include "ns3/enum.h"
+#include "ns3/node-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/lte-helper.h"
+#include "ns3/spectrum-channel.h"
+#include "ns3/radio-environment-map-helper.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/three-gpp-propagation-loss-model.h"
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestRadioEnvironmentMap");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test that the analytical Radio Environment Map, computed by one
+ * or several threads and saved as text or numpy array, matches the map
+ * sampled by the event-driven RemSpectrumPhy listeners.
+ */
+class LteRadioEnvironmentMapTestCase : public TestCase
+{
+public:
+  LteRadioEnvironmentMapTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Create a REM helper for the DL channel of the scenario.
+   *
+   * \param channelPath the path of the DL channel
+   * \param file the output file
+   * \param mode the REM mode
+   * \param threads the number of threads
+   * \return the REM helper
+   */
+  Ptr<RadioEnvironmentMapHelper> InstallRem (std::string channelPath, std::string file,
+                                             RadioEnvironmentMapHelper::RemMode mode,
+                                             uint32_t threads);
+
+  /**
+   * Read the SINR column of a REM in text format.
+   *
+   * \param file the REM file
+   * \return the SINR of each point
+   */
+  std::vector<double> ReadText (std::string file);
+
+  /**
+   * Read a REM in numpy format.
+   *
+   * \param file the REM file
+   * \param [out] shape the shape of the array
+   * \return the SINR of each point
+   */
+  std::vector<double> ReadNpy (std::string file, std::string &shape);
+};
+
+LteRadioEnvironmentMapTestCase::LteRadioEnvironmentMapTestCase ()
+  : TestCase ("Analytical REM matches the event-driven REM")
+{
+}
+
+Ptr<RadioEnvironmentMapHelper>
+LteRadioEnvironmentMapTestCase::InstallRem (std::string channelPath, std::string file,
+                                            RadioEnvironmentMapHelper::RemMode mode,
+                                            uint32_t threads)
+{
+  Ptr<RadioEnvironmentMapHelper> rem = CreateObject<RadioEnvironmentMapHelper> ();
+  rem->SetAttribute ("ChannelPath", StringValue (channelPath));
+  rem->SetAttribute ("OutputFile", StringValue (file));
+  rem->SetAttribute ("XMin", DoubleValue (-100.0));
+  rem->SetAttribute ("XMax", DoubleValue (400.0));
+  rem->SetAttribute ("XRes", UintegerValue (11));
+  rem->SetAttribute ("YMin", DoubleValue (-100.0));
+  rem->SetAttribute ("YMax", DoubleValue (100.0));
+  rem->SetAttribute ("YRes", UintegerValue (7));
+  rem->SetAttribute ("Z", DoubleValue (1.5));
+  rem->SetAttribute ("StopWhenDone", BooleanValue (false));
+  rem->SetAttribute ("Mode", EnumValue (mode));
+  rem->SetAttribute ("Threads", UintegerValue (threads));
+  rem->Install ();
+  return rem;
+}
+
+std::vector<double>
+LteRadioEnvironmentMapTestCase::ReadText (std::string file)
+{
+  std::vector<double> sinr;
+  std::ifstream in (file.c_str ());
+  double x, y, z, s;
+  while (in >> x >> y >> z >> s)
+    {
+      sinr.push_back (s);
+    }
+  return sinr;
+}
+
+std::vector<double>
+LteRadioEnvironmentMapTestCase::ReadNpy (std::string file, std::string &shape)
+{
+  std::ifstream in (file.c_str (), std::ios::binary);
+  char magic[8];
+  unsigned char headerLen[2];
+  in.read (magic, sizeof (magic));
+  in.read (reinterpret_cast<char *> (headerLen), sizeof (headerLen));
+  NS_TEST_EXPECT_MSG_EQ (std::memcmp (magic, "\x93NUMPY\x01\x00", 8), 0, "wrong numpy magic string");
+  uint16_t len = headerLen[0] | (headerLen[1] << 8);
+  NS_TEST_EXPECT_MSG_EQ ((10 + len) % 64, 0, "numpy data is not aligned");
+  std::string header (len, ' ');
+  in.read (&header[0], len);
+  std::string::size_type begin = header.find ("'shape': (");
+  std::string::size_type end = header.find (")", begin);
+  if (begin != std::string::npos && end != std::string::npos)
+    {
+      shape = header.substr (begin + 10, end - begin - 10);
+    }
+  std::vector<double> sinr;
+  double s;
+  while (in.read (reinterpret_cast<char *> (&s), sizeof (s)))
+    {
+      sinr.push_back (s);
+    }
+  return sinr;
+}
+
+void
+LteRadioEnvironmentMapTestCase::DoRun (void)
+{
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  NodeContainer enbNodes;
+  enbNodes.Create (3);
+  Ptr<ListPositionAllocator> positions = CreateObject<ListPositionAllocator> ();
+  positions->Add (Vector (0.0, 0.0, 30.0));
+  positions->Add (Vector (150.0, 50.0, 30.0));
+  positions->Add (Vector (300.0, -20.0, 30.0));
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.SetPositionAllocator (positions);
+  mobility.Install (enbNodes);
+  lteHelper->InstallEnbDevice (enbNodes);
+
+  std::ostringstream channelPath;
+  channelPath << "/ChannelList/" << lteHelper->GetDownlinkSpectrumChannel ()->GetId ();
+  std::string eventFile = CreateTempDirFilename ("rem-event-driven.out");
+  std::string analyticalFile = CreateTempDirFilename ("rem-analytical.out");
+  std::string npyFile = CreateTempDirFilename ("rem-analytical.npy");
+  Ptr<RadioEnvironmentMapHelper> eventRem =
+    InstallRem (channelPath.str (), eventFile, RadioEnvironmentMapHelper::EVENT_DRIVEN, 1);
+  Ptr<RadioEnvironmentMapHelper> analyticalRem =
+    InstallRem (channelPath.str (), analyticalFile, RadioEnvironmentMapHelper::ANALYTICAL, 1);
+  Ptr<RadioEnvironmentMapHelper> npyRem =
+    InstallRem (channelPath.str (), npyFile, RadioEnvironmentMapHelper::ANALYTICAL, 4);
+
+  Simulator::Stop (Seconds (0.05));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  std::vector<double> expected = ReadText (eventFile);
+  std::vector<double> analytical = ReadText (analyticalFile);
+  std::string shape;
+  std::vector<double> npy = ReadNpy (npyFile, shape);
+
+  NS_TEST_ASSERT_MSG_EQ (expected.size (), 11 * 7, "wrong number of event-driven REM points");
+  NS_TEST_ASSERT_MSG_EQ (analytical.size (), expected.size (), "wrong number of analytical REM points");
+  NS_TEST_ASSERT_MSG_EQ (npy.size (), expected.size (), "wrong number of numpy REM points");
+  NS_TEST_ASSERT_MSG_EQ (shape, "11, 7", "wrong numpy shape");
+  for (uint32_t i = 0; i < expected.size (); ++i)
+    {
+      // the text output has six significant digits
+      double tolerance = 1e-5 * expected[i];
+      NS_TEST_ASSERT_MSG_EQ_TOL (analytical[i], expected[i], tolerance, "wrong analytical SINR at point " << i);
+      NS_TEST_ASSERT_MSG_EQ_TOL (npy[i], expected[i], tolerance, "wrong multi-threaded SINR at point " << i);
+    }
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test that the analytical Radio Environment Map is computed by
+ * several threads only with stateless propagation loss models, including
+ * the models chained after the first one.
+ */
+class LteRadioEnvironmentMapThreadSafeTestCase : public TestCase
+{
+public:
+  LteRadioEnvironmentMapThreadSafeTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteRadioEnvironmentMapThreadSafeTestCase::LteRadioEnvironmentMapThreadSafeTestCase ()
+  : TestCase ("Analytical REM threads only with stateless propagation loss models")
+{
+}
+
+void
+LteRadioEnvironmentMapThreadSafeTestCase::DoRun (void)
+{
+  NS_TEST_ASSERT_MSG_EQ (RadioEnvironmentMapHelper::IsThreadSafe (0), true,
+                         "no propagation loss model");
+  Ptr<PropagationLossModel> friis = CreateObject<FriisPropagationLossModel> ();
+  NS_TEST_ASSERT_MSG_EQ (RadioEnvironmentMapHelper::IsThreadSafe (friis), true,
+                         "Friis is stateless");
+  Ptr<PropagationLossModel> logDistance = CreateObject<LogDistancePropagationLossModel> ();
+  friis->SetNext (logDistance);
+  NS_TEST_ASSERT_MSG_EQ (RadioEnvironmentMapHelper::IsThreadSafe (friis), true,
+                         "Friis and LogDistance are stateless");
+  logDistance->SetNext (CreateObject<NakagamiPropagationLossModel> ());
+  NS_TEST_ASSERT_MSG_EQ (RadioEnvironmentMapHelper::IsThreadSafe (friis), false,
+                         "Nakagami, chained, draws random variables");
+  NS_TEST_ASSERT_MSG_EQ (RadioEnvironmentMapHelper::IsThreadSafe (CreateObject<RandomPropagationLossModel> ()),
+                         false, "the random model draws random variables");
+  NS_TEST_ASSERT_MSG_EQ (RadioEnvironmentMapHelper::IsThreadSafe (CreateObject<ThreeGppUmaPropagationLossModel> ()),
+                         false, "the 3GPP models cache the channel conditions and the shadowing");
+}
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Radio Environment Map test suite.
+ */
+class LteRadioEnvironmentMapTestSuite : public TestSuite
+{
+public:
+  LteRadioEnvironmentMapTestSuite ();
+};
+
+static LteRadioEnvironmentMapTestSuite g_lteRadioEnvironmentMapTestSuite; ///< the test suite
+
+LteRadioEnvironmentMapTestSuite::LteRadioEnvironmentMapTestSuite ()
+  : TestSuite ("lte-radio-environment-map", SYSTEM)
+{
+  AddTestCase (new LteRadioEnvironmentMapTestCase, TestCase::QUICK);
+  AddTestCase (new LteRadioEnvironmentMapThreadSafeTestCase, TestCase::QUICK);
+}
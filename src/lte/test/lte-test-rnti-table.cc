@@ -0,0 +1,139 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/rnti-table.h"
+#include <map>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestRntiTable");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test that an RntiTable holds the same values as a std::map
+ * through insertions, erasures with slot reuse, and clearing.
+ */
+class LteRntiTableTestCase : public TestCase
+{
+public:
+  LteRntiTableTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Check the table against the reference map.
+   *
+   * \param table the table under test
+   * \param reference the reference map
+   * \param msg the message of the failures
+   */
+  void Check (const RntiTable<uint32_t> &table, const std::map<uint16_t, uint32_t> &reference,
+              std::string msg);
+};
+
+LteRntiTableTestCase::LteRntiTableTestCase ()
+  : TestCase ("RNTI table against std::map")
+{
+}
+
+void
+LteRntiTableTestCase::Check (const RntiTable<uint32_t> &table,
+                             const std::map<uint16_t, uint32_t> &reference, std::string msg)
+{
+  NS_TEST_ASSERT_MSG_EQ (table.GetN (), reference.size (), msg << ": wrong number of RNTIs");
+  for (uint32_t rnti = 0; rnti < 1100; ++rnti)
+    {
+      std::map<uint16_t, uint32_t>::const_iterator it = reference.find (rnti);
+      bool expected = it != reference.end ();
+      const uint32_t *value = table.Find (rnti);
+      NS_TEST_ASSERT_MSG_EQ (table.Contains (rnti), expected, msg << ": RNTI " << rnti);
+      NS_TEST_ASSERT_MSG_EQ ((value != 0), expected, msg << ": value of RNTI " << rnti << " not found");
+      if (expected && value != 0)
+        {
+          NS_TEST_ASSERT_MSG_EQ (*value, it->second, msg << ": value of RNTI " << rnti);
+        }
+    }
+  bool expected = reference.find (65535) != reference.end ();
+  NS_TEST_ASSERT_MSG_EQ (table.Contains (65535), expected, msg << ": RNTI 65535");
+}
+
+void
+LteRntiTableTestCase::DoRun (void)
+{
+  RntiTable<uint32_t> table;
+  std::map<uint16_t, uint32_t> reference;
+  Check (table, reference, "empty table");
+
+  for (uint16_t rnti = 1; rnti <= 1000; ++rnti)
+    {
+      NS_TEST_ASSERT_MSG_EQ (table.Insert (rnti, rnti * 7), true, "RNTI " << rnti << " not inserted");
+      reference[rnti] = rnti * 7;
+    }
+  NS_TEST_ASSERT_MSG_EQ (table.Insert (10, 0), false, "RNTI inserted twice");
+  Check (table, reference, "after the insertions");
+
+  // the erased slots are reused by new RNTIs, as after handovers
+  for (uint16_t rnti = 2; rnti <= 1000; rnti += 3)
+    {
+      NS_TEST_ASSERT_MSG_EQ (table.Erase (rnti), true, "RNTI " << rnti << " not erased");
+      reference.erase (rnti);
+    }
+  NS_TEST_ASSERT_MSG_EQ (table.Erase (2), false, "RNTI erased twice");
+  Check (table, reference, "after the erasures");
+  for (uint16_t rnti = 1001; rnti <= 1090; ++rnti)
+    {
+      table.Insert (rnti, rnti + 1);
+      reference[rnti] = rnti + 1;
+    }
+  table.Insert (65535, 3);
+  reference[65535] = 3;
+  *table.Find (1) = 42;
+  reference[1] = 42;
+  Check (table, reference, "after the reuse of the slots");
+
+  table.Clear ();
+  reference.clear ();
+  Check (table, reference, "after the clearing");
+  table.Insert (5, 6);
+  reference[5] = 6;
+  Check (table, reference, "after an insertion in the cleared table");
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief RNTI table test suite
+ */
+class LteRntiTableTestSuite : public TestSuite
+{
+public:
+  LteRntiTableTestSuite ();
+};
+
+LteRntiTableTestSuite::LteRntiTableTestSuite ()
+  : TestSuite ("lte-rnti-table", UNIT)
+{
+  AddTestCase (new LteRntiTableTestCase (), TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static LteRntiTableTestSuite lteRntiTableTestSuite;
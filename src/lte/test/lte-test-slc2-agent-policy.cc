@@ -0,0 +1,153 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/q-table-policy.h"
+#include "ns3/dqn-policy.h"
+#include "ns3/slc2-agent-policy.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestSlc2AgentPolicy");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test that Slc2AgentPolicy applies the actions of the small SLC2
+ * agent, step by step, for an episode of its trace. The traces and the
+ * Q-tables are generated by reference/generate-slc2-agent-trace.py, which
+ * runs the main code of the agent; without coordinator, the agent runs
+ * with a coordinator always applying the new actions.
+ */
+class Slc2AgentPolicyTraceTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param withCoordinator true to use the coordinator of the trace
+   */
+  Slc2AgentPolicyTraceTestCase (bool withCoordinator);
+
+private:
+  virtual void DoRun (void);
+
+  bool m_withCoordinator; ///< whether the coordinator of the trace is used
+};
+
+Slc2AgentPolicyTraceTestCase::Slc2AgentPolicyTraceTestCase (bool withCoordinator)
+  : TestCase (withCoordinator ? "SLC2 agent trace with coordinator"
+              : "SLC2 agent trace without coordinator"),
+    m_withCoordinator (withCoordinator)
+{
+}
+
+void
+Slc2AgentPolicyTraceTestCase::DoRun (void)
+{
+  const uint32_t nCells = 5;
+  SetDataDir (NS_TEST_SOURCEDIR);
+  std::vector<std::string> mlbFiles;
+  std::vector<std::string> mroFiles;
+  for (uint32_t cell = 1; cell <= nCells; ++cell)
+    {
+      std::ostringstream oss;
+      oss << "reference/slc2-agent-small/Qtable" << cell;
+      mlbFiles.push_back (CreateDataDirFilename (oss.str () + "_QMLB_Mid.csv"));
+      mroFiles.push_back (CreateDataDirFilename (oss.str () + "_QMRO_Mid.csv"));
+    }
+  Ptr<QTablePolicy> tables = Create<QTablePolicy> ();
+  NS_TEST_ASSERT_MSG_EQ (tables->ImportCsv (mlbFiles, mroFiles), true, "cannot import the Q-tables");
+  Ptr<DqnPolicy> coordinator;
+  if (m_withCoordinator)
+    {
+      coordinator = Create<DqnPolicy> ();
+      NS_TEST_ASSERT_MSG_EQ (coordinator->Load (CreateDataDirFilename ("reference/slc2-coordinator-small.bin")),
+                             true, "cannot load the coordinator");
+    }
+  Ptr<Slc2AgentPolicy> policy = Create<Slc2AgentPolicy> (tables, coordinator);
+  NS_TEST_ASSERT_MSG_EQ (policy->GetNCells (), nCells, "wrong number of cells");
+
+  // one row per step: the enbMLBstate, AverageVelocity, AvgCqi, dlPrbusage
+  // and enbBestCell observations, the action of the coordinator, then the
+  // actions of the agent
+  std::string trace = m_withCoordinator ? "trace-coordinator.csv" : "trace-tables.csv";
+  std::ifstream ifs (CreateDataDirFilename ("reference/slc2-agent-small/" + trace).c_str ());
+  NS_TEST_ASSERT_MSG_EQ (ifs.is_open (), true, "cannot open the trace " << trace);
+  std::string line;
+  uint32_t nSteps = 0;
+  while (std::getline (ifs, line))
+    {
+      std::vector<float> values;
+      const char *p = line.c_str ();
+      char *end;
+      for (double v = std::strtod (p, &end); end != p; v = std::strtod (p, &end))
+        {
+          values.push_back (v);
+          p = *end == ',' ? end + 1 : end;
+        }
+      NS_TEST_ASSERT_MSG_EQ (values.size (), 8 * nCells + 1, "wrong row " << nSteps);
+      std::vector<float> mlbState (values.begin (), values.begin () + nCells);
+      std::vector<float> mroState (values.begin () + nCells, values.begin () + 2 * nCells);
+      std::vector<float> observations (values.begin () + 2 * nCells, values.begin () + 5 * nCells);
+      uint32_t coordinatorAction = values[5 * nCells];
+
+      const std::vector<float> &actions = policy->Step (mlbState, mroState, observations);
+      NS_TEST_ASSERT_MSG_EQ (policy->GetCoordinatorAction (), coordinatorAction,
+                             "wrong action of the coordinator at step " << nSteps);
+      NS_TEST_ASSERT_MSG_EQ (actions.size (), 3 * nCells, "wrong number of actions");
+      for (uint32_t a = 0; a < 3 * nCells; ++a)
+        {
+          NS_TEST_ASSERT_MSG_EQ (actions[a], values[5 * nCells + 1 + a],
+                                 "wrong action " << a << " at step " << nSteps);
+        }
+      ++nSteps;
+    }
+  NS_TEST_ASSERT_MSG_EQ (nSteps, 30, "wrong number of steps");
+  NS_TEST_ASSERT_MSG_EQ (policy->GetNSteps (), 30, "wrong number of steps of the policy");
+
+  // a new episode starts again from the first step
+  policy->Reset ();
+  NS_TEST_ASSERT_MSG_EQ (policy->GetNSteps (), 0, "steps not reset");
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Slc2AgentPolicy test suite
+ */
+class Slc2AgentPolicyTestSuite : public TestSuite
+{
+public:
+  Slc2AgentPolicyTestSuite ();
+};
+
+Slc2AgentPolicyTestSuite::Slc2AgentPolicyTestSuite ()
+  : TestSuite ("lte-slc2-agent-policy", UNIT)
+{
+  AddTestCase (new Slc2AgentPolicyTraceTestCase (false), TestCase::QUICK);
+  AddTestCase (new Slc2AgentPolicyTraceTestCase (true), TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static Slc2AgentPolicyTestSuite slc2AgentPolicyTestSuite;
@@ -0,0 +1,217 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/config.h"
+#include "ns3/uinteger.h"
+#include "ns3/boolean.h"
+#include "ns3/string.h"
+#include "ns3/enum.h"
+#include "ns3/node-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/lte-helper.h"
+#include "ns3/lte-enb-rrc.h"
+#include "ns3/eps-bearer.h"
+#include "ns3/lte-traffic-generator.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestTrafficGenerator");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test that the LteTrafficGenerator loads the downlink data radio
+ * bearer of a UE, without EPC, according to its traffic model.
+ */
+class LteTrafficGeneratorTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param model the traffic model
+   * \param mappingAfterInstall if true, set the RLC mapping of the eNB with
+   *        Config::Set after its installation instead of as a default
+   */
+  LteTrafficGeneratorTestCase (LteTrafficGenerator::Model model, bool mappingAfterInstall);
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * PDU received by the PDCP of the UE
+   *
+   * \param context the context
+   * \param rnti the RNTI
+   * \param lcid the LCID
+   * \param size the size of the PDU
+   * \param delay the delay of the PDU
+   */
+  void RxPdu (std::string context, uint16_t rnti, uint8_t lcid, uint32_t size, uint64_t delay);
+
+  LteTrafficGenerator::Model m_model; ///< the traffic model
+  bool m_mappingAfterInstall;         ///< set the RLC mapping of the eNB after its installation
+  uint64_t m_rxBytes;                 ///< bytes received by the PDCP of the UE
+};
+
+/// \return the name of the test case of the traffic model
+static std::string
+BuildNameString (LteTrafficGenerator::Model model, bool mappingAfterInstall)
+{
+  std::string name;
+  switch (model)
+    {
+    case LteTrafficGenerator::FULL_BUFFER:
+      name = "Full buffer traffic generator";
+      break;
+    case LteTrafficGenerator::CBR:
+      name = "CBR traffic generator";
+      break;
+    default:
+      name = "FTP model 3 traffic generator";
+      break;
+    }
+  return mappingAfterInstall ? name + ", RLC mapping set after install" : name;
+}
+
+LteTrafficGeneratorTestCase::LteTrafficGeneratorTestCase (LteTrafficGenerator::Model model, bool mappingAfterInstall)
+  : TestCase (BuildNameString (model, mappingAfterInstall)),
+    m_model (model),
+    m_mappingAfterInstall (mappingAfterInstall),
+    m_rxBytes (0)
+{
+}
+
+void
+LteTrafficGeneratorTestCase::RxPdu (std::string context, uint16_t rnti, uint8_t lcid,
+                                    uint32_t size, uint64_t delay)
+{
+  m_rxBytes += size;
+}
+
+/**
+ * Connect the trace of the PDCP of the UE, once the bearer is set up.
+ *
+ * \param cb the trace sink
+ */
+static void
+ConnectUePdcp (Callback<void, std::string, uint16_t, uint8_t, uint32_t, uint64_t> cb)
+{
+  Config::Connect ("/NodeList/*/DeviceList/*/LteUeRrc/DataRadioBearerMap/*/LtePdcp/RxPDU", cb);
+}
+
+void
+LteTrafficGeneratorTestCase::DoRun (void)
+{
+  Config::Reset ();
+  Config::SetDefault ("ns3::LteSpectrumPhy::CtrlErrorModelEnabled", BooleanValue (false));
+  Config::SetDefault ("ns3::LteSpectrumPhy::DataErrorModelEnabled", BooleanValue (false));
+  Config::SetDefault ("ns3::LteHelper::UseIdealRrc", BooleanValue (true));
+  if (!m_mappingAfterInstall)
+    {
+      Config::SetDefault ("ns3::LteEnbRrc::EpsBearerToRlcMapping", EnumValue (LteEnbRrc::RLC_UM_ALWAYS));
+    }
+
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+
+  NodeContainer enbNodes;
+  NodeContainer ueNodes;
+  enbNodes.Create (1);
+  ueNodes.Create (1);
+
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, 0.0, 0.0));
+  positionAlloc->Add (Vector (50.0, 0.0, 0.0));
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (enbNodes);
+  mobility.Install (ueNodes);
+
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+  if (m_mappingAfterInstall)
+    {
+      // the UE takes the mapping of the eNB when its bearer is activated
+      Config::Set ("/NodeList/*/DeviceList/*/LteEnbRrc/EpsBearerToRlcMapping", EnumValue (LteEnbRrc::RLC_UM_ALWAYS));
+    }
+  lteHelper->Attach (ueDevs, enbDevs.Get (0));
+  lteHelper->ActivateDataRadioBearer (ueDevs, EpsBearer (EpsBearer::NGBR_VIDEO_TCP_DEFAULT));
+
+  Ptr<LteTrafficGenerator> generator = CreateObject<LteTrafficGenerator> ();
+  generator->SetAttribute ("Model", EnumValue (m_model));
+  generator->SetAttribute ("PacketSize", UintegerValue (500));
+  generator->SetAttribute ("FileSize", StringValue ("ns3::ConstantRandomVariable[Constant=20000]"));
+  generator->SetAttribute ("FileInterArrival", StringValue ("ns3::ConstantRandomVariable[Constant=0.4]"));
+  ueNodes.Get (0)->AddApplication (generator);
+  generator->SetStartTime (Seconds (0.1));
+  generator->SetStopTime (Seconds (0.9));
+
+  Simulator::Schedule (Seconds (0.1), &ConnectUePdcp,
+                       MakeCallback (&LteTrafficGeneratorTestCase::RxPdu, this));
+  Simulator::Stop (Seconds (1.0));
+  Simulator::Run ();
+
+  NS_LOG_INFO ("tx " << generator->GetTxBytes () << " rx " << m_rxBytes);
+  switch (m_model)
+    {
+    case LteTrafficGenerator::FULL_BUFFER:
+      // the RLC buffer is kept at the backlog, the bearer is saturated
+      NS_TEST_ASSERT_MSG_GT (m_rxBytes, 500000, "full buffer bearer not saturated");
+      break;
+
+    case LteTrafficGenerator::CBR:
+      // 80 SDUs of 500 bytes, plus a 2-byte PDCP header each
+      NS_TEST_ASSERT_MSG_EQ (generator->GetTxBytes (), 80 * 500, "wrong CBR offered load");
+      NS_TEST_ASSERT_MSG_EQ (m_rxBytes, 80 * 502, "CBR SDUs not delivered");
+      break;
+
+    default:
+      // files at 0.1, 0.5 s, each of them 40 SDUs of 500 bytes
+      NS_TEST_ASSERT_MSG_EQ (generator->GetTxBytes (), 2 * 20000, "wrong FTP offered load");
+      NS_TEST_ASSERT_MSG_EQ (m_rxBytes, 2 * 40 * 502, "FTP files not delivered");
+      break;
+    }
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief LteTrafficGenerator test suite
+ */
+class LteTrafficGeneratorTestSuite : public TestSuite
+{
+public:
+  LteTrafficGeneratorTestSuite ();
+};
+
+LteTrafficGeneratorTestSuite::LteTrafficGeneratorTestSuite ()
+  : TestSuite ("lte-traffic-generator", SYSTEM)
+{
+  AddTestCase (new LteTrafficGeneratorTestCase (LteTrafficGenerator::FULL_BUFFER, false), TestCase::QUICK);
+  AddTestCase (new LteTrafficGeneratorTestCase (LteTrafficGenerator::CBR, false), TestCase::QUICK);
+  AddTestCase (new LteTrafficGeneratorTestCase (LteTrafficGenerator::FTP_MODEL_3, false), TestCase::QUICK);
+  AddTestCase (new LteTrafficGeneratorTestCase (LteTrafficGenerator::CBR, true), TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static LteTrafficGeneratorTestSuite lteTrafficGeneratorTestSuite;
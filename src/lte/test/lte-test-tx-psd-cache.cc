@@ -0,0 +1,175 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/config.h"
+#include "ns3/node-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/lte-helper.h"
+#include "ns3/lte-enb-net-device.h"
+#include "ns3/lte-enb-phy.h"
+#include "ns3/lte-spectrum-value-helper.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestTxPsdCache");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test that the eNB PHY reuses its TX PSDs while their parameters
+ * do not change, and that the PSDs are those created from the parameters.
+ */
+class LteTxPsdCacheTestCase : public TestCase
+{
+public:
+  LteTxPsdCacheTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /// Check the PSDs of the PHY, between two subframes
+  void Check (void);
+
+  /**
+   * Check that two PSDs have the same values.
+   *
+   * \param psd the PSD under test
+   * \param expected the expected PSD
+   * \param msg the message of the failures
+   */
+  void CheckPsd (Ptr<SpectrumValue> psd, Ptr<SpectrumValue> expected, std::string msg);
+
+  Ptr<LteEnbNetDevice> m_enbDev; ///< the eNB device
+};
+
+LteTxPsdCacheTestCase::LteTxPsdCacheTestCase ()
+  : TestCase ("Memoized TX PSDs of the eNB PHY")
+{
+}
+
+void
+LteTxPsdCacheTestCase::CheckPsd (Ptr<SpectrumValue> psd, Ptr<SpectrumValue> expected, std::string msg)
+{
+  NS_TEST_ASSERT_MSG_EQ (psd->GetValuesN (), expected->GetValuesN (), msg);
+  for (uint32_t i = 0; i < psd->GetValuesN (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ ((*psd)[i], (*expected)[i], msg << ", RB " << i);
+    }
+}
+
+void
+LteTxPsdCacheTestCase::Check (void)
+{
+  Ptr<LteEnbPhy> phy = m_enbDev->GetPhy ();
+  uint32_t earfcn = m_enbDev->GetDlEarfcn ();
+  uint16_t bandwidth = m_enbDev->GetDlBandwidth ();
+
+  std::vector<int> rbs;
+  for (int i = 0; i < bandwidth / 2; ++i)
+    {
+      rbs.push_back (i);
+    }
+  phy->SetTxPower (30);
+  phy->SetDownlinkSubChannels (rbs);
+  Ptr<SpectrumValue> psd = phy->CreateTxPowerSpectralDensity ();
+  NS_TEST_ASSERT_MSG_EQ (phy->CreateTxPowerSpectralDensity (), psd, "PSD not reused");
+  CheckPsd (psd, LteSpectrumValueHelper::CreateTxPowerSpectralDensity (earfcn, bandwidth, 30, rbs),
+            "wrong PSD");
+
+  // a new power or a new mask give a new PSD
+  phy->SetTxPower (20);
+  Ptr<SpectrumValue> psd2 = phy->CreateTxPowerSpectralDensity ();
+  NS_TEST_ASSERT_MSG_NE (psd2, psd, "PSD of the previous power reused");
+  CheckPsd (psd2, LteSpectrumValueHelper::CreateTxPowerSpectralDensity (earfcn, bandwidth, 20, rbs),
+            "wrong PSD after the power change");
+  rbs.push_back (bandwidth - 1);
+  phy->SetDownlinkSubChannels (rbs);
+  Ptr<SpectrumValue> psd3 = phy->CreateTxPowerSpectralDensity ();
+  NS_TEST_ASSERT_MSG_NE (psd3, psd2, "PSD of the previous mask reused");
+  CheckPsd (psd3, LteSpectrumValueHelper::CreateTxPowerSpectralDensity (earfcn, bandwidth, 20, rbs),
+            "wrong PSD after the mask change");
+
+  // the power allocation is part of the key of the data PSD
+  std::map<int, double> powerTxMap;
+  for (std::vector<int>::const_iterator it = rbs.begin (); it != rbs.end (); ++it)
+    {
+      phy->GeneratePowerAllocationMap (1, *it);
+      powerTxMap[*it] = 20;
+    }
+  Ptr<SpectrumValue> psd4 = phy->CreateTxPowerSpectralDensityWithPowerAllocation ();
+  NS_TEST_ASSERT_MSG_EQ (phy->CreateTxPowerSpectralDensityWithPowerAllocation (), psd4,
+                         "PSD with power allocation not reused");
+  CheckPsd (psd4, LteSpectrumValueHelper::CreateTxPowerSpectralDensity (earfcn, bandwidth, 20, powerTxMap, rbs),
+            "wrong PSD with power allocation");
+  NS_TEST_ASSERT_MSG_EQ (phy->CreateTxPowerSpectralDensity (), psd3,
+                         "PSD without power allocation not kept");
+
+  rbs.push_back (bandwidth - 2);
+  phy->SetDownlinkSubChannels (rbs);
+  phy->GeneratePowerAllocationMap (1, bandwidth - 2);
+  powerTxMap[bandwidth - 2] = 20;
+  Ptr<SpectrumValue> psd5 = phy->CreateTxPowerSpectralDensityWithPowerAllocation ();
+  NS_TEST_ASSERT_MSG_NE (psd5, psd4, "PSD of the previous power allocation reused");
+  CheckPsd (psd5, LteSpectrumValueHelper::CreateTxPowerSpectralDensity (earfcn, bandwidth, 20, powerTxMap, rbs),
+            "wrong PSD after the power allocation change");
+}
+
+void
+LteTxPsdCacheTestCase::DoRun (void)
+{
+  Config::Reset ();
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+
+  NodeContainer enbNodes;
+  enbNodes.Create (1);
+  MobilityHelper mobility;
+  mobility.Install (enbNodes);
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  m_enbDev = enbDevs.Get (0)->GetObject<LteEnbNetDevice> ();
+
+  // between the start of the first and of the second subframes
+  Simulator::Schedule (MicroSeconds (500), &LteTxPsdCacheTestCase::Check, this);
+  Simulator::Stop (MicroSeconds (600));
+  Simulator::Run ();
+
+  m_enbDev = 0;
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief TX PSD cache test suite
+ */
+class LteTxPsdCacheTestSuite : public TestSuite
+{
+public:
+  LteTxPsdCacheTestSuite ();
+};
+
+LteTxPsdCacheTestSuite::LteTxPsdCacheTestSuite ()
+  : TestSuite ("lte-tx-psd-cache", UNIT)
+{
+  AddTestCase (new LteTxPsdCacheTestCase (), TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static LteTxPsdCacheTestSuite lteTxPsdCacheTestSuite;
@@ -0,0 +1,176 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/lte-spectrum-value-helper.h"
+#include "ns3/lte-ue-phy.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestUePhyRePower");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test that the RSRP and RSRQ of LteUePhy, whose RE power sums are
+ * computed over partial sums and scaled once, and whose RSSI is computed
+ * once for all the measured cells, match, within a tolerance, the per-RB
+ * and per-cell computation they replaced, for random PSDs spanning
+ * several orders of magnitude.
+ */
+class LteUePhyRePowerTestCase : public TestCase
+{
+public:
+  LteUePhyRePowerTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Previous computation of the RE power sum, RB by RB.
+   *
+   * \param psd the PSD [W/Hz]
+   * \return the sum of the RE powers [W]
+   */
+  static double RefSumRePower (const SpectrumValue& psd);
+  /**
+   * Previous computation of the RSSI, RB by RB, for each measured cell.
+   *
+   * \param interference the interference plus noise PSD of the RS [W/Hz]
+   * \param signal the received PSD of the RS of the serving cell [W/Hz]
+   * \return the sum of the RSSI of the RBs [W]
+   */
+  static double RefRsRssi (const SpectrumValue& interference, const SpectrumValue& signal);
+};
+
+LteUePhyRePowerTestCase::LteUePhyRePowerTestCase ()
+  : TestCase ("RSRP and RSRQ of LteUePhy against the per-RB computation")
+{
+}
+
+double
+LteUePhyRePowerTestCase::RefSumRePower (const SpectrumValue& psd)
+{
+  double sum = 0.0;
+  for (Values::const_iterator it = psd.ConstValuesBegin (); it != psd.ConstValuesEnd (); it++)
+    {
+      sum += ((*it) * 180000.0) / 12.0;
+    }
+  return sum;
+}
+
+double
+LteUePhyRePowerTestCase::RefRsRssi (const SpectrumValue& interference, const SpectrumValue& signal)
+{
+  double rssiSum = 0.0;
+  Values::const_iterator itIntN = interference.ConstValuesBegin ();
+  for (Values::const_iterator itPj = signal.ConstValuesBegin ();
+       itPj != signal.ConstValuesEnd (); itIntN++, itPj++)
+    {
+      double interfPlusNoisePowerTxW = ((*itIntN) * 180000.0) / 12.0;
+      double signalPowerTxW = ((*itPj) * 180000.0) / 12.0;
+      rssiSum += (2 * (interfPlusNoisePowerTxW + signalPowerTxW));
+    }
+  return rssiSum;
+}
+
+void
+LteUePhyRePowerTestCase::DoRun (void)
+{
+  // the relative error of a sum of at most 100 positive values is below
+  // 100 times the double precision epsilon, about 2e-14
+  const double relTol = 1e-12;
+  const double dbTol = 1e-10;
+  const uint16_t rbNums[] = { 6, 15, 25, 50, 75, 100 };
+  const uint32_t nTrials = 100;
+
+  Ptr<UniformRandomVariable> exponent = CreateObject<UniformRandomVariable> ();
+  exponent->SetStream (1);
+  double maxRelDiff = 0.0;
+  double maxDbDiff = 0.0;
+  for (uint32_t r = 0; r < sizeof (rbNums) / sizeof (rbNums[0]); ++r)
+    {
+      uint16_t nRb = rbNums[r];
+      Ptr<SpectrumModel> model = LteSpectrumValueHelper::GetSpectrumModel (100, nRb);
+      for (uint32_t trial = 0; trial < nTrials; ++trial)
+        {
+          SpectrumValue signal (model);
+          SpectrumValue interference (model);
+          SpectrumValue pss (model);
+          for (uint16_t rb = 0; rb < nRb; ++rb)
+            {
+              signal[rb] = std::pow (10.0, exponent->GetValue (-22, -14));
+              interference[rb] = std::pow (10.0, exponent->GetValue (-21, -16));
+              pss[rb] = std::pow (10.0, exponent->GetValue (-22, -14));
+            }
+
+          // RSRP of ReceivePss and of the RSRP trace
+          double refRsrp = RefSumRePower (pss) / nRb;
+          double rsrp = LteUePhy::SumRePower (pss) / nRb;
+          NS_TEST_ASSERT_MSG_EQ_TOL (rsrp, refRsrp, relTol * refRsrp,
+                                     "wrong RSRP for " << nRb << " RBs, trial " << trial);
+          double refRsrpDbm = 10 * std::log10 (1000 * refRsrp);
+          double rsrpDbm = 10 * std::log10 (1000 * rsrp);
+          NS_TEST_ASSERT_MSG_EQ_TOL (rsrpDbm, refRsrpDbm, dbTol,
+                                     "wrong RSRP in dBm for " << nRb << " RBs, trial " << trial);
+
+          // RSRQ of GenerateCqiRsrpRsrq
+          double refRssi = RefRsRssi (interference, signal);
+          double rssi = LteUePhy::ComputeRsRssi (interference, signal);
+          NS_TEST_ASSERT_MSG_EQ_TOL (rssi, refRssi, relTol * refRssi,
+                                     "wrong RSSI for " << nRb << " RBs, trial " << trial);
+          double refRsrqDb = 10 * std::log10 (RefSumRePower (pss) / refRssi);
+          double rsrqDb = 10 * std::log10 (LteUePhy::SumRePower (pss) / rssi);
+          NS_TEST_ASSERT_MSG_EQ_TOL (rsrqDb, refRsrqDb, dbTol,
+                                     "wrong RSRQ for " << nRb << " RBs, trial " << trial);
+
+          maxRelDiff = std::max (maxRelDiff, std::abs (rsrp - refRsrp) / refRsrp);
+          maxRelDiff = std::max (maxRelDiff, std::abs (rssi - refRssi) / refRssi);
+          maxDbDiff = std::max (maxDbDiff, std::abs (rsrpDbm - refRsrpDbm));
+          maxDbDiff = std::max (maxDbDiff, std::abs (rsrqDb - refRsrqDb));
+        }
+    }
+  NS_LOG_INFO ("largest relative difference " << maxRelDiff
+                                              << ", largest difference " << maxDbDiff << " dB");
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief LteUePhy RE power test suite
+ */
+class LteUePhyRePowerTestSuite : public TestSuite
+{
+public:
+  LteUePhyRePowerTestSuite ();
+};
+
+LteUePhyRePowerTestSuite::LteUePhyRePowerTestSuite ()
+  : TestSuite ("lte-ue-phy-re-power", UNIT)
+{
+  AddTestCase (new LteUePhyRePowerTestCase (), TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static LteUePhyRePowerTestSuite lteUePhyRePowerTestSuite;
@@ -0,0 +1,172 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/lte-ue-rrc.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestUeRrcCancelTrigger");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test that the cells removed from the waiting time-to-trigger
+ * events of LteUeRrc are removed from every trigger of the measurement
+ * identity, and that the triggers left without cell are canceled.
+ */
+class LteUeRrcCancelTriggerTestCase : public TestCase
+{
+public:
+  LteUeRrcCancelTriggerTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Queue a waiting trigger.
+   *
+   * \param queue the entering or leaving trigger queue of the UE RRC
+   * \param cells the cells of the trigger
+   */
+  void AddTrigger (std::map<uint8_t, std::list<LteUeRrc::PendingTrigger_t> > &queue,
+                   std::list<uint16_t> cells);
+
+  /**
+   * Check the cells of the waiting triggers.
+   *
+   * \param queue the entering or leaving trigger queue of the UE RRC
+   * \param expected the cells of each trigger, 0 separating the triggers
+   */
+  void CheckTriggers (std::map<uint8_t, std::list<LteUeRrc::PendingTrigger_t> > &queue,
+                      std::vector<uint16_t> expected);
+
+  /// Time-to-trigger event, which must be canceled before it runs
+  void Trigger (void);
+
+  std::vector<EventId> m_timers; ///< the time-to-trigger events, in order
+};
+
+LteUeRrcCancelTriggerTestCase::LteUeRrcCancelTriggerTestCase ()
+  : TestCase ("Removal of cells from the waiting time-to-trigger events")
+{
+}
+
+void
+LteUeRrcCancelTriggerTestCase::AddTrigger (std::map<uint8_t, std::list<LteUeRrc::PendingTrigger_t> > &queue,
+                                           std::list<uint16_t> cells)
+{
+  LteUeRrc::PendingTrigger_t trigger;
+  trigger.measId = 1;
+  trigger.concernedCells = cells;
+  trigger.timer = Simulator::Schedule (Seconds (1), &LteUeRrcCancelTriggerTestCase::Trigger, this);
+  queue[1].push_back (trigger);
+  m_timers.push_back (trigger.timer);
+}
+
+void
+LteUeRrcCancelTriggerTestCase::CheckTriggers (std::map<uint8_t, std::list<LteUeRrc::PendingTrigger_t> > &queue,
+                                              std::vector<uint16_t> expected)
+{
+  std::vector<uint16_t> actual;
+  for (std::list<LteUeRrc::PendingTrigger_t>::const_iterator it = queue[1].begin ();
+       it != queue[1].end (); ++it)
+    {
+      if (it != queue[1].begin ())
+        {
+          actual.push_back (0);
+        }
+      actual.insert (actual.end (), it->concernedCells.begin (), it->concernedCells.end ());
+    }
+  NS_TEST_ASSERT_MSG_EQ (actual.size (), expected.size (), "wrong number of cells in the triggers");
+  for (uint32_t i = 0; i < expected.size (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_EQ (actual[i], expected[i], "wrong cell " << i << " of the triggers");
+    }
+}
+
+void
+LteUeRrcCancelTriggerTestCase::Trigger (void)
+{
+  NS_TEST_ASSERT_MSG_EQ (true, false, "a time-to-trigger event ran");
+}
+
+void
+LteUeRrcCancelTriggerTestCase::DoRun (void)
+{
+  Ptr<LteUeRrc> rrc = CreateObject<LteUeRrc> ();
+  std::map<uint8_t, std::list<LteUeRrc::PendingTrigger_t> > &entering = rrc->m_enteringTriggerQueue;
+  std::map<uint8_t, std::list<LteUeRrc::PendingTrigger_t> > &leaving = rrc->m_leavingTriggerQueue;
+
+  // triggers (1, 2, 3), (2), (4, 5, 2)
+  uint16_t cells1[] = { 1, 2, 3 };
+  uint16_t cells3[] = { 4, 5, 2 };
+  AddTrigger (entering, std::list<uint16_t> (cells1, cells1 + 3));
+  AddTrigger (entering, std::list<uint16_t> (1, 2));
+  AddTrigger (entering, std::list<uint16_t> (cells3, cells3 + 3));
+
+  // the removed cells, in any order, leave (1, 3), (4, 5)
+  uint16_t removed[] = { 7, 2 };
+  rrc->CancelEnteringTrigger (1, std::list<uint16_t> (removed, removed + 2));
+  uint16_t expected1[] = { 1, 3, 0, 4, 5 };
+  CheckTriggers (entering, std::vector<uint16_t> (expected1, expected1 + 5));
+  NS_TEST_ASSERT_MSG_EQ (m_timers[0].IsRunning (), true, "trigger with cells canceled");
+  NS_TEST_ASSERT_MSG_EQ (m_timers[1].IsRunning (), false, "trigger without cell not canceled");
+
+  // removing the last cell of a trigger, then all its cells
+  rrc->CancelEnteringTrigger (1, 5);
+  rrc->CancelEnteringTrigger (1, 4);
+  uint16_t expected2[] = { 1, 3 };
+  CheckTriggers (entering, std::vector<uint16_t> (expected2, expected2 + 2));
+  NS_TEST_ASSERT_MSG_EQ (m_timers[2].IsRunning (), false, "trigger without cell not canceled");
+
+  // the leaving triggers are independent from the entering ones
+  AddTrigger (leaving, std::list<uint16_t> (1, 3));
+  rrc->CancelLeavingTrigger (1, std::list<uint16_t> (cells1, cells1 + 3));
+  CheckTriggers (leaving, std::vector<uint16_t> ());
+  NS_TEST_ASSERT_MSG_EQ (m_timers[3].IsRunning (), false, "leaving trigger not canceled");
+  CheckTriggers (entering, std::vector<uint16_t> (expected2, expected2 + 2));
+
+  rrc->CancelEnteringTrigger (1);
+  NS_TEST_ASSERT_MSG_EQ (m_timers[0].IsRunning (), false, "trigger not canceled");
+  Simulator::Run ();
+  rrc->Dispose ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief LteUeRrc time-to-trigger cancellation test suite
+ */
+class LteUeRrcCancelTriggerTestSuite : public TestSuite
+{
+public:
+  LteUeRrcCancelTriggerTestSuite ();
+};
+
+LteUeRrcCancelTriggerTestSuite::LteUeRrcCancelTriggerTestSuite ()
+  : TestSuite ("lte-ue-rrc-cancel-trigger", UNIT)
+{
+  AddTestCase (new LteUeRrcCancelTriggerTestCase, TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static LteUeRrcCancelTriggerTestSuite lteUeRrcCancelTriggerTestSuite;
@@ -0,0 +1,246 @@
+#! /usr/bin/env python3
+# -*- coding: utf-8 -*-
+## -*- Mode: python; py-indent-offset: 4; indent-tabs-mode: nil; coding: utf-8; -*-
+
+# Generate the traces of lte-test-slc2-agent-policy.cc: the actions of the
+# small SLC2 agent for an episode of random observations, in the directory
+# slc2-agent-small:
+#
+#   Qtable{1..5}_QMLB_Mid.csv  random MLB Q-tables
+#   Qtable{1..5}_QMRO_Mid.csv  random MRO Q-tables
+#   trace-coordinator.csv      the steps of the agent with the coordinator
+#                              of slc2-coordinator-small.bin
+#   trace-tables.csv           the steps of the agent with a coordinator
+#                              always applying the new actions
+#
+# Each row of a trace is a step: the enbMLBstate, AverageVelocity, AvgCqi,
+# dlPrbusage and enbBestCell observations of the 5 cells, the action of the
+# coordinator, then the 15 actions sent to the environment.
+#
+# The main code of scratch/SLC2_Agent_small.py is run as is, with a scripted
+# environment in place of ns3gym and a greedy coordinator, evaluated with
+# numpy in single precision, in place of DDQNAgent, for one episode.
+#
+# Usage, from src/lte/test/reference, after generate-slc2-dqn-fixture.py:
+#   python3 generate-slc2-agent-trace.py [--seed=1]
+
+import argparse
+import ast
+import contextlib
+import io
+import os
+import types
+
+import numpy as np
+
+AGENT = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                     '..', '..', '..', '..', 'scratch', 'SLC2_Agent_small.py')
+OUTPUT = 'slc2-agent-small'
+N_CELLS = 5
+N_STEPS = 30
+N_MLB_STATES = 6
+N_MRO_STATES = 4
+N_MLB_ACTIONS = 9
+N_MRO_ACTIONS = 49
+# smallest difference between the two largest Q-values of the coordinator,
+# for its greedy action not to depend on the order of the sums
+MIN_MARGIN = 1e-3
+
+
+def load_dqn(filename):
+    """Load the layers of a file written by export_dqn."""
+    with open(filename, 'rb') as f:
+        data = f.read()
+    assert data[:4] == b'SLCD'
+    version, n_layers = np.frombuffer(data, '<u4', 2, 4)
+    assert version == 1
+    offset = 12
+    layers = []
+    for _ in range(n_layers):
+        n_inputs, n_outputs = np.frombuffer(data, '<u4', 2, offset)
+        offset += 8
+        w = np.frombuffer(data, '<f4', n_inputs * n_outputs, offset).reshape(n_outputs, n_inputs)
+        offset += 4 * n_inputs * n_outputs
+        b = np.frombuffer(data, '<f4', n_outputs, offset)
+        offset += 4 * n_outputs
+        layers.append((w, b))
+    return layers
+
+
+class Coordinator:
+    """Greedy stand-in of DDQNAgent, or always choosing 0 without layers."""
+
+    class Action:
+        def __init__(self, action):
+            self.action = action
+
+        def unsqueeze(self, dim):
+            return self
+
+        def cpu(self):
+            return self
+
+        def numpy(self):
+            return np.array([[self.action]])
+
+        def item(self):
+            return self.action
+
+    def __init__(self, layers):
+        self.layers = layers
+        self.model = None
+
+    def act(self, state):
+        if self.layers is None:
+            return Coordinator.Action(0)
+        x = np.asarray(state, dtype=np.float32)
+        for i, (w, b) in enumerate(self.layers):
+            x = x @ w.T + b
+            if i + 1 < len(self.layers):
+                x = np.maximum(x, np.float32(0))
+        q = x[0]
+        top = np.sort(q)[-2:]
+        if top[1] - top[0] < MIN_MARGIN:
+            raise RuntimeError('tie between the greedy actions of the coordinator')
+        return Coordinator.Action(int(np.argmax(q)))
+
+    def remember(self, state, action, reward, next_state):
+        pass
+
+    def learn(self, batch_size):
+        pass
+
+    def update_target_model(self):
+        pass
+
+
+class Environment:
+    """Scripted stand-in of ns3env.Ns3Env, recording the actions."""
+
+    def __init__(self, observations):
+        self.observations = observations
+        self.actions = []
+        self.resets = 0
+
+    def reset(self):
+        self.resets += 1
+        if self.resets > 1:
+            raise RuntimeError('the agent ran more than one episode')
+        return self.observations[0]
+
+    def step(self, action):
+        self.actions.append(list(action))
+        return self.observations[len(self.actions)], 0, False, {}
+
+
+class Box(np.ndarray):
+    """Observation converting its 1-element rows to int, as numpy 1 did."""
+
+    def __int__(self):
+        return int(np.asarray(self).item())
+
+
+def random_observations(rng):
+    observations = []
+    for _ in range(N_STEPS + 1):
+        obs = {
+            'enbMLBstate': rng.integers(0, N_MLB_STATES, N_CELLS).astype(float),
+            'AverageVelocity': rng.integers(0, N_MRO_STATES, N_CELLS).astype(float),
+            'AvgCqi': rng.integers(0, 61, N_CELLS) / 4.0,
+            'dlPrbusage': rng.integers(0, 101, N_CELLS).astype(float),
+            'enbBestCell': rng.integers(0, 30, N_CELLS).astype(float),
+            'Results': np.zeros(2),
+            'enbStepPrb': rng.integers(0, 101, N_CELLS).astype(float),
+            'enbStepRlf': rng.integers(0, 3, N_CELLS).astype(float),
+            'enbStepPp': rng.integers(0, 3, N_CELLS).astype(float),
+        }
+        observations.append({key: value.view(Box) for key, value in obs.items()})
+    return observations
+
+
+def write_tables(rng):
+    tables = {}
+    for cell in range(1, N_CELLS + 1):
+        for name, n_states, n_actions in (('QMLB', N_MLB_STATES, N_MLB_ACTIONS),
+                                          ('QMRO', N_MRO_STATES, N_MRO_ACTIONS)):
+            filename = 'Qtable%d_%s_Mid.csv' % (cell, name)
+            q = rng.normal(0, 1, (n_states, n_actions))
+            rows = [['%.4f' % v for v in row] for row in q]
+            with open(os.path.join(OUTPUT, filename), 'w') as f:
+                for row in rows:
+                    f.write(','.join(row) + '\n')
+            tables[filename] = rows
+    return tables
+
+
+def run_agent(tables, observations, coordinator):
+    """Run the main code of the agent for one episode."""
+    with open(AGENT) as f:
+        tree = ast.parse(f.read(), AGENT)
+    nodes = [n for n in tree.body
+             if isinstance(n, ast.FunctionDef) and n.name.startswith('action_func_')]
+    main = [n for n in tree.body
+            if isinstance(n, ast.If) and ast.unparse(n.test) == "__name__ == '__main__'"]
+    assert len(main) == 1
+    env = Environment(observations)
+    torch = types.SimpleNamespace(autograd=types.SimpleNamespace(set_detect_anomaly=lambda mode: None))
+    namespace = {
+        'np': np,
+        'torch': torch,
+        'ns3env': types.SimpleNamespace(Ns3Env=lambda **kwargs: env),
+        'csv2list': lambda path: tables[os.path.basename(path)],
+        'DDQNAgent': lambda state_size, action_size: coordinator,
+        'export_dqn': lambda model, path: None,
+        'EPISODES': 1, 'max_env_steps': N_STEPS, 'port': 0, 'stepTime': 0.5,
+        'startSim': 0, 'seed': 0, 'simArgs': {}, 'debug': False,
+    }
+    code = compile(ast.Module(body=nodes + main[0].body, type_ignores=[]), AGENT, 'exec')
+    with contextlib.redirect_stdout(io.StringIO()):
+        exec(code, namespace)
+    return env.actions, coordinator.choices
+
+
+def write_trace(filename, observations, actions, choices):
+    with open(os.path.join(OUTPUT, filename), 'w') as f:
+        for step, action in enumerate(actions):
+            obs = observations[step]
+            row = []
+            for key in ('enbMLBstate', 'AverageVelocity', 'AvgCqi', 'dlPrbusage', 'enbBestCell'):
+                row += ['%g' % v for v in obs[key]]
+            row.append('%d' % choices[step])
+            row += ['%g' % v for v in action]
+            f.write(','.join(row) + '\n')
+
+
+class RecordingCoordinator(Coordinator):
+    def __init__(self, layers):
+        Coordinator.__init__(self, layers)
+        self.choices = []
+
+    def act(self, state):
+        action = Coordinator.act(self, state)
+        self.choices.append(action.item())
+        return action
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--seed', type=int, default=1)
+    args = parser.parse_args()
+
+    os.makedirs(OUTPUT, exist_ok=True)
+    rng = np.random.default_rng(args.seed)
+    tables = write_tables(rng)
+    observations = random_observations(rng)
+    layers = load_dqn('slc2-coordinator-small.bin')
+    for filename, coordinator in (('trace-coordinator.csv', RecordingCoordinator(layers)),
+                                  ('trace-tables.csv', RecordingCoordinator(None))):
+        actions, choices = run_agent(tables, observations, coordinator)
+        assert len(actions) == N_STEPS
+        write_trace(filename, observations, actions, choices)
+        digits = set((c >> (2 * i)) & 3 for c in choices for i in range(N_CELLS))
+        print('%s: coordinator choices %s' % (filename, sorted(digits)))
+
+
+if __name__ == '__main__':
+    main()
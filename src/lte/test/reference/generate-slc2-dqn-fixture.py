@@ -0,0 +1,101 @@
+#! /usr/bin/env python3
+# -*- coding: utf-8 -*-
+## -*- Mode: python; py-indent-offset: 4; indent-tabs-mode: nil; coding: utf-8; -*-
+
+# Generate the coordinator fixture of lte-test-dqn-policy.cc: the network
+# of the coordinator of the small SLC2 agent, written by the export_dqn of
+# scratch/SLC2_Agent_small.py, and the Q-values it computes for some
+# coordinator states.
+#
+#   slc2-coordinator-small.bin    the network, as written by export_dqn
+#   slc2-coordinator-small-q.csv  one row per state: the 30 inputs, then
+#                                 the 1024 Q-values
+#
+# The network is the torch.nn.Module built by DDQNAgent._build_model, with
+# the default initialization of PyTorch, and is evaluated with PyTorch on
+# the CPU. export_dqn and _build_model are taken from the source of the
+# agent. generate-slc2-agent-trace.py must be run again after this script,
+# for trace-coordinator.csv to follow the new network.
+#
+# Usage, from src/lte/test/reference:
+#   python3 generate-slc2-dqn-fixture.py [--seed=1]
+
+import argparse
+import ast
+import os
+import sys
+import types
+
+import numpy as np
+import torch
+import torch.nn as nn
+
+AGENT = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                     '..', '..', '..', '..', 'scratch', 'SLC2_Agent_small.py')
+N_CELLS = 5
+STATE_SIZE = 6 * N_CELLS
+ACTION_SIZE = 4 ** N_CELLS
+N_STATES = 4
+# smallest difference between the two largest Q-values of a state, for
+# the greedy action not to depend on the order of the sums
+MIN_MARGIN = 1e-3
+
+
+def load_agent_functions(namespace):
+    """Take export_dqn and DDQNAgent._build_model from the source of the agent."""
+    with open(AGENT) as f:
+        tree = ast.parse(f.read(), AGENT)
+    nodes = [n for n in tree.body if isinstance(n, ast.FunctionDef) and n.name == 'export_dqn']
+    agent = [n for n in tree.body if isinstance(n, ast.ClassDef) and n.name == 'DDQNAgent']
+    assert len(nodes) == 1 and len(agent) == 1
+    nodes += [n for n in agent[0].body if isinstance(n, ast.FunctionDef) and n.name == '_build_model']
+    assert len(nodes) == 2
+    exec(compile(ast.Module(body=nodes, type_ignores=[]), AGENT, 'exec'), namespace)
+    return namespace['export_dqn'], namespace['_build_model']
+
+
+def build_model(seed):
+    """Return the model of the coordinator, the export_dqn of the agent and its evaluation."""
+    torch.manual_seed(seed)
+    export_dqn, build = load_agent_functions({'nn': nn, 'np': np, 'torch': torch,
+                                              'device': torch.device('cpu')})
+    model = build(types.SimpleNamespace(state_size=STATE_SIZE, action_size=ACTION_SIZE))
+
+    def evaluate(states):
+        with torch.no_grad():
+            return model(torch.tensor(states, dtype=torch.float32)).numpy()
+    return model, export_dqn, evaluate
+
+
+def coordinator_states(rng, n):
+    """States of the coordinator: directions, then observations."""
+    directions = rng.integers(-1, 2, (n, 3 * N_CELLS)).astype(np.float64)
+    cqi = rng.integers(0, 61, (n, N_CELLS)) / 4.0
+    prb = rng.integers(0, 101, (n, N_CELLS)).astype(np.float64)
+    best = rng.integers(0, 30, (n, N_CELLS)).astype(np.float64)
+    return np.concatenate((directions, cqi, prb, best), axis=1)
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--seed', type=int, default=1)
+    args = parser.parse_args()
+
+    model, export_dqn, evaluate = build_model(args.seed)
+    rng = np.random.default_rng(args.seed)
+    states = coordinator_states(rng, N_STATES)
+    q = evaluate(states)
+    for s in range(N_STATES):
+        top = np.sort(q[s])[-2:]
+        if top[1] - top[0] < MIN_MARGIN:
+            sys.exit('state %d: tie between the greedy actions, try another seed' % s)
+
+    export_dqn(model, 'slc2-coordinator-small.bin')
+    with open('slc2-coordinator-small-q.csv', 'w') as f:
+        for s in range(N_STATES):
+            f.write(','.join(['%.9g' % v for v in states[s]] + ['%.9g' % v for v in q[s]]) + '\n')
+    print('seed %d, evaluated with torch %s' % (args.seed, torch.__version__))
+
+
+if __name__ == '__main__':
+    main()
@@ -26,6 +26,7 @@
 #include "ns3/test.h"
 #include "ns3/ptr.h"
 #include "ns3/packet.h"
+#include "ns3/random-variable-stream.h"
 
 #include "ns3/lte-rrc-header.h"
 #include "ns3/lte-rrc-sap.h"
@@ -52,7 +53,7 @@ public:
   {
     uint32_t psize = pkt->GetSize ();
     uint8_t buffer[psize];
-    char sbuffer[psize * 3];
+    char sbuffer[psize * 3 + 1];
     pkt->CopyData (buffer, psize);
     for (uint32_t i = 0; i < psize; i++)
       {
@@ -329,6 +330,11 @@ RrcConnectionRequestTestCase::DoRun (void)
   // Log serialized packet contents
   TestUtils::LogPacketContents (packet);
 
+  // Check that the bitstream is the one of the bit-by-bit encoder
+  NS_TEST_ASSERT_MSG_EQ (TestUtils::sprintPacketContentsHex (packet),
+                         "48 3f ec af ec a6 ",
+                         "Different bitstream!");
+
   // Remove header
   RrcConnectionRequestHeader destination;
   packet->RemoveHeader (destination);
@@ -382,6 +388,12 @@ RrcConnectionSetupTestCase::DoRun (void)
   // Log serialized packet contents
   TestUtils::LogPacketContents (packet);
 
+  // Check that the bitstream is the one of the bit-by-bit encoder
+  NS_TEST_ASSERT_MSG_EQ (TestUtils::sprintPacketContentsHex (packet),
+                         "7f 81 c8 ce 14 e0 b8 80 80 4d 98 46 10 84 28 1a "
+                         "60 00 30 04 00 ",
+                         "Different bitstream!");
+
   // remove header
   RrcConnectionSetupHeader destination;
   packet->RemoveHeader (destination);
@@ -435,6 +447,11 @@ RrcConnectionSetupCompleteTestCase::DoRun (void)
   // Log serialized packet contents
   TestUtils::LogPacketContents (packet);
 
+  // Check that the bitstream is the one of the bit-by-bit encoder
+  NS_TEST_ASSERT_MSG_EQ (TestUtils::sprintPacketContentsHex (packet),
+                         "26 40 ",
+                         "Different bitstream!");
+
   // Remove header
   RrcConnectionSetupCompleteHeader destination;
   packet->RemoveHeader (destination);
@@ -487,6 +504,11 @@ RrcConnectionReconfigurationCompleteTestCase::DoRun (void)
   // Log serialized packet contents
   TestUtils::LogPacketContents (packet);
 
+  // Check that the bitstream is the one of the bit-by-bit encoder
+  NS_TEST_ASSERT_MSG_EQ (TestUtils::sprintPacketContentsHex (packet),
+                         "15 ",
+                         "Different bitstream!");
+
   // remove header
   RrcConnectionReconfigurationCompleteHeader destination;
   packet->RemoveHeader (destination);
@@ -650,6 +672,15 @@ RrcConnectionReconfigurationTestCase::DoRun (void)
   // Log serialized packet contents
   TestUtils::LogPacketContents (packet);
 
+  // Check that the bitstream is the one of the bit-by-bit encoder
+  NS_TEST_ASSERT_MSG_EQ (TestUtils::sprintPacketContentsHex (packet),
+                         "24 1a 3f e8 6c c0 08 3e 00 0a 9e 60 90 20 98 3b "
+                         "a0 00 23 40 53 e8 26 78 2a 04 3e 49 4c 81 1c 42 "
+                         "62 90 67 5a 21 e2 ae 70 a6 13 40 90 00 0c 00 05 "
+                         "99 00 00 b4 00 00 02 00 40 00 00 01 01 13 91 9c "
+                         "29 c1 71 01 00 9b 30 8c 21 08 50 34 c0 00 60 08 ",
+                         "Different bitstream!");
+
   // remove header
   RrcConnectionReconfigurationHeader destination;
   packet->RemoveHeader (destination);
@@ -768,6 +799,15 @@ HandoverPreparationInfoTestCase::DoRun (void)
   // Log serialized packet contents
   TestUtils::LogPacketContents (packet);
 
+  // Check that the bitstream is the one of the bit-by-bit encoder
+  NS_TEST_ASSERT_MSG_EQ (TestUtils::sprintPacketContentsHex (packet),
+                         "08 00 00 39 19 c2 9c 17 10 10 09 b3 08 c2 10 85 "
+                         "03 4c 00 06 00 80 00 05 b0 02 a0 88 44 8c 00 00 "
+                         "00 00 00 a4 00 00 02 14 00 00 00 00 00 01 00 20 "
+                         "00 03 c0 00 00 00 00 00 0f c2 20 01 00 00 0c 00 "
+                         "0a bc 00 00 06 ",
+                         "Different bitstream!");
+
   // remove header
   HandoverPreparationInfoHeader destination;
   packet->RemoveHeader (destination);
@@ -829,6 +869,11 @@ RrcConnectionReestablishmentRequestTestCase::DoRun (void)
   // Log serialized packet contents
   TestUtils::LogPacketContents (packet);
 
+  // Check that the bitstream is the one of the bit-by-bit encoder
+  NS_TEST_ASSERT_MSG_EQ (TestUtils::sprintPacketContentsHex (packet),
+                         "00 01 81 50 00 04 ",
+                         "Different bitstream!");
+
   // remove header
   RrcConnectionReestablishmentRequestHeader destination;
   packet->RemoveHeader (destination);
@@ -883,6 +928,12 @@ RrcConnectionReestablishmentTestCase::DoRun (void)
   // Log serialized packet contents
   TestUtils::LogPacketContents (packet);
 
+  // Check that the bitstream is the one of the bit-by-bit encoder
+  NS_TEST_ASSERT_MSG_EQ (TestUtils::sprintPacketContentsHex (packet),
+                         "10 1c 8c e1 4e 0b 88 08 04 d9 84 61 08 42 81 a6 "
+                         "00 03 00 40 ",
+                         "Different bitstream!");
+
   // remove header
   RrcConnectionReestablishmentHeader destination;
   packet->RemoveHeader (destination);
@@ -935,6 +986,11 @@ RrcConnectionReestablishmentCompleteTestCase::DoRun (void)
   // Log serialized packet contents
   TestUtils::LogPacketContents (packet);
 
+  // Check that the bitstream is the one of the bit-by-bit encoder
+  NS_TEST_ASSERT_MSG_EQ (TestUtils::sprintPacketContentsHex (packet),
+                         "1e 00 ",
+                         "Different bitstream!");
+
   // remove header
   RrcConnectionReestablishmentCompleteHeader destination;
   packet->RemoveHeader (destination);
@@ -986,6 +1042,11 @@ RrcConnectionRejectTestCase::DoRun (void)
   // Log serialized packet contents
   TestUtils::LogPacketContents (packet);
 
+  // Check that the bitstream is the one of the bit-by-bit encoder
+  NS_TEST_ASSERT_MSG_EQ (TestUtils::sprintPacketContentsHex (packet),
+                         "40 20 ",
+                         "Different bitstream!");
+
   // remove header
   RrcConnectionRejectHeader destination;
   packet->RemoveHeader (destination);
@@ -1054,6 +1115,11 @@ MeasurementReportTestCase::DoRun (void)
   // Log serialized packet contents
   TestUtils::LogPacketContents (packet);
 
+  // Check that the bitstream is the one of the bit-by-bit encoder
+  NS_TEST_ASSERT_MSG_EQ (TestUtils::sprintPacketContentsHex (packet),
+                         "08 02 42 4a 82 09 00 e0 00 00 06 00 05 68 56 ",
+                         "Different bitstream!");
+
   // remove header
   MeasurementReportHeader destination;
   packet->RemoveHeader (destination);
@@ -1115,6 +1181,87 @@ MeasurementReportTestCase::DoRun (void)
   packet = 0;
 }
 
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test the bitstreams of Asn1BitWriter and Asn1BitReader against
+ * a bit-by-bit encoding of random fields
+ */
+class Asn1BitStreamTestCase : public TestCase
+{
+public:
+  Asn1BitStreamTestCase ();
+  virtual void DoRun (void);
+};
+
+Asn1BitStreamTestCase::Asn1BitStreamTestCase ()
+  : TestCase ("Testing Asn1BitWriter and Asn1BitReader")
+{
+}
+
+void
+Asn1BitStreamTestCase::DoRun (void)
+{
+  NS_LOG_DEBUG ("============= Asn1BitStreamTestCase ===========");
+
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  random->SetStream (1);
+
+  for (uint32_t run = 0; run < 200; run++)
+    {
+      std::vector<uint32_t> values;
+      std::vector<uint8_t> widths;
+      std::vector<uint8_t> reference;
+      uint32_t numBits = 0;
+      Asn1BitWriter writer;
+
+      uint32_t numFields = random->GetInteger (0, 40);
+      for (uint32_t i = 0; i < numFields; i++)
+        {
+          uint8_t width = random->GetInteger (0, 32);
+          uint32_t value = static_cast<uint32_t> (random->GetValue (0, 4294967296.0));
+          writer.WriteBits (value, width);
+          if (width < 32)
+            {
+              value &= (1U << width) - 1;
+            }
+          values.push_back (value);
+          widths.push_back (width);
+
+          // Reference encoding: most significant bit first, one bit at a time
+          for (int bit = width - 1; bit >= 0; bit--)
+            {
+              if (numBits % 8 == 0)
+                {
+                  reference.push_back (0);
+                }
+              reference.back () |= ((value >> bit) & 1) << (7 - numBits % 8);
+              numBits++;
+            }
+        }
+      writer.Flush ();
+
+      const std::vector<uint8_t> &octets = writer.GetOctets ();
+      NS_TEST_ASSERT_MSG_EQ (octets.size (), reference.size (), "Different number of octets!");
+      for (uint32_t i = 0; i < octets.size (); i++)
+        {
+          NS_TEST_ASSERT_MSG_EQ ((uint16_t) octets[i], (uint16_t) reference[i], "Different octet " << i << "!");
+        }
+
+      Buffer buffer;
+      buffer.AddAtStart (octets.size ());
+      buffer.Begin ().Write (octets.data (), octets.size ());
+      Buffer::Iterator bIterator = buffer.Begin ();
+      Asn1BitReader reader;
+      for (uint32_t i = 0; i < values.size (); i++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (reader.ReadBits (widths[i], bIterator), values[i], "Different field " << i << "!");
+        }
+      NS_TEST_ASSERT_MSG_EQ (bIterator.GetDistanceFrom (buffer.Begin ()), reference.size (), "Different number of octets read!");
+    }
+}
+
 /**
  * \ingroup lte-test
  * \ingroup tests
@@ -1142,6 +1289,7 @@ Asn1EncodingSuite::Asn1EncodingSuite ()
   AddTestCase (new RrcConnectionReestablishmentCompleteTestCase (), TestCase::QUICK);
   AddTestCase (new RrcConnectionRejectTestCase (), TestCase::QUICK);
   AddTestCase (new MeasurementReportTestCase (), TestCase::QUICK);
+  AddTestCase (new Asn1BitStreamTestCase (), TestCase::QUICK);
 }
 
 Asn1EncodingSuite asn1EncodingSuite;
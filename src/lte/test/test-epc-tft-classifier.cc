@@ -211,6 +211,94 @@ EpcTftClassifierTestCase::DoRun (void)
 
 
 
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case to check that the classification of a flow, which
+ * the classifier caches, follows the TFTs added to and deleted from the
+ * classifier.
+ */
+class EpcTftClassifierCacheTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param useIpv6 use IPv6 or IPv4 addresses
+   */
+  EpcTftClassifierCacheTestCase (bool useIpv6);
+
+private:
+  bool m_useIpv6; ///< use IPv4 or IPv6 header/addresses
+
+  /**
+   * Classify an UDP packet from 9.1.1.1:4 to 8.1.1.1:1024
+   *
+   * \param c the EPC TFT classifier
+   * \returns the TFT ID
+   */
+  uint32_t ClassifyPacket (Ptr<EpcTftClassifier> c);
+
+  virtual void DoRun (void);
+};
+
+EpcTftClassifierCacheTestCase::EpcTftClassifierCacheTestCase (bool useIpv6)
+  : TestCase (useIpv6 ? "classification cache, IPv6" : "classification cache, IPv4"),
+    m_useIpv6 (useIpv6)
+{
+}
+
+uint32_t
+EpcTftClassifierCacheTestCase::ClassifyPacket (Ptr<EpcTftClassifier> c)
+{
+  UdpHeader udpHeader;
+  udpHeader.SetSourcePort (4);
+  udpHeader.SetDestinationPort (1024);
+  Ptr<Packet> udpPacket = Create<Packet> ();
+  udpPacket->AddHeader (udpHeader);
+  if (m_useIpv6)
+    {
+      Ipv6Header ipv6Header;
+      ipv6Header.SetSourceAddress (Ipv6Address::MakeIpv4MappedAddress (Ipv4Address ("9.1.1.1")));
+      ipv6Header.SetDestinationAddress (Ipv6Address::MakeIpv4MappedAddress (Ipv4Address ("8.1.1.1")));
+      ipv6Header.SetPayloadLength (8);
+      ipv6Header.SetNextHeader (UdpL4Protocol::PROT_NUMBER);
+      udpPacket->AddHeader (ipv6Header);
+    }
+  else
+    {
+      Ipv4Header ipHeader;
+      ipHeader.SetSource (Ipv4Address ("9.1.1.1"));
+      ipHeader.SetDestination (Ipv4Address ("8.1.1.1"));
+      ipHeader.SetPayloadSize (8);
+      ipHeader.SetProtocol (UdpL4Protocol::PROT_NUMBER);
+      udpPacket->AddHeader (ipHeader);
+    }
+  return c->Classify (udpPacket, EpcTft::UPLINK,
+                      m_useIpv6 ? Ipv6L3Protocol::PROT_NUMBER : Ipv4L3Protocol::PROT_NUMBER);
+}
+
+void
+EpcTftClassifierCacheTestCase::DoRun (void)
+{
+  Ptr<EpcTftClassifier> c = Create<EpcTftClassifier> ();
+  c->Add (EpcTft::Default (), 1);
+  NS_TEST_ASSERT_MSG_EQ (ClassifyPacket (c), 1, "bad classification with the default TFT only");
+  NS_TEST_ASSERT_MSG_EQ (ClassifyPacket (c), 1, "bad cached classification");
+
+  Ptr<EpcTft> tft = Create<EpcTft> ();
+  EpcTft::PacketFilter pf;
+  pf.remotePortStart = 1024;
+  pf.remotePortEnd = 1024;
+  tft->Add (pf);
+  c->Add (tft, 2);
+  NS_TEST_ASSERT_MSG_EQ (ClassifyPacket (c), 2, "classification not updated when a TFT is added");
+
+  c->Delete (2);
+  NS_TEST_ASSERT_MSG_EQ (ClassifyPacket (c), 1, "classification not updated when a TFT is deleted");
+}
+
 
 /**
  * \ingroup lte-test
@@ -429,5 +517,10 @@ EpcTftClassifierTestSuite::EpcTftClassifierTestSuite ()
       AddTestCase (new EpcTftClassifierTestCase (c4, EpcTft::UPLINK,   "9.1.1.1", "8.1.1.1",  7895,       10,     0,    1, useIpv6), TestCase::QUICK);
       AddTestCase (new EpcTftClassifierTestCase (c4, EpcTft::UPLINK,   "9.1.1.1", "8.1.1.1",     9,     5897,     0,    2, useIpv6), TestCase::QUICK);
       AddTestCase (new EpcTftClassifierTestCase (c4, EpcTft::DOWNLINK, "9.1.1.1", "8.1.1.1",  5897,       10,     0,    2, useIpv6), TestCase::QUICK);
+      ///////////////////////////////////////////
+      // check the classification cache
+      ///////////////////////////////////////////
+
+      AddTestCase (new EpcTftClassifierCacheTestCase (useIpv6), TestCase::QUICK);
     }
 }
@@ -40,6 +40,8 @@
 #include "ns3/double.h"
 #include "ns3/abort.h"
 #include "ns3/mobility-helper.h"
+#include "ns3/config.h"
+#include "ns3/epc-gtpu-header.h"
 
 
 
@@ -113,23 +115,46 @@ public:
    *
    * \param name the reference name
    * \param v the ENB test data
+   * \param idealBackhaul hand the user-plane packets directly between
+   * the EPC applications
    */
-  LteEpcE2eDataTestCase (std::string name, std::vector<EnbTestData> v);
+  LteEpcE2eDataTestCase (std::string name, std::vector<EnbTestData> v, bool idealBackhaul = false);
   virtual ~LteEpcE2eDataTestCase ();
 
 private:
   virtual void DoRun (void);
+  /**
+   * Check that a packet traced by the RxFromS1u trace source of the PGW
+   * has a GTP-U header, as received from the S5-U socket.
+   *
+   * \param packet the traced packet
+   */
+  void PgwRxFromS1u (Ptr<Packet> packet);
   std::vector<EnbTestData> m_enbTestData; ///< the ENB test data
+  bool m_idealBackhaul; ///< whether the EPC user plane bypasses GTP-U
+  uint32_t m_pgwRxFromS1uPkts; ///< number of packets traced by RxFromS1u
 };
 
 
-LteEpcE2eDataTestCase::LteEpcE2eDataTestCase (std::string name, std::vector<EnbTestData> v)
+LteEpcE2eDataTestCase::LteEpcE2eDataTestCase (std::string name, std::vector<EnbTestData> v, bool idealBackhaul)
   : TestCase (name),
-    m_enbTestData (v)
+    m_enbTestData (v),
+    m_idealBackhaul (idealBackhaul),
+    m_pgwRxFromS1uPkts (0)
 {
   NS_LOG_FUNCTION (this << name);
 }
 
+void
+LteEpcE2eDataTestCase::PgwRxFromS1u (Ptr<Packet> packet)
+{
+  GtpuHeader gtpu;
+  packet->RemoveHeader (gtpu);
+  NS_TEST_ASSERT_MSG_EQ (gtpu.GetLength (), packet->GetSize () + gtpu.GetSerializedSize () - 8,
+                         "wrong GTP-U length of the packet traced by RxFromS1u");
+  ++m_pgwRxFromS1uPkts;
+}
+
 LteEpcE2eDataTestCase::~LteEpcE2eDataTestCase ()
 {
 }
@@ -142,6 +167,8 @@ LteEpcE2eDataTestCase::DoRun ()
   Config::SetDefault ("ns3::LteSpectrumPhy::CtrlErrorModelEnabled", BooleanValue (false));
   Config::SetDefault ("ns3::LteSpectrumPhy::DataErrorModelEnabled", BooleanValue (false));  
   Config::SetDefault ("ns3::LteHelper::UseIdealRrc", BooleanValue (true));
+  Config::SetDefault ("ns3::NoBackhaulEpcHelper::IdealBackhaul", BooleanValue (m_idealBackhaul));
+  Config::SetDefault ("ns3::NoBackhaulEpcHelper::IdealS1uDelay", TimeValue (MilliSeconds (2)));
 
   Config::SetDefault ("ns3::RadioBearerStatsCalculator::DlPdcpOutputFilename", StringValue (CreateTempDirFilename ("DlPdcpStats.txt")));
   Config::SetDefault ("ns3::RadioBearerStatsCalculator::UlPdcpOutputFilename", StringValue (CreateTempDirFilename ("UlPdcpStats.txt")));
@@ -307,6 +334,9 @@ LteEpcE2eDataTestCase::DoRun ()
   double statsDuration = 2.0;
     
   lteHelper->EnablePdcpTraces ();
+  m_pgwRxFromS1uPkts = 0;
+  Config::ConnectWithoutContext ("/NodeList/*/ApplicationList/*/$ns3::EpcPgwApplication/RxFromS1u",
+                                 MakeCallback (&LteEpcE2eDataTestCase::PgwRxFromS1u, this));
 
   lteHelper->GetPdcpStats ()->SetAttribute ("StartTime", TimeValue (Seconds (statsStartTime)));
   lteHelper->GetPdcpStats ()->SetAttribute ("EpochDuration", TimeValue (Seconds (statsDuration)));
@@ -316,6 +346,7 @@ LteEpcE2eDataTestCase::DoRun ()
   Simulator::Run ();
 
   uint64_t imsiCounter = 0;
+  uint32_t expectedPgwRxPkts = 0;
 
   for (std::vector<EnbTestData>::iterator enbit = m_enbTestData.begin ();
        enbit < m_enbTestData.end ();
@@ -332,6 +363,7 @@ LteEpcE2eDataTestCase::DoRun ()
               // LCID 3 is (at the moment) the Default EPS bearer, and is unused in this test program
               uint8_t lcid = b+4;
               uint32_t expectedPkts = ueit->bearers.at (b).numPkts;
+              expectedPgwRxPkts += expectedPkts;
               uint32_t expectedBytes = (ueit->bearers.at (b).numPkts) * (ueit->bearers.at (b).pktSize);
               uint32_t txPktsPdcpDl = lteHelper->GetPdcpStats ()->GetDlTxPackets (imsi, lcid);
               uint32_t rxPktsPdcpDl = lteHelper->GetPdcpStats ()->GetDlRxPackets (imsi, lcid);
@@ -364,6 +396,7 @@ LteEpcE2eDataTestCase::DoRun ()
             }
         }      
     }
+  NS_TEST_ASSERT_MSG_EQ (m_pgwRxFromS1uPkts, expectedPgwRxPkts, "wrong number of packets traced by RxFromS1u");
   
   Simulator::Destroy ();
 }
@@ -414,6 +447,7 @@ LteEpcE2eDataTestSuite::LteEpcE2eDataTestSuite ()
   v3.push_back (e1);
   v3.push_back (e2);
   AddTestCase (new LteEpcE2eDataTestCase ("2 eNBs", v3), TestCase::EXTENSIVE);
+  AddTestCase (new LteEpcE2eDataTestCase ("2 eNBs, ideal backhaul", v3, true), TestCase::QUICK);
 
   EnbTestData e4;
   UeTestData u4_1;
@@ -66,8 +66,9 @@ public:
    * \param schedulerType the scheduler type
    * \param admitHo
    * \param useIdealRrc true if the ideal RRC should be used
+   * \param useIdealX2 true if the ideal X2 interface should be used
    */
-  LteX2HandoverTestCase (uint32_t nUes, uint32_t nDedicatedBearers, std::list<HandoverEvent> handoverEventList, std::string handoverEventListName, std::string schedulerType, bool admitHo, bool useIdealRrc);
+  LteX2HandoverTestCase (uint32_t nUes, uint32_t nDedicatedBearers, std::list<HandoverEvent> handoverEventList, std::string handoverEventListName, std::string schedulerType, bool admitHo, bool useIdealRrc, bool useIdealX2 = false);
 
 private:
   /**
@@ -78,9 +79,10 @@ private:
    * \param schedulerType the scheduler type
    * \param admitHo
    * \param useIdealRrc true if the ideal RRC should be used
+   * \param useIdealX2 true if the ideal X2 interface should be used
    * \returns the name string
    */
-  static std::string BuildNameString (uint32_t nUes, uint32_t nDedicatedBearers, std::string handoverEventListName, std::string schedulerType, bool admitHo, bool useIdealRrc);
+  static std::string BuildNameString (uint32_t nUes, uint32_t nDedicatedBearers, std::string handoverEventListName, std::string schedulerType, bool admitHo, bool useIdealRrc, bool useIdealX2);
   virtual void DoRun (void);
   /**
    * Check connected function
@@ -110,6 +112,7 @@ private:
   std::string m_schedulerType; ///< scheduler type
   bool m_admitHo; ///< whether to admit the handover request
   bool     m_useIdealRrc; ///< whether to use the ideal RRC
+  bool     m_useIdealX2; ///< whether to use the ideal X2 interface
   Ptr<LteHelper> m_lteHelper; ///< LTE helper
   Ptr<PointToPointEpcHelper> m_epcHelper; ///< EPC helper
 
@@ -161,7 +164,7 @@ private:
 };
 
 
-std::string LteX2HandoverTestCase::BuildNameString (uint32_t nUes, uint32_t nDedicatedBearers, std::string handoverEventListName, std::string schedulerType, bool admitHo, bool useIdealRrc)
+std::string LteX2HandoverTestCase::BuildNameString (uint32_t nUes, uint32_t nDedicatedBearers, std::string handoverEventListName, std::string schedulerType, bool admitHo, bool useIdealRrc, bool useIdealX2)
 {
   std::ostringstream oss;
   oss << " nUes=" << nUes
@@ -177,11 +180,15 @@ std::string LteX2HandoverTestCase::BuildNameString (uint32_t nUes, uint32_t nDed
     {
       oss << ", real RRC";
     }
+  if (useIdealX2)
+    {
+      oss << ", ideal X2";
+    }
   return oss.str ();
 }
 
-LteX2HandoverTestCase::LteX2HandoverTestCase (uint32_t nUes, uint32_t nDedicatedBearers, std::list<HandoverEvent> handoverEventList, std::string handoverEventListName, std::string schedulerType, bool admitHo, bool useIdealRrc)
-  : TestCase (BuildNameString (nUes, nDedicatedBearers, handoverEventListName, schedulerType, admitHo, useIdealRrc)),
+LteX2HandoverTestCase::LteX2HandoverTestCase (uint32_t nUes, uint32_t nDedicatedBearers, std::list<HandoverEvent> handoverEventList, std::string handoverEventListName, std::string schedulerType, bool admitHo, bool useIdealRrc, bool useIdealX2)
+  : TestCase (BuildNameString (nUes, nDedicatedBearers, handoverEventListName, schedulerType, admitHo, useIdealRrc, useIdealX2)),
     m_nUes (nUes),
     m_nDedicatedBearers (nDedicatedBearers),
     m_handoverEventList (handoverEventList),
@@ -190,6 +197,7 @@ LteX2HandoverTestCase::LteX2HandoverTestCase (uint32_t nUes, uint32_t nDedicated
     m_schedulerType (schedulerType),
     m_admitHo (admitHo),
     m_useIdealRrc (useIdealRrc),
+    m_useIdealX2 (useIdealX2),
     m_maxHoDuration (Seconds (0.1)),
     m_statsDuration (Seconds (0.1)),
     m_udpClientInterval (Seconds (0.01)),
@@ -200,7 +208,7 @@ LteX2HandoverTestCase::LteX2HandoverTestCase (uint32_t nUes, uint32_t nDedicated
 void
 LteX2HandoverTestCase::DoRun ()
 {
-  NS_LOG_FUNCTION (this << BuildNameString (m_nUes, m_nDedicatedBearers, m_handoverEventListName, m_schedulerType, m_admitHo, m_useIdealRrc));
+  NS_LOG_FUNCTION (this << BuildNameString (m_nUes, m_nDedicatedBearers, m_handoverEventListName, m_schedulerType, m_admitHo, m_useIdealRrc, m_useIdealX2));
 
   Config::Reset ();
   Config::SetDefault ("ns3::UdpClient::Interval",  TimeValue (m_udpClientInterval));
@@ -210,6 +218,8 @@ LteX2HandoverTestCase::DoRun ()
   //Disable Uplink Power Control
   Config::SetDefault ("ns3::LteUePhy::EnableUplinkPowerControl", BooleanValue (false));
 
+  Config::SetDefault ("ns3::NoBackhaulEpcHelper::IdealX2", BooleanValue (m_useIdealX2));
+
   int64_t stream = 1;
 
   m_lteHelper = CreateObject<LteHelper> ();
@@ -742,6 +752,11 @@ LteX2HandoverTestSuite::LteX2HandoverTestSuite ()
 
         }
     }
+
+  // ideal X2 interface                    nUes, nDBearers, helist, name, sched, admitHo, idealRrc, idealX2
+  AddTestCase (new LteX2HandoverTestCase (  2,    2,    hel3, hel3name, "ns3::RrFfMacScheduler", true,  true,  true), TestCase::QUICK);
+  AddTestCase (new LteX2HandoverTestCase (  2,    2,    hel1, hel1name, "ns3::RrFfMacScheduler", false, true,  true), TestCase::QUICK);
+  AddTestCase (new LteX2HandoverTestCase (  3,    2,    hel5, hel5name, "ns3::RrFfMacScheduler", true,  false, true), TestCase::QUICK);
 }
 
 static LteX2HandoverTestSuite g_lteX2HandoverTestSuiteInstance;
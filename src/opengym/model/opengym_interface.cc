@@ -24,6 +24,7 @@
 #include "ns3/log.h"
 #include "ns3/config.h"
 #include "ns3/simulator.h"
+#include "ns3/metrics-registry.h"
 #include "opengym_interface.h"
 #include "opengym_env.h"
 #include "container.h"
@@ -254,15 +255,19 @@ OpenGymInterface::NotifyCurrentState()
   envStateMsg.set_info(extraInfo);
 
   // send env state msg to python
-  zmq::message_t request(envStateMsg.ByteSizeLong());;
-  envStateMsg.SerializeToArray(request.data(), envStateMsg.ByteSizeLong());
-  m_zmq_socket.send (request, zmq::send_flags::none);
-
-  // receive act msg form python
+  static MetricHistogram *stepRoundTrip = MetricsRegistry::Get ()->GetHistogram ("OpenGymInterface/StepRoundTripNs");
   ns3opengym::EnvActMsg envActMsg;
-  zmq::message_t reply;
-  (void) m_zmq_socket.recv (reply, zmq::recv_flags::none);
-  envActMsg.ParseFromArray(reply.data(), reply.size());
+  {
+    MetricTimer timer (stepRoundTrip);
+    zmq::message_t request(envStateMsg.ByteSizeLong());;
+    envStateMsg.SerializeToArray(request.data(), envStateMsg.ByteSizeLong());
+    m_zmq_socket.send (request, zmq::send_flags::none);
+
+    // receive act msg form python
+    zmq::message_t reply;
+    (void) m_zmq_socket.recv (reply, zmq::recv_flags::none);
+    envActMsg.ParseFromArray(reply.data(), reply.size());
+  }
 
   if (m_simEnd) {
     // if sim end only rx ms and quit
@@ -269,6 +269,11 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
 
           if ((*rxPhyIterator) != txParams->txPhy)
             {
+              if (m_filter && m_filter->Filter (txParams, *rxPhyIterator))
+                {
+                  NS_LOG_LOGIC ("signal " << txParams << " filtered for " << *rxPhyIterator);
+                  continue;
+                }
               NS_LOG_LOGIC ("copying signal parameters " << txParams);
               Ptr<SpectrumSignalParameters> rxParams = txParams->Copy ();
               rxParams->psd = Copy<SpectrumValue> (convertedTxPowerSpectrum);
@@ -112,6 +112,11 @@ SingleModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
     {
       if ((*rxPhyIterator) != txParams->txPhy)
         {
+          if (m_filter && m_filter->Filter (txParams, *rxPhyIterator))
+            {
+              NS_LOG_LOGIC ("signal " << txParams << " filtered for " << *rxPhyIterator);
+              continue;
+            }
           Time delay  = MicroSeconds (0);
 
           Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility ();
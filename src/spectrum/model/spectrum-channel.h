@@ -32,6 +32,7 @@
 #include <ns3/spectrum-phy.h>
 #include <ns3/traced-callback.h>
 #include <ns3/mobility-model.h>
+#include <ns3/spectrum-transmit-filter.h>
 
 namespace ns3 {
 
@@ -101,6 +102,21 @@ public:
    */
   Ptr<PropagationLossModel> GetPropagationLossModel (void);
 
+  /**
+   * Add a transmit filter, to the end of the chain of filters of this
+   * channel. The signals filtered by the chain are not delivered to the
+   * receivers for which they are filtered.
+   *
+   * \param filter a pointer to the filter to add
+   */
+  void AddSpectrumTransmitFilter (Ptr<SpectrumTransmitFilter> filter);
+
+  /**
+   * Get the chain of transmit filters.
+   * \returns a pointer to the first filter of the chain, or 0 if none
+   */
+  Ptr<SpectrumTransmitFilter> GetSpectrumTransmitFilter (void) const;
+
   /**
    * Used by attached PHY instances to transmit signals on the channel
    *
@@ -198,6 +214,12 @@ protected:
    */
   Ptr<SpectrumPropagationLossModel> m_spectrumPropagationLoss;
 
+  /**
+   * Chain of transmit filters applied to the signals before delivering
+   * them to each receiver.
+   */
+  Ptr<SpectrumTransmitFilter> m_filter;
+
 
 };
 
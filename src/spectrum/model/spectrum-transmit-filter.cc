@@ -0,0 +1,88 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/log.h>
+
+#include "spectrum-transmit-filter.h"
+#include "spectrum-signal-parameters.h"
+#include "spectrum-phy.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("SpectrumTransmitFilter");
+
+NS_OBJECT_ENSURE_REGISTERED (SpectrumTransmitFilter);
+
+SpectrumTransmitFilter::SpectrumTransmitFilter ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TypeId
+SpectrumTransmitFilter::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::SpectrumTransmitFilter")
+    .SetParent<Object> ()
+    .SetGroupName ("Spectrum")
+  ;
+  return tid;
+}
+
+void
+SpectrumTransmitFilter::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  if (m_next)
+    {
+      m_next->Dispose ();
+    }
+  m_next = 0;
+  Object::DoDispose ();
+}
+
+void
+SpectrumTransmitFilter::SetNext (Ptr<SpectrumTransmitFilter> next)
+{
+  NS_LOG_FUNCTION (this << next);
+  if (m_next)
+    {
+      m_next->SetNext (next);
+    }
+  else
+    {
+      m_next = next;
+    }
+}
+
+Ptr<const SpectrumTransmitFilter>
+SpectrumTransmitFilter::GetNext (void) const
+{
+  return m_next;
+}
+
+bool
+SpectrumTransmitFilter::Filter (Ptr<const SpectrumSignalParameters> params,
+                                Ptr<const SpectrumPhy> receiverPhy) const
+{
+  NS_LOG_FUNCTION (this << params << receiverPhy);
+  if (DoFilter (params, receiverPhy))
+    {
+      return true;
+    }
+  return m_next && m_next->Filter (params, receiverPhy);
+}
+
+} // namespace ns3
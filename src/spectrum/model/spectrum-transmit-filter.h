@@ -0,0 +1,88 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SPECTRUM_TRANSMIT_FILTER_H
+#define SPECTRUM_TRANSMIT_FILTER_H
+
+#include <ns3/object.h>
+
+namespace ns3 {
+
+struct SpectrumSignalParameters;
+class SpectrumPhy;
+
+/**
+ * \ingroup spectrum
+ *
+ * Base class of the filters which a SpectrumChannel applies to each
+ * (signal, receiver) pair before delivering a signal. A filtered signal
+ * is not copied, propagated nor delivered to the receiver, which saves
+ * the computational load of the signals known to be irrelevant for it.
+ *
+ * The filters of a channel are chained: a signal is filtered if any
+ * filter of the chain filters it.
+ */
+class SpectrumTransmitFilter : public Object
+{
+public:
+  SpectrumTransmitFilter ();
+
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * Add a filter to the end of the chain of this filter.
+   *
+   * \param next the filter to add
+   */
+  void SetNext (Ptr<SpectrumTransmitFilter> next);
+
+  /**
+   * \return the next filter of the chain, or 0 if none
+   */
+  Ptr<const SpectrumTransmitFilter> GetNext (void) const;
+
+  /**
+   * Evaluate the chain of filters, starting from this one.
+   *
+   * \param params the parameters of the signal being transmitted
+   * \param receiverPhy the receiver
+   * \return true if the signal is not to be delivered to the receiver
+   */
+  bool Filter (Ptr<const SpectrumSignalParameters> params, Ptr<const SpectrumPhy> receiverPhy) const;
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  /**
+   * Evaluate this filter only.
+   *
+   * \param params the parameters of the signal being transmitted
+   * \param receiverPhy the receiver
+   * \return true if the signal is not to be delivered to the receiver
+   */
+  virtual bool DoFilter (Ptr<const SpectrumSignalParameters> params, Ptr<const SpectrumPhy> receiverPhy) const = 0;
+
+  Ptr<SpectrumTransmitFilter> m_next; ///< next filter of the chain
+};
+
+} // namespace ns3
+
+#endif /* SPECTRUM_TRANSMIT_FILTER_H */
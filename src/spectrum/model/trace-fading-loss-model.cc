@@ -28,18 +28,313 @@
 #include <ns3/double.h>
 #include "ns3/uinteger.h"
 #include <fstream>
+#include <cstring>
+#include <limits>
 #include <ns3/simulator.h>
+#include <ns3/simple-ref-count.h>
+#include <ns3/abort.h>
+#include <ns3/little-endian.h>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("TraceFadingLossModel");
 
 NS_OBJECT_ENSURE_REGISTERED (TraceFadingLossModel);
-  
+
+/// Magic number of the binary traces
+static const char FADING_MAGIC[4] = { 'S', 'L', 'C', 'F' };
+/// Version of the binary format
+static const uint32_t FADING_VERSION = 1;
+/// Size of the header of the binary traces, which keeps the samples aligned
+static const uint32_t FADING_HEADER_SIZE = 16;
+
+/**
+ * \return true if the floats of the host are stored in little endian
+ *         order, i.e., as in the binary traces
+ */
+static bool
+IsHostLittleEndian (void)
+{
+  uint32_t one = 1;
+  unsigned char b;
+  std::memcpy (&b, &one, 1);
+  return b == 1;
+}
+
+/**
+ * Read a text fading trace, RB after RB.
+ *
+ * \param is the input stream
+ * \param rbNum the number of RBs
+ * \param samplesNum the number of samples per RB
+ * \param [out] trace the samples of each RB
+ * \return false if the trace is truncated
+ */
+static bool
+ReadTextTrace (std::istream &is, uint32_t rbNum, uint32_t samplesNum,
+               std::vector<std::vector<double> > &trace)
+{
+  trace.clear ();
+  for (uint32_t i = 0; i < rbNum; i++)
+    {
+      std::vector<double> rbTimeFadingTrace;
+      rbTimeFadingTrace.reserve (samplesNum);
+      for (uint32_t j = 0; j < samplesNum; j++)
+        {
+          double sample;
+          is >> sample;
+          rbTimeFadingTrace.push_back (sample);
+        }
+      trace.push_back (rbTimeFadingTrace);
+    }
+  return !is.fail ();
+}
+
+/**
+ * Binary trace loaded in memory. The samples are mapped read-only from
+ * the file when the platform allows it, and read in a buffer otherwise.
+ * The loaded traces are registered by file name, so that all the
+ * instances of TraceFadingLossModel share them; the registry holds them
+ * until the last instance using them releases them.
+ */
+class TraceFadingLossModel::BinaryTrace : public SimpleRefCount<BinaryTrace>
+{
+public:
+  BinaryTrace ();
+  ~BinaryTrace ();
+
+  /**
+   * Get the binary trace of a file, loading it if no instance holds it.
+   *
+   * \param filename the file name
+   * \return the trace, or 0 if the file is not a valid binary trace
+   */
+  static Ptr<BinaryTrace> Get (std::string filename);
+
+  /**
+   * Release a trace returned by Get, and unregister it if no other
+   * instance holds it.
+   *
+   * \param trace the trace, set to 0
+   */
+  static void Release (Ptr<BinaryTrace> &trace);
+
+  /**
+   * \param filename the file name
+   * \return true if the file starts as a binary trace
+   */
+  static bool IsBinary (std::string filename);
+
+  /// \return the binary traces loaded, by file name
+  static std::map<std::string, Ptr<BinaryTrace> > &GetRegistry (void);
+
+  uint32_t rbNum;        ///< number of RBs
+  uint32_t samplesNum;   ///< number of samples per RB
+  const float *samples;  ///< samples, RB after RB
+
+private:
+  /**
+   * Map the file in memory.
+   *
+   * \return false if the file cannot be mapped
+   */
+  bool Map (void);
+
+  /**
+   * Read the file in a buffer.
+   *
+   * \return false if the file cannot be read
+   */
+  bool Read (void);
+
+  /**
+   * Check the header of the trace and set its dimensions.
+   *
+   * \param header the header
+   * \param size the size of the file
+   * \return false if the header is not the one of a binary trace or the
+   *         file is truncated
+   */
+  bool ParseHeader (const unsigned char *header, uint64_t size);
+
+  std::string m_filename;       ///< file name
+  void *m_mapping;              ///< mapping of the file
+  size_t m_mappingSize;         ///< size of the mapping
+  std::vector<float> m_buffer;  ///< samples, when not mapped
+};
+
+TraceFadingLossModel::BinaryTrace::BinaryTrace ()
+  : rbNum (0),
+    samplesNum (0),
+    samples (0),
+    m_mapping (0),
+    m_mappingSize (0)
+{
+}
+
+TraceFadingLossModel::BinaryTrace::~BinaryTrace ()
+{
+#ifndef _WIN32
+  if (m_mapping != 0)
+    {
+      munmap (m_mapping, m_mappingSize);
+    }
+#endif
+}
+
+std::map<std::string, Ptr<TraceFadingLossModel::BinaryTrace> > &
+TraceFadingLossModel::BinaryTrace::GetRegistry (void)
+{
+  static std::map<std::string, Ptr<BinaryTrace> > registry;
+  return registry;
+}
+
+bool
+TraceFadingLossModel::BinaryTrace::IsBinary (std::string filename)
+{
+  std::ifstream ifs (filename.c_str (), std::ios::binary);
+  char magic[4];
+  return ifs.read (magic, 4) && std::memcmp (magic, FADING_MAGIC, 4) == 0;
+}
+
+Ptr<TraceFadingLossModel::BinaryTrace>
+TraceFadingLossModel::BinaryTrace::Get (std::string filename)
+{
+  std::map<std::string, Ptr<BinaryTrace> >::iterator it = GetRegistry ().find (filename);
+  if (it != GetRegistry ().end ())
+    {
+      return it->second;
+    }
+  Ptr<BinaryTrace> trace = Create<BinaryTrace> ();
+  trace->m_filename = filename;
+  if (!trace->Map () && !trace->Read ())
+    {
+      return 0;
+    }
+  GetRegistry ()[filename] = trace;
+  return trace;
+}
+
+void
+TraceFadingLossModel::BinaryTrace::Release (Ptr<BinaryTrace> &trace)
+{
+  if (trace == 0)
+    {
+      return;
+    }
+  std::string filename = trace->m_filename;
+  trace = 0;
+  std::map<std::string, Ptr<BinaryTrace> >::iterator it = GetRegistry ().find (filename);
+  if (it != GetRegistry ().end () && it->second->GetReferenceCount () == 1)
+    {
+      GetRegistry ().erase (it);
+    }
+}
+
+bool
+TraceFadingLossModel::BinaryTrace::ParseHeader (const unsigned char *header, uint64_t size)
+{
+  if (std::memcmp (header, FADING_MAGIC, 4) != 0
+      || LittleEndian::DecodeU32 (header + 4) != FADING_VERSION)
+    {
+      NS_LOG_ERROR (m_filename << ": not a fading trace of version " << FADING_VERSION);
+      return false;
+    }
+  rbNum = LittleEndian::DecodeU32 (header + 8);
+  samplesNum = LittleEndian::DecodeU32 (header + 12);
+  if (rbNum == 0 || rbNum > 255 || samplesNum == 0
+      || size < FADING_HEADER_SIZE + sizeof (float) * static_cast<uint64_t> (rbNum) * samplesNum)
+    {
+      NS_LOG_ERROR (m_filename << ": invalid or truncated fading trace");
+      return false;
+    }
+  return true;
+}
+
+bool
+TraceFadingLossModel::BinaryTrace::Map (void)
+{
+#ifndef _WIN32
+  if (!IsHostLittleEndian ())
+    {
+      return false;
+    }
+  int fd = open (m_filename.c_str (), O_RDONLY);
+  if (fd < 0)
+    {
+      return false;
+    }
+  struct stat st;
+  if (fstat (fd, &st) != 0 || st.st_size < static_cast<off_t> (FADING_HEADER_SIZE))
+    {
+      close (fd);
+      return false;
+    }
+  void *mapping = mmap (0, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close (fd);
+  if (mapping == MAP_FAILED)
+    {
+      return false;
+    }
+  m_mapping = mapping;
+  m_mappingSize = st.st_size;
+  const unsigned char *bytes = static_cast<const unsigned char *> (mapping);
+  if (!ParseHeader (bytes, st.st_size))
+    {
+      return false;
+    }
+  samples = reinterpret_cast<const float *> (bytes + FADING_HEADER_SIZE);
+  NS_LOG_INFO ("mapped fading trace " << m_filename);
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool
+TraceFadingLossModel::BinaryTrace::Read (void)
+{
+  std::ifstream ifs (m_filename.c_str (), std::ios::binary);
+  unsigned char header[FADING_HEADER_SIZE];
+  if (!ifs.read (reinterpret_cast<char *> (header), FADING_HEADER_SIZE))
+    {
+      return false;
+    }
+  ifs.seekg (0, std::ios::end);
+  if (!ParseHeader (header, ifs.tellg ()))
+    {
+      return false;
+    }
+  ifs.seekg (FADING_HEADER_SIZE);
+  m_buffer.resize (static_cast<size_t> (rbNum) * samplesNum);
+  for (size_t i = 0; i < m_buffer.size (); ++i)
+    {
+      unsigned char b[4];
+      if (!ifs.read (reinterpret_cast<char *> (b), 4))
+        {
+          return false;
+        }
+      uint32_t v = LittleEndian::DecodeU32 (b);
+      std::memcpy (&m_buffer[i], &v, sizeof (v));
+    }
+  samples = &m_buffer[0];
+  NS_LOG_INFO ("read fading trace " << m_filename);
+  return true;
+}
+
+
 
 
 TraceFadingLossModel::TraceFadingLossModel ()
-  : m_streamsAssigned (false)
+  : m_binarySamples (0),
+    m_streamsAssigned (false)
 {
   NS_LOG_FUNCTION (this);
   SetNext (NULL);
@@ -49,10 +344,20 @@ TraceFadingLossModel::TraceFadingLossModel ()
 TraceFadingLossModel::~TraceFadingLossModel ()
 {
   m_fadingTrace.clear ();
+  m_binaryTrace = 0;
   m_windowOffsetsMap.clear ();
   m_startVariableMap.clear ();
 }
 
+void
+TraceFadingLossModel::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  BinaryTrace::Release (m_binaryTrace);
+  m_binarySamples = 0;
+  SpectrumPropagationLossModel::DoDispose ();
+}
+
 
 TypeId
 TraceFadingLossModel::GetTypeId (void)
@@ -120,32 +425,84 @@ void
 TraceFadingLossModel::LoadTrace ()
 {
   NS_LOG_FUNCTION (this << "Loading Fading Trace " << m_traceFile);
-  std::ifstream ifTraceFile;
-  ifTraceFile.open (m_traceFile.c_str (), std::ifstream::in);
   m_fadingTrace.clear ();
-  if (!ifTraceFile.good ())
+  BinaryTrace::Release (m_binaryTrace);
+  m_binarySamples = 0;
+  if (BinaryTrace::IsBinary (m_traceFile))
     {
-      NS_LOG_INFO (this << " File: " << m_traceFile);
-      NS_ASSERT_MSG(ifTraceFile.good (), " Fading trace file not found");
+      m_binaryTrace = BinaryTrace::Get (m_traceFile);
+      NS_ABORT_MSG_IF (m_binaryTrace == 0, "invalid binary fading trace " << m_traceFile);
+      NS_ABORT_MSG_IF (m_binaryTrace->rbNum > std::numeric_limits<uint8_t>::max (),
+                       "the binary fading trace " << m_traceFile << " has "
+                                                  << m_binaryTrace->rbNum << " RBs");
+      if (m_binaryTrace->rbNum != m_rbNum || m_binaryTrace->samplesNum != m_samplesNum)
+        {
+          NS_LOG_WARN (this << " the binary trace has " << m_binaryTrace->rbNum << " RBs and "
+                            << m_binaryTrace->samplesNum << " samples, not " << (uint32_t) m_rbNum
+                            << " and " << m_samplesNum);
+        }
+      m_rbNum = m_binaryTrace->rbNum;
+      m_samplesNum = m_binaryTrace->samplesNum;
+      m_binarySamples = m_binaryTrace->samples;
     }
-
-//   NS_LOG_INFO (this << " length " << m_traceLength.GetSeconds ());
-//   NS_LOG_INFO (this << " RB " << (uint32_t)m_rbNum << " samples " << m_samplesNum);
-  for (uint32_t i = 0; i < m_rbNum; i++)
+  else
     {
-      FadingTraceSample rbTimeFadingTrace;
-      for (uint32_t j = 0; j < m_samplesNum; j++)
+      std::ifstream ifTraceFile;
+      ifTraceFile.open (m_traceFile.c_str (), std::ifstream::in);
+      if (!ifTraceFile.good ())
         {
-          double sample;
-          ifTraceFile >> sample;
-          rbTimeFadingTrace.push_back (sample);
+          NS_LOG_INFO (this << " File: " << m_traceFile);
+          NS_ASSERT_MSG(ifTraceFile.good (), " Fading trace file not found");
         }
-      m_fadingTrace.push_back (rbTimeFadingTrace);
+      ReadTextTrace (ifTraceFile, m_rbNum, m_samplesNum, m_fadingTrace);
     }
   m_timeGranularity = m_traceLength.GetMilliSeconds () / m_samplesNum;
   m_lastWindowUpdate = Simulator::Now ();
 }
 
+bool
+TraceFadingLossModel::ConvertTrace (std::string textFile, std::string binaryFile,
+                                    uint8_t rbNum, uint32_t samplesNum)
+{
+  NS_LOG_FUNCTION (textFile << binaryFile << (uint32_t) rbNum << samplesNum);
+  std::ifstream ifs (textFile.c_str ());
+  FadingTrace trace;
+  if (!ifs.is_open () || !ReadTextTrace (ifs, rbNum, samplesNum, trace))
+    {
+      NS_LOG_ERROR ("cannot read " << (uint32_t) rbNum << " x " << samplesNum
+                                   << " samples from " << textFile);
+      return false;
+    }
+  std::ofstream ofs (binaryFile.c_str (), std::ios::binary | std::ios::trunc);
+  if (!ofs.is_open ())
+    {
+      NS_LOG_ERROR ("cannot open " << binaryFile);
+      return false;
+    }
+  ofs.write (FADING_MAGIC, 4);
+  LittleEndian::WriteU32 (ofs, FADING_VERSION);
+  LittleEndian::WriteU32 (ofs, rbNum);
+  LittleEndian::WriteU32 (ofs, samplesNum);
+  for (uint32_t i = 0; i < rbNum; i++)
+    {
+      for (uint32_t j = 0; j < samplesNum; j++)
+        {
+          float sample = trace[i][j];
+          uint32_t v;
+          std::memcpy (&v, &sample, sizeof (v));
+          LittleEndian::WriteU32 (ofs, v);
+        }
+    }
+  ofs.close ();
+  return !ofs.fail ();
+}
+
+uint32_t
+TraceFadingLossModel::GetNBinaryTraces (void)
+{
+  return BinaryTrace::GetRegistry ().size ();
+}
+
 
 Ptr<SpectrumValue>
 TraceFadingLossModel::DoCalcRxPowerSpectralDensity (
@@ -201,7 +558,7 @@ TraceFadingLossModel::DoCalcRxPowerSpectralDensity (
   //double speed = std::sqrt (std::pow (aSpeedVector.x-bSpeedVector.x,2) + std::pow (aSpeedVector.y-bSpeedVector.y,2));
 
   NS_LOG_LOGIC (this << *rxPsd);
-  NS_ASSERT (!m_fadingTrace.empty ());
+  NS_ASSERT (!m_fadingTrace.empty () || m_binarySamples != 0);
   int now_ms = static_cast<int> (Simulator::Now ().GetMilliSeconds () * m_timeGranularity);
   int lastUpdate_ms = static_cast<int> (m_lastWindowUpdate.GetMilliSeconds () * m_timeGranularity);
   int index = ((*itOff).second + now_ms - lastUpdate_ms) % m_samplesNum;
@@ -211,7 +568,17 @@ TraceFadingLossModel::DoCalcRxPowerSpectralDensity (
       NS_ASSERT (subChannel < 100);
       if (*vit != 0.)
         {
-          double fading = m_fadingTrace.at (subChannel).at (index);
+          double fading;
+          if (m_binarySamples != 0)
+            {
+              NS_ABORT_MSG_IF (subChannel >= m_rbNum, "the fading trace has " << (uint32_t) m_rbNum
+                               << " RBs, the spectrum model at least " << subChannel + 1);
+              fading = m_binarySamples[static_cast<size_t> (subChannel) * m_samplesNum + index];
+            }
+          else
+            {
+              fading = m_fadingTrace.at (subChannel).at (index);
+            }
           NS_LOG_INFO (this << " FADING now " << now_ms << " offset " << (*itOff).second << " id " << index << " fading " << fading);
           double power = *vit; // in Watt/Hz
           power = 10 * std::log10 (180000 * power); // in dB
@@ -40,6 +40,15 @@ class MobilityModel;
  * \ingroup spectrum
  *
  * \brief fading loss model based on precalculated fading traces
+ *
+ * The trace file is either the text trace generated by
+ * fading_trace_generator.m, with the samples of each RB on a row, which
+ * every instance parses into its own copy, or the binary trace converted
+ * from it by ConvertTrace (see utils/fading-trace-convert.cc). A binary
+ * trace carries its number of RBs and samples, which override the RbNum
+ * and SamplesNum attributes, and is mapped read-only in memory once per
+ * process: all the instances which load it share the mapping, and the
+ * page cache shares it between the processes of a parallel sweep.
  */
 class TraceFadingLossModel : public SpectrumPropagationLossModel
 {
@@ -70,8 +79,32 @@ public:
   */
   int64_t AssignStreams (int64_t stream);
 
-  
+  /**
+   * Convert a text fading trace into a binary trace, with the samples in
+   * single precision.
+   *
+   * \param textFile the text trace
+   * \param binaryFile the binary trace to write
+   * \param rbNum the number of RBs of the trace
+   * \param samplesNum the number of samples per RB of the trace
+   * \return false if the text trace cannot be read or the binary trace
+   *         cannot be written
+   */
+  static bool ConvertTrace (std::string textFile, std::string binaryFile,
+                            uint8_t rbNum, uint32_t samplesNum);
+
+  /**
+   * \return the number of binary traces currently loaded in this process
+   */
+  static uint32_t GetNBinaryTraces (void);
+
+  /// Binary trace loaded in memory, shared by the instances loading its file
+  class BinaryTrace;
+
 private:
+  // inherited from Object
+  virtual void DoDispose (void);
+
   /**
    * \param txPsd set of values vs frequency representing the
    *              transmission power. See SpectrumChannel for details.
@@ -125,7 +158,9 @@ private:
   
   std::string m_traceFile; ///< the trace file name
   
-  FadingTrace m_fadingTrace; ///< fading trace
+  FadingTrace m_fadingTrace; ///< fading trace, when loaded from a text trace
+  Ptr<BinaryTrace> m_binaryTrace; ///< fading trace, when loaded from a binary trace
+  const float *m_binarySamples; ///< samples of the binary trace, RB after RB
 
   
   Time m_traceLength; ///< the trace time
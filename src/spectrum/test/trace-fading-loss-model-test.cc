@@ -0,0 +1,183 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/test.h>
+#include <ns3/log.h>
+#include <ns3/simulator.h>
+#include <ns3/string.h>
+#include <ns3/uinteger.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/trace-fading-loss-model.h>
+#include <fstream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("TraceFadingLossModelTest");
+
+/**
+ * \ingroup spectrum
+ * \ingroup tests
+ *
+ * \brief Test that a binary fading trace converted from a text trace
+ * gives the same losses as the text trace, and that the instances which
+ * load the same binary trace share it.
+ */
+class TraceFadingBinaryTestCase : public TestCase
+{
+public:
+  TraceFadingBinaryTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Create a fading model loading a trace.
+   *
+   * \param filename the trace file
+   * \param rbNum the value of the RbNum attribute
+   * \param samplesNum the value of the SamplesNum attribute
+   * \return the model
+   */
+  Ptr<TraceFadingLossModel> CreateModel (std::string filename, uint32_t rbNum, uint32_t samplesNum);
+
+  /// Check that both models give the same received PSD
+  void Check (void);
+
+  Ptr<TraceFadingLossModel> m_text;   ///< model loading the text trace
+  Ptr<TraceFadingLossModel> m_binary; ///< model loading the binary trace
+  Ptr<MobilityModel> m_a;             ///< mobility of the sender
+  Ptr<MobilityModel> m_b;             ///< mobility of the receiver
+  Ptr<SpectrumValue> m_txPsd;         ///< transmitted PSD
+};
+
+/// Number of RBs of the trace
+static const uint32_t TEST_RB_NUM = 3;
+/// Number of samples per RB of the trace
+static const uint32_t TEST_SAMPLES_NUM = 20;
+
+TraceFadingBinaryTestCase::TraceFadingBinaryTestCase ()
+  : TestCase ("Binary fading trace converted from a text trace")
+{
+}
+
+Ptr<TraceFadingLossModel>
+TraceFadingBinaryTestCase::CreateModel (std::string filename, uint32_t rbNum, uint32_t samplesNum)
+{
+  Ptr<TraceFadingLossModel> model = CreateObject<TraceFadingLossModel> ();
+  model->SetAttribute ("TraceFilename", StringValue (filename));
+  model->SetAttribute ("TraceLength", TimeValue (MilliSeconds (TEST_SAMPLES_NUM)));
+  model->SetAttribute ("WindowSize", TimeValue (MilliSeconds (5)));
+  model->SetAttribute ("RbNum", UintegerValue (rbNum));
+  model->SetAttribute ("SamplesNum", UintegerValue (samplesNum));
+  model->AssignStreams (1);
+  model->Initialize ();
+  return model;
+}
+
+void
+TraceFadingBinaryTestCase::Check (void)
+{
+  Ptr<SpectrumValue> text = m_text->CalcRxPowerSpectralDensity (m_txPsd, m_a, m_b);
+  Ptr<SpectrumValue> binary = m_binary->CalcRxPowerSpectralDensity (m_txPsd, m_a, m_b);
+  for (uint32_t i = 0; i < TEST_RB_NUM; ++i)
+    {
+      NS_TEST_ASSERT_MSG_NE ((*text)[i], (*m_txPsd)[i], "no fading applied");
+      NS_TEST_ASSERT_MSG_EQ ((*binary)[i], (*text)[i], "different PSD at "
+                             << Simulator::Now ().GetMilliSeconds () << " ms, RB " << i);
+    }
+}
+
+void
+TraceFadingBinaryTestCase::DoRun (void)
+{
+  // samples which single precision represents exactly
+  std::string textFile = CreateTempDirFilename ("trace-fading.fad");
+  std::string binaryFile = CreateTempDirFilename ("trace-fading.bin");
+  std::ofstream ofs (textFile.c_str ());
+  for (uint32_t i = 0; i < TEST_RB_NUM; ++i)
+    {
+      for (uint32_t j = 0; j < TEST_SAMPLES_NUM; ++j)
+        {
+          ofs << (i * TEST_SAMPLES_NUM + j) * 0.25 - 7 << " ";
+        }
+      ofs << std::endl;
+    }
+  ofs.close ();
+  NS_TEST_ASSERT_MSG_EQ (TraceFadingLossModel::ConvertTrace (textFile, binaryFile, TEST_RB_NUM, TEST_SAMPLES_NUM + 1),
+                         false, "truncated text trace converted");
+  NS_TEST_ASSERT_MSG_EQ (TraceFadingLossModel::ConvertTrace (textFile, binaryFile, TEST_RB_NUM, TEST_SAMPLES_NUM),
+                         true, "text trace not converted");
+
+  // the binary trace sets the dimensions of the model
+  m_text = CreateModel (textFile, TEST_RB_NUM, TEST_SAMPLES_NUM);
+  m_binary = CreateModel (binaryFile, 100, 10000);
+  UintegerValue samplesNum;
+  m_binary->GetAttribute ("SamplesNum", samplesNum);
+  NS_TEST_ASSERT_MSG_EQ (samplesNum.Get (), TEST_SAMPLES_NUM, "dimensions of the binary trace not used");
+
+  // the instances loading the same binary trace share it
+  NS_TEST_ASSERT_MSG_EQ (TraceFadingLossModel::GetNBinaryTraces (), 1, "binary trace not loaded");
+  Ptr<TraceFadingLossModel> other = CreateModel (binaryFile, TEST_RB_NUM, TEST_SAMPLES_NUM);
+  NS_TEST_ASSERT_MSG_EQ (TraceFadingLossModel::GetNBinaryTraces (), 1, "binary trace not shared");
+
+  m_a = CreateObject<ConstantPositionMobilityModel> ();
+  m_b = CreateObject<ConstantPositionMobilityModel> ();
+  std::vector<double> freqs;
+  for (uint32_t i = 0; i < TEST_RB_NUM; ++i)
+    {
+      freqs.push_back (2.1e9 + i * 180e3);
+    }
+  m_txPsd = Create<SpectrumValue> (Create<SpectrumModel> (freqs));
+  *m_txPsd = 1e-10;
+
+  // within and across the fading windows
+  for (uint32_t t = 0; t < 16; t += 3)
+    {
+      Simulator::Schedule (MilliSeconds (t), &TraceFadingBinaryTestCase::Check, this);
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  // a disposed instance releases the trace, which the other one still holds
+  other->Dispose ();
+  NS_TEST_ASSERT_MSG_EQ (TraceFadingLossModel::GetNBinaryTraces (), 1, "binary trace released too early");
+  m_text = 0;
+  m_binary = 0;
+  other = 0;
+  NS_TEST_ASSERT_MSG_EQ (TraceFadingLossModel::GetNBinaryTraces (), 0, "binary trace not released");
+}
+
+/**
+ * \ingroup spectrum
+ * \ingroup tests
+ *
+ * \brief Trace fading loss model test suite
+ */
+class TraceFadingLossModelTestSuite : public TestSuite
+{
+public:
+  TraceFadingLossModelTestSuite ();
+};
+
+TraceFadingLossModelTestSuite::TraceFadingLossModelTestSuite ()
+  : TestSuite ("trace-fading-loss-model", UNIT)
+{
+  AddTestCase (new TraceFadingBinaryTestCase (), TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static TraceFadingLossModelTestSuite g_traceFadingLossModelTestSuite;
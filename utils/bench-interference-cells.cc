@@ -0,0 +1,321 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to measure the speedup and the accuracy of the
+// LteUePhy::InterferenceCells approximation on the eNB layouts of the SLC2
+// scenarios: the 5 cells of NS3_Env_small with 40 UEs, or the 3x3 grid of
+// NS3_Env_large with 60 UEs, with the UDP traffic of the scenarios, or with
+// saturated DL traffic, i.e., the full load assumed by the approximation.
+// The UEs are static, and the propagation loss is log-distance, without
+// the buildings of the scenarios.
+// The layout is simulated exactly, then with the given number of exact
+// neighbour cells per UE, and the DL data SINR of each UE is compared.
+// Sample usage:  ./waf --run 'bench-interference-cells --layout=large --interferenceCells=2'
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/lte-module.h"
+#include "ns3/system-wall-clock-ms.h"
+#include <iostream>
+#include <stdlib.h> // for exit ()
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <sstream>
+
+using namespace ns3;
+
+/// Accumulator of the DL data SINR of a UE
+struct SinrAccumulator
+{
+  SinrAccumulator ()
+    : m_sum (0),
+      m_n (0)
+  {
+  }
+
+  /**
+   * Add a SINR chunk, once the first interference background is set.
+   * \param [in] sinr The SINR per RB.
+   */
+  void Add (const SpectrumValue &sinr)
+  {
+    if (Simulator::Now () > Seconds (0.5))
+      {
+        m_sum += Sum (sinr) / sinr.GetValuesN ();
+        ++m_n;
+      }
+  }
+
+  /** \return The mean SINR, in dB. */
+  double GetDb (void) const
+  {
+    return 10 * std::log10 (m_sum / m_n);
+  }
+
+  double m_sum;  //!< Sum of the linear SINRs averaged over the RBs.
+  uint32_t m_n;  //!< Number of SINR chunks.
+};
+
+/// Bytes scheduled in DL by all the eNBs
+static uint64_t g_dlBytes = 0;
+
+/**
+ * Count the bytes scheduled in DL.
+ * \param [in] info The DL scheduling information.
+ */
+static void
+DlScheduling (DlSchedulingCallbackInfo info)
+{
+  if (Simulator::Now () > Seconds (0.5))
+    {
+      g_dlBytes += info.sizeTb1 + info.sizeTb2;
+    }
+}
+
+/**
+ * Simulate a layout.
+ * \param [in] enbs The positions of the eNBs.
+ * \param [in] ues The positions of the UEs.
+ * \param [in] interferenceCells The InterferenceCells attribute of the UEs.
+ * \param [in] saturated Whether the DL traffic is saturated.
+ * \param [in] simTime The duration of the simulation.
+ * \param [out] sinr The DL data SINR of each UE.
+ * \return The wall clock time of the simulation, in ms.
+ */
+static int64_t
+Run (const std::vector<Vector> &enbs, const std::vector<Vector> &ues,
+     uint16_t interferenceCells, bool saturated, double simTime,
+     std::vector<SinrAccumulator> &sinr)
+{
+  Config::SetDefault ("ns3::LteUePhy::InterferenceCells", UintegerValue (interferenceCells));
+  Ipv4AddressGenerator::Reset ();
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  lteHelper->SetAttribute ("PathlossModel", StringValue ("ns3::LogDistancePropagationLossModel"));
+  lteHelper->SetPathlossModelAttribute ("Exponent", DoubleValue (3.0));
+  Ptr<PointToPointEpcHelper> epcHelper;
+  if (!saturated)
+    {
+      epcHelper = CreateObject<PointToPointEpcHelper> ();
+      lteHelper->SetEpcHelper (epcHelper);
+    }
+  lteHelper->SetSchedulerType ("ns3::PfFfMacScheduler");
+  lteHelper->SetEnbDeviceAttribute ("DlBandwidth", UintegerValue (75));
+  lteHelper->SetEnbDeviceAttribute ("UlBandwidth", UintegerValue (75));
+
+  NodeContainer enbNodes;
+  NodeContainer ueNodes;
+  enbNodes.Create (enbs.size ());
+  ueNodes.Create (ues.size ());
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  for (std::vector<Vector>::const_iterator it = enbs.begin (); it != enbs.end (); ++it)
+    {
+      positionAlloc->Add (*it);
+    }
+  for (std::vector<Vector>::const_iterator it = ues.begin (); it != ues.end (); ++it)
+    {
+      positionAlloc->Add (*it);
+    }
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.Install (enbNodes);
+  mobility.Install (ueNodes);
+
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+  lteHelper->AssignStreams (enbDevs, 1);
+  lteHelper->AssignStreams (ueDevs, 1000);
+  if (saturated)
+    {
+      lteHelper->AttachToClosestEnb (ueDevs, enbDevs);
+      lteHelper->ActivateDataRadioBearer (ueDevs, EpsBearer (EpsBearer::NGBR_VIDEO_TCP_DEFAULT));
+    }
+  else
+    {
+      // the remote host and the UDP flows of the scenarios, in both directions
+      NodeContainer remoteHostContainer;
+      remoteHostContainer.Create (1);
+      Ptr<Node> remoteHost = remoteHostContainer.Get (0);
+      InternetStackHelper internet;
+      internet.Install (remoteHostContainer);
+      PointToPointHelper p2ph;
+      p2ph.SetDeviceAttribute ("DataRate", DataRateValue (DataRate ("100Mb/s")));
+      p2ph.SetDeviceAttribute ("Mtu", UintegerValue (1500));
+      p2ph.SetChannelAttribute ("Delay", TimeValue (Seconds (0.010)));
+      NetDeviceContainer internetDevices = p2ph.Install (epcHelper->GetPgwNode (), remoteHost);
+      Ipv4AddressHelper ipv4h;
+      ipv4h.SetBase ("1.0.0.0", "255.0.0.0");
+      Ipv4InterfaceContainer internetIpIfaces = ipv4h.Assign (internetDevices);
+      Ipv4Address remoteHostAddr = internetIpIfaces.GetAddress (1);
+      Ipv4StaticRoutingHelper ipv4RoutingHelper;
+      Ptr<Ipv4StaticRouting> remoteHostStaticRouting = ipv4RoutingHelper.GetStaticRouting (remoteHost->GetObject<Ipv4> ());
+      remoteHostStaticRouting->AddNetworkRouteTo (Ipv4Address ("7.0.0.0"), Ipv4Mask ("255.0.0.0"), 1);
+
+      internet.Install (ueNodes);
+      Ipv4InterfaceContainer ueIpIfaces = epcHelper->AssignUeIpv4Address (ueDevs);
+      lteHelper->AttachToClosestEnb (ueDevs, enbDevs);
+
+      ApplicationContainer apps;
+      for (uint32_t u = 0; u < ueNodes.GetN (); ++u)
+        {
+          Ptr<Ipv4StaticRouting> ueStaticRouting = ipv4RoutingHelper.GetStaticRouting (ueNodes.Get (u)->GetObject<Ipv4> ());
+          ueStaticRouting->SetDefaultRoute (epcHelper->GetUeDefaultGatewayAddress (), 1);
+          uint16_t dlPort = 10000 + u;
+          uint16_t ulPort = 20000 + u;
+          UdpServerHelper dlServer (dlPort);
+          apps.Add (dlServer.Install (ueNodes.Get (u)));
+          UdpClientHelper dlClient (ueIpIfaces.GetAddress (u), dlPort);
+          dlClient.SetAttribute ("Interval", TimeValue (MilliSeconds (10)));
+          dlClient.SetAttribute ("MaxPackets", UintegerValue (100000));
+          ApplicationContainer dlApp = dlClient.Install (remoteHost);
+          dlApp.Start (MilliSeconds (100 + u));
+          UdpServerHelper ulServer (ulPort);
+          apps.Add (ulServer.Install (remoteHost));
+          UdpClientHelper ulClient (remoteHostAddr, ulPort);
+          ulClient.SetAttribute ("Interval", TimeValue (MilliSeconds (10)));
+          ulClient.SetAttribute ("MaxPackets", UintegerValue (100000));
+          ApplicationContainer ulApp = ulClient.Install (ueNodes.Get (u));
+          ulApp.Start (MilliSeconds (100 + u));
+        }
+    }
+
+  sinr.assign (ues.size (), SinrAccumulator ());
+  for (uint32_t i = 0; i < ueDevs.GetN (); ++i)
+    {
+      Ptr<LteChunkProcessor> p = Create<LteChunkProcessor> ();
+      p->AddCallback (MakeCallback (&SinrAccumulator::Add, &sinr[i]));
+      ueDevs.Get (i)->GetObject<LteUeNetDevice> ()->GetPhy ()->GetDlSpectrumPhy ()->AddDataSinrChunkProcessor (p);
+    }
+  Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/ComponentCarrierMap/*/LteEnbMac/DlScheduling",
+                                 MakeCallback (&DlScheduling));
+
+  g_dlBytes = 0;
+  Simulator::Stop (Seconds (simTime));
+  SystemWallClockMs time;
+  time.Start ();
+  Simulator::Run ();
+  int64_t ms = time.End ();
+  Simulator::Destroy ();
+  return ms;
+}
+
+/**
+ * Print the results of a simulation.
+ * \param [in] name The name of the simulation.
+ * \param [in] ms The wall clock time of the simulation.
+ * \param [in] sinr The DL data SINR of each UE.
+ * \param [in] exact The DL data SINR of each UE in the exact simulation.
+ * \param [in] simTime The duration of the simulation.
+ */
+static void
+Print (std::string name, int64_t ms, const std::vector<SinrAccumulator> &sinr,
+       const std::vector<SinrAccumulator> &exact, double simTime)
+{
+  double mean = 0;
+  double meanError = 0;
+  double maxError = 0;
+  for (uint32_t i = 0; i < sinr.size (); ++i)
+    {
+      double error = sinr[i].GetDb () - exact[i].GetDb ();
+      mean += sinr[i].GetDb ();
+      meanError += error;
+      maxError = std::max (maxError, std::fabs (error));
+    }
+  std::cout << name << ": " << ms << " ms elapsed"
+            << ", mean SINR " << mean / sinr.size () << " dB"
+            << ", SINR error mean " << meanError / sinr.size () << " dB max " << maxError << " dB"
+            << ", DL " << g_dlBytes * 8 / (simTime - 0.5) / 1e6 << " Mbps scheduled"
+            << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  std::string layout = "small";
+  uint16_t interferenceCells = 2;
+  bool saturated = false;
+  double simTime = 3;
+
+  CommandLine cmd (__FILE__);
+  cmd.Usage ("Measure the speedup and accuracy of LteUePhy::InterferenceCells on the SLC2 layouts");
+  cmd.AddValue ("layout", "small (5 cells, 40 UEs) or large (9 cells, 60 UEs)", layout);
+  cmd.AddValue ("interferenceCells", "the number of exact neighbour cells per UE", interferenceCells);
+  cmd.AddValue ("saturated", "saturate the DL instead of the UDP traffic of the scenarios", saturated);
+  cmd.AddValue ("simTime", "the duration of each simulation, in seconds", simTime);
+  cmd.Parse (argc, argv);
+
+  std::vector<Vector> enbs;
+  uint32_t nUes;
+  if (layout == "small")
+    {
+      enbs.push_back (Vector (200, 0, 1.5));
+      enbs.push_back (Vector (0, 200, 1.5));
+      enbs.push_back (Vector (200, 200, 1.5));
+      enbs.push_back (Vector (400, 200, 1.5));
+      enbs.push_back (Vector (200, 400, 1.5));
+      nUes = 40;
+    }
+  else if (layout == "large")
+    {
+      for (uint32_t i = 0; i < 9; ++i)
+        {
+          enbs.push_back (Vector (200.0 * (i % 3), 200.0 * (i / 3), 1.6));
+        }
+      nUes = 60;
+    }
+  else
+    {
+      std::cerr << "Error-- unknown layout " << layout << std::endl;
+      exit (1);
+    }
+  if (simTime <= 0.5)
+    {
+      std::cerr << "Error-- the simulations must last more than 0.5 s" << std::endl;
+      exit (1);
+    }
+
+  if (saturated)
+    {
+      Config::SetDefault ("ns3::LteEnbRrc::EpsBearerToRlcMapping", EnumValue (LteEnbRrc::RLC_SM_ALWAYS));
+    }
+  Config::SetDefault ("ns3::LteHelper::UseIdealRrc", BooleanValue (true));
+  Ptr<UniformRandomVariable> position = CreateObject<UniformRandomVariable> ();
+  position->SetStream (0);
+  std::vector<Vector> ues;
+  for (uint32_t i = 0; i < nUes; ++i)
+    {
+      double x = position->GetValue (0, 400);
+      double y = position->GetValue (0, 400);
+      ues.push_back (Vector (x, y, 1.5));
+    }
+
+  std::cout << "Running bench-interference-cells with layout=" << layout
+            << " (" << enbs.size () << " cells, " << nUes << " UEs)"
+            << (saturated ? ", saturated" : "") << std::endl;
+  std::vector<SinrAccumulator> exact;
+  int64_t ms = Run (enbs, ues, 0, saturated, simTime, exact);
+  Print ("exact", ms, exact, exact, simTime);
+  std::vector<SinrAccumulator> approximated;
+  ms = Run (enbs, ues, interferenceCells, saturated, simTime, approximated);
+  std::ostringstream name;
+  name << "InterferenceCells=" << interferenceCells;
+  Print (name.str (), ms, approximated, exact, simTime);
+
+  return 0;
+}
@@ -0,0 +1,156 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the per-RNTI lookups of an
+// RntiTable against those of a std::map, as done by the eNB MAC and RRC,
+// with 10 to 1000 UEs per cell, for various numbers of lookups 'n'
+// Sample usage:  ./waf --run 'bench-rnti-table --n=10000000'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/rnti-table.h"
+#include <iostream>
+#include <stdlib.h> // for exit ()
+#include <limits>
+#include <algorithm>
+#include <map>
+#include <vector>
+
+using namespace ns3;
+
+/// Accumulator of the values found, so the lookups cannot be optimized away
+static uint64_t g_sum = 0;
+
+/**
+ * Get the RNTIs of the UEs of a cell, in the order in which they are
+ * looked up, the RNTIs allocated by the eNB RRC being consecutive.
+ * \param [in] ues The number of UEs.
+ * \param [in] n The number of lookups.
+ * \return The RNTIs to look up.
+ */
+static std::vector<uint16_t>
+GetLookups (uint32_t ues, uint32_t n)
+{
+  std::vector<uint16_t> rntis;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      // a stride coprime with the number of UEs visits all of them
+      rntis.push_back (1 + (i * 7919) % ues);
+    }
+  return rntis;
+}
+
+/**
+ * Look up the RNTIs of \p ues UEs \p n times in a std::map.
+ * \param [in] ues The number of UEs.
+ * \param [in] n The number of lookups.
+ */
+static void
+benchMap (uint32_t ues, uint32_t n)
+{
+  std::map<uint16_t, uint32_t> table;
+  for (uint32_t rnti = 1; rnti <= ues; rnti++)
+    {
+      table.insert (std::make_pair (rnti, rnti));
+    }
+  std::vector<uint16_t> rntis = GetLookups (ues, n);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      std::map<uint16_t, uint32_t>::iterator it = table.find (rntis[i]);
+      if (it != table.end ())
+        {
+          g_sum += it->second;
+        }
+    }
+}
+
+/**
+ * Look up the RNTIs of \p ues UEs \p n times in an RntiTable.
+ * \param [in] ues The number of UEs.
+ * \param [in] n The number of lookups.
+ */
+static void
+benchRntiTable (uint32_t ues, uint32_t n)
+{
+  RntiTable<uint32_t> table;
+  for (uint32_t rnti = 1; rnti <= ues; rnti++)
+    {
+      table.Insert (rnti, rnti);
+    }
+  std::vector<uint16_t> rntis = GetLookups (ues, n);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      uint32_t *value = table.Find (rntis[i]);
+      if (value != 0)
+        {
+          g_sum += *value;
+        }
+    }
+}
+
+static void
+runBench (void (*bench) (uint32_t, uint32_t), uint32_t ues, uint32_t n,
+          uint32_t minIterations, char const *name)
+{
+  uint64_t minDelay = std::numeric_limits<uint64_t>::max ();
+  for (uint32_t i = 0; i < minIterations; i++)
+    {
+      SystemWallClockMs time;
+      time.Start ();
+      (*bench) (ues, n);
+      minDelay = std::min (minDelay, static_cast<uint64_t> (time.End ()));
+    }
+  double ns = minDelay;
+  ns *= 1000000;
+  ns /= n;
+  std::cout << ns << " ns/lookup"
+            << " (" << minDelay << " ms elapsed)\t"
+            << name << ", " << ues << " UEs"
+            << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 0;
+  uint32_t minIterations = 1;
+
+  CommandLine cmd (__FILE__);
+  cmd.Usage ("Benchmark the per-RNTI lookups of RntiTable and std::map");
+  cmd.AddValue ("n", "number of lookups", n);
+  cmd.AddValue ("min-iterations", "number of subiterations to minimize iteration time over", minIterations);
+  cmd.Parse (argc, argv);
+
+  if (n == 0)
+    {
+      std::cerr << "Error-- number of lookups must be specified " <<
+        "by command-line argument --n=(number of lookups)" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-rnti-table with n=" << n << std::endl;
+
+  uint32_t ues[] = {10, 100, 1000};
+  for (uint32_t i = 0; i < sizeof (ues) / sizeof (ues[0]); i++)
+    {
+      runBench (&benchMap, ues[i], n, minIterations, "std::map");
+    }
+  for (uint32_t i = 0; i < sizeof (ues) / sizeof (ues[0]); i++)
+    {
+      runBench (&benchRntiTable, ues[i], n, minIterations, "RntiTable");
+    }
+  std::cout << "Checksum " << g_sum << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the cost of firing a TracedCallback
+// with 0, 1 and 4 connected sinks, for various numbers of firings 'n'
+// Sample usage:  ./waf --run 'bench-traced-callback --n=10000000'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/traced-callback.h"
+#include <iostream>
+#include <stdlib.h> // for exit ()
+#include <limits>
+#include <algorithm>
+
+using namespace ns3;
+
+/// Accumulator written by the sinks, so the calls cannot be optimized away
+static uint64_t g_sum = 0;
+
+/**
+ * Trace sink.
+ * \param [in] rnti An RNTI-like argument.
+ * \param [in] lcid An LCID-like argument.
+ * \param [in] size A size-like argument.
+ */
+static void
+Sink (uint16_t rnti, uint8_t lcid, uint32_t size)
+{
+  g_sum += rnti + lcid + size;
+}
+
+/**
+ * Fire a TracedCallback with \p sinks sinks connected \p n times.
+ * \param [in] sinks The number of sinks to connect.
+ * \param [in] n The number of firings.
+ */
+static void
+benchFire (uint32_t sinks, uint32_t n)
+{
+  TracedCallback<uint16_t, uint8_t, uint32_t> trace;
+  for (uint32_t i = 0; i < sinks; i++)
+    {
+      trace.ConnectWithoutContext (MakeCallback (&Sink));
+    }
+  for (uint32_t i = 0; i < n; i++)
+    {
+      trace (1, 3, i);
+    }
+}
+
+/**
+ * Same as benchFire, but guard each firing with TracedCallback::IsEmpty ().
+ * \param [in] sinks The number of sinks to connect.
+ * \param [in] n The number of firings.
+ */
+static void
+benchFireIfConnected (uint32_t sinks, uint32_t n)
+{
+  TracedCallback<uint16_t, uint8_t, uint32_t> trace;
+  for (uint32_t i = 0; i < sinks; i++)
+    {
+      trace.ConnectWithoutContext (MakeCallback (&Sink));
+    }
+  for (uint32_t i = 0; i < n; i++)
+    {
+      if (!trace.IsEmpty ())
+        {
+          trace (1, 3, i);
+        }
+    }
+}
+
+static void
+runBench (void (*bench) (uint32_t, uint32_t), uint32_t sinks, uint32_t n,
+          uint32_t minIterations, char const *name)
+{
+  uint64_t minDelay = std::numeric_limits<uint64_t>::max ();
+  for (uint32_t i = 0; i < minIterations; i++)
+    {
+      SystemWallClockMs time;
+      time.Start ();
+      (*bench) (sinks, n);
+      minDelay = std::min (minDelay, static_cast<uint64_t> (time.End ()));
+    }
+  double ns = minDelay;
+  ns *= 1000000;
+  ns /= n;
+  std::cout << ns << " ns/firing"
+            << " (" << minDelay << " ms elapsed)\t"
+            << name << ", " << sinks << " sinks"
+            << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 0;
+  uint32_t minIterations = 1;
+
+  CommandLine cmd (__FILE__);
+  cmd.Usage ("Benchmark TracedCallback firing");
+  cmd.AddValue ("n", "number of firings", n);
+  cmd.AddValue ("min-iterations", "number of subiterations to minimize iteration time over", minIterations);
+  cmd.Parse (argc, argv);
+
+  if (n == 0)
+    {
+      std::cerr << "Error-- number of firings must be specified " <<
+        "by command-line argument --n=(number of firings)" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-traced-callback with n=" << n << std::endl;
+
+  uint32_t sinks[] = {0, 1, 4};
+  for (uint32_t i = 0; i < sizeof (sinks) / sizeof (sinks[0]); i++)
+    {
+      runBench (&benchFire, sinks[i], n, minIterations, "Fire");
+    }
+  for (uint32_t i = 0; i < sizeof (sinks) / sizeof (sinks[0]); i++)
+    {
+      runBench (&benchFireIfConnected, sinks[i], n, minIterations, "Fire if not empty");
+    }
+  std::cout << "Checksum " << g_sum << std::endl;
+
+  return 0;
+}
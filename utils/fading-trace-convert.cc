@@ -0,0 +1,60 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program converts a text fading trace, as generated by
+// src/lte/model/fading-traces/fading_trace_generator.m, into the binary
+// trace which TraceFadingLossModel maps in memory. The binary trace is
+// used in place of the text one through the TraceFilename attribute.
+// Sample usage:
+//   ./waf --run 'fading-trace-convert
+//     --input=src/lte/model/fading-traces/fading_trace_EPA_3kmph.fad
+//     --output=fading_trace_EPA_3kmph.bin --rbNum=100 --samplesNum=10000'
+
+#include "ns3/command-line.h"
+#include "ns3/trace-fading-loss-model.h"
+#include <iostream>
+#include <string>
+
+using namespace ns3;
+
+int main (int argc, char *argv[])
+{
+  std::string input = "fading_trace_EPA_3kmph.fad";
+  std::string output = "fading_trace_EPA_3kmph.bin";
+  uint32_t rbNum = 100;
+  uint32_t samplesNum = 10000;
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("input", "text fading trace", input);
+  cmd.AddValue ("output", "binary fading trace", output);
+  cmd.AddValue ("rbNum", "number of RBs of the trace", rbNum);
+  cmd.AddValue ("samplesNum", "number of samples per RB of the trace", samplesNum);
+  cmd.Parse (argc, argv);
+
+  if (rbNum == 0 || rbNum > 255 || samplesNum == 0)
+    {
+      std::cerr << "invalid trace size " << rbNum << " x " << samplesNum << std::endl;
+      return 1;
+    }
+  if (!TraceFadingLossModel::ConvertTrace (input, output, rbNum, samplesNum))
+    {
+      std::cerr << "cannot convert " << input << " to " << output << std::endl;
+      return 1;
+    }
+  std::cout << "wrote " << rbNum << " x " << samplesNum << " samples to "
+            << output << std::endl;
+  return 0;
+}
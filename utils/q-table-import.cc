@@ -0,0 +1,90 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program converts the MLB and MRO Q-table CSV files of the SLC2
+// agents into the binary policy file of MyGymEnv::QTablePolicy. The
+// "{}" in the file patterns is replaced by the cell numbers, from 1.
+// Sample usage:
+//   ./waf --run 'q-table-import --nCells=5
+//     --mlb=Qtable/mid/Qtable{}_QMLB_Mid.csv
+//     --mro=Qtable/mid/Qtable{}_QMRO_Mid.csv --output=qtable-mid.bin'
+
+#include "ns3/command-line.h"
+#include "ns3/q-table-policy.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Replace the "{}" of a file pattern by a cell number.
+ *
+ * \param pattern the file pattern
+ * \param cell the cell number
+ * \return the file name
+ */
+static std::string
+GetFileName (std::string pattern, uint32_t cell)
+{
+  std::string::size_type pos = pattern.find ("{}");
+  if (pos == std::string::npos)
+    {
+      return pattern;
+    }
+  std::ostringstream oss;
+  oss << cell;
+  return pattern.replace (pos, 2, oss.str ());
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t nCells = 5;
+  std::string mlb = "Qtable/mid/Qtable{}_QMLB_Mid.csv";
+  std::string mro = "Qtable/mid/Qtable{}_QMRO_Mid.csv";
+  std::string output = "qtable.bin";
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("nCells", "number of cells", nCells);
+  cmd.AddValue ("mlb", "pattern of the MLB Q-table CSV files", mlb);
+  cmd.AddValue ("mro", "pattern of the MRO Q-table CSV files", mro);
+  cmd.AddValue ("output", "binary policy file", output);
+  cmd.Parse (argc, argv);
+
+  std::vector<std::string> mlbFiles;
+  std::vector<std::string> mroFiles;
+  for (uint32_t cell = 1; cell <= nCells; ++cell)
+    {
+      mlbFiles.push_back (GetFileName (mlb, cell));
+      mroFiles.push_back (GetFileName (mro, cell));
+    }
+
+  Ptr<QTablePolicy> policy = Create<QTablePolicy> ();
+  if (!policy->ImportCsv (mlbFiles, mroFiles))
+    {
+      std::cerr << "cannot import the Q-tables" << std::endl;
+      return 1;
+    }
+  if (!policy->Save (output))
+    {
+      std::cerr << "cannot write " << output << std::endl;
+      return 1;
+    }
+  std::cout << "wrote the Q-tables of " << policy->GetNCells () << " cells to "
+            << output << std::endl;
+  return 0;
+}